@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2025 Pergyra Language Project
+ * All rights reserved.
+ *
+ * Security audit decoder
+ *
+ * Formats binary audit files written by the security audit logger:
+ *
+ *   audit_decode [-s] [-e EVENT] [-l SLOT] FILE...
+ *
+ *   -s        print per-event counts instead of entries
+ *   -e EVENT  only entries of this event (name, e.g. TOKEN_VALIDATION_FAILED)
+ *   -l SLOT   only entries for this slot ID
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "runtime/security_audit.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct
+{
+    bool     summary;
+    int      event;                /* -1 = all */
+    bool     filterSlot;
+    uint32_t slotId;
+    uint64_t counts[SECURITY_AUDIT_EVENT_COUNT + 1];  /* Last = unknown */
+} DecodeOptions;
+
+static int
+ParseEventName(const char *name)
+{
+    for (int i = 1; i < SECURITY_AUDIT_EVENT_COUNT; i++) {
+        if (strcmp(SecurityAuditEventName((SecurityAuditEvent)i), name) == 0)
+            return i;
+    }
+    
+    return -1;
+}
+
+static void
+PrintEntry(const SecurityAuditHeader *session, const SecurityAuditEntry *entry)
+{
+    int64_t ticks = (int64_t)(entry->timestamp - session->startTicks);
+    double offsetNs = session->ticksPerSecond > 0 ?
+                      (double)ticks * 1e9 / (double)session->ticksPerSecond : 0.0;
+    int64_t realtimeNs = (int64_t)session->startRealtimeNs + (int64_t)offsetNs;
+    
+    time_t seconds = (time_t)(realtimeNs / 1000000000LL);
+    struct tm timeinfo;
+    char timestamp[32];
+    localtime_r(&seconds, &timeinfo);
+    strftime(timestamp, sizeof(timestamp), "%Y-%m-%d %H:%M:%S", &timeinfo);
+    
+    printf("%s.%09lld ring=%u slot=%u %s\n", timestamp,
+           (long long)(realtimeNs % 1000000000LL), entry->ring, entry->slotId,
+           SecurityAuditEventName((SecurityAuditEvent)entry->event));
+}
+
+static bool
+DecodeFile(const char *path, DecodeOptions *options)
+{
+    FILE *fp = fopen(path, "rb");
+    if (fp == NULL) {
+        perror(path);
+        return false;
+    }
+    
+    SecurityAuditHeader session;
+    bool haveSession = false;
+    bool ok = true;
+    SecurityAuditEntry entry;
+    
+    while (fread(&entry, sizeof(entry), 1, fp) == 1) {
+        if (entry.timestamp == SECURITY_AUDIT_MAGIC) {
+            /* Session header: the first unit is already read */
+            memcpy(&session, &entry, sizeof(entry));
+            size_t rest = sizeof(session) - sizeof(entry);
+            if (fread((uint8_t *)&session + sizeof(entry), rest, 1, fp) != 1 ||
+                session.version != SECURITY_AUDIT_VERSION ||
+                session.entrySize != sizeof(SecurityAuditEntry)) {
+                fprintf(stderr, "%s: unsupported or truncated session header\n", path);
+                ok = false;
+                break;
+            }
+            haveSession = true;
+            continue;
+        }
+    
+        if (!haveSession) {
+            fprintf(stderr, "%s: entries before the first session header\n", path);
+            ok = false;
+            break;
+        }
+    
+        if (options->event >= 0 && entry.event != options->event)
+            continue;
+        if (options->filterSlot && entry.slotId != options->slotId)
+            continue;
+    
+        if (options->summary) {
+            size_t index = entry.event < SECURITY_AUDIT_EVENT_COUNT ?
+                           entry.event : SECURITY_AUDIT_EVENT_COUNT;
+            options->counts[index]++;
+        } else {
+            PrintEntry(&session, &entry);
+        }
+    }
+    
+    fclose(fp);
+    return ok;
+}
+
+static void
+Usage(const char *program)
+{
+    fprintf(stderr, "usage: %s [-s] [-e EVENT] [-l SLOT] FILE...\n", program);
+}
+
+int
+main(int argc, char *argv[])
+{
+    DecodeOptions options;
+    memset(&options, 0, sizeof(options));
+    options.event = -1;
+    
+    int argi = 1;
+    for (; argi < argc && argv[argi][0] == '-'; argi++) {
+        if (strcmp(argv[argi], "-s") == 0) {
+            options.summary = true;
+        } else if (strcmp(argv[argi], "-e") == 0 && argi + 1 < argc) {
+            options.event = ParseEventName(argv[++argi]);
+            if (options.event < 0) {
+                fprintf(stderr, "unknown event: %s\n", argv[argi]);
+                return 2;
+            }
+        } else if (strcmp(argv[argi], "-l") == 0 && argi + 1 < argc) {
+            options.filterSlot = true;
+            options.slotId = (uint32_t)strtoul(argv[++argi], NULL, 10);
+        } else {
+            Usage(argv[0]);
+            return 2;
+        }
+    }
+    
+    if (argi == argc) {
+        Usage(argv[0]);
+        return 2;
+    }
+    
+    bool ok = true;
+    for (; argi < argc; argi++)
+        ok &= DecodeFile(argv[argi], &options);
+    
+    if (options.summary) {
+        for (int i = 0; i <= SECURITY_AUDIT_EVENT_COUNT; i++) {
+            if (options.counts[i] == 0)
+                continue;
+            printf("%-32s %llu\n",
+                   i < SECURITY_AUDIT_EVENT_COUNT ?
+                   SecurityAuditEventName((SecurityAuditEvent)i) : "UNKNOWN",
+                   (unsigned long long)options.counts[i]);
+        }
+    }
+    
+    return ok ? 0 : 1;
+}
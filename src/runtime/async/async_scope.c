@@ -6,8 +6,11 @@
  * BSD Style + C# naming conventions
  */
 
+#define _GNU_SOURCE
+
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <assert.h>
 #include "async_scope.h"
 #include "scheduler.h"
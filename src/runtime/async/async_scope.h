@@ -10,6 +10,7 @@
 #define PERGYRA_ASYNC_SCOPE_H
 
 #include <stdbool.h>
+#include <pthread.h>
 #include "fiber.h"
 
 /* Forward declarations */
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2025 Pergyra Language Project
+ * All rights reserved.
+ *
+ * Atomic types and spin locks shared by the SEA runtime
+ * BSD Style + C# naming conventions
+ */
+
+#ifndef PERGYRA_ATOMICS_H
+#define PERGYRA_ATOMICS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <sched.h>
+
+/* Fixed-width atomic counters (C11 only names the least/fast variants) */
+typedef _Atomic(uint64_t) atomic_uint64_t;
+typedef _Atomic(uint32_t) atomic_uint32_t;
+
+/* Spins before a waiter gives its time slice back */
+#define SPIN_LOCK_SPINS_BEFORE_YIELD 64
+
+/*
+ * Test-and-test-and-set lock for short critical sections. Zeroed memory
+ * is an unlocked lock, so it can live in calloc'd or static structures.
+ * Holders must not yield the fiber.
+ */
+typedef struct SpinLock {
+    atomic_bool locked;
+} SpinLock;
+
+static inline void SpinLockInit(SpinLock* lock)
+{
+    atomic_init(&lock->locked, false);
+}
+
+static inline bool SpinLockTryAcquire(SpinLock* lock)
+{
+    return !atomic_load_explicit(&lock->locked, memory_order_relaxed) &&
+           !atomic_exchange_explicit(&lock->locked, true, memory_order_acquire);
+}
+
+static inline void SpinLockAcquire(SpinLock* lock)
+{
+    uint32_t spins = 0;
+
+    while (!SpinLockTryAcquire(lock)) {
+        if (++spins >= SPIN_LOCK_SPINS_BEFORE_YIELD) {
+            spins = 0;
+            sched_yield();
+        }
+    }
+}
+
+static inline void SpinLockRelease(SpinLock* lock)
+{
+    atomic_store_explicit(&lock->locked, false, memory_order_release);
+}
+
+#endif /* PERGYRA_ATOMICS_H */
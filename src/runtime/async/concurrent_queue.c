@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2025 Pergyra Language Project
+ * All rights reserved.
+ *
+ * Concurrent queue implementation for scheduler
+ * BSD Style + C# naming conventions
+ */
+
+#include <stdlib.h>
+#include "concurrent_queue.h"
+
+ConcurrentQueue* ConcurrentQueueCreate(void)
+{
+    ConcurrentQueue* queue = (ConcurrentQueue*)calloc(1, sizeof(ConcurrentQueue));
+    if (queue == NULL) {
+        return NULL;
+    }
+
+    QueueNode* dummy = (QueueNode*)calloc(1, sizeof(QueueNode));
+    if (dummy == NULL) {
+        free(queue);
+        return NULL;
+    }
+
+    atomic_init(&dummy->next, NULL);
+    queue->head = dummy;
+    queue->tail = dummy;
+    SpinLockInit(&queue->headLock);
+    SpinLockInit(&queue->tailLock);
+    atomic_init(&queue->size, 0);
+
+    return queue;
+}
+
+void ConcurrentQueueDestroy(ConcurrentQueue* queue)
+{
+    if (queue == NULL) {
+        return;
+    }
+
+    /* Items still queued belong to the caller; only the nodes are freed */
+    QueueNode* node = queue->head;
+    while (node != NULL) {
+        QueueNode* next = atomic_load_explicit(&node->next, memory_order_relaxed);
+        free(node);
+        node = next;
+    }
+
+    free(queue);
+}
+
+bool ConcurrentQueuePush(ConcurrentQueue* queue, void* data)
+{
+    return ConcurrentQueuePushBatch(queue, &data, 1);
+}
+
+/* Unlink the first item (head lock held) */
+static void* ConcurrentQueuePopLocked(ConcurrentQueue* queue)
+{
+    QueueNode* dummy = queue->head;
+    QueueNode* first = atomic_load_explicit(&dummy->next, memory_order_acquire);
+    if (first == NULL) {
+        return NULL;
+    }
+
+    /* The first node becomes the new dummy */
+    void* data = first->data;
+    first->data = NULL;
+    queue->head = first;
+    atomic_fetch_sub_explicit(&queue->size, 1, memory_order_relaxed);
+
+    free(dummy);
+    return data;
+}
+
+void* ConcurrentQueuePop(ConcurrentQueue* queue)
+{
+    if (queue == NULL || ConcurrentQueueIsEmpty(queue)) {
+        return NULL;
+    }
+
+    SpinLockAcquire(&queue->headLock);
+    void* data = ConcurrentQueuePopLocked(queue);
+    SpinLockRelease(&queue->headLock);
+
+    return data;
+}
+
+void* ConcurrentQueueTryPop(ConcurrentQueue* queue)
+{
+    if (queue == NULL || ConcurrentQueueIsEmpty(queue)) {
+        return NULL;
+    }
+
+    /* Give up rather than wait behind another consumer */
+    if (!SpinLockTryAcquire(&queue->headLock)) {
+        return NULL;
+    }
+    void* data = ConcurrentQueuePopLocked(queue);
+    SpinLockRelease(&queue->headLock);
+
+    return data;
+}
+
+size_t ConcurrentQueueSize(ConcurrentQueue* queue)
+{
+    return queue != NULL ? atomic_load_explicit(&queue->size, memory_order_relaxed) : 0;
+}
+
+bool ConcurrentQueueIsEmpty(ConcurrentQueue* queue)
+{
+    return ConcurrentQueueSize(queue) == 0;
+}
+
+bool ConcurrentQueuePushBatch(ConcurrentQueue* queue, void** items, size_t count)
+{
+    if (queue == NULL || items == NULL || count == 0) {
+        return false;
+    }
+
+    /* Link the batch privately, then splice it in under one lock hold */
+    QueueNode* first = NULL;
+    QueueNode* last = NULL;
+
+    for (size_t i = 0; i < count; i++) {
+        QueueNode* node = (QueueNode*)malloc(sizeof(QueueNode));
+        if (node == NULL) {
+            /* All or nothing: the caller still owns every item */
+            while (first != NULL) {
+                QueueNode* next = atomic_load_explicit(&first->next, memory_order_relaxed);
+                free(first);
+                first = next;
+            }
+            return false;
+        }
+        node->data = items[i];
+        atomic_init(&node->next, NULL);
+
+        if (last != NULL) {
+            atomic_store_explicit(&last->next, node, memory_order_relaxed);
+        } else {
+            first = node;
+        }
+        last = node;
+    }
+
+    SpinLockAcquire(&queue->tailLock);
+    /* Count first so a consumer never sees a node the size does not cover */
+    atomic_fetch_add_explicit(&queue->size, count, memory_order_relaxed);
+    atomic_store_explicit(&queue->tail->next, first, memory_order_release);
+    queue->tail = last;
+    SpinLockRelease(&queue->tailLock);
+
+    return true;
+}
+
+size_t ConcurrentQueuePopBatch(ConcurrentQueue* queue, void** buffer, size_t maxCount)
+{
+    if (queue == NULL || buffer == NULL || maxCount == 0 || ConcurrentQueueIsEmpty(queue)) {
+        return 0;
+    }
+
+    size_t popped = 0;
+
+    SpinLockAcquire(&queue->headLock);
+    while (popped < maxCount) {
+        void* data = ConcurrentQueuePopLocked(queue);
+        if (data == NULL) {
+            break;
+        }
+        buffer[popped++] = data;
+    }
+    SpinLockRelease(&queue->headLock);
+
+    return popped;
+}
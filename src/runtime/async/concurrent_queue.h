@@ -12,17 +12,25 @@
 #include <stdatomic.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include "atomics.h"
 
 /* Queue node */
 typedef struct QueueNode {
     void* data;
-    atomic_intptr_t next;
+    _Atomic(struct QueueNode*) next;
 } QueueNode;
 
-/* Lock-free concurrent queue using Michael & Scott algorithm */
+/*
+ * Michael & Scott two-lock queue: producers only take the tail lock and
+ * consumers only the head lock, and a dummy node keeps them apart. Nodes
+ * are freed by the consumer that unlinks them, so no reclamation scheme
+ * is needed.
+ */
 typedef struct ConcurrentQueue {
-    atomic_intptr_t head;
-    atomic_intptr_t tail;
+    QueueNode* head;           /* Dummy node; guarded by headLock */
+    QueueNode* tail;           /* Guarded by tailLock */
+    SpinLock headLock;
+    SpinLock tailLock;
     atomic_size_t size;
 } ConcurrentQueue;
 
@@ -30,8 +38,8 @@ typedef struct ConcurrentQueue {
 ConcurrentQueue* ConcurrentQueueCreate(void);
 void ConcurrentQueueDestroy(ConcurrentQueue* queue);
 
-/* Enqueue/Dequeue */
-void ConcurrentQueuePush(ConcurrentQueue* queue, void* data);
+/* Enqueue/Dequeue (pushes fail only when a node cannot be allocated) */
+bool ConcurrentQueuePush(ConcurrentQueue* queue, void* data);
 void* ConcurrentQueuePop(ConcurrentQueue* queue);
 void* ConcurrentQueueTryPop(ConcurrentQueue* queue);
 
@@ -40,7 +48,7 @@ size_t ConcurrentQueueSize(ConcurrentQueue* queue);
 bool ConcurrentQueueIsEmpty(ConcurrentQueue* queue);
 
 /* Batch operations for efficiency */
-void ConcurrentQueuePushBatch(ConcurrentQueue* queue, void** items, size_t count);
+bool ConcurrentQueuePushBatch(ConcurrentQueue* queue, void** items, size_t count);
 size_t ConcurrentQueuePopBatch(ConcurrentQueue* queue, void** buffer, size_t maxCount);
 
 #endif /* PERGYRA_CONCURRENT_QUEUE_H */
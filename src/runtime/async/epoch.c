@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2025 Pergyra Language Project
+ * All rights reserved.
+ *
+ * Epoch-based reclamation implementation
+ * BSD Style + C# naming conventions
+ */
+
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include "epoch.h"
+
+/* Reader record state: 0 = quiescent, otherwise the epoch it entered in */
+#define EPOCH_QUIESCENT 0
+
+/* Reclaim eagerly once this many objects are pending */
+#define EPOCH_RECLAIM_THRESHOLD 64
+
+/* Per-thread reader record (never freed, reused by later threads) */
+typedef struct EpochRecord {
+    _Atomic(uint64_t) epoch;
+    atomic_bool inUse;
+    struct EpochRecord* next;
+} EpochRecord;
+
+/* Object waiting for reclamation */
+typedef struct RetiredObject {
+    void* object;
+    EpochDestructor destructor;
+    uint64_t retireEpoch;
+    struct RetiredObject* next;
+} RetiredObject;
+
+/* Global epoch starts at 1 so 0 can mean quiescent */
+static _Atomic(uint64_t) g_globalEpoch = 1;
+
+/* Push-only list of reader records */
+static _Atomic(EpochRecord*) g_records = NULL;
+static atomic_uint_fast64_t g_recordCount = 0;
+
+/* Retired objects (writer side only, so a mutex is fine) */
+static pthread_mutex_t g_retireMutex = PTHREAD_MUTEX_INITIALIZER;
+static RetiredObject* g_retired = NULL;
+static uint64_t g_pendingCount = 0;
+static uint64_t g_reclaimedCount = 0;
+
+/* Thread-local record and nesting depth */
+static __thread EpochRecord* tlsRecord = NULL;
+static __thread uint32_t tlsDepth = 0;
+static pthread_key_t g_recordKey;
+static pthread_once_t g_recordKeyOnce = PTHREAD_ONCE_INIT;
+
+static void EpochReleaseRecord(void* arg)
+{
+    EpochRecord* record = (EpochRecord*)arg;
+    atomic_store(&record->epoch, EPOCH_QUIESCENT);
+    atomic_store(&record->inUse, false);
+}
+
+static void EpochCreateKey(void)
+{
+    pthread_key_create(&g_recordKey, EpochReleaseRecord);
+}
+
+static EpochRecord* EpochAcquireRecord(void)
+{
+    if (tlsRecord != NULL) {
+        return tlsRecord;
+    }
+
+    pthread_once(&g_recordKeyOnce, EpochCreateKey);
+
+    /* Reuse a record released by an exited thread */
+    for (EpochRecord* r = atomic_load(&g_records); r != NULL; r = r->next) {
+        bool expected = false;
+        if (atomic_compare_exchange_strong(&r->inUse, &expected, true)) {
+            tlsRecord = r;
+            pthread_setspecific(g_recordKey, r);
+            return r;
+        }
+    }
+
+    EpochRecord* record = (EpochRecord*)calloc(1, sizeof(EpochRecord));
+    if (record == NULL) {
+        abort();
+    }
+    atomic_init(&record->epoch, EPOCH_QUIESCENT);
+    atomic_init(&record->inUse, true);
+
+    /* Lock-free push */
+    EpochRecord* head = atomic_load(&g_records);
+    do {
+        record->next = head;
+    } while (!atomic_compare_exchange_weak(&g_records, &head, record));
+
+    atomic_fetch_add(&g_recordCount, 1);
+    tlsRecord = record;
+    pthread_setspecific(g_recordKey, record);
+    return record;
+}
+
+void EpochEnter(void)
+{
+    if (tlsDepth++ > 0) {
+        return;
+    }
+
+    EpochRecord* record = EpochAcquireRecord();
+
+    /*
+     * Sequentially consistent store: if a reclaimer's scan misses this
+     * record, every pointer load that follows is ordered after the
+     * writer's swap and observes the new version.
+     */
+    atomic_store(&record->epoch, atomic_load(&g_globalEpoch));
+}
+
+void EpochExit(void)
+{
+    if (tlsDepth == 0 || --tlsDepth > 0) {
+        return;
+    }
+
+    atomic_store_explicit(&tlsRecord->epoch, EPOCH_QUIESCENT, memory_order_release);
+}
+
+/* Oldest epoch still observed by a reader (UINT64_MAX if none) */
+static uint64_t EpochMinActive(void)
+{
+    uint64_t minEpoch = UINT64_MAX;
+
+    for (EpochRecord* r = atomic_load(&g_records); r != NULL; r = r->next) {
+        uint64_t e = atomic_load(&r->epoch);
+        if (e != EPOCH_QUIESCENT && e < minEpoch) {
+            minEpoch = e;
+        }
+    }
+
+    return minEpoch;
+}
+
+void EpochRetire(void* object, EpochDestructor destructor)
+{
+    if (object == NULL || destructor == NULL) {
+        return;
+    }
+
+    RetiredObject* retired = (RetiredObject*)malloc(sizeof(RetiredObject));
+    if (retired == NULL) {
+        /* Cannot defer - wait for readers and destroy now */
+        atomic_fetch_add(&g_globalEpoch, 1);
+        EpochSynchronize();
+        destructor(object);
+        return;
+    }
+
+    retired->object = object;
+    retired->destructor = destructor;
+
+    /* Readers entering after this see a newer epoch and the new version */
+    retired->retireEpoch = atomic_fetch_add(&g_globalEpoch, 1);
+
+    pthread_mutex_lock(&g_retireMutex);
+    retired->next = g_retired;
+    g_retired = retired;
+    bool shouldReclaim = ++g_pendingCount >= EPOCH_RECLAIM_THRESHOLD;
+    pthread_mutex_unlock(&g_retireMutex);
+
+    if (shouldReclaim) {
+        EpochReclaim();
+    }
+}
+
+size_t EpochReclaim(void)
+{
+    RetiredObject* reclaim = NULL;
+
+    pthread_mutex_lock(&g_retireMutex);
+
+    uint64_t minActive = EpochMinActive();
+    RetiredObject** link = &g_retired;
+    while (*link != NULL) {
+        RetiredObject* r = *link;
+        if (r->retireEpoch < minActive) {
+            *link = r->next;
+            r->next = reclaim;
+            reclaim = r;
+            g_pendingCount--;
+        } else {
+            link = &r->next;
+        }
+    }
+
+    pthread_mutex_unlock(&g_retireMutex);
+
+    /* Run destructors outside the lock */
+    size_t count = 0;
+    while (reclaim != NULL) {
+        RetiredObject* next = reclaim->next;
+        reclaim->destructor(reclaim->object);
+        free(reclaim);
+        reclaim = next;
+        count++;
+    }
+
+    if (count > 0) {
+        pthread_mutex_lock(&g_retireMutex);
+        g_reclaimedCount += count;
+        pthread_mutex_unlock(&g_retireMutex);
+    }
+
+    return count;
+}
+
+void EpochSynchronize(void)
+{
+    uint64_t target = atomic_load(&g_globalEpoch);
+
+    /* Wait for readers that entered before now */
+    while (EpochMinActive() < target) {
+        sched_yield();
+    }
+
+    EpochReclaim();
+}
+
+void EpochGetStats(EpochStats* stats)
+{
+    if (stats == NULL) {
+        return;
+    }
+
+    stats->currentEpoch = atomic_load(&g_globalEpoch);
+    stats->registeredThreads = atomic_load(&g_recordCount);
+
+    pthread_mutex_lock(&g_retireMutex);
+    stats->pendingObjects = g_pendingCount;
+    stats->reclaimedObjects = g_reclaimedCount;
+    pthread_mutex_unlock(&g_retireMutex);
+}
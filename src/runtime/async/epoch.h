@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2025 Pergyra Language Project
+ * All rights reserved.
+ *
+ * Epoch-based reclamation for read-mostly runtime tables
+ * BSD Style + C# naming conventions
+ */
+
+#ifndef PERGYRA_EPOCH_H
+#define PERGYRA_EPOCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+ * Readers bracket their accesses with EpochEnter/EpochExit and never block.
+ * Writers publish a new version with an atomic pointer swap and hand the
+ * old one to EpochRetire; it is destroyed once every reader that could
+ * still observe it has left its critical section.
+ *
+ * Critical sections must not yield the fiber (they may migrate threads).
+ */
+
+/* Destructor invoked for retired objects */
+typedef void (*EpochDestructor)(void* object);
+
+/* Read-side critical section (nestable, wait-free) */
+void EpochEnter(void);
+void EpochExit(void);
+
+/* Defer destruction of an unpublished object */
+void EpochRetire(void* object, EpochDestructor destructor);
+
+/* Destroy every retired object that no reader can reach; returns count */
+size_t EpochReclaim(void);
+
+/* Block until all retired objects have been destroyed (not from a reader) */
+void EpochSynchronize(void);
+
+/* Statistics */
+typedef struct EpochStats {
+    uint64_t currentEpoch;
+    uint64_t registeredThreads;
+    uint64_t pendingObjects;
+    uint64_t reclaimedObjects;
+} EpochStats;
+
+void EpochGetStats(EpochStats* stats);
+
+#endif /* PERGYRA_EPOCH_H */
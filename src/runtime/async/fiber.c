@@ -6,6 +6,8 @@
  * BSD Style + C# naming conventions
  */
 
+#define _GNU_SOURCE
+
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
@@ -14,35 +16,59 @@
 #include "fiber.h"
 #include "scheduler.h"
 
-/* Thread-local current fiber */
+/* Thread-local current fiber and the worker context it returns to */
 static __thread Fiber* tlsCurrentFiber = NULL;
+static __thread FiberContext* tlsReturnContext = NULL;
 
 /* Fiber ID counter */
 static atomic_uint64_t fiberIdCounter = 0;
 
+/*
+ * Fibers migrate between workers, so thread-locals are re-read after every
+ * switch through these out-of-line accessors rather than from a cached
+ * TLS address.
+ */
+static __attribute__((noinline)) Fiber* FiberLoadCurrent(void)
+{
+    return tlsCurrentFiber;
+}
+
+static __attribute__((noinline)) FiberContext* FiberLoadReturnContext(void)
+{
+    return tlsReturnContext;
+}
+
 /* Internal fiber entry point wrapper */
-static void FiberEntryPoint(Fiber* fiber)
+static void FiberEntryPoint(void)
 {
+    Fiber* fiber = FiberLoadCurrent();
     assert(fiber != NULL);
     assert(fiber->startRoutine != NULL);
     
-    /* Set current fiber */
-    tlsCurrentFiber = fiber;
-    
-    /* Update state */
-    fiber->state = FIBER_STATE_RUNNING;
-    
     /* Execute the fiber function */
     fiber->startRoutine(fiber->arg);
     
-    /* Mark as done */
+    /* Mark as done and return control to the worker for good */
     fiber->state = FIBER_STATE_DONE;
-    
-    /* Return control to scheduler */
-    SchedulerYield();
+    FiberSwitchContext(&fiber->context, FiberLoadReturnContext());
     
     /* Should never reach here */
-    assert(0 && "Fiber returned after completion");
+    assert(0 && "Fiber resumed after completion");
+}
+
+static bool FiberInitContext(FiberContext* context, void* stackBase, size_t stackSize)
+{
+    ucontext_t* machineContext = &context->machineContext;
+    
+    if (getcontext(machineContext) != 0) {
+        return false;
+    }
+    
+    machineContext->uc_stack.ss_sp = stackBase;
+    machineContext->uc_stack.ss_size = stackSize;
+    machineContext->uc_link = NULL;
+    makecontext(machineContext, FiberEntryPoint, 0);
+    return true;
 }
 
 Fiber* FiberCreate(FiberStartRoutine startRoutine, void* arg)
@@ -76,18 +102,15 @@ Fiber* FiberCreate(FiberStartRoutine startRoutine, void* arg)
         return NULL;
     }
     
-    /* Initialize stack pointer to top of stack (stacks grow down) */
-    fiber->context.stackPointer = (char*)fiber->stackBase + fiber->stackSize;
-    
-    /* Setup initial context */
-    if (setjmp(fiber->context.jmpBuf) == 0) {
-        /* First time - will be resumed later */
-        fiber->state = FIBER_STATE_READY;
-    } else {
-        /* Resumed - start execution */
-        FiberEntryPoint(fiber);
+    /* Enter FiberEntryPoint on the fresh stack at the first switch */
+    if (!FiberInitContext(&fiber->context, fiber->stackBase, fiber->stackSize)) {
+        munmap(fiber->stackBase, fiber->stackSize);
+        free(fiber);
+        return NULL;
     }
     
+    fiber->state = FIBER_STATE_READY;
+    
     return fiber;
 }
 
@@ -142,42 +165,48 @@ void FiberYield(void)
         return;
     }
     
-    /* Save current context and switch to scheduler */
-    if (setjmp(current->context.jmpBuf) == 0) {
-        /* Saved context - switch to scheduler */
-        SchedulerYield();
-    } else {
-        /* Resumed - continue execution */
+    /* The caller has set the state the worker acts on; switch to it */
+    FiberSwitchContext(&current->context, FiberLoadReturnContext());
+}
+
+void FiberRun(Fiber* fiber, FiberContext* returnContext)
+{
+    if (fiber == NULL || returnContext == NULL) {
         return;
     }
+    
+    Fiber* previous = tlsCurrentFiber;
+    FiberContext* previousReturn = tlsReturnContext;
+    
+    tlsCurrentFiber = fiber;
+    tlsReturnContext = returnContext;
+    fiber->state = FIBER_STATE_RUNNING;
+    fiber->switchCount++;
+    
+    FiberSwitchContext(returnContext, &fiber->context);
+    
+    tlsCurrentFiber = previous;
+    tlsReturnContext = previousReturn;
 }
 
 void FiberSuspend(Fiber* fiber)
 {
-    if (fiber == NULL || fiber->state != FIBER_STATE_RUNNING) {
+    /* Only the running fiber can suspend itself; FiberResume wakes it */
+    if (fiber == NULL || fiber != FiberGetCurrent()) {
         return;
     }
     
-    fiber->state = FIBER_STATE_SUSPENDED;
-    
-    if (fiber == FiberGetCurrent()) {
-        FiberYield();
-    }
+    SchedulerBlock(fiber);
 }
 
 void FiberResume(Fiber* fiber)
 {
-    if (fiber == NULL || fiber->state != FIBER_STATE_SUSPENDED) {
+    if (fiber == NULL || fiber->scheduler == NULL) {
         return;
     }
     
-    fiber->state = FIBER_STATE_READY;
-    
-    /* Schedule for execution */
-    Scheduler* scheduler = fiber->scheduler;
-    if (scheduler != NULL) {
-        SchedulerUnblock(fiber);
-    }
+    /* Schedule for execution (or let its next suspend return at once) */
+    SchedulerUnblock(fiber);
 }
 
 void FiberCancel(Fiber* fiber)
@@ -196,16 +225,18 @@ void FiberCancel(Fiber* fiber)
         child = child->nextSibling;
     }
     
-    /* If suspended or blocked, mark as done */
-    if (fiber->state == FIBER_STATE_SUSPENDED ||
-        fiber->state == FIBER_STATE_BLOCKED) {
-        fiber->state = FIBER_STATE_DONE;
+    /*
+     * Cancellation is cooperative: wake a blocked fiber so it can observe
+     * the flag and unwind, rather than stranding it (and whatever it owns).
+     */
+    if (fiber->state == FIBER_STATE_BLOCKED && fiber->scheduler != NULL) {
+        SchedulerUnblock(fiber);
     }
 }
 
 Fiber* FiberGetCurrent(void)
 {
-    return tlsCurrentFiber;
+    return FiberLoadCurrent();
 }
 
 bool FiberIsCancelled(Fiber* fiber)
@@ -256,42 +287,7 @@ void FiberDetachChild(Fiber* parent, Fiber* child)
     child->nextSibling = NULL;
 }
 
-/* Assembly implementation for context switching */
-#ifdef __x86_64__
-__asm__(
-    ".global FiberSwitchContext\n"
-    "FiberSwitchContext:\n"
-    "    # Save callee-saved registers\n"
-    "    pushq %rbp\n"
-    "    pushq %rbx\n"
-    "    pushq %r12\n"
-    "    pushq %r13\n"
-    "    pushq %r14\n"
-    "    pushq %r15\n"
-    "    \n"
-    "    # Save old stack pointer\n"
-    "    movq %rsp, 8(%rdi)\n"   /* oldContext->stackPointer */
-    "    \n"
-    "    # Load new stack pointer\n"
-    "    movq 8(%rsi), %rsp\n"   /* newContext->stackPointer */
-    "    \n"
-    "    # Restore callee-saved registers\n"
-    "    popq %r15\n"
-    "    popq %r14\n"
-    "    popq %r13\n"
-    "    popq %r12\n"
-    "    popq %rbx\n"
-    "    popq %rbp\n"
-    "    \n"
-    "    # Return to new context\n"
-    "    ret\n"
-);
-#else
-/* Fallback to setjmp/longjmp for non-x86_64 platforms */
 void FiberSwitchContext(FiberContext* oldContext, FiberContext* newContext)
 {
-    if (setjmp(oldContext->jmpBuf) == 0) {
-        longjmp(newContext->jmpBuf, 1);
-    }
+    swapcontext(&oldContext->machineContext, &newContext->machineContext);
 }
-#endif
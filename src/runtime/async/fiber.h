@@ -11,7 +11,9 @@
 
 #include <stdint.h>
 #include <stdbool.h>
-#include <setjmp.h>
+#include <stddef.h>
+#include <ucontext.h>
+#include "atomics.h"
 
 #define FIBER_STACK_SIZE (1024 * 64) /* 64KB stack for each fiber */
 
@@ -34,25 +36,9 @@ typedef struct Effect Effect;
 /* Fiber function signature */
 typedef void (*FiberStartRoutine)(void* arg);
 
-/* Fiber context for platform-specific context switching */
+/* Saved execution context (ucontext keeps signal masks and FP state portable) */
 typedef struct FiberContext {
-    /* For prototyping with setjmp/longjmp */
-    jmp_buf jmpBuf;
-    
-    /* For assembly implementation */
-    void* stackPointer;     /* rsp */
-    void* basePointer;      /* rbp */
-    void* instructionPointer; /* rip */
-    
-    /* Callee-saved registers */
-    uint64_t rbx;
-    uint64_t r12;
-    uint64_t r13;
-    uint64_t r14;
-    uint64_t r15;
-    
-    /* Extended state */
-    void* extendedState;    /* For SSE/AVX state if needed */
+    ucontext_t machineContext;
 } FiberContext;
 
 /* Fiber structure */
@@ -85,6 +71,9 @@ struct Fiber {
     /* Cancellation */
     bool isCancelled;
     
+    /* Block/unblock handoff with the worker that switched the fiber out */
+    atomic_int parkState;
+    
     /* Parent-child relationship for structured concurrency */
     Fiber* parent;
     Fiber* firstChild;
@@ -105,9 +94,12 @@ void FiberSuspend(Fiber* fiber);
 void FiberResume(Fiber* fiber);
 void FiberCancel(Fiber* fiber);
 
-/* Context switching - Assembly implementation */
+/* Context switching */
 void FiberSwitchContext(FiberContext* oldContext, FiberContext* newContext);
 
+/* Run a fiber on the calling thread until it yields, blocks or finishes */
+void FiberRun(Fiber* fiber, FiberContext* returnContext);
+
 /* Fiber query functions */
 Fiber* FiberGetCurrent(void);
 bool FiberIsCancelled(Fiber* fiber);
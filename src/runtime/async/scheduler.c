@@ -6,6 +6,8 @@
  * BSD Style + C# naming conventions
  */
 
+#define _GNU_SOURCE
+
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
@@ -20,11 +22,126 @@
 /* Thread-local current scheduler */
 static __thread Scheduler* tlsCurrentScheduler = NULL;
 
+/*
+ * Fiber parkState values. A blocking fiber is still running on its worker
+ * until the switch completes, so only the worker loop may publish it as
+ * parked; a wake that arrives earlier leaves a permit instead.
+ */
+enum {
+    FIBER_PARK_IDLE = 0,    /* Not blocked, no wake pending */
+    FIBER_PARK_PERMIT,      /* Woken while not parked; next block returns at once */
+    FIBER_PARK_SWITCHING,   /* Blocked, still switching out */
+    FIBER_PARK_PARKED       /* Switched out; the waker requeues it */
+};
+
+static void SchedulerWakeWorkers(Scheduler* scheduler, bool all)
+{
+    /* Pairs with the fence in WorkerPark: queue push before the load */
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load(&scheduler->parkedWorkers) == 0) {
+        return;
+    }
+    
+    pthread_mutex_lock(&scheduler->parkMutex);
+    if (all) {
+        pthread_cond_broadcast(&scheduler->parkCondition);
+    } else {
+        pthread_cond_signal(&scheduler->parkCondition);
+    }
+    pthread_mutex_unlock(&scheduler->parkMutex);
+}
+
+static bool SchedulerEnqueue(Scheduler* scheduler, Fiber* fiber)
+{
+    if (!ConcurrentQueuePush(scheduler->globalRunQueue, fiber)) {
+        return false;
+    }
+    
+    SchedulerWakeWorkers(scheduler, false);
+    return true;
+}
+
+/* Queue a freshly created fiber; on failure it is destroyed unrun */
+static bool SchedulerSubmit(Scheduler* scheduler, ConcurrentQueue* queue, Fiber* fiber,
+                            uint32_t priority)
+{
+    fiber->scheduler = scheduler;
+    fiber->priority = priority;
+    
+    /* Update statistics (before the fiber can run and finish) */
+    atomic_fetch_add(&scheduler->totalFibers, 1);
+    atomic_fetch_add(&scheduler->activeFibers, 1);
+    
+    if (!ConcurrentQueuePush(queue, fiber)) {
+        atomic_fetch_sub(&scheduler->totalFibers, 1);
+        atomic_fetch_sub(&scheduler->activeFibers, 1);
+        FiberDestroy(fiber);
+        return false;
+    }
+    
+    return true;
+}
+
+/* Anything this worker could run or steal */
+static bool WorkerHasWork(WorkerThread* worker)
+{
+    Scheduler* scheduler = worker->scheduler;
+    
+    if (!ConcurrentQueueIsEmpty(worker->localRunQueue) ||
+        !ConcurrentQueueIsEmpty(scheduler->globalRunQueue)) {
+        return true;
+    }
+    
+    if (scheduler->config.enableWorkStealing) {
+        for (uint32_t i = 0; i < scheduler->numWorkers; i++) {
+            if (!ConcurrentQueueIsEmpty(scheduler->workers[i].localRunQueue)) {
+                return true;
+            }
+        }
+    }
+    
+    return false;
+}
+
+static void WorkerPark(WorkerThread* worker)
+{
+    Scheduler* scheduler = worker->scheduler;
+    
+    pthread_mutex_lock(&scheduler->parkMutex);
+    atomic_store(&worker->isParked, true);
+    atomic_fetch_add(&scheduler->parkedWorkers, 1);
+    
+    /* Re-check after announcing: a producer either sees us or we see its work */
+    atomic_thread_fence(memory_order_seq_cst);
+    if (!WorkerHasWork(worker) && !atomic_load(&worker->shouldStop)) {
+        pthread_cond_wait(&scheduler->parkCondition, &scheduler->parkMutex);
+    }
+    
+    atomic_store(&worker->isParked, false);
+    atomic_fetch_sub(&scheduler->parkedWorkers, 1);
+    pthread_mutex_unlock(&scheduler->parkMutex);
+}
+
+/* A blocked fiber has switched out: park it unless a wake beat us here */
+static void WorkerParkFiber(WorkerThread* worker, Fiber* fiber)
+{
+    int expected = FIBER_PARK_SWITCHING;
+    if (atomic_compare_exchange_strong(&fiber->parkState, &expected, FIBER_PARK_PARKED)) {
+        return;
+    }
+    
+    /* Only a permit can have replaced SWITCHING; consume it and run again */
+    atomic_store(&fiber->parkState, FIBER_PARK_IDLE);
+    fiber->state = FIBER_STATE_READY;
+    ConcurrentQueuePush(worker->localRunQueue, fiber);
+}
+
 /* Worker thread main function */
 static void* WorkerThreadMain(void* arg)
 {
     WorkerThread* worker = (WorkerThread*)arg;
     Scheduler* scheduler = worker->scheduler;
+    FiberContext schedulerContext;
     
     /* Set thread-local scheduler */
     tlsCurrentScheduler = scheduler;
@@ -49,28 +166,13 @@ static void* WorkerThreadMain(void* arg)
         
         /* If no work available, park the worker */
         if (fiber == NULL) {
-            pthread_mutex_lock(&scheduler->parkMutex);
-            atomic_store(&worker->isParked, true);
-            atomic_fetch_add(&scheduler->parkedWorkers, 1);
-            
-            /* Wait for work or stop signal */
-            pthread_cond_wait(&scheduler->parkCondition, &scheduler->parkMutex);
-            
-            atomic_store(&worker->isParked, false);
-            atomic_fetch_sub(&scheduler->parkedWorkers, 1);
-            pthread_mutex_unlock(&scheduler->parkMutex);
+            WorkerPark(worker);
             continue;
         }
         
-        /* Execute the fiber */
+        /* Run the fiber until it yields, blocks or finishes */
         worker->currentFiber = fiber;
-        fiber->state = FIBER_STATE_RUNNING;
-        
-        /* Context switch to fiber */
-        FiberContext schedulerContext;
-        FiberSwitchContext(&schedulerContext, &fiber->context);
-        
-        /* Fiber yielded or completed */
+        FiberRun(fiber, &schedulerContext);
         worker->currentFiber = NULL;
         
         /* Handle fiber state */
@@ -83,7 +185,7 @@ static void* WorkerThreadMain(void* arg)
             case FIBER_STATE_DONE:
             case FIBER_STATE_ERROR:
                 /* Update statistics */
-                atomic_fetch_add(&scheduler->totalFibers, -1);
+                atomic_fetch_sub(&scheduler->activeFibers, 1);
                 atomic_fetch_add(&worker->tasksExecuted, 1);
                 
                 /* Clean up fiber */
@@ -91,7 +193,8 @@ static void* WorkerThreadMain(void* arg)
                 break;
                 
             case FIBER_STATE_BLOCKED:
-                /* Fiber is waiting for I/O or timer */
+                /* Waiting for SchedulerUnblock (I/O, timers, resident work) */
+                WorkerParkFiber(worker, fiber);
                 break;
                 
             default:
@@ -287,38 +390,55 @@ void SchedulerStop(Scheduler* scheduler)
     pthread_join(scheduler->ioWorker, NULL);
 }
 
-void SchedulerSpawn(Scheduler* scheduler, FiberStartRoutine routine, void* arg)
+bool SchedulerSpawn(Scheduler* scheduler, FiberStartRoutine routine, void* arg)
 {
-    SchedulerSpawnWithPriority(scheduler, routine, arg, 0);
+    return SchedulerSpawnWithPriority(scheduler, routine, arg, 0);
 }
 
-void SchedulerSpawnWithPriority(Scheduler* scheduler, FiberStartRoutine routine, void* arg, uint32_t priority)
+bool SchedulerSpawnWithPriority(Scheduler* scheduler, FiberStartRoutine routine, void* arg, uint32_t priority)
 {
     if (scheduler == NULL || routine == NULL) {
-        return;
+        return false;
     }
     
     Fiber* fiber = FiberCreate(routine, arg);
     if (fiber == NULL) {
-        return;
+        return false;
     }
     
-    fiber->scheduler = scheduler;
-    fiber->priority = priority;
+    /* Add to global queue and wake a parked worker if available */
+    if (!SchedulerSubmit(scheduler, scheduler->globalRunQueue, fiber, priority)) {
+        return false;
+    }
     
-    /* Update statistics */
-    atomic_fetch_add(&scheduler->totalFibers, 1);
-    atomic_fetch_add(&scheduler->activeFibers, 1);
+    SchedulerWakeWorkers(scheduler, false);
+    return true;
+}
+
+bool SchedulerSpawnOnWorker(Scheduler* scheduler, uint32_t workerIndex, FiberStartRoutine routine,
+                            void* arg, uint32_t priority)
+{
+    if (scheduler == NULL || routine == NULL) {
+        return false;
+    }
     
-    /* Add to global queue */
-    ConcurrentQueuePush(scheduler->globalRunQueue, fiber);
+    if (scheduler->numWorkers == 0) {
+        return SchedulerSpawnWithPriority(scheduler, routine, arg, priority);
+    }
     
-    /* Wake a parked worker if available */
-    if (atomic_load(&scheduler->parkedWorkers) > 0) {
-        pthread_mutex_lock(&scheduler->parkMutex);
-        pthread_cond_signal(&scheduler->parkCondition);
-        pthread_mutex_unlock(&scheduler->parkMutex);
+    Fiber* fiber = FiberCreate(routine, arg);
+    if (fiber == NULL) {
+        return false;
     }
+    
+    WorkerThread* worker = &scheduler->workers[workerIndex % scheduler->numWorkers];
+    if (!SchedulerSubmit(scheduler, worker->localRunQueue, fiber, priority)) {
+        return false;
+    }
+    
+    /* Wake everyone: a single signal may not reach the target worker */
+    SchedulerWakeWorkers(scheduler, true);
+    return true;
 }
 
 void SchedulerYield(void)
@@ -334,36 +454,64 @@ void SchedulerYield(void)
 
 void SchedulerBlock(Fiber* fiber)
 {
-    if (fiber == NULL) {
+    /* Only the running fiber can block itself */
+    if (fiber == NULL || fiber != FiberGetCurrent()) {
         return;
     }
     
-    fiber->state = FIBER_STATE_BLOCKED;
-    
-    if (fiber == FiberGetCurrent()) {
-        FiberYield();
+    for (;;) {
+        int parkState = atomic_load(&fiber->parkState);
+        
+        /* A wake already arrived: consume it instead of sleeping */
+        if (parkState == FIBER_PARK_PERMIT) {
+            if (atomic_compare_exchange_weak(&fiber->parkState, &parkState, FIBER_PARK_IDLE)) {
+                return;
+            }
+            continue;
+        }
+        
+        if (atomic_compare_exchange_weak(&fiber->parkState, &parkState, FIBER_PARK_SWITCHING)) {
+            break;
+        }
     }
+    
+    /* The worker publishes PARKED once the switch is complete */
+    fiber->state = FIBER_STATE_BLOCKED;
+    FiberYield();
 }
 
 void SchedulerUnblock(Fiber* fiber)
 {
-    if (fiber == NULL || fiber->state != FIBER_STATE_BLOCKED) {
+    if (fiber == NULL) {
         return;
     }
     
+    for (;;) {
+        int parkState = atomic_load(&fiber->parkState);
+        
+        if (parkState == FIBER_PARK_PERMIT) {
+            return;
+        }
+        
+        if (parkState == FIBER_PARK_PARKED) {
+            if (atomic_compare_exchange_weak(&fiber->parkState, &parkState, FIBER_PARK_IDLE)) {
+                break;
+            }
+            continue;
+        }
+        
+        /* Running or still switching out: leave a permit for the worker or next block */
+        if (atomic_compare_exchange_weak(&fiber->parkState, &parkState, FIBER_PARK_PERMIT)) {
+            return;
+        }
+    }
+    
     fiber->state = FIBER_STATE_READY;
     
     /* Add to scheduler queue */
     Scheduler* scheduler = fiber->scheduler;
     if (scheduler != NULL) {
-        ConcurrentQueuePush(scheduler->globalRunQueue, fiber);
-        
-        /* Wake a parked worker */
-        if (atomic_load(&scheduler->parkedWorkers) > 0) {
-            pthread_mutex_lock(&scheduler->parkMutex);
-            pthread_cond_signal(&scheduler->parkCondition);
-            pthread_mutex_unlock(&scheduler->parkMutex);
-        }
+        SchedulerEnqueue(scheduler, fiber);
     }
 }
 
@@ -83,9 +83,13 @@ void SchedulerDestroy(Scheduler* scheduler);
 void SchedulerStart(Scheduler* scheduler);
 void SchedulerStop(Scheduler* scheduler);
 
-/* Fiber scheduling */
-void SchedulerSpawn(Scheduler* scheduler, FiberStartRoutine routine, void* arg);
-void SchedulerSpawnWithPriority(Scheduler* scheduler, FiberStartRoutine routine, void* arg, uint32_t priority);
+/* Fiber scheduling (false if the fiber could not be created; the routine will not run) */
+bool SchedulerSpawn(Scheduler* scheduler, FiberStartRoutine routine, void* arg);
+bool SchedulerSpawnWithPriority(Scheduler* scheduler, FiberStartRoutine routine, void* arg, uint32_t priority);
+
+/* Queue on one worker's local queue (modulo numWorkers); idle workers may still steal it */
+bool SchedulerSpawnOnWorker(Scheduler* scheduler, uint32_t workerIndex, FiberStartRoutine routine,
+                            void* arg, uint32_t priority);
 
 /* Called by fibers */
 void SchedulerYield(void);
@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2025 Pergyra Language Project
+ * All rights reserved.
+ *
+ * Hashed timer wheel implementation
+ * BSD Style + C# naming conventions
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "timer_wheel.h"
+
+static uint32_t RoundUpPowerOfTwo(uint32_t value)
+{
+    uint32_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+TimerWheel* TimerWheelCreate(uint64_t tickNs, uint32_t slotCount, uint64_t startNs)
+{
+    if (tickNs == 0 || slotCount == 0) {
+        return NULL;
+    }
+
+    TimerWheel* wheel = (TimerWheel*)calloc(1, sizeof(TimerWheel));
+    if (wheel == NULL) {
+        return NULL;
+    }
+
+    wheel->tickNs = tickNs;
+    wheel->slotCount = RoundUpPowerOfTwo(slotCount);
+    wheel->slots = (TimerEntry**)calloc(wheel->slotCount, sizeof(TimerEntry*));
+    if (wheel->slots == NULL) {
+        free(wheel);
+        return NULL;
+    }
+
+    wheel->currentTick = startNs / tickNs;
+    pthread_mutex_init(&wheel->lock, NULL);
+
+    return wheel;
+}
+
+void TimerWheelDestroy(TimerWheel* wheel)
+{
+    if (wheel == NULL) {
+        return;
+    }
+
+    /* Timers are caller-owned; just disarm them */
+    for (uint32_t i = 0; i < wheel->slotCount; i++) {
+        for (TimerEntry* t = wheel->slots[i]; t != NULL; t = t->next) {
+            t->armed = false;
+        }
+    }
+
+    pthread_mutex_destroy(&wheel->lock);
+    free(wheel->slots);
+    free(wheel);
+}
+
+void TimerEntryInit(TimerEntry* timer, TimerCallback callback, void* userData)
+{
+    memset(timer, 0, sizeof(TimerEntry));
+    timer->callback = callback;
+    timer->userData = userData;
+}
+
+static void TimerUnlink(TimerWheel* wheel, TimerEntry* timer)
+{
+    *timer->prevNext = timer->next;
+    if (timer->next != NULL) {
+        timer->next->prevNext = timer->prevNext;
+    }
+
+    timer->next = NULL;
+    timer->prevNext = NULL;
+    timer->armed = false;
+    wheel->armedCount--;
+}
+
+void TimerWheelSchedule(TimerWheel* wheel, TimerEntry* timer, uint64_t deadlineNs)
+{
+    if (wheel == NULL || timer == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&wheel->lock);
+
+    if (timer->armed) {
+        TimerUnlink(wheel, timer);
+    }
+
+    /* Overdue timers go into the next slot to be processed */
+    uint64_t tick = deadlineNs / wheel->tickNs;
+    if (tick <= wheel->currentTick) {
+        tick = wheel->currentTick + 1;
+    }
+
+    TimerEntry** head = &wheel->slots[tick & (wheel->slotCount - 1)];
+
+    timer->deadlineNs = deadlineNs;
+    timer->next = *head;
+    timer->prevNext = head;
+    if (*head != NULL) {
+        (*head)->prevNext = &timer->next;
+    }
+    *head = timer;
+    timer->armed = true;
+    wheel->armedCount++;
+
+    pthread_mutex_unlock(&wheel->lock);
+}
+
+bool TimerWheelCancel(TimerWheel* wheel, TimerEntry* timer)
+{
+    if (wheel == NULL || timer == NULL) {
+        return false;
+    }
+
+    pthread_mutex_lock(&wheel->lock);
+
+    bool wasArmed = timer->armed;
+    if (wasArmed) {
+        TimerUnlink(wheel, timer);
+    }
+
+    pthread_mutex_unlock(&wheel->lock);
+    return wasArmed;
+}
+
+size_t TimerWheelAdvance(TimerWheel* wheel, uint64_t nowNs)
+{
+    if (wheel == NULL) {
+        return 0;
+    }
+
+    TimerEntry* due = NULL;
+
+    pthread_mutex_lock(&wheel->lock);
+
+    uint64_t targetTick = nowNs / wheel->tickNs;
+    if (targetTick > wheel->currentTick) {
+        /* Visit each elapsed slot once, even after a long stall */
+        uint64_t elapsed = targetTick - wheel->currentTick;
+        if (elapsed > wheel->slotCount) {
+            elapsed = wheel->slotCount;
+        }
+
+        for (uint64_t i = 1; i <= elapsed; i++) {
+            uint64_t tick = targetTick - elapsed + i;
+            TimerEntry* t = wheel->slots[tick & (wheel->slotCount - 1)];
+
+            while (t != NULL) {
+                TimerEntry* next = t->next;
+
+                /* Later revolutions stay in the slot */
+                if (t->deadlineNs <= nowNs) {
+                    TimerUnlink(wheel, t);
+                    t->next = due;
+                    due = t;
+                }
+                t = next;
+            }
+        }
+
+        /* The current tick is only partly over; revisit its slot next time */
+        wheel->currentTick = targetTick - 1;
+    }
+
+    pthread_mutex_unlock(&wheel->lock);
+
+    /* Fire outside the lock so callbacks can reschedule */
+    size_t fired = 0;
+    while (due != NULL) {
+        TimerEntry* next = due->next;
+        due->next = NULL;
+        due->callback(due, nowNs);
+        due = next;
+        fired++;
+    }
+
+    return fired;
+}
+
+uint64_t TimerWheelNextDeadline(TimerWheel* wheel)
+{
+    if (wheel == NULL) {
+        return UINT64_MAX;
+    }
+
+    uint64_t earliest = UINT64_MAX;
+
+    pthread_mutex_lock(&wheel->lock);
+
+    if (wheel->armedCount > 0) {
+        /* Walk one revolution; the first slot holding a current-revolution timer wins */
+        for (uint64_t i = 1; i <= wheel->slotCount && earliest == UINT64_MAX; i++) {
+            uint64_t tick = wheel->currentTick + i;
+            TimerEntry* t = wheel->slots[tick & (wheel->slotCount - 1)];
+
+            for (; t != NULL; t = t->next) {
+                if (t->deadlineNs / wheel->tickNs <= tick && t->deadlineNs < earliest) {
+                    earliest = t->deadlineNs;
+                }
+            }
+        }
+
+        /* Everything is at least a revolution away - take the global minimum */
+        if (earliest == UINT64_MAX) {
+            for (uint32_t i = 0; i < wheel->slotCount; i++) {
+                for (TimerEntry* t = wheel->slots[i]; t != NULL; t = t->next) {
+                    if (t->deadlineNs < earliest) {
+                        earliest = t->deadlineNs;
+                    }
+                }
+            }
+        }
+    }
+
+    pthread_mutex_unlock(&wheel->lock);
+    return earliest;
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2025 Pergyra Language Project
+ * All rights reserved.
+ *
+ * Hashed timer wheel for deadline-driven runtime services
+ * BSD Style + C# naming conventions
+ */
+
+#ifndef PERGYRA_TIMER_WHEEL_H
+#define PERGYRA_TIMER_WHEEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <pthread.h>
+
+/*
+ * Timers hash into slots by deadline tick; a slot holds timers for every
+ * revolution, so scheduling and cancelling are O(1) and advancing costs
+ * one slot per elapsed tick. Callbacks run outside the wheel lock and may
+ * reschedule their own timer.
+ */
+
+struct TimerEntry;
+
+/* Timer callback, invoked with the firing time */
+typedef void (*TimerCallback)(struct TimerEntry* timer, uint64_t nowNs);
+
+/* Intrusive timer, owned by the caller */
+typedef struct TimerEntry {
+    uint64_t deadlineNs;
+    TimerCallback callback;
+    void* userData;
+
+    /* Wheel bookkeeping */
+    struct TimerEntry* next;
+    struct TimerEntry** prevNext;
+    bool armed;
+} TimerEntry;
+
+typedef struct TimerWheel {
+    uint64_t tickNs;
+    uint32_t slotCount;             /* Power of two */
+    TimerEntry** slots;
+
+    uint64_t currentTick;           /* Last tick processed */
+    size_t armedCount;
+
+    pthread_mutex_t lock;
+} TimerWheel;
+
+/* Wheel lifecycle - BSD style with PascalCase */
+TimerWheel* TimerWheelCreate(uint64_t tickNs, uint32_t slotCount, uint64_t startNs);
+void TimerWheelDestroy(TimerWheel* wheel);
+
+/* Timer operations */
+void TimerEntryInit(TimerEntry* timer, TimerCallback callback, void* userData);
+void TimerWheelSchedule(TimerWheel* wheel, TimerEntry* timer, uint64_t deadlineNs);
+bool TimerWheelCancel(TimerWheel* wheel, TimerEntry* timer);
+
+/* Fire every timer due at 'nowNs'; returns the number fired */
+size_t TimerWheelAdvance(TimerWheel* wheel, uint64_t nowNs);
+
+/* Earliest armed deadline (UINT64_MAX if none) */
+uint64_t TimerWheelNextDeadline(TimerWheel* wheel);
+
+#endif /* PERGYRA_TIMER_WHEEL_H */
@@ -3,44 +3,168 @@
  * Party System Runtime Implementation
  */
 
+#define _GNU_SOURCE
+
 #include "party_runtime.h"
-#include "../async/fiber.h"
-#include "../async/scheduler.h"
-#include "../slot_manager.h"
+#include "async/fiber.h"
+#include "async/scheduler.h"
+#include "slot_manager.h"
+#include "../runtime/async/epoch.h"
+#include "../runtime/async/timer_wheel.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <stdarg.h>
+#include <unistd.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include <errno.h>
+#include <time.h>
 
 /* ============= Global State ============= */
 
-/* Scheduler registry */
+/* Scheduler pools, indexed by tag */
 static struct {
-    SchedulerTag tag;
+    _Atomic(FiberScheduler*) scheduler;
     const char* name;
-    FiberScheduler* scheduler;
-} g_schedulerRegistry[16] = {0};
+    bool owned;                      /* Created by the runtime */
+    uint32_t workerCount;            /* 0 = default for the tag */
+} g_schedulerPools[SCHEDULER_TAG_COUNT];
 
-static size_t g_schedulerCount = 0;
+static pthread_mutex_t g_schedulerPoolLock = PTHREAD_MUTEX_INITIALIZER;
+
+static const char* g_schedulerPoolNames[SCHEDULER_TAG_COUNT] = {
+    "main", "cpu", "gpu", "io", "background", "compute", "network",
+    "custom1", "custom2", "custom3"
+};
 
 /* Fiber map cache */
-FiberMapCache* g_fiberMapCache = NULL;
+_Atomic(FiberMapCache*) g_fiberMapCache = NULL;
 
-/* Statistics tracking */
-static struct {
-    FiberStats* stats;
-    size_t count;
-    size_t capacity;
-} g_fiberStats = {0};
+/* Intern tables (open addressing, must stay > 2x the name limit) */
+#define INTERN_TABLE_SIZE 8192
+
+typedef struct {
+    _Atomic(const char*) keys[INTERN_TABLE_SIZE];
+    InternId ids[INTERN_TABLE_SIZE];
+    _Atomic(const char*) names[INTERN_TABLE_SIZE / 2];  /* ID -> name */
+    uint32_t count;                  /* Next ID; 0 is never assigned */
+    uint32_t limit;
+    SpinLock writeLock;              /* Serializes inserts only */
+} InternTable;
+
+static InternTable g_slotNames = { .count = 1, .limit = MAX_INTERNED_SLOT_NAMES };
+static InternTable g_abilityNames = { .count = 1, .limit = MAX_INTERNED_ABILITIES };
+static InternTable g_fieldNames = { .count = 1, .limit = MAX_INTERNED_FIELD_NAMES };
+
+static uint64_t HashString(const char* str);
+static uint64_t GetTimeNanos(void);
+static void UpdateFiberStats(InternId roleNameId, const FiberResult* result);
+
+/* ============= Interned Names ============= */
+
+static InternId InternTableFind(InternTable* table, const char* name, uint64_t hash)
+{
+    size_t mask = INTERN_TABLE_SIZE - 1;
+    
+    for (size_t i = hash & mask; ; i = (i + 1) & mask) {
+        const char* key = atomic_load_explicit(&table->keys[i], memory_order_acquire);
+        if (!key) {
+            return INTERN_ID_NONE;
+        }
+        if (strcmp(key, name) == 0) {
+            return table->ids[i];
+        }
+    }
+}
+
+static InternId InternTableInsert(InternTable* table, const char* name)
+{
+    uint64_t hash = HashString(name);
+    
+    /* Fast path: already interned */
+    InternId id = InternTableFind(table, name, hash);
+    if (id != INTERN_ID_NONE) {
+        return id;
+    }
+    
+    SpinLockAcquire(&table->writeLock);
+    
+    /* Re-check under the lock in case another thread won the race */
+    id = InternTableFind(table, name, hash);
+    if (id == INTERN_ID_NONE && table->count < table->limit) {
+        char* copy = strdup(name);
+        if (copy) {
+            size_t mask = INTERN_TABLE_SIZE - 1;
+            size_t i = hash & mask;
+            while (atomic_load_explicit(&table->keys[i], memory_order_relaxed)) {
+                i = (i + 1) & mask;
+            }
+            
+            id = (InternId)table->count++;
+            table->ids[i] = id;
+            atomic_store_explicit(&table->names[id], copy, memory_order_release);
+            
+            /* Publish the key last so readers never see a stale ID */
+            atomic_store_explicit(&table->keys[i], copy, memory_order_release);
+        }
+    }
+    
+    SpinLockRelease(&table->writeLock);
+    return id;
+}
+
+InternId InternSlotName(const char* slotName)
+{
+    return slotName ? InternTableInsert(&g_slotNames, slotName) : INTERN_ID_NONE;
+}
+
+InternId InternAbilityName(const char* abilityName)
+{
+    return abilityName ? InternTableInsert(&g_abilityNames, abilityName) : INTERN_ID_NONE;
+}
+
+InternId InternFieldName(const char* fieldName)
+{
+    return fieldName ? InternTableInsert(&g_fieldNames, fieldName) : INTERN_ID_NONE;
+}
+
+const char* GetSlotNameById(InternId slotId)
+{
+    if (slotId == INTERN_ID_NONE || slotId >= INTERN_TABLE_SIZE / 2) return NULL;
+    return atomic_load_explicit(&g_slotNames.names[slotId], memory_order_acquire);
+}
+
+const char* GetFieldNameById(InternId fieldId)
+{
+    if (fieldId == INTERN_ID_NONE || fieldId >= INTERN_TABLE_SIZE / 2) return NULL;
+    return atomic_load_explicit(&g_fieldNames.names[fieldId], memory_order_acquire);
+}
+
+InternId LookupSlotNameId(const char* slotName)
+{
+    if (!slotName) return INTERN_ID_NONE;
+    return InternTableFind(&g_slotNames, slotName, HashString(slotName));
+}
+
+InternId LookupAbilityNameId(const char* abilityName)
+{
+    if (!abilityName) return INTERN_ID_NONE;
+    return InternTableFind(&g_abilityNames, abilityName, HashString(abilityName));
+}
+
+InternId LookupFieldNameId(const char* fieldName)
+{
+    if (!fieldName) return INTERN_ID_NONE;
+    return InternTableFind(&g_fieldNames, fieldName, HashString(fieldName));
+}
 
 /* ============= FiberMap Generation ============= */
 
 FiberMap* GenerateFiberMap(
     const char* partyType,
-    const struct {
-        const char* slotName;
-        uint32_t instanceSlotId;
-        RoleParallelMetadata* metadata;
-    }* roleBindings,
+    const RoleBinding* roleBindings,
     size_t bindingCount)
 {
     /* Allocate FiberMap */
@@ -49,11 +173,22 @@ FiberMap* GenerateFiberMap(
     
     map->partyTypeName = strdup(partyType);
     map->entries = (FiberMapEntry*)calloc(bindingCount, sizeof(FiberMapEntry));
-    if (!map->entries) {
+    map->bindings = (RoleBinding*)calloc(bindingCount ? bindingCount : 1, sizeof(RoleBinding));
+    if (!map->entries || !map->bindings) {
+        free(map->bindings);
+        free(map->entries);
+        free((void*)map->partyTypeName);
         free(map);
         return NULL;
     }
     
+    /* Keep the full binding set so cache hits can be verified, not just keyed */
+    for (size_t i = 0; i < bindingCount; i++) {
+        map->bindings[i] = roleBindings[i];
+        map->bindings[i].slotName = roleBindings[i].slotName ? strdup(roleBindings[i].slotName) : NULL;
+    }
+    map->bindingCount = bindingCount;
+    
     /* Count entries that have parallel blocks */
     size_t entryCount = 0;
     
@@ -70,6 +205,7 @@ FiberMap* GenerateFiberMap(
         
         /* Fill entry data */
         entry->roleId = strdup(roleBindings[i].slotName);
+        entry->roleNameId = InternSlotName(roleBindings[i].slotName);
         entry->instanceSlotId = roleBindings[i].instanceSlotId;
         entry->parallelFn = metadata->function;
         entry->schedulerTag = metadata->scheduler;
@@ -82,16 +218,66 @@ FiberMap* GenerateFiberMap(
     
     map->entryCount = entryCount;
     
-    /* Generate cache key based on party type and role configuration */
-    map->cacheKey = HashString(partyType);
-    for (size_t i = 0; i < entryCount; i++) {
-        map->cacheKey ^= HashString(map->entries[i].roleId);
-        map->cacheKey ^= (uint64_t)map->entries[i].schedulerTag << 32;
-    }
+    /* Generate cache key based on party type and role bindings */
+    map->cacheKey = ComputeFiberMapKey(partyType, roleBindings, bindingCount);
     
     /* Determine if this map can be statically cached */
     map->isStatic = true; /* For now, assume all maps are cacheable */
+    atomic_init(&map->refs, 1);
+    
+    return map;
+}
+
+/* Order-sensitive 64-bit mix (murmur3 finalizer step) */
+static uint64_t MixFiberMapKey(uint64_t key, uint64_t value)
+{
+    key ^= value;
+    key *= 0xFF51AFD7ED558CCDULL;
+    key ^= key >> 33;
+    return key;
+}
+
+uint64_t ComputeFiberMapKey(
+    const char* partyType,
+    const RoleBinding* roleBindings,
+    size_t bindingCount)
+{
+    uint64_t key = HashString(partyType ? partyType : "");
+    
+    for (size_t i = 0; i < bindingCount; i++) {
+        const RoleBinding* binding = &roleBindings[i];
+        key = MixFiberMapKey(key, binding->slotName ? HashString(binding->slotName) : 0);
+        key = MixFiberMapKey(key, binding->instanceSlotId);
+        key = MixFiberMapKey(key, (uint64_t)(uintptr_t)binding->metadata);
+    }
+    
+    /* 0 marks an empty cache slot */
+    return key ? key : 1;
+}
+
+FiberMap* GenerateFiberMapCached(
+    const char* partyType,
+    const RoleBinding* roleBindings,
+    size_t bindingCount)
+{
+    uint64_t key = ComputeFiberMapKey(partyType, roleBindings, bindingCount);
+    
+    FiberMap* map = GetCachedFiberMap(key, partyType, roleBindings, bindingCount);
+    if (map) return map;
     
+    map = GenerateFiberMap(partyType, roleBindings, bindingCount);
+    if (map) {
+        CacheFiberMap(key, map);
+    }
+    
+    return map;
+}
+
+FiberMap* RetainFiberMap(FiberMap* map)
+{
+    if (map && atomic_load_explicit(&map->refs, memory_order_relaxed) > 0) {
+        atomic_fetch_add_explicit(&map->refs, 1, memory_order_relaxed);
+    }
     return map;
 }
 
@@ -99,438 +285,3121 @@ void FreeFiberMap(FiberMap* map)
 {
     if (!map) return;
     
+    /* Static maps are never freed */
+    if (atomic_load_explicit(&map->refs, memory_order_relaxed) == 0) return;
+    if (atomic_fetch_sub_explicit(&map->refs, 1, memory_order_acq_rel) != 1) return;
+    
     /* Free role IDs */
     for (size_t i = 0; i < map->entryCount; i++) {
         free((void*)map->entries[i].roleId);
     }
     
+    for (size_t i = 0; i < map->bindingCount; i++) {
+        free((void*)map->bindings[i].slotName);
+    }
+    
     free((void*)map->partyTypeName);
+    free(map->bindings);
     free(map->entries);
     free(map);
 }
 
-/* ============= Context API Implementation ============= */
+/* ============= Optimization & Caching ============= */
 
-void* ContextGetRole(
-    PartyContext* context,
-    const char* slotName,
-    const char* requiredAbility)
+#define FIBER_MAP_CACHE_DEFAULT_ENTRIES 256
+
+/*
+ * Open-addressed table of cached maps. Readers probe without locks inside
+ * an epoch and confirm a hit against the map's own cacheKey, so a slot
+ * caught mid-update only ever costs a miss. The map's party type and
+ * bindings are then compared with the request, so a key collision is a
+ * miss rather than another party's map. Inserts and CLOCK eviction
+ * are serialized by writeLock; deletion shifts the probe chain back
+ * instead of leaving tombstones. An evicted map keeps the cache's
+ * reference until a grace period has passed.
+ */
+typedef struct {
+    _Atomic(uint64_t) key;           /* 0 = empty */
+    _Atomic(FiberMap*) map;
+    atomic_bool referenced;          /* CLOCK bit, set on hit */
+} FiberMapCacheSlot;
+
+struct FiberMapCache {
+    FiberMapCacheSlot* slots;
+    size_t mask;                     /* Slot count - 1 (power of two) */
+    size_t maxEntries;
+    size_t clockHand;                /* Writer-side */
+    atomic_size_t count;
+    SpinLock writeLock;              /* Serializes inserts and evictions */
+    
+    /* Statistics */
+    atomic_uint_fast64_t hits;
+    atomic_uint_fast64_t misses;
+    atomic_uint_fast64_t insertions;
+    atomic_uint_fast64_t evictions;
+};
+
+static void FiberMapCacheDestroy(void* object)
 {
-    if (!context || !slotName) return NULL;
+    FiberMapCache* cache = (FiberMapCache*)object;
     
-    /* Lock for thread safety */
-    SpinLockAcquire(&context->contextLock);
+    for (size_t i = 0; i <= cache->mask; i++) {
+        FreeFiberMap(atomic_load_explicit(&cache->slots[i].map, memory_order_relaxed));
+    }
     
-    void* result = NULL;
+    free(cache->slots);
+    free(cache);
+}
+
+static void ReleaseEvictedFiberMap(void* map)
+{
+    FreeFiberMap((FiberMap*)map);
+}
+
+void InitializeFiberMapCache(size_t maxEntries)
+{
+    if (atomic_load_explicit(&g_fiberMapCache, memory_order_acquire)) return;
     
-    /* Find the role slot */
-    for (size_t i = 0; i < context->roleCount; i++) {
-        if (strcmp(context->roles[i].slotName, slotName) == 0) {
-            /* Check if role has required ability */
-            if (requiredAbility) {
-                bool hasAbility = false;
-                for (size_t j = 0; j < context->roles[i].abilityCount; j++) {
-                    if (strcmp(context->roles[i].abilities[j], requiredAbility) == 0) {
-                        hasAbility = true;
-                        break;
-                    }
-                }
-                
-                if (!hasAbility) {
-                    /* Role doesn't have required ability */
-                    break;
-                }
-            }
-            
-            /* Return cached instance or load from slot */
-            if (context->roles[i].roleInstance) {
-                result = context->roles[i].roleInstance;
-            } else {
-                /* Load from slot and cache */
-                void* instance = GetSlotPointer(context->roles[i].slotId);
-                context->roles[i].roleInstance = instance;
-                result = instance;
-            }
-            break;
+    FiberMapCache* cache = (FiberMapCache*)calloc(1, sizeof(FiberMapCache));
+    if (!cache) return;
+    
+    cache->maxEntries = maxEntries ? maxEntries : FIBER_MAP_CACHE_DEFAULT_ENTRIES;
+    
+    /* Keep the load factor at or below one half */
+    size_t slotCount = 16;
+    while (slotCount < cache->maxEntries * 2) {
+        slotCount <<= 1;
+    }
+    
+    cache->mask = slotCount - 1;
+    cache->slots = (FiberMapCacheSlot*)calloc(slotCount, sizeof(FiberMapCacheSlot));
+    if (!cache->slots) {
+        free(cache);
+        return;
+    }
+    
+    /* Lost the race to another initializer */
+    FiberMapCache* expected = NULL;
+    if (!atomic_compare_exchange_strong(&g_fiberMapCache, &expected, cache)) {
+        FiberMapCacheDestroy(cache);
+    }
+}
+
+static bool FiberMapStringsEqual(const char* a, const char* b)
+{
+    if (!a || !b) return a == b;
+    return strcmp(a, b) == 0;
+}
+
+/* True if 'map' was generated from exactly this party type and binding set */
+static bool FiberMapMatches(
+    const FiberMap* map,
+    const char* partyType,
+    const RoleBinding* roleBindings,
+    size_t bindingCount)
+{
+    if (map->bindingCount != bindingCount) return false;
+    if (bindingCount && !map->bindings) return false;
+    if (!FiberMapStringsEqual(map->partyTypeName, partyType)) return false;
+    
+    for (size_t i = 0; i < bindingCount; i++) {
+        const RoleBinding* cached = &map->bindings[i];
+        const RoleBinding* wanted = &roleBindings[i];
+        if (cached->instanceSlotId != wanted->instanceSlotId ||
+            cached->metadata != wanted->metadata ||
+            !FiberMapStringsEqual(cached->slotName, wanted->slotName)) {
+            return false;
         }
     }
     
-    SpinLockRelease(&context->contextLock);
-    return result;
+    return true;
 }
 
-RoleQueryResult ContextFindRoles(
-    PartyContext* context,
-    const char* requiredAbility)
+FiberMap* GetCachedFiberMap(
+    uint64_t key,
+    const char* partyType,
+    const RoleBinding* roleBindings,
+    size_t bindingCount)
 {
-    RoleQueryResult result = {0};
-    if (!context || !requiredAbility) return result;
+    if (key == 0) return NULL;
     
-    SpinLockAcquire(&context->contextLock);
+    FiberMap* found = NULL;
     
-    /* Count matching roles */
-    size_t matches = 0;
-    for (size_t i = 0; i < context->roleCount; i++) {
-        for (size_t j = 0; j < context->roles[i].abilityCount; j++) {
-            if (strcmp(context->roles[i].abilities[j], requiredAbility) == 0) {
-                matches++;
-                break;
-            }
-        }
+    EpochEnter();
+    
+    FiberMapCache* cache = atomic_load_explicit(&g_fiberMapCache, memory_order_acquire);
+    if (!cache) {
+        EpochExit();
+        return NULL;
     }
     
-    if (matches > 0) {
-        /* Allocate result arrays */
-        result.instances = (void**)calloc(matches, sizeof(void*));
-        result.slotNames = (const char**)calloc(matches, sizeof(char*));
-        result.count = matches;
+    for (size_t i = key & cache->mask; ; i = (i + 1) & cache->mask) {
+        FiberMapCacheSlot* slot = &cache->slots[i];
+        uint64_t slotKey = atomic_load_explicit(&slot->key, memory_order_acquire);
+        if (slotKey == 0) break;
+        if (slotKey != key) continue;
         
-        /* Fill results */
-        size_t idx = 0;
-        for (size_t i = 0; i < context->roleCount && idx < matches; i++) {
-            for (size_t j = 0; j < context->roles[i].abilityCount; j++) {
-                if (strcmp(context->roles[i].abilities[j], requiredAbility) == 0) {
-                    /* Get instance */
-                    if (!context->roles[i].roleInstance) {
-                        context->roles[i].roleInstance = 
-                            GetSlotPointer(context->roles[i].slotId);
-                    }
-                    
-                    result.instances[idx] = context->roles[i].roleInstance;
-                    result.slotNames[idx] = context->roles[i].slotName;
-                    idx++;
-                    break;
-                }
+        /* The slot may be mid-move; trust only the map's own key */
+        FiberMap* map = atomic_load_explicit(&slot->map, memory_order_acquire);
+        if (map && map->cacheKey == key) {
+            /* Same key, different binding set: a collision is a miss */
+            if (!FiberMapMatches(map, partyType, roleBindings, bindingCount)) break;
+            
+            if (!atomic_load_explicit(&slot->referenced, memory_order_relaxed)) {
+                atomic_store_explicit(&slot->referenced, true, memory_order_relaxed);
             }
+            found = RetainFiberMap(map);
+            break;
         }
     }
     
-    SpinLockRelease(&context->contextLock);
-    return result;
+    atomic_fetch_add_explicit(found ? &cache->hits : &cache->misses, 1, memory_order_relaxed);
+    
+    EpochExit();
+    return found;
 }
 
-void* ContextGetShared(PartyContext* context, const char* fieldName)
+/* Remove the entry at 'hole', shifting later chain members back (writer only) */
+static void FiberMapCacheRemoveAt(FiberMapCache* cache, size_t hole)
 {
-    if (!context || !fieldName) return NULL;
-    
-    SpinLockAcquire(&context->contextLock);
+    size_t mask = cache->mask;
     
-    void* result = NULL;
-    for (size_t i = 0; i < context->sharedFieldCount; i++) {
-        if (strcmp(context->sharedFields[i].fieldName, fieldName) == 0) {
-            result = context->sharedFields[i].value;
-            break;
-        }
+    for (size_t j = (hole + 1) & mask; ; j = (j + 1) & mask) {
+        uint64_t key = atomic_load_explicit(&cache->slots[j].key, memory_order_relaxed);
+        if (key == 0) break;
+        
+        /* Entries whose home lies cyclically in (hole, j] stay put */
+        size_t home = key & mask;
+        if (((j - home) & mask) < ((j - hole) & mask)) continue;
+        
+        FiberMapCacheSlot* from = &cache->slots[j];
+        FiberMapCacheSlot* to = &cache->slots[hole];
+        atomic_store_explicit(&to->map,
+            atomic_load_explicit(&from->map, memory_order_relaxed), memory_order_release);
+        atomic_store_explicit(&to->referenced,
+            atomic_load_explicit(&from->referenced, memory_order_relaxed), memory_order_relaxed);
+        atomic_store_explicit(&to->key, key, memory_order_release);
+        hole = j;
     }
     
-    SpinLockRelease(&context->contextLock);
-    return result;
+    atomic_store_explicit(&cache->slots[hole].key, 0, memory_order_release);
+    atomic_store_explicit(&cache->slots[hole].map, NULL, memory_order_release);
 }
 
-/* ============= Runtime Dispatcher ============= */
-
-/* Fiber wrapper structure */
-typedef struct {
-    FiberMapEntry* entry;
-    PartyContext* context;
-    void* roleInstance;
-    FiberResult* result;
-    volatile bool* shouldStop;
-} FiberWrapper;
+/* CLOCK: clear reference bits until an unreferenced entry comes round */
+static void FiberMapCacheEvictOne(FiberMapCache* cache)
+{
+    for (;;) {
+        size_t i = cache->clockHand;
+        cache->clockHand = (i + 1) & cache->mask;
+        
+        FiberMapCacheSlot* slot = &cache->slots[i];
+        if (atomic_load_explicit(&slot->key, memory_order_relaxed) == 0) continue;
+        if (atomic_exchange_explicit(&slot->referenced, false, memory_order_relaxed)) continue;
+        
+        FiberMap* victim = atomic_load_explicit(&slot->map, memory_order_relaxed);
+        FiberMapCacheRemoveAt(cache, i);
+        
+        /* Readers may still be retaining it */
+        EpochRetire(victim, ReleaseEvictedFiberMap);
+        
+        atomic_fetch_sub_explicit(&cache->count, 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&cache->evictions, 1, memory_order_relaxed);
+        return;
+    }
+}
 
-/* Periodic execution wrapper */
-static void PeriodicFiberFunction(void* userData)
+void CacheFiberMap(uint64_t key, FiberMap* map)
 {
-    FiberWrapper* wrapper = (FiberWrapper*)userData;
-    uint64_t startTime = GetTimeNanos();
+    if (key == 0 || !map || !map->isStatic) return;
     
-    while (!*wrapper->shouldStop) {
-        /* Execute the role's parallel function */
-        wrapper->entry->parallelFn(wrapper->roleInstance, wrapper->context);
+    if (!atomic_load_explicit(&g_fiberMapCache, memory_order_acquire)) {
+        InitializeFiberMapCache(FIBER_MAP_CACHE_DEFAULT_ENTRIES);
+    }
+    
+    EpochEnter();
+    
+    FiberMapCache* cache = atomic_load_explicit(&g_fiberMapCache, memory_order_acquire);
+    if (!cache) {
+        EpochExit();
+        return;
+    }
+    
+    SpinLockAcquire(&cache->writeLock);
+    
+    /* First writer wins; a concurrent build of the same map is dropped */
+    size_t i = key & cache->mask;
+    for (;;) {
+        uint64_t slotKey = atomic_load_explicit(&cache->slots[i].key, memory_order_relaxed);
+        if (slotKey == key) {
+            SpinLockRelease(&cache->writeLock);
+            EpochExit();
+            return;
+        }
+        if (slotKey == 0) break;
+        i = (i + 1) & cache->mask;
+    }
+    
+    if (atomic_load_explicit(&cache->count, memory_order_relaxed) >= cache->maxEntries) {
+        FiberMapCacheEvictOne(cache);
         
-        /* Sleep for interval */
-        if (wrapper->entry->executionIntervalMs > 0) {
-            FiberSleep(wrapper->entry->executionIntervalMs);
-        } else {
-            /* Continuous execution - yield to avoid hogging CPU */
-            FiberYield();
+        /* Eviction may have shifted the chain; find the first free slot again */
+        i = key & cache->mask;
+        while (atomic_load_explicit(&cache->slots[i].key, memory_order_relaxed) != 0) {
+            i = (i + 1) & cache->mask;
         }
     }
     
-    /* Record execution time */
-    wrapper->result->executionTimeNs = GetTimeNanos() - startTime;
-    wrapper->result->success = true;
+    FiberMapCacheSlot* slot = &cache->slots[i];
+    atomic_store_explicit(&slot->referenced, true, memory_order_relaxed);
+    atomic_store_explicit(&slot->map, RetainFiberMap(map), memory_order_release);
+    atomic_store_explicit(&slot->key, key, memory_order_release);
+    
+    atomic_fetch_add_explicit(&cache->count, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&cache->insertions, 1, memory_order_relaxed);
+    
+    SpinLockRelease(&cache->writeLock);
+    EpochExit();
 }
 
-/* One-shot execution wrapper */
-static void OneshotFiberFunction(void* userData)
+void CleanupFiberMapCache(void)
 {
-    FiberWrapper* wrapper = (FiberWrapper*)userData;
-    uint64_t startTime = GetTimeNanos();
+    FiberMapCache* cache = atomic_exchange(&g_fiberMapCache, NULL);
+    if (!cache) return;
     
-    /* Execute once */
-    wrapper->entry->parallelFn(wrapper->roleInstance, wrapper->context);
+    /* Lookups in flight may still be probing the table */
+    EpochRetire(cache, FiberMapCacheDestroy);
+    EpochSynchronize();
+}
+
+void GetFiberMapCacheStats(FiberMapCacheStats* stats)
+{
+    if (!stats) return;
+    memset(stats, 0, sizeof(FiberMapCacheStats));
     
-    /* Record result */
-    wrapper->result->executionTimeNs = GetTimeNanos() - startTime;
-    wrapper->result->success = true;
+    EpochEnter();
+    
+    FiberMapCache* cache = atomic_load_explicit(&g_fiberMapCache, memory_order_acquire);
+    if (cache) {
+        stats->hits = atomic_load_explicit(&cache->hits, memory_order_relaxed);
+        stats->misses = atomic_load_explicit(&cache->misses, memory_order_relaxed);
+        stats->insertions = atomic_load_explicit(&cache->insertions, memory_order_relaxed);
+        stats->evictions = atomic_load_explicit(&cache->evictions, memory_order_relaxed);
+        stats->entries = atomic_load_explicit(&cache->count, memory_order_relaxed);
+        stats->maxEntries = cache->maxEntries;
+    }
+    
+    EpochExit();
 }
 
-/* Dispatch implementation */
-DispatchResult DispatchParallel(
-    FiberMap* map,
+/* ============= Context API Implementation ============= */
+
+/*
+ * Published context table. Built from the context's role and shared-field
+ * declarations in a single allocation and never modified afterwards,
+ * except for the lazily filled role instance cache. Writers build a new
+ * version under contextLock and retire the old one through the epoch
+ * reclaimer; readers only ever pay an epoch enter/exit.
+ */
+struct PartyContextTable {
+    uint64_t version;
+    
+    /* Roles, indexed by declaration order */
+    size_t roleCount;
+    _Atomic(void*)* roleInstances;   /* Cached instance pointers */
+    uint32_t* roleSlotIds;
+    InternId* roleNameIds;           /* Interned slot names (live forever) */
+    AbilitySet* abilities;
+    
+    /* Slot name ID -> role index */
+    uint16_t* roleBySlotId;
+    size_t slotIdCount;
+    
+    /* Shared fields, indexed by declaration order */
+    void** fieldValues;
+    size_t fieldCount;
+    
+    /* Field name ID -> field index */
+    uint16_t* fieldByNameId;
+    size_t fieldIdCount;
+};
+
+static void PartyContextTableDestroy(void* table)
+{
+    free(table);
+}
+
+/* Build a new table version from the declarations (writer lock held) */
+static PartyContextTable* PartyContextBuildTable(
     PartyContext* context,
-    JoinStrategy joinStrategy,
-    DispatcherConfig* config)
+    const PartyContextTable* previous)
 {
-    DispatchResult result = {0};
+    if (context->roleCount >= ROLE_INDEX_NONE ||
+        context->sharedFieldCount >= ROLE_INDEX_NONE) {
+        return NULL;
+    }
     
-    if (!map || !context || map->entryCount == 0) {
-        return result;
+    /* Intern names and size the ID -> index maps */
+    size_t slotIdCount = 0;
+    for (size_t i = 0; i < context->roleCount; i++) {
+        InternId slotId = InternSlotName(context->roles[i].slotName);
+        if (slotId == INTERN_ID_NONE) return NULL;
+        if ((size_t)slotId + 1 > slotIdCount) {
+            slotIdCount = (size_t)slotId + 1;
+        }
     }
     
-    /* Allocate result array */
-    result.results = (FiberResult*)calloc(map->entryCount, sizeof(FiberResult));
-    result.resultCount = map->entryCount;
+    size_t fieldIdCount = 0;
+    for (size_t i = 0; i < context->sharedFieldCount; i++) {
+        InternId fieldId = InternFieldName(context->sharedFields[i].fieldName);
+        if (fieldId == INTERN_ID_NONE) return NULL;
+        if ((size_t)fieldId + 1 > fieldIdCount) {
+            fieldIdCount = (size_t)fieldId + 1;
+        }
+    }
     
-    /* Fiber handles and control flags */
-    Fiber** fibers = (Fiber**)calloc(map->entryCount, sizeof(Fiber*));
-    FiberWrapper* wrappers = (FiberWrapper*)calloc(map->entryCount, sizeof(FiberWrapper));
-    volatile bool* stopFlags = (volatile bool*)calloc(map->entryCount, sizeof(bool));
+    /* One allocation, arrays laid out by decreasing alignment */
+    size_t roleCount = context->roleCount;
+    size_t fieldCount = context->sharedFieldCount;
+    size_t size = sizeof(PartyContextTable) +
+        roleCount * sizeof(_Atomic(void*)) +
+        fieldCount * sizeof(void*) +
+        roleCount * sizeof(AbilitySet) +
+        roleCount * sizeof(uint32_t) +
+        roleCount * sizeof(InternId) +
+        slotIdCount * sizeof(uint16_t) +
+        fieldIdCount * sizeof(uint16_t);
     
-    uint64_t dispatchStartTime = GetTimeNanos();
+    PartyContextTable* table = (PartyContextTable*)calloc(1, size);
+    if (!table) return NULL;
     
-    /* Create and schedule fibers */
-    for (size_t i = 0; i < map->entryCount; i++) {
+    char* cursor = (char*)(table + 1);
+    table->roleInstances = (_Atomic(void*)*)cursor;
+    cursor += roleCount * sizeof(_Atomic(void*));
+    table->fieldValues = (void**)cursor;
+    cursor += fieldCount * sizeof(void*);
+    table->abilities = (AbilitySet*)cursor;
+    cursor += roleCount * sizeof(AbilitySet);
+    table->roleSlotIds = (uint32_t*)cursor;
+    cursor += roleCount * sizeof(uint32_t);
+    table->roleNameIds = (InternId*)cursor;
+    cursor += roleCount * sizeof(InternId);
+    table->roleBySlotId = (uint16_t*)cursor;
+    cursor += slotIdCount * sizeof(uint16_t);
+    table->fieldByNameId = (uint16_t*)cursor;
+    
+    table->version = previous ? previous->version + 1 : 1;
+    table->roleCount = roleCount;
+    table->slotIdCount = slotIdCount;
+    table->fieldCount = fieldCount;
+    table->fieldIdCount = fieldIdCount;
+    
+    for (size_t i = 0; i < slotIdCount; i++) {
+        table->roleBySlotId[i] = ROLE_INDEX_NONE;
+    }
+    for (size_t i = 0; i < fieldIdCount; i++) {
+        table->fieldByNameId[i] = ROLE_INDEX_NONE;
+    }
+    
+    /* Roles: slot index, ability bitset, carried-over instance cache */
+    for (size_t i = 0; i < roleCount; i++) {
+        InternId nameId = LookupSlotNameId(context->roles[i].slotName);
+        table->roleBySlotId[nameId] = (uint16_t)i;
+        table->roleNameIds[i] = nameId;
+        table->roleSlotIds[i] = context->roles[i].slotId;
+        
+        void* instance = context->roles[i].roleInstance;
+        if (!instance && previous && i < previous->roleCount &&
+            previous->roleSlotIds[i] == context->roles[i].slotId) {
+            instance = atomic_load_explicit(&previous->roleInstances[i],
+                memory_order_relaxed);
+        }
+        atomic_init(&table->roleInstances[i], instance);
+        
+        for (size_t j = 0; j < context->roles[i].abilityCount; j++) {
+            InternId abilityId = InternAbilityName(context->roles[i].abilities[j]);
+            if (abilityId == INTERN_ID_NONE) {
+                free(table);
+                return NULL;
+            }
+            AbilitySetAdd(&table->abilities[i], abilityId);
+        }
+    }
+    
+    /* Shared fields */
+    for (size_t i = 0; i < fieldCount; i++) {
+        table->fieldByNameId[LookupFieldNameId(context->sharedFields[i].fieldName)] =
+            (uint16_t)i;
+        table->fieldValues[i] = context->sharedFields[i].value;
+    }
+    
+    return table;
+}
+
+/* Build, publish and retire the previous version (writer lock held) */
+static bool PartyContextRepublish(PartyContext* context)
+{
+    PartyContextTable* previous = atomic_load_explicit(&context->table,
+        memory_order_relaxed);
+    
+    PartyContextTable* table = PartyContextBuildTable(context, previous);
+    if (!table) return false;
+    
+    atomic_store_explicit(&context->table, table, memory_order_release);
+    
+    if (previous) {
+        EpochRetire(previous, PartyContextTableDestroy);
+    }
+    return true;
+}
+
+bool PartyContextPublish(PartyContext* context)
+{
+    if (!context) return false;
+    
+    SpinLockAcquire(&context->contextLock);
+    bool published = PartyContextRepublish(context);
+    SpinLockRelease(&context->contextLock);
+    
+    return published;
+}
+
+void PartyContextRelease(PartyContext* context)
+{
+    if (!context) return;
+    
+    SpinLockAcquire(&context->contextLock);
+    PartyContextTable* table = atomic_exchange(&context->table, NULL);
+    SpinLockRelease(&context->contextLock);
+    
+    if (table) {
+        EpochRetire(table, PartyContextTableDestroy);
+    }
+}
+
+/* Load the current table, publishing the first version on demand */
+static PartyContextTable* ContextAcquireTable(PartyContext* context)
+{
+    PartyContextTable* table = atomic_load_explicit(&context->table,
+        memory_order_acquire);
+    
+    if (!table) {
+        /* Publishing takes the writer lock - leave the read section */
+        EpochExit();
+        PartyContextPublish(context);
+        EpochEnter();
+        table = atomic_load_explicit(&context->table, memory_order_acquire);
+    }
+    
+    return table;
+}
+
+/* Return cached instance or load from slot and cache (epoch held) */
+static void* ContextLoadRoleInstance(PartyContextTable* table, size_t roleIndex)
+{
+    void* instance = atomic_load_explicit(&table->roleInstances[roleIndex],
+        memory_order_relaxed);
+    
+    if (!instance) {
+        /* Racing readers resolve the same slot, so last store wins */
+        instance = GetSlotPointer(table->roleSlotIds[roleIndex]);
+        atomic_store_explicit(&table->roleInstances[roleIndex], instance,
+            memory_order_relaxed);
+    }
+    return instance;
+}
+
+void* ContextGetRoleById(
+    PartyContext* context,
+    InternId slotId,
+    InternId abilityId)
+{
+    if (!context || slotId == INTERN_ID_NONE) return NULL;
+    
+    EpochEnter();
+    
+    void* result = NULL;
+    PartyContextTable* table = ContextAcquireTable(context);
+    
+    /* Indexed load plus a bit test - no string compares, no lock */
+    if (table && slotId < table->slotIdCount) {
+        uint16_t roleIndex = table->roleBySlotId[slotId];
+        
+        if (roleIndex != ROLE_INDEX_NONE &&
+            (abilityId == INTERN_ID_NONE ||
+             AbilitySetContains(&table->abilities[roleIndex], abilityId))) {
+            result = ContextLoadRoleInstance(table, roleIndex);
+        }
+    }
+    
+    EpochExit();
+    return result;
+}
+
+void* ContextGetRole(
+    PartyContext* context,
+    const char* slotName,
+    const char* requiredAbility)
+{
+    if (!context || !slotName) return NULL;
+    
+    /* String-keyed shim for dynamic callers */
+    if (!atomic_load_explicit(&context->table, memory_order_acquire) &&
+        !PartyContextPublish(context)) {
+        return NULL;
+    }
+    
+    InternId abilityId = INTERN_ID_NONE;
+    if (requiredAbility) {
+        abilityId = LookupAbilityNameId(requiredAbility);
+        if (abilityId == INTERN_ID_NONE) {
+            /* No role anywhere implements this ability */
+            return NULL;
+        }
+    }
+    
+    return ContextGetRoleById(context, LookupSlotNameId(slotName), abilityId);
+}
+
+RoleQueryResult ContextFindRolesById(
+    PartyContext* context,
+    InternId abilityId)
+{
+    RoleQueryResult result = {0};
+    if (!context || abilityId == INTERN_ID_NONE) return result;
+    
+    EpochEnter();
+    
+    PartyContextTable* table = ContextAcquireTable(context);
+    
+    /* Count matching roles */
+    size_t matches = 0;
+    for (size_t i = 0; table && i < table->roleCount; i++) {
+        if (AbilitySetContains(&table->abilities[i], abilityId)) {
+            matches++;
+        }
+    }
+    
+    if (matches > 0) {
+        /* Allocate result arrays */
+        result.instances = (void**)calloc(matches, sizeof(void*));
+        result.slotNames = (const char**)calloc(matches, sizeof(char*));
+        if (!result.instances || !result.slotNames) {
+            free(result.instances);
+            free((void*)result.slotNames);
+            EpochExit();
+            return (RoleQueryResult){0};
+        }
+        result.count = matches;
+        
+        /*
+         * Fill results from the table only: the declarations may be
+         * reallocated by a writer, the interned names never are.
+         */
+        size_t idx = 0;
+        for (size_t i = 0; i < table->roleCount && idx < matches; i++) {
+            if (AbilitySetContains(&table->abilities[i], abilityId)) {
+                result.instances[idx] = ContextLoadRoleInstance(table, i);
+                result.slotNames[idx] = GetSlotNameById(table->roleNameIds[i]);
+                idx++;
+            }
+        }
+    }
+    
+    EpochExit();
+    return result;
+}
+
+RoleQueryResult ContextFindRoles(
+    PartyContext* context,
+    const char* requiredAbility)
+{
+    RoleQueryResult result = {0};
+    if (!context || !requiredAbility) return result;
+    
+    if (!atomic_load_explicit(&context->table, memory_order_acquire) &&
+        !PartyContextPublish(context)) {
+        return result;
+    }
+    
+    return ContextFindRolesById(context, LookupAbilityNameId(requiredAbility));
+}
+
+void* ContextGetSharedById(PartyContext* context, InternId fieldId)
+{
+    if (!context || fieldId == INTERN_ID_NONE) return NULL;
+    
+    EpochEnter();
+    
+    void* result = NULL;
+    PartyContextTable* table = ContextAcquireTable(context);
+    
+    if (table && fieldId < table->fieldIdCount) {
+        uint16_t fieldIndex = table->fieldByNameId[fieldId];
+        if (fieldIndex != ROLE_INDEX_NONE) {
+            result = table->fieldValues[fieldIndex];
+        }
+    }
+    
+    EpochExit();
+    return result;
+}
+
+void* ContextGetShared(PartyContext* context, const char* fieldName)
+{
+    if (!context || !fieldName) return NULL;
+    
+    if (!atomic_load_explicit(&context->table, memory_order_acquire) &&
+        !PartyContextPublish(context)) {
+        return NULL;
+    }
+    
+    return ContextGetSharedById(context, LookupFieldNameId(fieldName));
+}
+
+bool ContextSetShared(PartyContext* context, const char* fieldName, void* value)
+{
+    if (!context || !fieldName) return false;
+    
+    SpinLockAcquire(&context->contextLock);
+    
+    /* Writers are rare - a linear scan of the declarations is fine */
+    bool found = false;
+    for (size_t i = 0; i < context->sharedFieldCount; i++) {
+        if (strcmp(context->sharedFields[i].fieldName, fieldName) == 0) {
+            context->sharedFields[i].value = value;
+            found = true;
+            break;
+        }
+    }
+    
+    bool published = found && PartyContextRepublish(context);
+    
+    SpinLockRelease(&context->contextLock);
+    return published;
+}
+
+/* ============= Join Latch ============= */
+
+enum {
+    LATCH_ENTRY_PENDING = 0,
+    LATCH_ENTRY_EXCLUDED,
+    LATCH_ENTRY_DONE
+};
+
+/* Initialize over caller-provided entry state ('capacity' bytes) */
+static void DispatchLatchInitWithBuffer(DispatchLatch* latch, size_t capacity,
+                                        uint8_t* entryState)
+{
+    memset(latch, 0, sizeof(DispatchLatch));
+    
+    latch->entryState = entryState;
+    latch->capacity = capacity;
+    pthread_mutex_init(&latch->mutex, NULL);
+    pthread_cond_init(&latch->changed, NULL);
+}
+
+bool DispatchLatchInit(DispatchLatch* latch, size_t capacity)
+{
+    uint8_t* entryState = (uint8_t*)calloc(capacity ? capacity : 1, sizeof(uint8_t));
+    if (!entryState) return false;
+    
+    DispatchLatchInitWithBuffer(latch, capacity, entryState);
+    latch->ownsEntryState = true;
+    return true;
+}
+
+void DispatchLatchDestroy(DispatchLatch* latch)
+{
+    pthread_mutex_destroy(&latch->mutex);
+    pthread_cond_destroy(&latch->changed);
+    if (latch->ownsEntryState) {
+        free(latch->entryState);
+    }
+    latch->entryState = NULL;
+}
+
+void DispatchLatchArm(
+    DispatchLatch* latch,
+    JoinStrategy strategy,
+    const DispatcherConfig* config,
+    FiberResult* results,
+    size_t count)
+{
+    pthread_mutex_lock(&latch->mutex);
+    
+    latch->strategy = strategy;
+    latch->customJoin = config ? config->customJoin : NULL;
+    latch->customJoinUserData = config ? config->customJoinUserData : NULL;
+    latch->results = results;
+    latch->count = count < latch->capacity ? count : latch->capacity;
+    latch->participants = latch->count;
+    latch->completed = 0;
+    latch->succeeded = 0;
+    latch->finished = 0;
+    latch->satisfied = false;
+    latch->outcome = false;
+    latch->closed = false;
+    memset(latch->entryState, LATCH_ENTRY_PENDING, latch->count);
+    
+    pthread_mutex_unlock(&latch->mutex);
+}
+
+void DispatchLatchExclude(DispatchLatch* latch, size_t index)
+{
+    pthread_mutex_lock(&latch->mutex);
+    
+    if (index < latch->count && latch->entryState[index] == LATCH_ENTRY_PENDING) {
+        latch->entryState[index] = LATCH_ENTRY_EXCLUDED;
+        latch->participants--;
+    }
+    
+    pthread_mutex_unlock(&latch->mutex);
+}
+
+/* Evaluate the join predicate (mutex held) */
+static void DispatchLatchEvaluate(DispatchLatch* latch)
+{
+    size_t total = latch->participants;
+    size_t failed = latch->completed - latch->succeeded;
+    bool allDone = latch->completed == total;
+    
+    switch (latch->strategy) {
+        case JOIN_ANY:
+            /* First to complete, whatever its outcome */
+            if (latch->completed > 0 || total == 0) {
+                latch->satisfied = true;
+                latch->outcome = latch->succeeded > 0 || total == 0;
+            }
+            break;
+            
+        case JOIN_RACE:
+            /* First success, or nobody left who could succeed */
+            if (latch->succeeded > 0 || allDone) {
+                latch->satisfied = true;
+                latch->outcome = latch->succeeded > 0 || total == 0;
+            }
+            break;
+            
+        case JOIN_MAJORITY: {
+            /* Decided once a majority succeeded or can no longer succeed */
+            size_t required = (total / 2) + 1;
+            if (latch->succeeded >= required || failed > total - required || allDone) {
+                latch->satisfied = true;
+                latch->outcome = latch->succeeded >= required || total == 0;
+            }
+            break;
+        }
+            
+        case JOIN_CUSTOM:
+            if (latch->customJoin) {
+                if (latch->results &&
+                    latch->customJoin(latch->results, latch->count,
+                        latch->customJoinUserData)) {
+                    latch->satisfied = true;
+                    latch->outcome = true;
+                } else if (allDone) {
+                    latch->satisfied = true;
+                    latch->outcome = false;
+                }
+                break;
+            }
+            /* No predicate supplied - behave like JOIN_ALL */
+            /* fall through */
+            
+        case JOIN_ALL:
+        default:
+            if (allDone) {
+                latch->satisfied = true;
+                latch->outcome = latch->succeeded == total;
+            }
+            break;
+    }
+}
+
+void DispatchLatchSignal(
+    DispatchLatch* latch,
+    size_t index,
+    const FiberResult* result)
+{
+    pthread_mutex_lock(&latch->mutex);
+    
+    if (index >= latch->count || latch->entryState[index] == LATCH_ENTRY_DONE) {
+        pthread_mutex_unlock(&latch->mutex);
+        return;
+    }
+    
+    bool participant = latch->entryState[index] == LATCH_ENTRY_PENDING;
+    latch->entryState[index] = LATCH_ENTRY_DONE;
+    latch->finished++;
+    
+    bool wasSatisfied = latch->satisfied;
+    
+    if (!latch->closed) {
+        if (latch->results && result) {
+            latch->results[index] = *result;
+        }
+        if (participant) {
+            latch->completed++;
+            if (result && result->success) {
+                latch->succeeded++;
+            }
+            if (!latch->satisfied) {
+                DispatchLatchEvaluate(latch);
+            }
+        }
+    }
+    
+    /* Wake the joiner on a decision and the idle waiter on the last exit */
+    bool decided = latch->satisfied != wasSatisfied;
+    if (decided || latch->finished == latch->count) {
+        pthread_cond_broadcast(&latch->changed);
+    }
+    
+    DispatchReadyFunction onReady = decided ? latch->onReady : NULL;
+    void* onReadyUserData = latch->onReadyUserData;
+    pthread_mutex_unlock(&latch->mutex);
+    
+    /* May close and even re-arm the latch: nothing touches it after this */
+    if (onReady) {
+        onReady(latch, onReadyUserData);
+    }
+}
+
+/* Mark the join closed and report the losers (mutex held) */
+static bool DispatchLatchCloseLocked(
+    DispatchLatch* latch,
+    DispatchLoserFunction onLoser,
+    void* userData)
+{
+    latch->closed = true;
+    
+    /* Entries still pending lost the join; they cannot exit while we hold the mutex */
+    for (size_t i = 0; i < latch->count; i++) {
+        if (latch->entryState[i] == LATCH_ENTRY_DONE) continue;
+        
+        if (latch->results && latch->entryState[i] == LATCH_ENTRY_PENDING) {
+            latch->results[i].error = "Cancelled by join";
+        }
+        if (onLoser) {
+            onLoser(i, userData);
+        }
+    }
+    
+    return latch->outcome;
+}
+
+bool DispatchLatchWait(
+    DispatchLatch* latch,
+    DispatchLoserFunction onLoser,
+    void* userData)
+{
+    pthread_mutex_lock(&latch->mutex);
+    
+    if (!latch->satisfied) {
+        /* Exclusions may already have decided the join */
+        DispatchLatchEvaluate(latch);
+    }
+    while (!latch->satisfied) {
+        pthread_cond_wait(&latch->changed, &latch->mutex);
+    }
+    
+    bool outcome = DispatchLatchCloseLocked(latch, onLoser, userData);
+    pthread_mutex_unlock(&latch->mutex);
+    return outcome;
+}
+
+void DispatchLatchWaitIdle(DispatchLatch* latch)
+{
+    pthread_mutex_lock(&latch->mutex);
+    while (latch->finished < latch->count) {
+        pthread_cond_wait(&latch->changed, &latch->mutex);
+    }
+    pthread_mutex_unlock(&latch->mutex);
+}
+
+void DispatchLatchSetReady(DispatchLatch* latch, DispatchReadyFunction onReady, void* userData)
+{
+    pthread_mutex_lock(&latch->mutex);
+    latch->onReady = onReady;
+    latch->onReadyUserData = userData;
+    pthread_mutex_unlock(&latch->mutex);
+}
+
+/* Decide the join if 'outcome' is non-NULL, else evaluate it; fires the hook on a decision */
+static bool DispatchLatchSettle(DispatchLatch* latch, const bool* outcome)
+{
+    pthread_mutex_lock(&latch->mutex);
+    
+    if (latch->satisfied) {
+        pthread_mutex_unlock(&latch->mutex);
+        return false;
+    }
+    
+    if (outcome) {
+        latch->satisfied = true;
+        latch->outcome = *outcome;
+    } else {
+        DispatchLatchEvaluate(latch);
+    }
+    
+    bool decided = latch->satisfied;
+    if (decided) {
+        pthread_cond_broadcast(&latch->changed);
+    }
+    
+    DispatchReadyFunction onReady = decided ? latch->onReady : NULL;
+    void* onReadyUserData = latch->onReadyUserData;
+    pthread_mutex_unlock(&latch->mutex);
+    
+    if (onReady) {
+        onReady(latch, onReadyUserData);
+    }
+    return decided;
+}
+
+void DispatchLatchPoll(DispatchLatch* latch)
+{
+    DispatchLatchSettle(latch, NULL);
+}
+
+bool DispatchLatchDecide(DispatchLatch* latch, bool outcome)
+{
+    return DispatchLatchSettle(latch, &outcome);
+}
+
+bool DispatchLatchClose(
+    DispatchLatch* latch,
+    DispatchLoserFunction onLoser,
+    void* userData)
+{
+    pthread_mutex_lock(&latch->mutex);
+    bool outcome = DispatchLatchCloseLocked(latch, onLoser, userData);
+    pthread_mutex_unlock(&latch->mutex);
+    return outcome;
+}
+
+/* ============= Dispatch Arena ============= */
+
+#define DISPATCH_ARENA_ALIGN        16
+#define DISPATCH_ARENA_MIN_CHUNK    4096
+
+typedef struct DispatchArenaChunk {
+    struct DispatchArenaChunk* next;
+    size_t capacity;
+    size_t used;
+    _Alignas(DISPATCH_ARENA_ALIGN) uint8_t data[];
+} DispatchArenaChunk;
+
+struct DispatchArena {
+    DispatchArenaChunk* chunks;      /* Current chunk first */
+    size_t totalCapacity;
+    DispatchAllocStats stats;        /* Since the last reset */
+    
+    /* Dispatches whose fibers may still touch arena memory */
+    size_t inFlight;
+    pthread_mutex_t lock;
+    pthread_cond_t idle;
+};
+
+static size_t DispatchAlign(size_t size)
+{
+    return (size + DISPATCH_ARENA_ALIGN - 1) & ~(size_t)(DISPATCH_ARENA_ALIGN - 1);
+}
+
+static DispatchArenaChunk* DispatchArenaNewChunk(DispatchArena* arena, size_t capacity)
+{
+    DispatchArenaChunk* chunk = (DispatchArenaChunk*)malloc(sizeof(DispatchArenaChunk) + capacity);
+    if (!chunk) return NULL;
+    
+    chunk->capacity = capacity;
+    chunk->used = 0;
+    chunk->next = arena->chunks;
+    arena->chunks = chunk;
+    arena->totalCapacity += capacity;
+    arena->stats.heapAllocations++;
+    
+    return chunk;
+}
+
+static void DispatchArenaFreeChunks(DispatchArena* arena)
+{
+    DispatchArenaChunk* chunk = arena->chunks;
+    while (chunk) {
+        DispatchArenaChunk* next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    
+    arena->chunks = NULL;
+    arena->totalCapacity = 0;
+}
+
+static void DispatchArenaEnter(DispatchArena* arena)
+{
+    pthread_mutex_lock(&arena->lock);
+    arena->inFlight++;
+    pthread_mutex_unlock(&arena->lock);
+}
+
+static void DispatchArenaLeave(DispatchArena* arena)
+{
+    pthread_mutex_lock(&arena->lock);
+    if (--arena->inFlight == 0) {
+        pthread_cond_broadcast(&arena->idle);
+    }
+    pthread_mutex_unlock(&arena->lock);
+}
+
+static void DispatchArenaWaitIdle(DispatchArena* arena)
+{
+    pthread_mutex_lock(&arena->lock);
+    while (arena->inFlight > 0) {
+        pthread_cond_wait(&arena->idle, &arena->lock);
+    }
+    pthread_mutex_unlock(&arena->lock);
+}
+
+DispatchArena* DispatchArenaCreate(size_t initialBytes)
+{
+    DispatchArena* arena = (DispatchArena*)calloc(1, sizeof(DispatchArena));
+    if (!arena) return NULL;
+    
+    pthread_mutex_init(&arena->lock, NULL);
+    pthread_cond_init(&arena->idle, NULL);
+    
+    if (!DispatchArenaNewChunk(arena, initialBytes > DISPATCH_ARENA_MIN_CHUNK ?
+            DispatchAlign(initialBytes) : DISPATCH_ARENA_MIN_CHUNK)) {
+        DispatchArenaDestroy(arena);
+        return NULL;
+    }
+    
+    arena->stats = (DispatchAllocStats){0};
+    return arena;
+}
+
+void DispatchArenaDestroy(DispatchArena* arena)
+{
+    if (!arena) return;
+    
+    DispatchArenaWaitIdle(arena);
+    DispatchArenaFreeChunks(arena);
+    pthread_mutex_destroy(&arena->lock);
+    pthread_cond_destroy(&arena->idle);
+    free(arena);
+}
+
+void DispatchArenaReset(DispatchArena* arena)
+{
+    if (!arena) return;
+    
+    /* Losers of the previous dispatch may still be running to their stop check */
+    DispatchArenaWaitIdle(arena);
+    arena->stats = (DispatchAllocStats){0};
+    
+    if (arena->chunks && arena->chunks->next) {
+        /* Overflowed last time: one chunk that fits it all from now on */
+        size_t capacity = arena->totalCapacity;
+        DispatchArenaFreeChunks(arena);
+        DispatchArenaNewChunk(arena, capacity);
+    } else if (arena->chunks) {
+        arena->chunks->used = 0;
+    }
+}
+
+void* DispatchArenaAlloc(DispatchArena* arena, size_t size)
+{
+    if (!arena) return NULL;
+    
+    size = DispatchAlign(size ? size : 1);
+    
+    DispatchArenaChunk* chunk = arena->chunks;
+    if (!chunk || chunk->capacity - chunk->used < size) {
+        size_t capacity = chunk ? chunk->capacity * 2 : DISPATCH_ARENA_MIN_CHUNK;
+        while (capacity < size) {
+            capacity *= 2;
+        }
+        
+        chunk = DispatchArenaNewChunk(arena, capacity);
+        if (!chunk) return NULL;
+    }
+    
+    void* memory = chunk->data + chunk->used;
+    chunk->used += size;
+    memset(memory, 0, size);
+    
+    arena->stats.arenaAllocations++;
+    arena->stats.arenaBytes += size;
+    return memory;
+}
+
+const char* DispatchArenaPrintf(DispatchArena* arena, const char* format, ...)
+{
+    va_list args;
+    
+    va_start(args, format);
+    int length = vsnprintf(NULL, 0, format, args);
+    va_end(args);
+    if (length < 0) return NULL;
+    
+    char* text = (char*)DispatchArenaAlloc(arena, (size_t)length + 1);
+    if (!text) return NULL;
+    
+    va_start(args, format);
+    vsnprintf(text, (size_t)length + 1, format, args);
+    va_end(args);
+    
+    return text;
+}
+
+void DispatchArenaGetStats(const DispatchArena* arena, DispatchAllocStats* stats)
+{
+    if (!stats) return;
+    *stats = arena ? arena->stats : (DispatchAllocStats){0};
+}
+
+/* Dispatch-scoped memory: from the arena, or zeroed heap memory without one */
+static void* DispatchAlloc(DispatchArena* arena, size_t size, DispatchAllocStats* stats)
+{
+    if (arena) return DispatchArenaAlloc(arena, size);
+    
+    stats->heapAllocations++;
+    return calloc(1, size);
+}
+
+/* ============= Runtime Dispatcher ============= */
+
+/*
+ * Per-dispatch state shared with the role fibers. DispatchParallel
+ * returns as soon as the join is decided, so losers may still be
+ * running; the last of the dispatcher and the fibers frees it.
+ */
+typedef struct DispatchState DispatchState;
+
+/* Fiber wrapper structure */
+typedef struct {
+    FiberMapEntry* entry;
+    InternId roleNameId;
+    PartyContext* context;
+    void* roleInstance;
+    size_t index;
+    DispatchState* state;
+    atomic_bool* shouldStop;
+} FiberWrapper;
+
+struct DispatchState {
+    atomic_size_t refs;
+    DispatchLatch latch;
+    FiberMap* map;                   /* Referenced until the last fiber exits */
+    DispatchArena* arena;            /* Owner of this block (NULL = heap) */
+    bool* spawned;                   /* Entry got a fiber or timer registration */
+    PeriodicRole** periodicRoles;    /* Timer-driven entries */
+    FiberWrapper* wrappers;
+    atomic_bool* stopFlags;
+};
+
+/* Interned role ID of an entry; compiler-emitted static maps leave it unset */
+static InternId EntryRoleNameId(const FiberMapEntry* entry)
+{
+    return entry->roleNameId ? entry->roleNameId : InternSlotName(entry->roleId);
+}
+
+/* State and per-entry arrays (latch entry state included) in one block */
+static DispatchState* DispatchStateCreate(FiberMap* map, DispatchArena* arena,
+                                          DispatchAllocStats* stats)
+{
+    size_t count = map->entryCount;
+    size_t stateBytes = DispatchAlign(sizeof(DispatchState));
+    size_t spawnedBytes = DispatchAlign(count * sizeof(bool));
+    size_t periodicBytes = DispatchAlign(count * sizeof(PeriodicRole*));
+    size_t wrapperBytes = DispatchAlign(count * sizeof(FiberWrapper));
+    size_t flagBytes = DispatchAlign(count * sizeof(atomic_bool));
+    
+    uint8_t* block = (uint8_t*)DispatchAlloc(arena, stateBytes + spawnedBytes +
+        periodicBytes + wrapperBytes + flagBytes + count, stats);
+    if (!block) return NULL;
+    
+    DispatchState* state = (DispatchState*)block;
+    block += stateBytes;
+    state->spawned = (bool*)block;
+    block += spawnedBytes;
+    state->periodicRoles = (PeriodicRole**)block;
+    block += periodicBytes;
+    state->wrappers = (FiberWrapper*)block;
+    block += wrapperBytes;
+    state->stopFlags = (atomic_bool*)block;
+    block += flagBytes;
+    
+    for (size_t i = 0; i < count; i++) {
+        atomic_init(&state->stopFlags[i], false);
+    }
+    
+    DispatchLatchInitWithBuffer(&state->latch, count, block);
+    atomic_init(&state->refs, 1);
+    state->map = RetainFiberMap(map);
+    state->arena = arena;
+    
+    if (arena) {
+        DispatchArenaEnter(arena);
+    }
+    
+    return state;
+}
+
+static void DispatchStateRelease(DispatchState* state)
+{
+    if (atomic_fetch_sub(&state->refs, 1) != 1) return;
+    
+    DispatchLatchDestroy(&state->latch);
+    FreeFiberMap(state->map);
+    
+    /* Arena memory is reclaimed by the next reset */
+    if (state->arena) {
+        DispatchArenaLeave(state->arena);
+    } else {
+        free(state);
+    }
+}
+
+/* Setup error; with an arena the text names the role and scheduler tag */
+static const char* DispatchSetupError(DispatchArena* arena, const FiberMapEntry* entry,
+                                      const char* error)
+{
+    if (!arena) return error;
+    
+    const char* detailed = DispatchArenaPrintf(arena, "%s: %s (scheduler tag %d)",
+        entry->roleId, error, (int)entry->schedulerTag);
+    return detailed ? detailed : error;
+}
+
+/* Continuous execution wrapper (periodic roles use the timer service) */
+static void ContinuousFiberFunction(void* userData)
+{
+    FiberWrapper* wrapper = (FiberWrapper*)userData;
+    uint64_t startTime = GetTimeNanos();
+    
+    while (!atomic_load_explicit(wrapper->shouldStop, memory_order_acquire)) {
+        /* Execute the role's parallel function */
+        wrapper->entry->parallelFn(wrapper->roleInstance, wrapper->context);
+        
+        /* Yield to avoid hogging CPU (stays runnable) */
+        SchedulerYield();
+    }
+    
+    /* Record execution time */
+    FiberResult result = { .roleId = wrapper->entry->roleId, .success = true };
+    result.executionTimeNs = GetTimeNanos() - startTime;
+    UpdateFiberStats(wrapper->roleNameId, &result);
+    
+    DispatchLatchSignal(&wrapper->state->latch, wrapper->index, &result);
+    DispatchStateRelease(wrapper->state);
+}
+
+/* One-shot execution wrapper */
+static void OneshotFiberFunction(void* userData)
+{
+    FiberWrapper* wrapper = (FiberWrapper*)userData;
+    uint64_t startTime = GetTimeNanos();
+    
+    /* Execute once */
+    wrapper->entry->parallelFn(wrapper->roleInstance, wrapper->context);
+    
+    /* Record result */
+    FiberResult result = { .roleId = wrapper->entry->roleId, .success = true };
+    result.executionTimeNs = GetTimeNanos() - startTime;
+    UpdateFiberStats(wrapper->roleNameId, &result);
+    
+    DispatchLatchSignal(&wrapper->state->latch, wrapper->index, &result);
+    DispatchStateRelease(wrapper->state);
+}
+
+/*
+ * Ask a role that lost the join to stop (latch mutex held). Only the flag
+ * is touched here: the fiber runs on to its own signal and state release,
+ * and timer-driven roles are removed once the latch lock is dropped.
+ */
+static void StopLosingRole(size_t index, void* userData)
+{
+    DispatchState* state = (DispatchState*)userData;
+    
+    atomic_store_explicit(&state->stopFlags[index], true, memory_order_release);
+}
+
+/* Deregister timer-driven roles after the join closed (latch lock not held) */
+static void DispatchStopPeriodicRoles(DispatchState* state)
+{
+    for (size_t i = 0; i < state->map->entryCount; i++) {
+        if (state->periodicRoles[i]) {
+            PeriodicServiceRemove(GetPeriodicService(), state->periodicRoles[i]);
+            state->periodicRoles[i] = NULL;
+        }
+    }
+}
+
+/* Report a setup failure for an entry that never got a fiber */
+static void SignalSetupFailure(DispatchLatch* latch, size_t index,
+                               const FiberMapEntry* entry, const char* error)
+{
+    FiberResult failed = { .roleId = entry->roleId, .success = false, .error = error };
+    UpdateFiberStats(EntryRoleNameId(entry), &failed);
+    DispatchLatchSignal(latch, index, &failed);
+}
+
+/* Create and schedule a fiber (or periodic registration) for every entry */
+static void DispatchSpawnRoles(
+    DispatchState* state,
+    PartyContext* context,
+    FiberResult* results)
+{
+    FiberMap* map = state->map;
+    DispatchArena* arena = state->arena;
+    
+    for (size_t i = 0; i < map->entryCount; i++) {
+        FiberMapEntry* entry = &map->entries[i];
+        
+        /* Initialize result */
+        results[i].roleId = entry->roleId;
+        results[i].success = false;
+        
+        /* Continuous roles run until the join is decided, not toward it */
+        if (entry->isContinuous) {
+            DispatchLatchExclude(&state->latch, i);
+        }
+        
+        /* Get role instance */
+        void* roleInstance = GetSlotPointer(entry->instanceSlotId);
+        if (!roleInstance) {
+            SignalSetupFailure(&state->latch, i, entry,
+                DispatchSetupError(arena, entry, "Failed to load role instance"));
+            continue;
+        }
+        
+        /* Setup wrapper */
+        FiberWrapper* wrapper = &state->wrappers[i];
+        wrapper->entry = entry;
+        wrapper->roleNameId = EntryRoleNameId(entry);
+        wrapper->context = context;
+        wrapper->roleInstance = roleInstance;
+        wrapper->index = i;
+        wrapper->state = state;
+        wrapper->shouldStop = &state->stopFlags[i];
+        
+        /* Periodic roles fire from the timer wheel until the join closes */
+        if (entry->isContinuous && entry->executionIntervalMs > 0) {
+            state->periodicRoles[i] = PeriodicServiceAdd(GetPeriodicService(),
+                map, entry, roleInstance, context, PERIODIC_SKIP);
+            if (!state->periodicRoles[i]) {
+                SignalSetupFailure(&state->latch, i, entry,
+                    DispatchSetupError(arena, entry, "Failed to register periodic role"));
+                continue;
+            }
+            state->spawned[i] = true;
+            continue;
+        }
+        
+        /* Get scheduler */
+        FiberScheduler* scheduler = GetSchedulerForTag(entry->schedulerTag);
+        if (!scheduler) {
+            SignalSetupFailure(&state->latch, i, entry,
+                DispatchSetupError(arena, entry, "Scheduler not found"));
+            continue;
+        }
+        
+        /* Create fiber based on execution mode */
+        FiberStartRoutine fiberFn = entry->isContinuous ? 
+            ContinuousFiberFunction : OneshotFiberFunction;
+        
+        /* The fiber holds a reference until it signals; taken first since it may run at once */
+        atomic_fetch_add(&state->refs, 1);
+        
+        if (!SchedulerSpawnWithPriority(scheduler, fiberFn, wrapper, (uint32_t)entry->priority)) {
+            atomic_fetch_sub(&state->refs, 1);
+            SignalSetupFailure(&state->latch, i, entry,
+                DispatchSetupError(arena, entry, "Failed to create fiber"));
+            continue;
+        }
+        state->spawned[i] = true;
+    }
+}
+
+/* Continuous roles ran for the whole join */
+static void DispatchCompleteContinuous(DispatchState* state, DispatchResult* result)
+{
+    FiberMap* map = state->map;
+    
+    for (size_t i = 0; i < map->entryCount; i++) {
+        if (map->entries[i].isContinuous &&
+            state->spawned[i] &&
+            !result->results[i].success) {
+            result->results[i].success = true;
+            result->results[i].error = NULL;
+            result->results[i].executionTimeNs = result->totalExecutionTimeNs;
+        }
+    }
+}
+
+/* Dispatch implementation */
+static DispatchResult DispatchRun(
+    FiberMap* map,
+    PartyContext* context,
+    JoinStrategy joinStrategy,
+    DispatcherConfig* config,
+    DispatchArena* arena)
+{
+    DispatchResult result = {0};
+    
+    if (!map || !context || map->entryCount == 0) {
+        return result;
+    }
+    
+    /* Result array, then shared state: fiber handles, wrappers, flags and latch */
+    result.results = (FiberResult*)DispatchAlloc(arena,
+        map->entryCount * sizeof(FiberResult), &result.allocations);
+    DispatchState* state = result.results ?
+        DispatchStateCreate(map, arena, &result.allocations) : NULL;
+    if (!state) {
+        if (!arena) free(result.results);
+        return (DispatchResult){0};
+    }
+    result.resultCount = map->entryCount;
+    
+    DispatchLatchArm(&state->latch, joinStrategy, config, result.results, map->entryCount);
+    
+    uint64_t dispatchStartTime = GetTimeNanos();
+    
+    DispatchSpawnRoles(state, context, result.results);
+    
+    /*
+     * Wait until the join predicate holds. Fibers still running at that
+     * point (losers and continuous roles) are asked to stop.
+     */
+    result.allSucceeded = DispatchLatchWait(&state->latch, StopLosingRole, state);
+    DispatchStopPeriodicRoles(state);
+    
+    /* Calculate total execution time */
+    result.totalExecutionTimeNs = GetTimeNanos() - dispatchStartTime;
+    
+    DispatchCompleteContinuous(state, &result);
+    
+    /* Cleanup (remaining fibers drop their references on exit) */
+    DispatchStateRelease(state);
+    
+    if (arena) {
+        result.allocations = arena->stats;
+    }
+    
+    return result;
+}
+
+DispatchResult DispatchParallel(
+    FiberMap* map,
+    PartyContext* context,
+    JoinStrategy joinStrategy,
+    DispatcherConfig* config)
+{
+    return DispatchRun(map, context, joinStrategy, config, NULL);
+}
+
+bool DispatchParallelInto(
+    FiberMap* map,
+    PartyContext* context,
+    JoinStrategy joinStrategy,
+    DispatcherConfig* config,
+    DispatchArena* arena,
+    DispatchResult* result)
+{
+    if (!arena || !result) return false;
+    
+    /* The previous dispatch's results and bookkeeping go away here */
+    DispatchArenaReset(arena);
+    
+    *result = DispatchRun(map, context, joinStrategy, config, arena);
+    return result->results != NULL;
+}
+
+DispatchResult DispatchParty(
+    const char* partyType,
+    const RoleBinding* roleBindings,
+    size_t bindingCount,
+    PartyContext* context,
+    JoinStrategy joinStrategy,
+    DispatcherConfig* config)
+{
+    FiberMap* map = GenerateFiberMapCached(partyType, roleBindings, bindingCount);
+    DispatchResult result = DispatchParallel(map, context, joinStrategy, config);
+    
+    /* The dispatch keeps its own reference while fibers are still running */
+    FreeFiberMap(map);
+    
+    return result;
+}
+
+/* ============= Async Dispatch ============= */
+
+typedef struct DispatchContinuation {
+    struct DispatchContinuation* next;
+    DispatchCallback callback;
+    void* userData;
+} DispatchContinuation;
+
+struct DispatchHandle {
+    atomic_size_t refs;              /* Caller + one until completion */
+    DispatchState* state;
+    DispatchResult result;
+    uint64_t startTimeNs;
+    atomic_uint pendingArrivals;     /* Setup finished + join decided */
+    
+    pthread_mutex_t mutex;
+    pthread_cond_t completed;        /* CLOCK_MONOTONIC */
+    bool done;
+    bool resultTaken;                /* results went to a WaitForDispatch caller */
+    DispatchContinuation* continuations;   /* Newest first */
+};
+
+void ReleaseDispatch(DispatchHandle* handle)
+{
+    if (!handle || atomic_fetch_sub(&handle->refs, 1) != 1) return;
+    
+    /* Continuations already ran and freed themselves */
+    if (!handle->resultTaken) {
+        free(handle->result.results);
+    }
+    DispatchStateRelease(handle->state);
+    pthread_mutex_destroy(&handle->mutex);
+    pthread_cond_destroy(&handle->completed);
+    free(handle);
+}
+
+/* Close the join, publish the result and run the continuations in registration order */
+static void DispatchHandleComplete(DispatchHandle* handle)
+{
+    DispatchState* state = handle->state;
+    
+    handle->result.allSucceeded = DispatchLatchClose(&state->latch, StopLosingRole, state);
+    DispatchStopPeriodicRoles(state);
+    handle->result.totalExecutionTimeNs = GetTimeNanos() - handle->startTimeNs;
+    DispatchCompleteContinuous(state, &handle->result);
+    
+    pthread_mutex_lock(&handle->mutex);
+    handle->done = true;
+    DispatchContinuation* pending = handle->continuations;
+    handle->continuations = NULL;
+    pthread_cond_broadcast(&handle->completed);
+    pthread_mutex_unlock(&handle->mutex);
+    
+    DispatchContinuation* ordered = NULL;
+    while (pending) {
+        DispatchContinuation* next = pending->next;
+        pending->next = ordered;
+        ordered = pending;
+        pending = next;
+    }
+    while (ordered) {
+        DispatchContinuation* next = ordered->next;
+        ordered->callback(handle, &handle->result, ordered->userData);
+        free(ordered);
+        ordered = next;
+    }
+    
+    ReleaseDispatch(handle);
+}
+
+/* Completion needs both the end of setup and the join decision */
+static void DispatchHandleArrive(DispatchHandle* handle)
+{
+    if (atomic_fetch_sub(&handle->pendingArrivals, 1) == 1) {
+        DispatchHandleComplete(handle);
+    }
+}
+
+static void DispatchHandleReady(DispatchLatch* latch, void* userData)
+{
+    (void)latch;
+    DispatchHandleArrive((DispatchHandle*)userData);
+}
+
+DispatchHandle* DispatchParallelAsync(
+    FiberMap* map,
+    PartyContext* context,
+    JoinStrategy joinStrategy,
+    DispatcherConfig* config)
+{
+    if (!map || !context || map->entryCount == 0) return NULL;
+    
+    DispatchHandle* handle = (DispatchHandle*)calloc(1, sizeof(DispatchHandle));
+    if (!handle) return NULL;
+    
+    DispatchResult* result = &handle->result;
+    result->results = (FiberResult*)DispatchAlloc(NULL,
+        map->entryCount * sizeof(FiberResult), &result->allocations);
+    handle->state = result->results ?
+        DispatchStateCreate(map, NULL, &result->allocations) : NULL;
+    if (!handle->state) {
+        free(result->results);
+        free(handle);
+        return NULL;
+    }
+    result->resultCount = map->entryCount;
+    
+    atomic_init(&handle->refs, 2);
+    atomic_init(&handle->pendingArrivals, 2);
+    pthread_mutex_init(&handle->mutex, NULL);
+    
+    /* Timed waits use GetTimeNanos deadlines */
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&handle->completed, &attr);
+    pthread_condattr_destroy(&attr);
+    
+    DispatchState* state = handle->state;
+    DispatchLatchArm(&state->latch, joinStrategy, config, result->results, map->entryCount);
+    DispatchLatchSetReady(&state->latch, DispatchHandleReady, handle);
+    
+    handle->startTimeNs = GetTimeNanos();
+    DispatchSpawnRoles(state, context, result->results);
+    
+    /* Exclusions alone may have decided the join; losers only exist after setup */
+    DispatchLatchPoll(&state->latch);
+    DispatchHandleArrive(handle);
+    
+    return handle;
+}
+
+bool DispatchThen(DispatchHandle* handle, DispatchCallback callback, void* userData)
+{
+    if (!handle || !callback) return false;
+    
+    pthread_mutex_lock(&handle->mutex);
+    
+    if (handle->done) {
+        pthread_mutex_unlock(&handle->mutex);
+        callback(handle, &handle->result, userData);
+        return true;
+    }
+    
+    DispatchContinuation* continuation =
+        (DispatchContinuation*)malloc(sizeof(DispatchContinuation));
+    if (continuation) {
+        continuation->callback = callback;
+        continuation->userData = userData;
+        continuation->next = handle->continuations;
+        handle->continuations = continuation;
+    }
+    
+    pthread_mutex_unlock(&handle->mutex);
+    return continuation != NULL;
+}
+
+bool DispatchIsComplete(DispatchHandle* handle)
+{
+    if (!handle) return false;
+    
+    pthread_mutex_lock(&handle->mutex);
+    bool done = handle->done;
+    pthread_mutex_unlock(&handle->mutex);
+    return done;
+}
+
+DispatchResult WaitForDispatch(DispatchHandle* handle, uint64_t timeoutMs)
+{
+    DispatchResult result = {0};
+    if (!handle) return result;
+    
+    uint64_t deadlineNs = GetTimeNanos() + timeoutMs * 1000000ULL;
+    struct timespec deadline = {
+        .tv_sec = (time_t)(deadlineNs / 1000000000ULL),
+        .tv_nsec = (long)(deadlineNs % 1000000000ULL)
+    };
+    
+    pthread_mutex_lock(&handle->mutex);
+    while (!handle->done) {
+        if (timeoutMs == 0) {
+            pthread_cond_wait(&handle->completed, &handle->mutex);
+        } else if (pthread_cond_timedwait(&handle->completed, &handle->mutex,
+                                          &deadline) == ETIMEDOUT) {
+            break;
+        }
+    }
+    
+    bool done = handle->done;
+    if (done) {
+        result = handle->result;
+        handle->resultTaken = true;
+    }
+    pthread_mutex_unlock(&handle->mutex);
+    
+    if (done) {
+        ReleaseDispatch(handle);
+    }
+    return result;
+}
+
+void CancelDispatch(DispatchHandle* handle)
+{
+    if (!handle) return;
+    
+    /* Completion asks every role still running to stop */
+    DispatchLatchDecide(&handle->state->latch, false);
+}
+
+/* ============= Resident Dispatch ============= */
+
+/* One parked role fiber */
+typedef struct {
+    struct ResidentDispatch* dispatch;
+    FiberMapEntry* entry;
+    InternId roleNameId;
+    size_t index;
+    void* roleInstance;
+    FiberResult local;               /* Written by the fiber, copied by the latch */
+    _Atomic(Fiber*) fiber;           /* Published by the fiber once it runs */
+    const char* setupError;          /* Set if the fiber could not be spawned */
+} ResidentWorker;
+
+struct ResidentDispatch {
+    FiberMap* map;
+    PartyContext* context;
+    DispatcherConfig* config;
+    ResidentWorker* workers;
+    FiberResult* results;            /* Reused every round */
+    
+    _Atomic(uint64_t) generation;    /* Bumped to start a round */
+    atomic_bool shuttingDown;
+    atomic_bool waking;              /* Shutdown wakes still in flight */
+    DispatchLatch latch;
+};
+
+/*
+ * Block the role fiber until the round generation moves past 'seen'.
+ * The scheduler keeps a wake that lands before the fiber has switched
+ * out (or before it blocks at all) as a permit, so a round can never be
+ * missed; a stale permit only costs one more generation check.
+ */
+static uint64_t ResidentPark(ResidentWorker* worker, uint64_t seen)
+{
+    ResidentDispatch* dispatch = worker->dispatch;
+    Fiber* self = atomic_load_explicit(&worker->fiber, memory_order_relaxed);
+    
+    for (;;) {
+        uint64_t generation = atomic_load(&dispatch->generation);
+        if (generation != seen) return generation;
+        
+        SchedulerBlock(self);
+    }
+}
+
+/* Called after the generation bump */
+static void ResidentWake(ResidentWorker* worker)
+{
+    /* Not published yet: the fiber reads the new generation before it first parks */
+    Fiber* fiber = atomic_load(&worker->fiber);
+    if (fiber) {
+        SchedulerUnblock(fiber);
+    }
+}
+
+static void ResidentFiberFunction(void* userData)
+{
+    ResidentWorker* worker = (ResidentWorker*)userData;
+    ResidentDispatch* dispatch = worker->dispatch;
+    uint64_t seen = 0;
+    
+    /* Publish before the first generation check (pairs with ResidentWake) */
+    atomic_store(&worker->fiber, FiberGetCurrent());
+    
+    for (;;) {
+        seen = ResidentPark(worker, seen);
+        if (atomic_load(&dispatch->shuttingDown)) break;
+        
+        uint64_t startTime = GetTimeNanos();
+        worker->entry->parallelFn(worker->roleInstance, dispatch->context);
+        
+        worker->local.executionTimeNs = GetTimeNanos() - startTime;
+        worker->local.success = true;
+        UpdateFiberStats(worker->roleNameId, &worker->local);
+        
+        DispatchLatchSignal(&dispatch->latch, worker->index, &worker->local);
+    }
+    
+    /* The scheduler frees the fiber on exit; no wake may still be aimed at it */
+    while (atomic_load(&dispatch->waking)) {
+        SchedulerYield();
+    }
+    
+    /* Acknowledge shutdown */
+    DispatchLatchSignal(&dispatch->latch, worker->index, NULL);
+}
+
+/* Signal entries without a fiber so the latch does not wait on them */
+static void ResidentSignalDeadWorkers(ResidentDispatch* dispatch)
+{
+    for (size_t i = 0; i < dispatch->map->entryCount; i++) {
+        ResidentWorker* worker = &dispatch->workers[i];
+        if (worker->setupError) {
+            SignalSetupFailure(&dispatch->latch, i, worker->entry,
+                worker->setupError);
+        }
+    }
+}
+
+ResidentDispatch* ResidentDispatchCreate(
+    FiberMap* map,
+    PartyContext* context,
+    DispatcherConfig* config)
+{
+    if (!map || !context || map->entryCount == 0) return NULL;
+    
+    ResidentDispatch* dispatch = (ResidentDispatch*)calloc(1, sizeof(ResidentDispatch));
+    if (!dispatch) return NULL;
+    
+    dispatch->map = map;
+    dispatch->context = context;
+    dispatch->config = config;
+    dispatch->workers = (ResidentWorker*)calloc(map->entryCount, sizeof(ResidentWorker));
+    dispatch->results = (FiberResult*)calloc(map->entryCount, sizeof(FiberResult));
+    if (!dispatch->workers || !dispatch->results ||
+        !DispatchLatchInit(&dispatch->latch, map->entryCount)) {
+        free(dispatch->workers);
+        free(dispatch->results);
+        free(dispatch);
+        return NULL;
+    }
+    
+    atomic_init(&dispatch->generation, 0);
+    atomic_init(&dispatch->shuttingDown, false);
+    atomic_init(&dispatch->waking, false);
+    
+    /* Create one fiber per entry; each parks until the first round */
+    for (size_t i = 0; i < map->entryCount; i++) {
         FiberMapEntry* entry = &map->entries[i];
+        ResidentWorker* worker = &dispatch->workers[i];
         
-        /* Initialize result */
-        result.results[i].roleId = entry->roleId;
-        result.results[i].success = false;
+        worker->dispatch = dispatch;
+        worker->entry = entry;
+        worker->roleNameId = EntryRoleNameId(entry);
+        worker->index = i;
+        worker->local.roleId = entry->roleId;
+        dispatch->results[i].roleId = entry->roleId;
+        atomic_init(&worker->fiber, NULL);
         
-        /* Get role instance */
-        void* roleInstance = GetSlotPointer(entry->instanceSlotId);
-        if (!roleInstance) {
-            result.results[i].error = "Failed to load role instance";
+        worker->roleInstance = GetSlotPointer(entry->instanceSlotId);
+        if (!worker->roleInstance) {
+            worker->setupError = "Failed to load role instance";
             continue;
         }
         
-        /* Setup wrapper */
-        wrappers[i].entry = entry;
-        wrappers[i].context = context;
-        wrappers[i].roleInstance = roleInstance;
-        wrappers[i].result = &result.results[i];
-        wrappers[i].shouldStop = &stopFlags[i];
-        
-        /* Get scheduler */
-        FiberScheduler* scheduler = GetSchedulerForTag(entry->schedulerTag);
-        if (!scheduler) {
-            result.results[i].error = "Scheduler not found";
-            continue;
+        FiberScheduler* scheduler = GetSchedulerForTag(entry->schedulerTag);
+        if (!scheduler) {
+            worker->setupError = "Scheduler not found";
+            continue;
+        }
+        
+        if (!SchedulerSpawnWithPriority(scheduler, ResidentFiberFunction, worker,
+                                        (uint32_t)entry->priority)) {
+            worker->setupError = "Failed to create fiber";
+        }
+    }
+    
+    RetainFiberMap(map);
+    return dispatch;
+}
+
+DispatchResult ResidentDispatchRun(
+    ResidentDispatch* dispatch,
+    JoinStrategy joinStrategy)
+{
+    DispatchResult result = {0};
+    if (!dispatch) return result;
+    
+    size_t entryCount = dispatch->map->entryCount;
+    
+    /* Stragglers from an early-joined previous round must finish first */
+    DispatchLatchWaitIdle(&dispatch->latch);
+    
+    uint64_t dispatchStartTime = GetTimeNanos();
+    
+    /* Reset the reused result buffer */
+    for (size_t i = 0; i < entryCount; i++) {
+        FiberResult* r = &dispatch->results[i];
+        r->success = false;
+        r->result = NULL;
+        r->executionTimeNs = 0;
+        r->error = NULL;
+    }
+    
+    /* Start the round and wake every parked role fiber */
+    DispatchLatchArm(&dispatch->latch, joinStrategy, dispatch->config,
+        dispatch->results, entryCount);
+    ResidentSignalDeadWorkers(dispatch);
+    atomic_fetch_add(&dispatch->generation, 1);
+    
+    for (size_t i = 0; i < entryCount; i++) {
+        ResidentWake(&dispatch->workers[i]);
+    }
+    
+    /* Resident fibers are reused, so losers are left to finish the round */
+    result.allSucceeded = DispatchLatchWait(&dispatch->latch, NULL, NULL);
+    
+    result.results = dispatch->results;
+    result.resultCount = entryCount;
+    result.totalExecutionTimeNs = GetTimeNanos() - dispatchStartTime;
+    
+    return result;
+}
+
+void ResidentDispatchDestroy(ResidentDispatch* dispatch)
+{
+    if (!dispatch) return;
+    
+    DispatchLatchWaitIdle(&dispatch->latch);
+    
+    /* Wake everyone with the shutdown flag set and wait for them to exit */
+    DispatchLatchArm(&dispatch->latch, JOIN_ALL, NULL, NULL, dispatch->map->entryCount);
+    ResidentSignalDeadWorkers(dispatch);
+    atomic_store(&dispatch->waking, true);
+    atomic_store(&dispatch->shuttingDown, true);
+    atomic_fetch_add(&dispatch->generation, 1);
+    
+    for (size_t i = 0; i < dispatch->map->entryCount; i++) {
+        ResidentWake(&dispatch->workers[i]);
+    }
+    atomic_store(&dispatch->waking, false);
+    
+    DispatchLatchWaitIdle(&dispatch->latch);
+    DispatchLatchDestroy(&dispatch->latch);
+    
+    FreeFiberMap(dispatch->map);
+    free(dispatch->workers);
+    free(dispatch->results);
+    free(dispatch);
+}
+
+/* ============= Periodic Roles ============= */
+
+#define PERIODIC_WHEEL_SLOTS    512
+#define PERIODIC_IDLE_WAIT_NS   100000000ULL   /* Re-check when no timers are armed */
+
+struct PeriodicRole {
+    FiberMap* map;                   /* Retained: owns 'entry' */
+    FiberMapEntry* entry;
+    InternId roleNameId;
+    void* roleInstance;
+    PartyContext* context;
+    struct PeriodicGroup* group;
+    struct PeriodicRole* next;       /* Next role in the group */
+    
+    atomic_size_t refs;              /* Service + in-flight firing */
+    atomic_uint_fast64_t pendingRuns;/* Firings owed to the running fiber */
+    
+    /* Written by the timer thread only */
+    _Atomic(uint64_t) firings;
+    _Atomic(uint64_t) overruns;
+    _Atomic(uint64_t) skippedPeriods;
+    _Atomic(uint64_t) totalJitterNs;
+    _Atomic(uint64_t) maxJitterNs;
+};
+
+/* Roles sharing a period and policy, woken by one timer */
+typedef struct PeriodicGroup {
+    uint64_t periodNs;
+    PeriodicCatchUpPolicy policy;
+    uint64_t deadlineNs;             /* Next fixed-rate deadline */
+    bool scheduled;                  /* Timer armed or firing */
+    TimerEntry timer;
+    PeriodicRole* roles;
+    struct PeriodicService* service;
+    struct PeriodicGroup* next;
+} PeriodicGroup;
+
+struct PeriodicService {
+    TimerWheel* wheel;
+    PeriodicGroup* groups;           /* Never freed before the service */
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    pthread_t thread;
+    bool running;
+};
+
+static PeriodicService* g_periodicService = NULL;
+static pthread_once_t g_periodicServiceOnce = PTHREAD_ONCE_INIT;
+
+static void PeriodicRoleRelease(PeriodicRole* role)
+{
+    if (atomic_fetch_sub(&role->refs, 1) == 1) {
+        FreeFiberMap(role->map);
+        free(role);
+    }
+}
+
+/* Firing fiber: runs the body once per owed period */
+static void PeriodicRoleFiberFunction(void* userData)
+{
+    PeriodicRole* role = (PeriodicRole*)userData;
+    
+    do {
+        uint64_t startTime = GetTimeNanos();
+        role->entry->parallelFn(role->roleInstance, role->context);
+        
+        FiberResult result = { .roleId = role->entry->roleId, .success = true };
+        result.executionTimeNs = GetTimeNanos() - startTime;
+        UpdateFiberStats(role->roleNameId, &result);
+    } while (atomic_fetch_sub(&role->pendingRuns, 1) > 1);
+    
+    PeriodicRoleRelease(role);
+}
+
+static void PeriodicRoleFire(PeriodicRole* role, uint64_t runs, uint64_t jitterNs)
+{
+    atomic_store_explicit(&role->firings,
+        atomic_load_explicit(&role->firings, memory_order_relaxed) + 1, memory_order_relaxed);
+    atomic_store_explicit(&role->totalJitterNs,
+        atomic_load_explicit(&role->totalJitterNs, memory_order_relaxed) + jitterNs,
+        memory_order_relaxed);
+    if (jitterNs > atomic_load_explicit(&role->maxJitterNs, memory_order_relaxed)) {
+        atomic_store_explicit(&role->maxJitterNs, jitterNs, memory_order_relaxed);
+    }
+    
+    uint64_t idle = 0;
+    bool start;
+    if (role->group->policy == PERIODIC_CATCH_UP) {
+        /* Owe every missed period; a running fiber picks them up */
+        start = atomic_fetch_add(&role->pendingRuns, runs) == 0;
+    } else {
+        start = atomic_compare_exchange_strong(&role->pendingRuns, &idle, 1);
+    }
+    
+    if (!start) {
+        atomic_store_explicit(&role->overruns,
+            atomic_load_explicit(&role->overruns, memory_order_relaxed) + 1,
+            memory_order_relaxed);
+        return;
+    }
+    
+    /* The firing holds a reference; taken first since the fiber may run at once */
+    atomic_fetch_add(&role->refs, 1);
+    
+    FiberScheduler* scheduler = GetSchedulerForTag(role->entry->schedulerTag);
+    if (!scheduler || !SchedulerSpawnWithPriority(scheduler, PeriodicRoleFiberFunction,
+            role, (uint32_t)role->entry->priority)) {
+        atomic_store(&role->pendingRuns, 0);
+        PeriodicRoleRelease(role);
+    }
+}
+
+/* Group timer callback (timer thread, outside the wheel lock) */
+static void PeriodicGroupExpired(TimerEntry* timer, uint64_t nowNs)
+{
+    PeriodicGroup* group = (PeriodicGroup*)timer->userData;
+    PeriodicService* service = group->service;
+    
+    pthread_mutex_lock(&service->lock);
+    
+    if (!group->roles) {
+        /* Last role left; re-armed by the next PeriodicServiceAdd */
+        group->scheduled = false;
+        pthread_mutex_unlock(&service->lock);
+        return;
+    }
+    
+    uint64_t jitterNs = nowNs > group->deadlineNs ? nowNs - group->deadlineNs : 0;
+    uint64_t missed = jitterNs / group->periodNs;
+    
+    for (PeriodicRole* role = group->roles; role; role = role->next) {
+        PeriodicRoleFire(role, missed + 1, jitterNs);
+        
+        if (missed > 0 && group->policy != PERIODIC_CATCH_UP) {
+            atomic_store_explicit(&role->skippedPeriods,
+                atomic_load_explicit(&role->skippedPeriods, memory_order_relaxed) + missed,
+                memory_order_relaxed);
+        }
+    }
+    
+    /* Next deadline: fixed-rate grid unless the policy restarts it */
+    if (group->policy == PERIODIC_RESCHEDULE) {
+        group->deadlineNs = nowNs + group->periodNs;
+    } else {
+        group->deadlineNs += (missed + 1) * group->periodNs;
+    }
+    
+    TimerWheelSchedule(service->wheel, &group->timer, group->deadlineNs);
+    
+    pthread_mutex_unlock(&service->lock);
+}
+
+static void* PeriodicServiceThread(void* arg)
+{
+    PeriodicService* service = (PeriodicService*)arg;
+    
+    pthread_mutex_lock(&service->lock);
+    while (service->running) {
+        pthread_mutex_unlock(&service->lock);
+        
+        TimerWheelAdvance(service->wheel, GetTimeNanos());
+        uint64_t next = TimerWheelNextDeadline(service->wheel);
+        
+        pthread_mutex_lock(&service->lock);
+        if (!service->running) break;
+        
+        uint64_t now = GetTimeNanos();
+        if (next > now) {
+            uint64_t wakeNs = next == UINT64_MAX ? now + PERIODIC_IDLE_WAIT_NS : next;
+            struct timespec deadline = {
+                .tv_sec = (time_t)(wakeNs / 1000000000ULL),
+                .tv_nsec = (long)(wakeNs % 1000000000ULL)
+            };
+            pthread_cond_timedwait(&service->wake, &service->lock, &deadline);
+        }
+    }
+    pthread_mutex_unlock(&service->lock);
+    
+    return NULL;
+}
+
+PeriodicService* PeriodicServiceCreate(uint64_t tickNs)
+{
+    PeriodicService* service = (PeriodicService*)calloc(1, sizeof(PeriodicService));
+    if (!service) return NULL;
+    
+    service->wheel = TimerWheelCreate(tickNs, PERIODIC_WHEEL_SLOTS, GetTimeNanos());
+    if (!service->wheel) {
+        free(service);
+        return NULL;
+    }
+    
+    /* Deadlines are CLOCK_MONOTONIC, so the condition variable must be too */
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&service->wake, &attr);
+    pthread_condattr_destroy(&attr);
+    pthread_mutex_init(&service->lock, NULL);
+    
+    service->running = true;
+    if (pthread_create(&service->thread, NULL, PeriodicServiceThread, service) != 0) {
+        pthread_cond_destroy(&service->wake);
+        pthread_mutex_destroy(&service->lock);
+        TimerWheelDestroy(service->wheel);
+        free(service);
+        return NULL;
+    }
+    
+    return service;
+}
+
+void PeriodicServiceDestroy(PeriodicService* service)
+{
+    if (!service) return;
+    
+    pthread_mutex_lock(&service->lock);
+    service->running = false;
+    pthread_cond_signal(&service->wake);
+    pthread_mutex_unlock(&service->lock);
+    
+    pthread_join(service->thread, NULL);
+    
+    /* Drop the service's reference on every remaining role */
+    PeriodicGroup* group = service->groups;
+    while (group) {
+        PeriodicGroup* nextGroup = group->next;
+        PeriodicRole* role = group->roles;
+        while (role) {
+            PeriodicRole* nextRole = role->next;
+            PeriodicRoleRelease(role);
+            role = nextRole;
+        }
+        free(group);
+        group = nextGroup;
+    }
+    
+    TimerWheelDestroy(service->wheel);
+    pthread_cond_destroy(&service->wake);
+    pthread_mutex_destroy(&service->lock);
+    free(service);
+}
+
+static void CreateDefaultPeriodicService(void)
+{
+    g_periodicService = PeriodicServiceCreate(1000000ULL);
+}
+
+PeriodicService* GetPeriodicService(void)
+{
+    pthread_once(&g_periodicServiceOnce, CreateDefaultPeriodicService);
+    return g_periodicService;
+}
+
+PeriodicRole* PeriodicServiceAdd(
+    PeriodicService* service,
+    FiberMap* map,
+    FiberMapEntry* entry,
+    void* roleInstance,
+    PartyContext* context,
+    PeriodicCatchUpPolicy policy)
+{
+    if (!service || !map || !entry || !entry->parallelFn || entry->executionIntervalMs == 0) {
+        return NULL;
+    }
+    
+    PeriodicRole* role = (PeriodicRole*)calloc(1, sizeof(PeriodicRole));
+    if (!role) return NULL;
+    
+    role->map = RetainFiberMap(map);
+    role->entry = entry;
+    role->roleNameId = EntryRoleNameId(entry);
+    role->roleInstance = roleInstance;
+    role->context = context;
+    atomic_init(&role->refs, 1);
+    
+    uint64_t periodNs = (uint64_t)entry->executionIntervalMs * 1000000ULL;
+    
+    pthread_mutex_lock(&service->lock);
+    
+    /* Batch with roles of the same period and policy */
+    PeriodicGroup* group = service->groups;
+    while (group && (group->periodNs != periodNs || group->policy != policy)) {
+        group = group->next;
+    }
+    
+    if (!group) {
+        group = (PeriodicGroup*)calloc(1, sizeof(PeriodicGroup));
+        if (!group) {
+            pthread_mutex_unlock(&service->lock);
+            PeriodicRoleRelease(role);
+            return NULL;
+        }
+        group->periodNs = periodNs;
+        group->policy = policy;
+        group->service = service;
+        TimerEntryInit(&group->timer, PeriodicGroupExpired, group);
+        group->next = service->groups;
+        service->groups = group;
+    }
+    
+    role->group = group;
+    role->next = group->roles;
+    group->roles = role;
+    
+    if (!group->scheduled) {
+        group->deadlineNs = GetTimeNanos() + periodNs;
+        group->scheduled = true;
+        TimerWheelSchedule(service->wheel, &group->timer, group->deadlineNs);
+        
+        /* The timer thread may be sleeping past the new deadline */
+        pthread_cond_signal(&service->wake);
+    }
+    
+    pthread_mutex_unlock(&service->lock);
+    return role;
+}
+
+void PeriodicServiceRemove(PeriodicService* service, PeriodicRole* role)
+{
+    if (!service || !role) return;
+    
+    pthread_mutex_lock(&service->lock);
+    
+    PeriodicRole** link = &role->group->roles;
+    while (*link && *link != role) {
+        link = &(*link)->next;
+    }
+    if (*link) {
+        *link = role->next;
+    }
+    
+    pthread_mutex_unlock(&service->lock);
+    
+    /* An in-flight firing keeps the role alive until it finishes */
+    PeriodicRoleRelease(role);
+}
+
+PeriodicRoleStats PeriodicRoleGetStats(PeriodicRole* role)
+{
+    PeriodicRoleStats stats = {0};
+    if (!role) return stats;
+    
+    stats.roleId = role->entry->roleId;
+    stats.firings = atomic_load_explicit(&role->firings, memory_order_relaxed);
+    stats.overruns = atomic_load_explicit(&role->overruns, memory_order_relaxed);
+    stats.skippedPeriods = atomic_load_explicit(&role->skippedPeriods, memory_order_relaxed);
+    stats.maxJitterNs = atomic_load_explicit(&role->maxJitterNs, memory_order_relaxed);
+    if (stats.firings > 0) {
+        stats.avgJitterNs = atomic_load_explicit(&role->totalJitterNs,
+            memory_order_relaxed) / stats.firings;
+    }
+    
+    return stats;
+}
+
+/* ============= Role Batching ============= */
+
+#define ROLE_BATCH_CHUNK            256     /* Instances per chunk job */
+#define ROLE_BATCH_COLUMN_ALIGN     64
+#define BATCH_KERNEL_TABLE_SIZE     256
+
+/* Kernel registry (open addressing on the function pointer, insert-only) */
+static struct {
+    _Atomic(ParallelFunction) functions[BATCH_KERNEL_TABLE_SIZE];
+    RoleBatchKernel kernels[BATCH_KERNEL_TABLE_SIZE];
+    const RoleBatchLayout* layouts[BATCH_KERNEL_TABLE_SIZE];
+    SpinLock writeLock;
+} g_batchKernels;
+
+/* One one-shot entry of one party */
+typedef struct {
+    ParallelFunction function;
+    SchedulerTag tag;
+    SchedulerPriority priority;
+    InternId roleNameId;
+    void* instance;
+    PartyContext* context;
+    FiberResult* result;             /* Slot in the party's result array */
+} BatchItem;
+
+/* A chunk of one (function, tag) group */
+typedef struct {
+    BatchItem* items;
+    size_t count;
+    size_t index;                    /* Latch entry */
+    DispatchLatch* latch;
+} BatchJob;
+
+static size_t BatchKernelSlot(ParallelFunction function)
+{
+    uint64_t hash = (uint64_t)(uintptr_t)function * 0x9E3779B97F4A7C15ULL;
+    return (size_t)(hash >> 56) & (BATCH_KERNEL_TABLE_SIZE - 1);
+}
+
+bool RegisterRoleBatchKernel(
+    ParallelFunction function,
+    RoleBatchKernel kernel,
+    const RoleBatchLayout* layout)
+{
+    if (!function || !kernel) return false;
+    
+    bool registered = false;
+    size_t mask = BATCH_KERNEL_TABLE_SIZE - 1;
+    
+    SpinLockAcquire(&g_batchKernels.writeLock);
+    
+    size_t i = BatchKernelSlot(function);
+    for (size_t probes = 0; probes < BATCH_KERNEL_TABLE_SIZE; probes++, i = (i + 1) & mask) {
+        ParallelFunction key = atomic_load_explicit(&g_batchKernels.functions[i],
+            memory_order_relaxed);
+        if (key == function) break;
+        if (!key) {
+            /* Publish the kernel before the key that makes it visible */
+            g_batchKernels.kernels[i] = kernel;
+            g_batchKernels.layouts[i] = layout;
+            atomic_store_explicit(&g_batchKernels.functions[i], function,
+                memory_order_release);
+            registered = true;
+            break;
+        }
+    }
+    
+    SpinLockRelease(&g_batchKernels.writeLock);
+    return registered;
+}
+
+static RoleBatchKernel FindRoleBatchKernel(ParallelFunction function,
+                                           const RoleBatchLayout** layout)
+{
+    size_t mask = BATCH_KERNEL_TABLE_SIZE - 1;
+    size_t i = BatchKernelSlot(function);
+    
+    for (size_t probes = 0; probes < BATCH_KERNEL_TABLE_SIZE; probes++, i = (i + 1) & mask) {
+        ParallelFunction key = atomic_load_explicit(&g_batchKernels.functions[i],
+            memory_order_acquire);
+        if (!key) break;
+        if (key == function) {
+            *layout = g_batchKernels.layouts[i];
+            return g_batchKernels.kernels[i];
+        }
+    }
+    
+    return NULL;
+}
+
+/* Group by function and tag; address order keeps each chunk's walk sequential */
+static int CompareBatchItems(const void* a, const void* b)
+{
+    const BatchItem* x = (const BatchItem*)a;
+    const BatchItem* y = (const BatchItem*)b;
+    
+    uintptr_t fx = (uintptr_t)x->function;
+    uintptr_t fy = (uintptr_t)y->function;
+    if (fx != fy) return fx < fy ? -1 : 1;
+    if (x->tag != y->tag) return x->tag < y->tag ? -1 : 1;
+    
+    uintptr_t ix = (uintptr_t)x->instance;
+    uintptr_t iy = (uintptr_t)y->instance;
+    if (ix != iy) return ix < iy ? -1 : 1;
+    return 0;
+}
+
+static size_t BatchGroupEnd(const BatchItem* items, size_t count, size_t start)
+{
+    size_t end = start + 1;
+    while (end < count &&
+           items[end].function == items[start].function &&
+           items[end].tag == items[start].tag) {
+        end++;
+    }
+    return end;
+}
+
+/* Hand a chunk to its kernel, gathering SoA columns when a layout is set */
+static bool RunRoleBatchKernel(BatchJob* job, RoleBatchKernel kernel,
+                               const RoleBatchLayout* layout)
+{
+    size_t count = job->count;
+    size_t columnCount = layout ? layout->fieldCount : 0;
+    
+    /* Instance and context arrays, column table, then aligned columns */
+    size_t bytes = count * (sizeof(void*) + sizeof(PartyContext*)) +
+                   columnCount * (sizeof(void*) + ROLE_BATCH_COLUMN_ALIGN);
+    for (size_t f = 0; f < columnCount; f++) {
+        bytes += count * layout->fieldSizes[f];
+    }
+    
+    uint8_t* scratch = (uint8_t*)malloc(bytes);
+    if (!scratch) return false;
+    
+    RoleBatch batch = {0};
+    batch.instances = (void**)scratch;
+    batch.contexts = (PartyContext**)(batch.instances + count);
+    batch.columns = (void**)(batch.contexts + count);
+    batch.count = count;
+    batch.columnCount = columnCount;
+    
+    for (size_t i = 0; i < count; i++) {
+        batch.instances[i] = job->items[i].instance;
+        batch.contexts[i] = job->items[i].context;
+    }
+    
+    /* Evenly spaced instances can be indexed without the pointer array */
+    size_t stride = count > 1 ?
+        (size_t)((uint8_t*)batch.instances[1] - (uint8_t*)batch.instances[0]) : 0;
+    bool even = true;
+    for (size_t i = 2; i < count && even; i++) {
+        even = (size_t)((uint8_t*)batch.instances[i] -
+                        (uint8_t*)batch.instances[i - 1]) == stride;
+    }
+    if (even) {
+        batch.base = (uint8_t*)batch.instances[0];
+        batch.stride = stride;
+    }
+    
+    /* Gather AoS fields into columns */
+    uint8_t* column = (uint8_t*)(batch.columns + columnCount);
+    for (size_t f = 0; f < columnCount; f++) {
+        size_t offset = layout->fieldOffsets[f];
+        size_t size = layout->fieldSizes[f];
+        
+        column = (uint8_t*)(((uintptr_t)column + ROLE_BATCH_COLUMN_ALIGN - 1) &
+                            ~(uintptr_t)(ROLE_BATCH_COLUMN_ALIGN - 1));
+        batch.columns[f] = column;
+        for (size_t i = 0; i < count; i++) {
+            memcpy(column + i * size, (uint8_t*)batch.instances[i] + offset, size);
         }
+        column += count * size;
+    }
+    
+    kernel(&batch);
+    
+    /* Scatter the columns back */
+    for (size_t f = 0; f < columnCount; f++) {
+        size_t offset = layout->fieldOffsets[f];
+        size_t size = layout->fieldSizes[f];
+        uint8_t* data = (uint8_t*)batch.columns[f];
         
-        /* Create fiber based on execution mode */
-        FiberFunction fiberFn = entry->isContinuous ? 
-            PeriodicFiberFunction : OneshotFiberFunction;
+        for (size_t i = 0; i < count; i++) {
+            memcpy((uint8_t*)batch.instances[i] + offset, data + i * size, size);
+        }
+    }
+    
+    free(scratch);
+    return true;
+}
+
+/* Record a chunk's outcome on every item and signal its latch entry */
+static void CompleteBatchJob(BatchJob* job, const FiberResult* result)
+{
+    FiberResult itemResult = *result;
+    
+    /* Amortize the chunk's time over its instances */
+    itemResult.executionTimeNs = result->executionTimeNs / job->count;
+    
+    for (size_t i = 0; i < job->count; i++) {
+        itemResult.roleId = job->items[i].result->roleId;
+        *job->items[i].result = itemResult;
+        UpdateFiberStats(job->items[i].roleNameId, &itemResult);
+    }
+    
+    DispatchLatchSignal(job->latch, job->index, result);
+}
+
+static void RoleBatchJobFunction(void* userData)
+{
+    BatchJob* job = (BatchJob*)userData;
+    BatchItem* items = job->items;
+    uint64_t startTime = GetTimeNanos();
+    
+    FiberResult result = { .roleId = items[0].result->roleId, .success = true };
+    
+    const RoleBatchLayout* layout = NULL;
+    RoleBatchKernel kernel = FindRoleBatchKernel(items[0].function, &layout);
+    
+    if (!kernel) {
+        /* Scalar body: a loop iteration per instance instead of a fiber */
+        for (size_t i = 0; i < job->count; i++) {
+            items[i].function(items[i].instance, items[i].context);
+        }
+    } else if (!RunRoleBatchKernel(job, kernel, layout)) {
+        result.success = false;
+        result.error = "Failed to allocate role batch";
+    }
+    
+    result.executionTimeNs = GetTimeNanos() - startTime;
+    CompleteBatchJob(job, &result);
+}
+
+BatchedDispatchResult DispatchPartiesBatched(
+    const PartyDispatch* parties,
+    size_t partyCount,
+    DispatcherConfig* config)
+{
+    BatchedDispatchResult result = {0};
+    
+    if (!parties || partyCount == 0) return result;
+    
+    uint64_t dispatchStartTime = GetTimeNanos();
+    
+    result.partyResults = (DispatchResult*)calloc(partyCount, sizeof(DispatchResult));
+    if (!result.partyResults) return result;
+    result.partyCount = partyCount;
+    
+    size_t totalEntries = 0;
+    for (size_t p = 0; p < partyCount; p++) {
+        if (parties[p].map) totalEntries += parties[p].map->entryCount;
+    }
+    
+    BatchItem* items = (BatchItem*)calloc(totalEntries ? totalEntries : 1, sizeof(BatchItem));
+    if (!items) {
+        free(result.partyResults);
+        return (BatchedDispatchResult){0};
+    }
+    
+    /* Flatten every party's one-shot entries */
+    size_t itemCount = 0;
+    bool setupFailed = false;
+    
+    for (size_t p = 0; p < partyCount; p++) {
+        FiberMap* map = parties[p].map;
+        DispatchResult* partyResult = &result.partyResults[p];
         
-        fibers[i] = CreateFiber(fiberFn, &wrappers[i], 
-            config ? config->maxMemoryPerFiber : DEFAULT_FIBER_STACK_SIZE);
+        if (!map || !parties[p].context || map->entryCount == 0) continue;
         
-        if (!fibers[i]) {
-            result.results[i].error = "Failed to create fiber";
+        partyResult->results = (FiberResult*)calloc(map->entryCount, sizeof(FiberResult));
+        if (!partyResult->results) {
+            setupFailed = true;
             continue;
         }
+        partyResult->resultCount = map->entryCount;
         
-        /* Schedule with priority */
-        ScheduleFiberWithPriority(scheduler, fibers[i], entry->priority);
-    }
-    
-    /* Wait based on join strategy */
-    bool allSucceeded = true;
-    
-    switch (joinStrategy) {
-        case JOIN_ALL:
-            /* Wait for all fibers to complete */
-            for (size_t i = 0; i < map->entryCount; i++) {
-                if (fibers[i]) {
-                    WaitForFiber(fibers[i]);
-                    if (!result.results[i].success) {
-                        allSucceeded = false;
-                    }
-                }
-            }
-            break;
-            
-        case JOIN_ANY:
-            /* Wait for first to complete */
-            WaitForAnyFiber(fibers, map->entryCount);
-            break;
+        for (size_t i = 0; i < map->entryCount; i++) {
+            FiberMapEntry* entry = &map->entries[i];
+            FiberResult* entryResult = &partyResult->results[i];
+            entryResult->roleId = entry->roleId;
             
-        case JOIN_RACE:
-            /* Wait for first successful */
-            while (true) {
-                size_t completed = WaitForAnyFiber(fibers, map->entryCount);
-                if (result.results[completed].success) {
-                    break;
-                }
-                /* Mark as done to skip in next wait */
-                fibers[completed] = NULL;
+            if (entry->isContinuous) {
+                entryResult->error = "Continuous roles are not batched";
+                setupFailed = true;
+                continue;
             }
-            break;
             
-        case JOIN_MAJORITY:
-            /* Wait for >50% to succeed */
-            size_t successCount = 0;
-            size_t requiredCount = (map->entryCount / 2) + 1;
-            
-            for (size_t i = 0; i < map->entryCount; i++) {
-                if (fibers[i]) {
-                    WaitForFiber(fibers[i]);
-                    if (result.results[i].success) {
-                        successCount++;
-                        if (successCount >= requiredCount) {
-                            break;
-                        }
-                    }
-                }
+            void* roleInstance = GetSlotPointer(entry->instanceSlotId);
+            if (!roleInstance) {
+                entryResult->error = "Failed to load role instance";
+                setupFailed = true;
+                continue;
             }
-            allSucceeded = (successCount >= requiredCount);
-            break;
+            
+            items[itemCount++] = (BatchItem){
+                .function = entry->parallelFn,
+                .tag = entry->schedulerTag,
+                .priority = entry->priority,
+                .roleNameId = EntryRoleNameId(entry),
+                .instance = roleInstance,
+                .context = parties[p].context,
+                .result = entryResult
+            };
+        }
     }
     
-    /* Stop continuous fibers */
-    for (size_t i = 0; i < map->entryCount; i++) {
-        if (map->entries[i].isContinuous) {
-            stopFlags[i] = true;
+    qsort(items, itemCount, sizeof(BatchItem), CompareBatchItems);
+    
+    /* Split each (function, tag) group into chunk jobs */
+    size_t jobCount = 0;
+    for (size_t start = 0; start < itemCount; ) {
+        size_t end = BatchGroupEnd(items, itemCount, start);
+        result.groupCount++;
+        jobCount += (end - start + ROLE_BATCH_CHUNK - 1) / ROLE_BATCH_CHUNK;
+        start = end;
+    }
+    
+    BatchJob* jobs = (BatchJob*)calloc(jobCount ? jobCount : 1, sizeof(BatchJob));
+    FiberResult* jobResults = (FiberResult*)calloc(jobCount ? jobCount : 1, sizeof(FiberResult));
+    DispatchLatch latch;
+    
+    if (!jobs || !jobResults || !DispatchLatchInit(&latch, jobCount)) {
+        for (size_t i = 0; i < itemCount; i++) {
+            items[i].result->error = "Failed to allocate role batch";
         }
+        free(jobs);
+        free(jobResults);
+        free(items);
+        result.totalExecutionTimeNs = GetTimeNanos() - dispatchStartTime;
+        return result;
     }
     
-    /* Final wait for continuous fibers to stop */
-    for (size_t i = 0; i < map->entryCount; i++) {
-        if (fibers[i] && map->entries[i].isContinuous) {
-            WaitForFiber(fibers[i]);
+    DispatchLatchArm(&latch, JOIN_ALL, NULL, jobResults, jobCount);
+    
+    size_t jobIndex = 0;
+    for (size_t start = 0; start < itemCount; ) {
+        size_t end = BatchGroupEnd(items, itemCount, start);
+        
+        for (size_t chunk = start; chunk < end; chunk += ROLE_BATCH_CHUNK) {
+            BatchJob* job = &jobs[jobIndex];
+            job->items = &items[chunk];
+            job->count = end - chunk < ROLE_BATCH_CHUNK ? end - chunk : ROLE_BATCH_CHUNK;
+            job->index = jobIndex;
+            job->latch = &latch;
+            jobIndex++;
         }
+        start = end;
     }
     
-    /* Calculate total execution time */
+    /* One fiber per chunk on the group's scheduler */
+    for (size_t j = 0; j < jobCount; j++) {
+        BatchItem* first = jobs[j].items;
+        FiberScheduler* scheduler = GetSchedulerForTag(first->tag);
+        
+        if (!scheduler || !SchedulerSpawnWithPriority(scheduler, RoleBatchJobFunction,
+                &jobs[j], (uint32_t)first->priority)) {
+            FiberResult failed = { .roleId = first->result->roleId, .success = false,
+                .error = scheduler ? "Failed to create fiber" : "Scheduler not found" };
+            CompleteBatchJob(&jobs[j], &failed);
+        }
+    }
+    
+    result.jobCount = jobCount;
+    bool jobsSucceeded = DispatchLatchWait(&latch, NULL, NULL);
+    
+    /* Every job signals under JOIN_ALL; wait for the last one to leave */
+    DispatchLatchWaitIdle(&latch);
+    DispatchLatchDestroy(&latch);
+    
     result.totalExecutionTimeNs = GetTimeNanos() - dispatchStartTime;
-    result.allSucceeded = allSucceeded;
+    result.allSucceeded = jobsSucceeded && !setupFailed;
     
-    /* Update statistics */
-    for (size_t i = 0; i < map->entryCount; i++) {
-        UpdateFiberStats(result.results[i].roleId, &result.results[i]);
+    for (size_t p = 0; p < partyCount; p++) {
+        DispatchResult* partyResult = &result.partyResults[p];
+        partyResult->allSucceeded = true;
+        partyResult->totalExecutionTimeNs = result.totalExecutionTimeNs;
+        
+        for (size_t i = 0; i < partyResult->resultCount; i++) {
+            if (!partyResult->results[i].success) {
+                partyResult->allSucceeded = false;
+                if (config && config->onFiberError) {
+                    config->onFiberError(partyResult->results[i].roleId,
+                        partyResult->results[i].error);
+                }
+            }
+        }
     }
     
-    /* Cleanup */
-    free(fibers);
-    free(wrappers);
-    free((void*)stopFlags);
+    free(jobs);
+    free(jobResults);
+    free(items);
     
     return result;
 }
 
+void FreeBatchedDispatchResult(BatchedDispatchResult* result)
+{
+    if (!result) return;
+    
+    for (size_t p = 0; p < result->partyCount; p++) {
+        free(result->partyResults[p].results);
+    }
+    
+    free(result->partyResults);
+    memset(result, 0, sizeof(BatchedDispatchResult));
+}
+
 /* ============= Scheduler Management ============= */
 
+static uint32_t DefaultPoolWorkers(SchedulerTag tag)
+{
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpus < 1) cpus = 1;
+    
+    switch (tag) {
+        case SCHEDULER_CPU_FIBER:
+        case SCHEDULER_COMPUTE_THREAD:
+            return (uint32_t)cpus;
+        case SCHEDULER_IO_FIBER:
+        case SCHEDULER_NETWORK_THREAD:
+            /* I/O fibers park on epoll, a couple of workers keep up */
+            return cpus > 1 ? 2 : 1;
+        default:
+            /* Main, GPU submission and background work stay serialized */
+            return 1;
+    }
+}
+
+/* Slow path of GetSchedulerForTag: create and start the tag's pool */
+static FiberScheduler* CreateSchedulerPool(SchedulerTag tag)
+{
+    pthread_mutex_lock(&g_schedulerPoolLock);
+    
+    FiberScheduler* scheduler = atomic_load_explicit(
+        &g_schedulerPools[tag].scheduler, memory_order_relaxed);
+    if (!scheduler) {
+        uint32_t workers = g_schedulerPools[tag].workerCount;
+        SchedulerConfig config = {
+            .numWorkers = workers ? workers : DefaultPoolWorkers(tag),
+            .stackSizeHint = FIBER_STACK_SIZE,
+            .enableWorkStealing = true
+        };
+        
+        scheduler = SchedulerCreate(&config);
+        if (scheduler) {
+            SchedulerStart(scheduler);
+            g_schedulerPools[tag].name = g_schedulerPoolNames[tag];
+            g_schedulerPools[tag].owned = true;
+            atomic_store_explicit(&g_schedulerPools[tag].scheduler, scheduler,
+                memory_order_release);
+        }
+    }
+    
+    pthread_mutex_unlock(&g_schedulerPoolLock);
+    return scheduler;
+}
+
 bool RegisterScheduler(SchedulerTag tag, const char* name, FiberScheduler* scheduler)
 {
-    if (g_schedulerCount >= 16) return false;
+    if ((unsigned)tag >= SCHEDULER_TAG_COUNT || !scheduler) return false;
     
-    g_schedulerRegistry[g_schedulerCount].tag = tag;
-    g_schedulerRegistry[g_schedulerCount].name = strdup(name);
-    g_schedulerRegistry[g_schedulerCount].scheduler = scheduler;
-    g_schedulerCount++;
+    pthread_mutex_lock(&g_schedulerPoolLock);
     
-    return true;
+    /* A tag is bound once; fibers may already be running on its pool */
+    bool registered = atomic_load_explicit(
+        &g_schedulerPools[tag].scheduler, memory_order_relaxed) == NULL;
+    if (registered) {
+        g_schedulerPools[tag].name = strdup(name ? name : g_schedulerPoolNames[tag]);
+        g_schedulerPools[tag].owned = false;
+        atomic_store_explicit(&g_schedulerPools[tag].scheduler, scheduler,
+            memory_order_release);
+    }
+    
+    pthread_mutex_unlock(&g_schedulerPoolLock);
+    return registered;
 }
 
 FiberScheduler* GetSchedulerForTag(SchedulerTag tag)
 {
-    /* Check registered schedulers */
-    for (size_t i = 0; i < g_schedulerCount; i++) {
-        if (g_schedulerRegistry[i].tag == tag) {
-            return g_schedulerRegistry[i].scheduler;
+    if ((unsigned)tag >= SCHEDULER_TAG_COUNT) {
+        tag = SCHEDULER_CPU_FIBER;
+    }
+    
+    FiberScheduler* scheduler = atomic_load_explicit(
+        &g_schedulerPools[tag].scheduler, memory_order_acquire);
+    if (scheduler) return scheduler;
+    
+    /* Unregistered custom tags share the CPU pool */
+    if (tag >= SCHEDULER_CUSTOM_1) {
+        return GetSchedulerForTag(SCHEDULER_CPU_FIBER);
+    }
+    
+    return CreateSchedulerPool(tag);
+}
+
+bool ConfigureSchedulerPools(const SchedulerPoolConfig* config)
+{
+    if (!config) return false;
+    
+    bool applied = true;
+    
+    pthread_mutex_lock(&g_schedulerPoolLock);
+    
+    for (size_t tag = 0; tag < SCHEDULER_TAG_COUNT; tag++) {
+        if (config->workerCounts[tag] == 0) continue;
+        
+        if (atomic_load_explicit(&g_schedulerPools[tag].scheduler, memory_order_relaxed)) {
+            applied = false;
+            continue;
         }
+        g_schedulerPools[tag].workerCount = config->workerCounts[tag];
     }
     
-    /* Return default scheduler based on tag */
-    switch (tag) {
-        case SCHEDULER_MAIN_THREAD:
-            return GetMainThreadScheduler();
-        case SCHEDULER_CPU_FIBER:
-            return GetCPUScheduler();
-        case SCHEDULER_GPU_FIBER:
-            return GetGPUScheduler();
-        case SCHEDULER_IO_FIBER:
-            return GetIOScheduler();
-        case SCHEDULER_BACKGROUND_THREAD:
-            return GetBackgroundScheduler();
-        default:
-            return GetDefaultScheduler();
+    pthread_mutex_unlock(&g_schedulerPoolLock);
+    return applied;
+}
+
+void ShutdownSchedulerPools(void)
+{
+    pthread_mutex_lock(&g_schedulerPoolLock);
+    
+    for (size_t tag = 0; tag < SCHEDULER_TAG_COUNT; tag++) {
+        FiberScheduler* scheduler = atomic_exchange(&g_schedulerPools[tag].scheduler, NULL);
+        if (!scheduler) continue;
+        
+        if (g_schedulerPools[tag].owned) {
+            SchedulerStop(scheduler);
+            SchedulerDestroy(scheduler);
+        } else {
+            free((void*)g_schedulerPools[tag].name);
+        }
+        
+        g_schedulerPools[tag].name = NULL;
+        g_schedulerPools[tag].owned = false;
     }
+    
+    pthread_mutex_unlock(&g_schedulerPoolLock);
+}
+
+bool SchedulerHandoff(
+    SchedulerTag tag,
+    FiberStartRoutine routine,
+    void* arg,
+    SchedulerPriority priority)
+{
+    if (!routine) return false;
+    
+    FiberScheduler* scheduler = GetSchedulerForTag(tag);
+    if (!scheduler) return false;
+    
+    /* Lands on the target pool's run queue; the calling worker moves on */
+    return SchedulerSpawnWithPriority(scheduler, routine, arg, (uint32_t)priority);
 }
 
 /* ============= Statistics ============= */
 
-static void UpdateFiberStats(const char* roleId, FiberResult* result)
+/*
+ * Latency histogram: values below 8 ns get exact buckets, larger ones are
+ * bucketed by most significant bit with 8 linear sub-buckets per power
+ * of two, bounding the percentile error at 12.5%.
+ */
+#define STATS_SUB_BUCKETS     8
+#define STATS_HISTOGRAM_SIZE  (62 * STATS_SUB_BUCKETS)
+
+/* Per-role counters within one shard (single writer, relaxed atomics) */
+typedef struct {
+    _Atomic(uint64_t) executions;
+    _Atomic(uint64_t) totalTimeNs;
+    _Atomic(uint64_t) minTimeNs;
+    _Atomic(uint64_t) maxTimeNs;
+    _Atomic(uint64_t) errors;
+    _Atomic(uint64_t) histogram[STATS_HISTOGRAM_SIZE];
+} RoleStatsBlock;
+
+/* One shard per worker thread; never freed, reused after thread exit */
+typedef struct StatsShard {
+    _Atomic(RoleStatsBlock*) roles[MAX_INTERNED_SLOT_NAMES];
+    atomic_bool inUse;
+    struct StatsShard* next;
+} StatsShard;
+
+static _Atomic(StatsShard*) g_statsShards = NULL;
+static __thread StatsShard* tlsStatsShard = NULL;
+static pthread_key_t g_statsShardKey;
+static pthread_once_t g_statsShardKeyOnce = PTHREAD_ONCE_INIT;
+
+static void StatsReleaseShard(void* arg)
+{
+    atomic_store(&((StatsShard*)arg)->inUse, false);
+}
+
+static void StatsCreateKey(void)
+{
+    pthread_key_create(&g_statsShardKey, StatsReleaseShard);
+}
+
+static StatsShard* StatsAcquireShard(void)
 {
-    /* Find or create stats entry */
-    FiberStats* stats = NULL;
+    if (tlsStatsShard) return tlsStatsShard;
     
-    for (size_t i = 0; i < g_fiberStats.count; i++) {
-        if (strcmp(g_fiberStats.stats[i].roleId, roleId) == 0) {
-            stats = &g_fiberStats.stats[i];
+    pthread_once(&g_statsShardKeyOnce, StatsCreateKey);
+    
+    /* Adopt a shard released by an exited thread (its counts carry over) */
+    StatsShard* shard = NULL;
+    for (StatsShard* s = atomic_load(&g_statsShards); s; s = s->next) {
+        bool expected = false;
+        if (atomic_compare_exchange_strong(&s->inUse, &expected, true)) {
+            shard = s;
             break;
         }
     }
     
-    if (!stats) {
-        /* Create new entry */
-        if (g_fiberStats.count >= g_fiberStats.capacity) {
-            /* Grow array */
-            size_t newCapacity = g_fiberStats.capacity ? g_fiberStats.capacity * 2 : 16;
-            FiberStats* newStats = (FiberStats*)realloc(g_fiberStats.stats, 
-                newCapacity * sizeof(FiberStats));
-            if (!newStats) return;
-            
-            g_fiberStats.stats = newStats;
-            g_fiberStats.capacity = newCapacity;
-        }
+    if (!shard) {
+        shard = (StatsShard*)calloc(1, sizeof(StatsShard));
+        if (!shard) return NULL;
+        atomic_init(&shard->inUse, true);
         
-        stats = &g_fiberStats.stats[g_fiberStats.count++];
-        memset(stats, 0, sizeof(FiberStats));
-        stats->roleId = strdup(roleId);
-        stats->minTimeNs = UINT64_MAX;
+        StatsShard* head = atomic_load(&g_statsShards);
+        do {
+            shard->next = head;
+        } while (!atomic_compare_exchange_weak(&g_statsShards, &head, shard));
     }
     
-    /* Update statistics */
-    stats->totalExecutions++;
-    stats->totalTimeNs += result->executionTimeNs;
+    tlsStatsShard = shard;
+    pthread_setspecific(g_statsShardKey, shard);
+    return shard;
+}
+
+/* Only the owning thread writes, so load + store replaces a locked RMW */
+static inline void StatsAdd(_Atomic(uint64_t)* counter, uint64_t value)
+{
+    atomic_store_explicit(counter,
+        atomic_load_explicit(counter, memory_order_relaxed) + value,
+        memory_order_relaxed);
+}
+
+static size_t StatsBucketIndex(uint64_t ns)
+{
+    if (ns < STATS_SUB_BUCKETS) return (size_t)ns;
+    
+    unsigned msb = 63 - (unsigned)__builtin_clzll(ns);
+    size_t sub = (size_t)(ns >> (msb - 3)) & (STATS_SUB_BUCKETS - 1);
+    return (size_t)(msb - 2) * STATS_SUB_BUCKETS + sub;
+}
+
+/* Midpoint of a bucket's range */
+static uint64_t StatsBucketValue(size_t index)
+{
+    if (index < STATS_SUB_BUCKETS) return index;
+    
+    unsigned msb = (unsigned)(index / STATS_SUB_BUCKETS) + 2;
+    uint64_t sub = index % STATS_SUB_BUCKETS;
+    uint64_t width = 1ULL << (msb - 3);
+    return ((STATS_SUB_BUCKETS + sub) << (msb - 3)) + width / 2;
+}
+
+static void UpdateFiberStats(InternId roleNameId, const FiberResult* result)
+{
+    if (roleNameId == INTERN_ID_NONE || roleNameId >= MAX_INTERNED_SLOT_NAMES) return;
+    
+    StatsShard* shard = StatsAcquireShard();
+    if (!shard) return;
     
-    if (result->executionTimeNs < stats->minTimeNs) {
-        stats->minTimeNs = result->executionTimeNs;
-    }
-    if (result->executionTimeNs > stats->maxTimeNs) {
-        stats->maxTimeNs = result->executionTimeNs;
+    /* Lazily allocate this role's block in the shard */
+    RoleStatsBlock* block = atomic_load_explicit(&shard->roles[roleNameId],
+        memory_order_relaxed);
+    if (!block) {
+        block = (RoleStatsBlock*)calloc(1, sizeof(RoleStatsBlock));
+        if (!block) return;
+        atomic_init(&block->minTimeNs, UINT64_MAX);
+        atomic_store_explicit(&shard->roles[roleNameId], block, memory_order_release);
     }
     
-    stats->avgTimeNs = stats->totalTimeNs / stats->totalExecutions;
+    uint64_t timeNs = result->executionTimeNs;
+    
+    StatsAdd(&block->executions, 1);
+    StatsAdd(&block->totalTimeNs, timeNs);
+    StatsAdd(&block->histogram[StatsBucketIndex(timeNs)], 1);
+    
+    if (timeNs < atomic_load_explicit(&block->minTimeNs, memory_order_relaxed)) {
+        atomic_store_explicit(&block->minTimeNs, timeNs, memory_order_relaxed);
+    }
+    if (timeNs > atomic_load_explicit(&block->maxTimeNs, memory_order_relaxed)) {
+        atomic_store_explicit(&block->maxTimeNs, timeNs, memory_order_relaxed);
+    }
     
     if (!result->success) {
-        stats->errorCount++;
+        StatsAdd(&block->errors, 1);
     }
 }
 
-FiberStats GetFiberStats(const char* roleId)
+/* Smallest bucket value covering the given fraction of samples */
+static uint64_t StatsPercentile(const uint64_t* histogram, uint64_t total, double fraction)
 {
-    FiberStats empty = {0};
+    uint64_t target = (uint64_t)(fraction * (double)total);
+    if (target == 0) target = 1;
+    
+    uint64_t seen = 0;
+    for (size_t i = 0; i < STATS_HISTOGRAM_SIZE; i++) {
+        seen += histogram[i];
+        if (seen >= target) {
+            return StatsBucketValue(i);
+        }
+    }
+    return 0;
+}
+
+void RecordFiberStats(InternId roleNameId, const FiberResult* result)
+{
+    if (!result) return;
+    UpdateFiberStats(roleNameId, result);
+}
+
+FiberStats GetFiberStatsById(InternId roleNameId)
+{
+    FiberStats stats = {0};
+    if (roleNameId == INTERN_ID_NONE || roleNameId >= MAX_INTERNED_SLOT_NAMES) return stats;
+    
+    stats.roleId = GetSlotNameById(roleNameId);
+    stats.minTimeNs = UINT64_MAX;
+    
+    /* Merge every shard's block for this role */
+    uint64_t histogram[STATS_HISTOGRAM_SIZE] = {0};
     
-    for (size_t i = 0; i < g_fiberStats.count; i++) {
-        if (strcmp(g_fiberStats.stats[i].roleId, roleId) == 0) {
-            return g_fiberStats.stats[i];
+    for (StatsShard* shard = atomic_load(&g_statsShards); shard; shard = shard->next) {
+        RoleStatsBlock* block = atomic_load_explicit(&shard->roles[roleNameId],
+            memory_order_acquire);
+        if (!block) continue;
+        
+        stats.totalExecutions += atomic_load_explicit(&block->executions, memory_order_relaxed);
+        stats.totalTimeNs += atomic_load_explicit(&block->totalTimeNs, memory_order_relaxed);
+        stats.errorCount += (uint32_t)atomic_load_explicit(&block->errors, memory_order_relaxed);
+        
+        uint64_t minTime = atomic_load_explicit(&block->minTimeNs, memory_order_relaxed);
+        uint64_t maxTime = atomic_load_explicit(&block->maxTimeNs, memory_order_relaxed);
+        if (minTime < stats.minTimeNs) stats.minTimeNs = minTime;
+        if (maxTime > stats.maxTimeNs) stats.maxTimeNs = maxTime;
+        
+        for (size_t i = 0; i < STATS_HISTOGRAM_SIZE; i++) {
+            histogram[i] += atomic_load_explicit(&block->histogram[i], memory_order_relaxed);
         }
     }
     
-    return empty;
+    if (stats.totalExecutions == 0) {
+        stats.minTimeNs = 0;
+        return stats;
+    }
+    
+    stats.avgTimeNs = stats.totalTimeNs / stats.totalExecutions;
+    
+    /* Shards are read without stopping writers, so use the histogram's own total */
+    uint64_t samples = 0;
+    for (size_t i = 0; i < STATS_HISTOGRAM_SIZE; i++) {
+        samples += histogram[i];
+    }
+    stats.p50TimeNs = StatsPercentile(histogram, samples, 0.50);
+    stats.p99TimeNs = StatsPercentile(histogram, samples, 0.99);
+    stats.p999TimeNs = StatsPercentile(histogram, samples, 0.999);
+    
+    return stats;
+}
+
+FiberStats GetFiberStats(const char* roleId)
+{
+    FiberStats empty = {0};
+    if (!roleId) return empty;
+    
+    return GetFiberStatsById(LookupSlotNameId(roleId));
 }
 
 /* ============= Debugging ============= */
@@ -538,23 +3407,34 @@ FiberStats GetFiberStats(const char* roleId)
 void DumpFiberMaps(void)
 {
     printf("=== Fiber Map Dump ===\n");
-    printf("Registered Schedulers: %zu\n", g_schedulerCount);
+    printf("Scheduler Pools:\n");
     
-    for (size_t i = 0; i < g_schedulerCount; i++) {
-        printf("  [%d] %s -> %p\n", 
-            g_schedulerRegistry[i].tag,
-            g_schedulerRegistry[i].name,
-            g_schedulerRegistry[i].scheduler);
+    for (size_t tag = 0; tag < SCHEDULER_TAG_COUNT; tag++) {
+        FiberScheduler* scheduler = atomic_load(&g_schedulerPools[tag].scheduler);
+        if (!scheduler) continue;
+        
+        printf("  [%zu] %s -> %p (%u workers%s)\n",
+            tag,
+            g_schedulerPools[tag].name,
+            (void*)scheduler,
+            scheduler->numWorkers,
+            g_schedulerPools[tag].owned ? "" : ", registered");
     }
     
     printf("\nFiber Statistics:\n");
-    for (size_t i = 0; i < g_fiberStats.count; i++) {
-        FiberStats* s = &g_fiberStats.stats[i];
-        printf("  Role: %s\n", s->roleId);
-        printf("    Executions: %llu\n", s->totalExecutions);
-        printf("    Avg Time: %llu ns\n", s->avgTimeNs);
-        printf("    Min/Max: %llu / %llu ns\n", s->minTimeNs, s->maxTimeNs);
-        printf("    Errors: %u\n", s->errorCount);
+    for (InternId id = 1; id < MAX_INTERNED_SLOT_NAMES && GetSlotNameById(id); id++) {
+        FiberStats s = GetFiberStatsById(id);
+        if (s.totalExecutions == 0) continue;
+        
+        printf("  Role: %s\n", s.roleId);
+        printf("    Executions: %llu\n", (unsigned long long)s.totalExecutions);
+        printf("    Avg Time: %llu ns\n", (unsigned long long)s.avgTimeNs);
+        printf("    Min/Max: %llu / %llu ns\n",
+            (unsigned long long)s.minTimeNs, (unsigned long long)s.maxTimeNs);
+        printf("    p50/p99/p999: %llu / %llu / %llu ns\n",
+            (unsigned long long)s.p50TimeNs, (unsigned long long)s.p99TimeNs,
+            (unsigned long long)s.p999TimeNs);
+        printf("    Errors: %u\n", s.errorCount);
     }
 }
 
@@ -9,12 +9,16 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdatomic.h>
 #include "../runtime/slot_manager.h"
 #include "../runtime/async/fiber.h"
 #include "../runtime/async/scheduler.h"
 
 /* ============= Scheduler Tags ============= */
 
+/* Party fibers run on the SEA scheduler */
+typedef Scheduler FiberScheduler;
+
 typedef enum {
     SCHEDULER_MAIN_THREAD = 0,      /* UI/Game main thread */
     SCHEDULER_CPU_FIBER,            /* CPU-bound computation */
@@ -29,6 +33,9 @@ typedef enum {
     SCHEDULER_ANY                   /* Let runtime decide */
 } SchedulerTag;
 
+/* Tags with a pool of their own (SCHEDULER_ANY runs on the CPU pool) */
+#define SCHEDULER_TAG_COUNT SCHEDULER_ANY
+
 /* Scheduler priority levels */
 typedef enum {
     PRIORITY_CRITICAL = 100,
@@ -46,6 +53,7 @@ typedef void (*ParallelFunction)(void* roleInstance, void* partyContext);
 /* Single entry in the FiberMap */
 typedef struct {
     const char* roleId;              /* Role slot name (e.g., "tank", "healer") */
+    uint16_t roleNameId;             /* Interned roleId (0 = resolve at dispatch) */
     uint32_t instanceSlotId;         /* Slot ID of the role instance */
     ParallelFunction parallelFn;     /* Function to execute */
     SchedulerTag schedulerTag;       /* Which scheduler to use */
@@ -60,11 +68,73 @@ typedef struct {
     FiberMapEntry* entries;          /* Array of fiber entries */
     size_t entryCount;               /* Number of entries */
     uint64_t cacheKey;               /* For caching compiled fiber maps */
+    struct RoleBinding* bindings;    /* Copy of the bindings it was built from (cache identity) */
+    size_t bindingCount;
     bool isStatic;                   /* true if can be cached at compile time */
+    atomic_uint refs;                /* Heap map owners (0 = static, never freed) */
 } FiberMap;
 
+/*
+ * Resolve an instance slot ID to the role instance (NULL if unbound).
+ * Supplied by the program that owns the slots, normally compiler-emitted.
+ */
+void* GetSlotPointer(uint32_t slotId);
+
+/* ============= Interned Names ============= */
+
+/*
+ * Small integer ID assigned to a role slot, ability or field name. IDs
+ * start at 1 so zero-initialized ID fields read as "not interned".
+ */
+typedef uint16_t InternId;
+
+#define INTERN_ID_NONE          ((InternId)0xFFFF)
+#define MAX_INTERNED_SLOT_NAMES 4096
+#define MAX_INTERNED_FIELD_NAMES 4096
+
+/* Ability membership bitset, one bit per interned ability name */
+#define ABILITY_SET_WORDS       4
+#define MAX_INTERNED_ABILITIES  (ABILITY_SET_WORDS * 64)
+
+typedef struct {
+    uint64_t bits[ABILITY_SET_WORDS];
+} AbilitySet;
+
+static inline void AbilitySetAdd(AbilitySet* set, InternId abilityId)
+{
+    if (abilityId < MAX_INTERNED_ABILITIES) {
+        set->bits[abilityId >> 6] |= 1ULL << (abilityId & 63);
+    }
+}
+
+static inline bool AbilitySetContains(const AbilitySet* set, InternId abilityId)
+{
+    return abilityId < MAX_INTERNED_ABILITIES &&
+        (set->bits[abilityId >> 6] & (1ULL << (abilityId & 63))) != 0;
+}
+
+/* Intern a name, assigning a new ID on first use (INTERN_ID_NONE if full) */
+InternId InternSlotName(const char* slotName);
+InternId InternAbilityName(const char* abilityName);
+InternId InternFieldName(const char* fieldName);
+
+/* Look up an already interned name without taking a lock */
+InternId LookupSlotNameId(const char* slotName);
+InternId LookupAbilityNameId(const char* abilityName);
+InternId LookupFieldNameId(const char* fieldName);
+
+/* Reverse lookup (NULL if the ID was never assigned) */
+const char* GetSlotNameById(InternId slotId);
+const char* GetFieldNameById(InternId fieldId);
+
 /* ============= Party Context ============= */
 
+/* Sentinel for slot/field IDs that are not bound in a context */
+#define ROLE_INDEX_NONE ((uint16_t)0xFFFF)
+
+/* Immutable, versioned snapshot of a context's role and shared-field tables */
+typedef struct PartyContextTable PartyContextTable;
+
 /* Runtime context available to roles via 'context' keyword */
 typedef struct PartyContext {
     /* Role lookup table */
@@ -76,7 +146,7 @@ typedef struct PartyContext {
         size_t abilityCount;
     }* roles;
     size_t roleCount;
-    
+
     /* Shared party data */
     struct {
         const char* fieldName;
@@ -89,8 +159,11 @@ typedef struct PartyContext {
     const char* partyName;
     bool inCombat;                   /* Example shared state */
     
+    /* Published lookup table - readers load it without locking */
+    _Atomic(PartyContextTable*) table;
+    
     /* Synchronization */
-    SpinLock contextLock;            /* For thread-safe access */
+    SpinLock contextLock;            /* Serializes table writers */
 } PartyContext;
 
 /* ============= FiberMap Generation ============= */
@@ -105,39 +178,42 @@ typedef struct {
     bool continuous;
 } RoleParallelMetadata;
 
+/* Binding of a party slot to a role instance and its parallel metadata */
+typedef struct RoleBinding {
+    const char* slotName;
+    uint32_t instanceSlotId;
+    RoleParallelMetadata* metadata;  /* Compile-time constant, keyed by address */
+} RoleBinding;
+
 /* Generate FiberMap from party type and role bindings */
 FiberMap* GenerateFiberMap(
     const char* partyType,
-    const struct {
-        const char* slotName;
-        uint32_t instanceSlotId;
-        RoleParallelMetadata* metadata;
-    }* roleBindings,
+    const RoleBinding* roleBindings,
     size_t bindingCount
 );
 
-/* Free a dynamically generated FiberMap */
+/* Cache key for a party type and binding set (never 0) */
+uint64_t ComputeFiberMapKey(
+    const char* partyType,
+    const RoleBinding* roleBindings,
+    size_t bindingCount
+);
+
+/* Shared map from the FiberMap cache, generated and cached on a miss */
+FiberMap* GenerateFiberMapCached(
+    const char* partyType,
+    const RoleBinding* roleBindings,
+    size_t bindingCount
+);
+
+/* Take another reference on a generated map (no-op for static maps) */
+FiberMap* RetainFiberMap(FiberMap* map);
+
+/* Drop a reference; the map is freed with its last owner */
 void FreeFiberMap(FiberMap* map);
 
 /* ============= Runtime Dispatcher ============= */
 
-/* Dispatcher configuration */
-typedef struct {
-    /* Scheduler pool limits */
-    uint32_t maxCpuFibers;
-    uint32_t maxGpuFibers;
-    uint32_t maxIoFibers;
-    uint32_t maxBackgroundThreads;
-    
-    /* Resource constraints */
-    size_t maxMemoryPerFiber;
-    uint64_t maxExecutionTimeMs;
-    
-    /* Error handling */
-    void (*onFiberError)(const char* roleId, const char* error);
-    void (*onTimeout)(const char* roleId);
-} DispatcherConfig;
-
 /* Dispatch result for join strategies */
 typedef struct {
     const char* roleId;
@@ -163,14 +239,44 @@ typedef bool (*CustomJoinFunction)(
     void* userData
 );
 
+/* Dispatcher configuration */
+typedef struct {
+    /* Scheduler pool limits */
+    uint32_t maxCpuFibers;
+    uint32_t maxGpuFibers;
+    uint32_t maxIoFibers;
+    uint32_t maxBackgroundThreads;
+    
+    /* Resource constraints */
+    size_t maxMemoryPerFiber;
+    uint64_t maxExecutionTimeMs;
+    
+    /* Error handling */
+    void (*onFiberError)(const char* roleId, const char* error);
+    void (*onTimeout)(const char* roleId);
+    
+    /* JOIN_CUSTOM predicate, re-evaluated each time a role finishes */
+    CustomJoinFunction customJoin;
+    void* customJoinUserData;
+} DispatcherConfig;
+
+/* Memory traffic of one dispatch */
+typedef struct {
+    uint32_t heapAllocations;        /* malloc/calloc calls */
+    uint32_t arenaAllocations;       /* Bump allocations from a DispatchArena */
+    size_t arenaBytes;
+} DispatchAllocStats;
+
 /* Main dispatcher function */
 typedef struct {
     FiberResult* results;
     size_t resultCount;
     bool allSucceeded;
     uint64_t totalExecutionTimeNs;
+    DispatchAllocStats allocations;
 } DispatchResult;
 
+/* Caller frees result.results */
 DispatchResult DispatchParallel(
     FiberMap* map,
     PartyContext* context,
@@ -178,7 +284,44 @@ DispatchResult DispatchParallel(
     DispatcherConfig* config
 );
 
-/* Async version that returns immediately */
+/*
+ * Bump arena backing every dispatch-scoped allocation: results, fiber
+ * bookkeeping and formatted error strings. Each DispatchParallelInto
+ * resets it, first waiting for fibers the previous dispatch left behind,
+ * so a frame loop reusing one arena and one DispatchResult stops
+ * allocating once the arena has grown to its working size. Only the
+ * dispatching thread allocates from an arena.
+ */
+typedef struct DispatchArena DispatchArena;
+
+DispatchArena* DispatchArenaCreate(size_t initialBytes);
+void DispatchArenaDestroy(DispatchArena* arena);
+
+/* Release everything allocated since the last reset */
+void DispatchArenaReset(DispatchArena* arena);
+
+/* Zeroed, 16-byte aligned; valid until the next reset */
+void* DispatchArenaAlloc(DispatchArena* arena, size_t size);
+const char* DispatchArenaPrintf(DispatchArena* arena, const char* format, ...);
+
+/* Allocation counts since the last reset */
+void DispatchArenaGetStats(const DispatchArena* arena, DispatchAllocStats* stats);
+
+/* Dispatch into a reused result; result->results lives in the arena */
+bool DispatchParallelInto(
+    FiberMap* map,
+    PartyContext* context,
+    JoinStrategy joinStrategy,
+    DispatcherConfig* config,
+    DispatchArena* arena,
+    DispatchResult* result
+);
+
+/*
+ * Async version that returns immediately. The handle completes when the
+ * join is decided, on the thread of the role that decided it, which then
+ * runs the handle's continuations. Results live on the heap.
+ */
 typedef struct DispatchHandle DispatchHandle;
 
 DispatchHandle* DispatchParallelAsync(
@@ -188,14 +331,282 @@ DispatchHandle* DispatchParallelAsync(
     DispatcherConfig* config
 );
 
-/* Wait for async dispatch to complete */
+/* Run on the completing thread, or right away if the dispatch already completed */
+typedef void (*DispatchCallback)(DispatchHandle* handle, const DispatchResult* result,
+                                 void* userData);
+
+bool DispatchThen(DispatchHandle* handle, DispatchCallback callback, void* userData);
+bool DispatchIsComplete(DispatchHandle* handle);
+
+/*
+ * Wait for async dispatch to complete (timeoutMs 0 = no limit). Once it
+ * has, the caller owns result.results and the handle is released; on
+ * timeout the result is empty and the handle stays valid.
+ */
 DispatchResult WaitForDispatch(DispatchHandle* handle, uint64_t timeoutMs);
 
-/* Cancel running dispatch */
+/* Decide the join as failed now and stop every role still running */
 void CancelDispatch(DispatchHandle* handle);
 
+/* Drop the caller's reference without waiting (results are freed with the handle) */
+void ReleaseDispatch(DispatchHandle* handle);
+
+/* ============= Join Latch ============= */
+
+/*
+ * Completion latch shared by a dispatch and its role fibers. Each fiber
+ * signals its entry once on exit; the join predicate is re-evaluated on
+ * every signal and the waiter wakes the moment it holds. Once the waiter
+ * closes the latch, late signals only update bookkeeping and no longer
+ * write the caller's results.
+ */
+typedef struct DispatchLatch {
+    JoinStrategy strategy;
+    CustomJoinFunction customJoin;
+    void* customJoinUserData;
+    
+    FiberResult* results;            /* Caller's results (may be NULL) */
+    uint8_t* entryState;             /* Per-entry pending/excluded/done */
+    bool ownsEntryState;
+    size_t capacity;
+    size_t count;
+    
+    size_t participants;             /* Entries that count toward the join */
+    size_t completed;
+    size_t succeeded;
+    size_t finished;                 /* Every entry, excluded ones too */
+    
+    bool satisfied;
+    bool outcome;
+    bool closed;
+    
+    /* DispatchReadyFunction, instead of a blocking waiter */
+    void (*onReady)(struct DispatchLatch* latch, void* userData);
+    void* onReadyUserData;
+    
+    pthread_mutex_t mutex;
+    pthread_cond_t changed;
+} DispatchLatch;
+
+/* Called under the latch for each entry still running when the join closes;
+ * it may only flag the entry (no locks, no scheduler calls) */
+typedef void (*DispatchLoserFunction)(size_t index, void* userData);
+
+/* Called once per arming, outside the latch mutex, when the join is decided */
+typedef void (*DispatchReadyFunction)(DispatchLatch* latch, void* userData);
+
+bool DispatchLatchInit(DispatchLatch* latch, size_t capacity);
+void DispatchLatchDestroy(DispatchLatch* latch);
+
+/* Prepare for 'count' entries; the latch must be idle */
+void DispatchLatchArm(
+    DispatchLatch* latch,
+    JoinStrategy strategy,
+    const DispatcherConfig* config,
+    FiberResult* results,
+    size_t count
+);
+
+/* Entry still has to signal but does not count toward the predicate */
+void DispatchLatchExclude(DispatchLatch* latch, size_t index);
+
+void DispatchLatchSignal(
+    DispatchLatch* latch,
+    size_t index,
+    const FiberResult* result
+);
+
+/* Block until the predicate holds, close the latch and return its outcome */
+bool DispatchLatchWait(
+    DispatchLatch* latch,
+    DispatchLoserFunction onLoser,
+    void* userData
+);
+
+/* Block until every entry has signalled */
+void DispatchLatchWaitIdle(DispatchLatch* latch);
+
+/*
+ * Non-blocking completion: 'onReady' fires from the signal that decides
+ * the join, and the hook (or whoever it hands off to) closes the latch.
+ * It stays set across arms.
+ */
+void DispatchLatchSetReady(DispatchLatch* latch, DispatchReadyFunction onReady, void* userData);
+
+/* Evaluate the predicate without blocking; exclusions alone may decide it */
+void DispatchLatchPoll(DispatchLatch* latch);
+
+/* Decide the join now with 'outcome' (e.g. cancellation); false if it already was */
+bool DispatchLatchDecide(DispatchLatch* latch, bool outcome);
+
+/* Close a decided latch, as DispatchLatchWait does once it wakes */
+bool DispatchLatchClose(
+    DispatchLatch* latch,
+    DispatchLoserFunction onLoser,
+    void* userData
+);
+
+/* ============= Resident Dispatch ============= */
+
+/*
+ * Resident dispatch keeps one parked fiber per FiberMap entry alive
+ * between rounds and owns the per-entry result buffer, so a steady-state
+ * round signals the fibers and waits for them without allocating or
+ * creating fibers. Every entry runs its parallel function once per round;
+ * continuous roles get their cadence from the caller's frame loop.
+ * A round returns as soon as its join strategy is satisfied; stragglers
+ * finish in the background and the next round waits for them first.
+ */
+typedef struct ResidentDispatch ResidentDispatch;
+
+/* Create the resident fibers for a map (map, context and config must outlive it) */
+ResidentDispatch* ResidentDispatchCreate(
+    FiberMap* map,
+    PartyContext* context,
+    DispatcherConfig* config
+);
+
+/* Run one round; results point into the dispatch and live until the next round */
+DispatchResult ResidentDispatchRun(
+    ResidentDispatch* dispatch,
+    JoinStrategy joinStrategy
+);
+
+/* Stop the resident fibers and free the dispatch */
+void ResidentDispatchDestroy(ResidentDispatch* dispatch);
+
+/* ============= Periodic Roles ============= */
+
+/*
+ * Timer-wheel driven execution for roles with executionIntervalMs.
+ * Roles fire at fixed-rate deadlines (period drift does not accumulate),
+ * roles sharing an interval and policy share one wakeup, and each firing
+ * runs on a short-lived fiber instead of a fiber parked in a sleep loop.
+ */
+
+/* What to do when a role fires one or more whole periods late */
+typedef enum {
+    PERIODIC_CATCH_UP,               /* Run every missed period back to back */
+    PERIODIC_SKIP,                   /* Drop missed periods, keep the grid */
+    PERIODIC_RESCHEDULE              /* Restart the grid from the late firing */
+} PeriodicCatchUpPolicy;
+
+typedef struct {
+    const char* roleId;
+    uint64_t firings;
+    uint64_t overruns;               /* Previous firing still running */
+    uint64_t skippedPeriods;
+    uint64_t avgJitterNs;            /* Firing time minus deadline */
+    uint64_t maxJitterNs;
+} PeriodicRoleStats;
+
+typedef struct PeriodicService PeriodicService;
+typedef struct PeriodicRole PeriodicRole;
+
+PeriodicService* PeriodicServiceCreate(uint64_t tickNs);
+void PeriodicServiceDestroy(PeriodicService* service);
+
+/* Process-wide service used by DispatchParallel (1 ms tick) */
+PeriodicService* GetPeriodicService(void);
+
+/* Start firing an entry of 'map' every executionIntervalMs; the map is
+ * retained for the role's lifetime, the context must outlive it */
+PeriodicRole* PeriodicServiceAdd(
+    PeriodicService* service,
+    FiberMap* map,
+    FiberMapEntry* entry,
+    void* roleInstance,
+    PartyContext* context,
+    PeriodicCatchUpPolicy policy
+);
+
+/* Stop firing; an in-flight firing completes in the background */
+void PeriodicServiceRemove(PeriodicService* service, PeriodicRole* role);
+
+PeriodicRoleStats PeriodicRoleGetStats(PeriodicRole* role);
+
+/* ============= Role Batching ============= */
+
+/*
+ * Parties dispatched together have their one-shot entries grouped by
+ * parallel function and scheduler tag. Each group runs as a few chunk
+ * jobs that loop over the instances in address order instead of
+ * spawning a fiber per role. A kernel registered for the function
+ * receives a whole chunk at once.
+ */
+typedef struct {
+    void** instances;                /* Sorted by address */
+    PartyContext** contexts;
+    size_t count;
+    
+    /* Set when instances are evenly spaced (e.g. one SlotPool run) */
+    uint8_t* base;
+    size_t stride;
+    
+    /* One column per layout field, gathered before and scattered after */
+    void** columns;
+    size_t columnCount;
+} RoleBatch;
+
+typedef void (*RoleBatchKernel)(RoleBatch* batch);
+
+/* Role fields gathered into SoA columns for the kernel */
+typedef struct {
+    const size_t* fieldOffsets;
+    const size_t* fieldSizes;
+    size_t fieldCount;
+} RoleBatchLayout;
+
+/* Register a batch kernel for a parallel function (layout is kept by reference, may be NULL) */
+bool RegisterRoleBatchKernel(
+    ParallelFunction function,
+    RoleBatchKernel kernel,
+    const RoleBatchLayout* layout
+);
+
+typedef struct {
+    FiberMap* map;
+    PartyContext* context;
+} PartyDispatch;
+
+typedef struct {
+    DispatchResult* partyResults;    /* One per party, in map entry order */
+    size_t partyCount;
+    size_t groupCount;               /* Distinct (function, tag) groups */
+    size_t jobCount;                 /* Chunk jobs spawned */
+    bool allSucceeded;
+    uint64_t totalExecutionTimeNs;
+} BatchedDispatchResult;
+
+/* Run every party's one-shot entries to completion (JOIN_ALL); continuous
+ * entries are not batched and are reported as failed */
+BatchedDispatchResult DispatchPartiesBatched(
+    const PartyDispatch* parties,
+    size_t partyCount,
+    DispatcherConfig* config
+);
+
+void FreeBatchedDispatchResult(BatchedDispatchResult* result);
+
 /* ============= Context API (for roles) ============= */
 
+/*
+ * Intern the context's slot, ability and field names and publish a new
+ * table version built from 'roles' and 'sharedFields'. Called once at
+ * party registration; generated code may instead emit the IDs directly
+ * and call the *ById lookups. Lookups are wait-free; the replaced table
+ * is reclaimed once no reader can still see it.
+ */
+bool PartyContextPublish(PartyContext* context);
+void PartyContextRelease(PartyContext* context);
+
+/* Get role by interned IDs (abilityId may be INTERN_ID_NONE) */
+void* ContextGetRoleById(
+    PartyContext* context,
+    InternId slotId,
+    InternId abilityId
+);
+
 /* Get role by ability - used by 'context.GetRole<Ability>("slot")' */
 void* ContextGetRole(
     PartyContext* context,
@@ -215,12 +626,29 @@ RoleQueryResult ContextFindRoles(
     const char* requiredAbility
 );
 
+RoleQueryResult ContextFindRolesById(
+    PartyContext* context,
+    InternId abilityId
+);
+
 /* Get shared field value */
 void* ContextGetShared(
     PartyContext* context,
     const char* fieldName
 );
 
+void* ContextGetSharedById(
+    PartyContext* context,
+    InternId fieldId
+);
+
+/* Replace a shared field value (publishes a new table version) */
+bool ContextSetShared(
+    PartyContext* context,
+    const char* fieldName,
+    void* value
+);
+
 /* ============= Scheduler Integration ============= */
 
 /* Register custom scheduler */
@@ -233,23 +661,81 @@ bool RegisterScheduler(
 /* Get scheduler for tag */
 FiberScheduler* GetSchedulerForTag(SchedulerTag tag);
 
+/*
+ * Every tag maps to its own pool, created and started on first use with
+ * the configured worker count. A registered scheduler replaces the
+ * built-in pool for its tag. Custom tags share the CPU pool until one is
+ * registered.
+ */
+typedef struct {
+    uint32_t workerCounts[SCHEDULER_TAG_COUNT];  /* 0 = default for the tag */
+} SchedulerPoolConfig;
+
+/* Size pools before first use; false if a configured pool already runs */
+bool ConfigureSchedulerPools(const SchedulerPoolConfig* config);
+
+/* Stop and destroy the runtime-owned pools */
+void ShutdownSchedulerPools(void);
+
+/* Continue on another tag's pool; queues the routine and never blocks */
+bool SchedulerHandoff(
+    SchedulerTag tag,
+    FiberStartRoutine routine,
+    void* arg,
+    SchedulerPriority priority
+);
+
 /* ============= Optimization & Caching ============= */
 
-/* Cache for static FiberMaps */
+/*
+ * Cache for static FiberMaps. Lookups are lock-free; the cache is bounded
+ * and evicts with CLOCK. It holds its own reference on every map, so
+ * GetCachedFiberMap returns a retained map the caller releases with
+ * FreeFiberMap. The key only selects a candidate: a hit must also match
+ * the party type and binding set the map was generated from, and a map
+ * that does not (a key collision) is reported as a miss.
+ */
 typedef struct FiberMapCache FiberMapCache;
 
-/* Global cache instance */
-extern FiberMapCache* g_fiberMapCache;
+/* Global cache instance (created on first use if not initialized) */
+extern _Atomic(FiberMapCache*) g_fiberMapCache;
 
 /* Cache operations */
 void InitializeFiberMapCache(size_t maxEntries);
 void CacheFiberMap(uint64_t key, FiberMap* map);
-FiberMap* GetCachedFiberMap(uint64_t key);
+FiberMap* GetCachedFiberMap(
+    uint64_t key,
+    const char* partyType,
+    const RoleBinding* roleBindings,
+    size_t bindingCount
+);
 void CleanupFiberMapCache(void);
 
+/* Cache statistics */
+typedef struct {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t insertions;
+    uint64_t evictions;
+    size_t entries;
+    size_t maxEntries;
+} FiberMapCacheStats;
+
+void GetFiberMapCacheStats(FiberMapCacheStats* stats);
+
+/* Dispatch a party through the FiberMap cache */
+DispatchResult DispatchParty(
+    const char* partyType,
+    const RoleBinding* roleBindings,
+    size_t bindingCount,
+    PartyContext* context,
+    JoinStrategy joinStrategy,
+    DispatcherConfig* config
+);
+
 /* ============= Debugging & Profiling ============= */
 
-/* Fiber execution statistics */
+/* Fiber execution statistics (percentiles from a log-bucketed histogram) */
 typedef struct {
     const char* roleId;
     uint64_t totalExecutions;
@@ -257,11 +743,18 @@ typedef struct {
     uint64_t minTimeNs;
     uint64_t maxTimeNs;
     uint64_t avgTimeNs;
+    uint64_t p50TimeNs;
+    uint64_t p99TimeNs;
+    uint64_t p999TimeNs;
     uint32_t errorCount;
 } FiberStats;
 
-/* Get statistics for a role */
+/* Get statistics for a role (merged across worker shards on read) */
 FiberStats GetFiberStats(const char* roleId);
+FiberStats GetFiberStatsById(InternId roleNameId);
+
+/* Record one execution into the calling thread's shard (for other executors) */
+void RecordFiberStats(InternId roleNameId, const FiberResult* result);
 
 /* Dump all fiber maps for debugging */
 void DumpFiberMaps(void);
@@ -284,8 +777,10 @@ void EnableFiberTracing(bool enable);
 
 /* Quick dispatcher for simple cases */
 #define DISPATCH_PARTY(party, join) \
-    DispatchParallel( \
-        GenerateFiberMap(#party, party##_bindings, party##_binding_count), \
+    DispatchParty( \
+        #party, \
+        party##_bindings, \
+        party##_binding_count, \
         &party##_context, \
         JOIN_##join, \
         NULL \
@@ -0,0 +1,468 @@
+/*
+ * Copyright (c) 2025 Pergyra Language Project
+ * All rights reserved.
+ *
+ * Security Audit Logger Implementation
+ *
+ * Each recording thread owns a single-producer ring; the writer thread is
+ * the only consumer. Rings are registered on a lock-free list the first
+ * time a thread records into a logger and live until the logger closes.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "security_audit.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <time.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#define SECURITY_AUDIT_CACHE_LINE 64
+
+typedef struct SecurityAuditRing
+{
+    _Alignas(SECURITY_AUDIT_CACHE_LINE) _Atomic uint64_t head;   /* Producer */
+    _Alignas(SECURITY_AUDIT_CACHE_LINE) _Atomic uint64_t tail;   /* Writer */
+    _Atomic uint64_t          dropped;
+    
+    /* Producer-only state */
+    _Alignas(SECURITY_AUDIT_CACHE_LINE) uint32_t sampleCount[SECURITY_AUDIT_EVENT_COUNT];
+    pthread_t                 owner;
+    uint16_t                  index;
+    
+    struct SecurityAuditRing *next;
+    SecurityAuditEntry       *entries;
+} SecurityAuditRing;
+
+struct SecurityAuditLogger
+{
+    int                        fd;
+    uint64_t                   id;
+    size_t                     ringCapacity;      /* Power of two */
+    uint32_t                   flushIntervalMs;
+    _Atomic uint32_t           sampleEvery[SECURITY_AUDIT_EVENT_COUNT];
+    
+    _Atomic(SecurityAuditRing *) rings;
+    _Atomic uint32_t           ringCount;
+    _Atomic uint64_t           written;
+    _Atomic uint64_t           unregisteredDrops; /* Ring allocation failed */
+    
+    pthread_t                  writer;
+    pthread_mutex_t            mutex;
+    pthread_cond_t             wake;
+    bool                       stopping;
+};
+
+static _Atomic uint64_t g_nextLoggerId = 1;
+
+/*
+ * The calling thread's ring for the logger it recorded into last
+ */
+static __thread uint64_t           tlsLoggerId = 0;
+static __thread SecurityAuditRing *tlsRing = NULL;
+
+/*
+ * Event metadata
+ */
+static const struct
+{
+    const char *name;
+    bool        routine;           /* Success path; sampled and never echoed */
+} g_auditEvents[SECURITY_AUDIT_EVENT_COUNT] = {
+    [SECURITY_AUDIT_SECURE_CLAIM]         = { "SECURE_CLAIM_SUCCESS", true },
+    [SECURITY_AUDIT_SECURE_READ]          = { "SECURE_READ_SUCCESS", true },
+    [SECURITY_AUDIT_SECURE_WRITE]         = { "SECURE_WRITE_SUCCESS", true },
+    [SECURITY_AUDIT_SECURE_RELEASE]       = { "SECURE_RELEASE_SUCCESS", true },
+    [SECURITY_AUDIT_TOKEN_REFRESHED]      = { "TOKEN_REFRESHED", true },
+    [SECURITY_AUDIT_TOKEN_REVOKED]        = { "TOKEN_REVOKED", false },
+    [SECURITY_AUDIT_READ_DENIED]          = { "READ_PERMISSION_DENIED", false },
+    [SECURITY_AUDIT_WRITE_DENIED]         = { "WRITE_PERMISSION_DENIED", false },
+    [SECURITY_AUDIT_TOKEN_INVALID]        = { "TOKEN_VALIDATION_FAILED", false },
+    [SECURITY_AUDIT_RELEASE_DENIED]       = { "RELEASE_TOKEN_VALIDATION_FAILED", false },
+    [SECURITY_AUDIT_ANOMALY_VIOLATIONS]   = { "ANOMALY_EXCESSIVE_VIOLATIONS", false },
+    [SECURITY_AUDIT_ANOMALY_RAPID_ACCESS] = { "ANOMALY_RAPID_ACCESS", false },
+    [SECURITY_AUDIT_ANOMALY_STALE_SLOT]   = { "ANOMALY_STALE_SLOT", false },
+    [SECURITY_AUDIT_PAYLOAD_REJECTED]     = { "PAYLOAD_AUTHENTICATION_FAILED", false },
+};
+
+const char *
+SecurityAuditEventName(SecurityAuditEvent event)
+{
+    if ((unsigned)event >= SECURITY_AUDIT_EVENT_COUNT ||
+        g_auditEvents[event].name == NULL)
+        return "UNKNOWN";
+    
+    return g_auditEvents[event].name;
+}
+
+bool
+SecurityAuditEventIsRoutine(SecurityAuditEvent event)
+{
+    if ((unsigned)event >= SECURITY_AUDIT_EVENT_COUNT)
+        return false;
+    
+    return g_auditEvents[event].routine;
+}
+
+/*
+ * Timestamps
+ */
+static inline uint64_t
+SecurityAuditTicks(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+static uint64_t
+SecurityAuditClockNs(clockid_t clock)
+{
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/*
+ * Measure the tick rate against CLOCK_MONOTONIC so the decoder can turn
+ * entry timestamps into wall time
+ */
+static uint64_t
+SecurityAuditCalibrate(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    uint64_t startNs = SecurityAuditClockNs(CLOCK_MONOTONIC);
+    uint64_t startTicks = SecurityAuditTicks();
+    
+    struct timespec pause = { 0, 10 * 1000000L };
+    while (nanosleep(&pause, &pause) != 0 && errno == EINTR)
+        ;
+    
+    uint64_t elapsedTicks = SecurityAuditTicks() - startTicks;
+    uint64_t elapsedNs = SecurityAuditClockNs(CLOCK_MONOTONIC) - startNs;
+    if (elapsedNs == 0)
+        return 1000000000ULL;
+    
+    return (uint64_t)((double)elapsedTicks * 1e9 / (double)elapsedNs);
+#else
+    return 1000000000ULL;
+#endif
+}
+
+/*
+ * File output
+ */
+static bool
+SecurityAuditWriteAll(int fd, const void *data, size_t size)
+{
+    const uint8_t *bytes = data;
+    
+    while (size > 0) {
+        ssize_t written = write(fd, bytes, size);
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        bytes += written;
+        size -= (size_t)written;
+    }
+    
+    return true;
+}
+
+/*
+ * Move everything currently published in each ring to the file
+ */
+static void
+SecurityAuditDrain(SecurityAuditLogger *logger)
+{
+    size_t mask = logger->ringCapacity - 1;
+    
+    for (SecurityAuditRing *ring = atomic_load_explicit(&logger->rings, memory_order_acquire);
+         ring != NULL; ring = ring->next) {
+        uint64_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+        uint64_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    
+        while (tail != head) {
+            size_t offset = (size_t)(tail & mask);
+            size_t count = (size_t)(head - tail);
+            if (count > logger->ringCapacity - offset)
+                count = logger->ringCapacity - offset;
+    
+            if (SecurityAuditWriteAll(logger->fd, &ring->entries[offset],
+                                      count * sizeof(SecurityAuditEntry)))
+                atomic_fetch_add_explicit(&logger->written, count, memory_order_relaxed);
+            else
+                atomic_fetch_add_explicit(&ring->dropped, count, memory_order_relaxed);
+    
+            tail += count;
+            atomic_store_explicit(&ring->tail, tail, memory_order_release);
+        }
+    }
+}
+
+static void *
+SecurityAuditWriterThread(void *arg)
+{
+    SecurityAuditLogger *logger = arg;
+    
+    pthread_mutex_lock(&logger->mutex);
+    while (!logger->stopping) {
+        struct timespec deadline;
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_sec += logger->flushIntervalMs / 1000;
+        deadline.tv_nsec += (long)(logger->flushIntervalMs % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+    
+        pthread_cond_timedwait(&logger->wake, &logger->mutex, &deadline);
+    
+        pthread_mutex_unlock(&logger->mutex);
+        SecurityAuditDrain(logger);
+        pthread_mutex_lock(&logger->mutex);
+    }
+    pthread_mutex_unlock(&logger->mutex);
+    
+    /* Final drain; producers have stopped */
+    SecurityAuditDrain(logger);
+    
+    return NULL;
+}
+
+/*
+ * Logger lifecycle
+ */
+SecurityAuditLogger *
+SecurityAuditLoggerOpen(const char *path, const SecurityAuditConfig *config)
+{
+    if (path == NULL)
+        return NULL;
+    
+    SecurityAuditLogger *logger = calloc(1, sizeof(SecurityAuditLogger));
+    if (logger == NULL)
+        return NULL;
+    
+    size_t capacity = config != NULL && config->ringCapacity > 0 ?
+                      config->ringCapacity : SECURITY_AUDIT_RING_CAPACITY;
+    logger->ringCapacity = 1;
+    while (logger->ringCapacity < capacity)
+        logger->ringCapacity <<= 1;
+    
+    logger->flushIntervalMs = config != NULL && config->flushIntervalMs > 0 ?
+                              config->flushIntervalMs : SECURITY_AUDIT_FLUSH_MS;
+    
+    for (int i = 0; i < SECURITY_AUDIT_EVENT_COUNT; i++) {
+        uint32_t every = config != NULL && config->sampleEvery[i] > 0 ?
+                         config->sampleEvery[i] : 1;
+        atomic_init(&logger->sampleEvery[i], every);
+    }
+    
+    atomic_init(&logger->rings, NULL);
+    atomic_init(&logger->ringCount, 0);
+    atomic_init(&logger->written, 0);
+    atomic_init(&logger->unregisteredDrops, 0);
+    logger->id = atomic_fetch_add(&g_nextLoggerId, 1);
+    
+    logger->fd = open(path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0600);
+    if (logger->fd < 0) {
+        free(logger);
+        return NULL;
+    }
+    
+    /* Session header */
+    SecurityAuditHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = SECURITY_AUDIT_MAGIC;
+    header.version = SECURITY_AUDIT_VERSION;
+    header.entrySize = sizeof(SecurityAuditEntry);
+    header.ticksPerSecond = SecurityAuditCalibrate();
+    header.startTicks = SecurityAuditTicks();
+    header.startRealtimeNs = SecurityAuditClockNs(CLOCK_REALTIME);
+    
+    if (!SecurityAuditWriteAll(logger->fd, &header, sizeof(header))) {
+        close(logger->fd);
+        free(logger);
+        return NULL;
+    }
+    
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&logger->wake, &attr);
+    pthread_condattr_destroy(&attr);
+    pthread_mutex_init(&logger->mutex, NULL);
+    
+    if (pthread_create(&logger->writer, NULL, SecurityAuditWriterThread, logger) != 0) {
+        pthread_cond_destroy(&logger->wake);
+        pthread_mutex_destroy(&logger->mutex);
+        close(logger->fd);
+        free(logger);
+        return NULL;
+    }
+    
+    return logger;
+}
+
+void
+SecurityAuditLoggerClose(SecurityAuditLogger *logger)
+{
+    if (logger == NULL)
+        return;
+    
+    pthread_mutex_lock(&logger->mutex);
+    logger->stopping = true;
+    pthread_cond_signal(&logger->wake);
+    pthread_mutex_unlock(&logger->mutex);
+    
+    pthread_join(logger->writer, NULL);
+    
+    fsync(logger->fd);
+    close(logger->fd);
+    
+    SecurityAuditRing *ring = atomic_load(&logger->rings);
+    while (ring != NULL) {
+        SecurityAuditRing *next = ring->next;
+        free(ring->entries);
+        free(ring);
+        ring = next;
+    }
+    
+    pthread_cond_destroy(&logger->wake);
+    pthread_mutex_destroy(&logger->mutex);
+    free(logger);
+}
+
+/*
+ * Find or register the calling thread's ring. Only runs when a thread
+ * first records into a logger, or switches between loggers.
+ */
+static SecurityAuditRing *
+SecurityAuditRingForThread(SecurityAuditLogger *logger)
+{
+    if (tlsLoggerId == logger->id)
+        return tlsRing;
+    
+    pthread_t self = pthread_self();
+    SecurityAuditRing *ring;
+    
+    for (ring = atomic_load_explicit(&logger->rings, memory_order_acquire);
+         ring != NULL; ring = ring->next) {
+        if (pthread_equal(ring->owner, self))
+            break;
+    }
+    
+    if (ring == NULL) {
+        ring = aligned_alloc(SECURITY_AUDIT_CACHE_LINE, sizeof(SecurityAuditRing));
+        if (ring == NULL)
+            return NULL;
+    
+        memset(ring, 0, sizeof(SecurityAuditRing));
+        ring->entries = malloc(logger->ringCapacity * sizeof(SecurityAuditEntry));
+        if (ring->entries == NULL) {
+            free(ring);
+            return NULL;
+        }
+    
+        atomic_init(&ring->head, 0);
+        atomic_init(&ring->tail, 0);
+        atomic_init(&ring->dropped, 0);
+        ring->owner = self;
+        ring->index = (uint16_t)atomic_fetch_add(&logger->ringCount, 1);
+    
+        SecurityAuditRing *first = atomic_load_explicit(&logger->rings, memory_order_relaxed);
+        do {
+            ring->next = first;
+        } while (!atomic_compare_exchange_weak_explicit(&logger->rings, &first, ring,
+                                                        memory_order_release,
+                                                        memory_order_relaxed));
+    }
+    
+    tlsLoggerId = logger->id;
+    tlsRing = ring;
+    
+    return ring;
+}
+
+void
+SecurityAuditLoggerRecord(SecurityAuditLogger *logger, SecurityAuditEvent event,
+                          uint32_t slotId)
+{
+    if (logger == NULL || (unsigned)event >= SECURITY_AUDIT_EVENT_COUNT)
+        return;
+    
+    uint32_t every = atomic_load_explicit(&logger->sampleEvery[event], memory_order_relaxed);
+    
+    SecurityAuditRing *ring = SecurityAuditRingForThread(logger);
+    if (ring == NULL) {
+        atomic_fetch_add_explicit(&logger->unregisteredDrops, 1, memory_order_relaxed);
+        return;
+    }
+    
+    if (every > 1 && ++ring->sampleCount[event] % every != 0)
+        return;
+    
+    uint64_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    uint64_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    if (head - tail >= logger->ringCapacity) {
+        atomic_fetch_add_explicit(&ring->dropped, 1, memory_order_relaxed);
+        return;
+    }
+    
+    SecurityAuditEntry *entry = &ring->entries[head & (logger->ringCapacity - 1)];
+    entry->timestamp = SecurityAuditTicks();
+    entry->slotId = slotId;
+    entry->event = (uint16_t)event;
+    entry->ring = ring->index;
+    
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+}
+
+void
+SecurityAuditLoggerSetSampling(SecurityAuditLogger *logger, SecurityAuditEvent event,
+                               uint32_t every)
+{
+    if (logger == NULL || (unsigned)event >= SECURITY_AUDIT_EVENT_COUNT)
+        return;
+    
+    /* Same meaning as in SecurityAuditConfig: 0 keeps every occurrence */
+    atomic_store_explicit(&logger->sampleEvery[event], every > 0 ? every : 1,
+                          memory_order_relaxed);
+}
+
+uint64_t
+SecurityAuditLoggerDropped(const SecurityAuditLogger *logger)
+{
+    if (logger == NULL)
+        return 0;
+    
+    uint64_t dropped = atomic_load_explicit(&logger->unregisteredDrops, memory_order_relaxed);
+    for (SecurityAuditRing *ring = atomic_load_explicit(&logger->rings, memory_order_acquire);
+         ring != NULL; ring = ring->next)
+        dropped += atomic_load_explicit(&ring->dropped, memory_order_relaxed);
+    
+    return dropped;
+}
+
+uint64_t
+SecurityAuditLoggerWritten(const SecurityAuditLogger *logger)
+{
+    if (logger == NULL)
+        return 0;
+    
+    return atomic_load_explicit(&logger->written, memory_order_relaxed);
+}
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2025 Pergyra Language Project
+ * All rights reserved.
+ *
+ * Security Audit Logger - Binary, ring-buffered audit trail
+ *
+ * Secure slot operations record fixed-size binary entries into a
+ * per-thread lock-free ring. A background writer drains the rings to an
+ * append-only file, and audit_decode formats it offline. Recording an
+ * event never takes a lock and never performs I/O; when a ring is full
+ * the entry is dropped and counted.
+ */
+
+#ifndef PERGYRA_SECURITY_AUDIT_H
+#define PERGYRA_SECURITY_AUDIT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+ * Audit event identifiers (stable; they are stored in audit files)
+ */
+typedef enum
+{
+    SECURITY_AUDIT_SECURE_CLAIM = 1,
+    SECURITY_AUDIT_SECURE_READ,
+    SECURITY_AUDIT_SECURE_WRITE,
+    SECURITY_AUDIT_SECURE_RELEASE,
+    SECURITY_AUDIT_TOKEN_REFRESHED,
+    SECURITY_AUDIT_TOKEN_REVOKED,
+    SECURITY_AUDIT_READ_DENIED,
+    SECURITY_AUDIT_WRITE_DENIED,
+    SECURITY_AUDIT_TOKEN_INVALID,
+    SECURITY_AUDIT_RELEASE_DENIED,
+    SECURITY_AUDIT_ANOMALY_VIOLATIONS,
+    SECURITY_AUDIT_ANOMALY_RAPID_ACCESS,
+    SECURITY_AUDIT_ANOMALY_STALE_SLOT,
+    SECURITY_AUDIT_PAYLOAD_REJECTED,
+    SECURITY_AUDIT_EVENT_COUNT
+} SecurityAuditEvent;
+
+/*
+ * On-disk entry (16 bytes, host byte order)
+ */
+typedef struct
+{
+    uint64_t timestamp;            /* Raw TSC (see SecurityAuditHeader) */
+    uint32_t slotId;               /* Slot concerned (0 = manager-wide) */
+    uint16_t event;                /* SecurityAuditEvent */
+    uint16_t ring;                 /* Recording thread's ring index */
+} SecurityAuditEntry;
+
+/*
+ * Session header, written each time a file is opened for appending.
+ * The magic occupies the timestamp position of an entry, so a decoder
+ * reading 16-byte units can tell headers and entries apart.
+ */
+#define SECURITY_AUDIT_MAGIC   0x5449445541594750ULL  /* "PGYAUDIT" */
+#define SECURITY_AUDIT_VERSION 1
+
+typedef struct
+{
+    uint64_t magic;
+    uint32_t version;
+    uint32_t entrySize;
+    uint64_t startTicks;           /* TSC at session start */
+    uint64_t startRealtimeNs;      /* CLOCK_REALTIME at startTicks */
+    uint64_t ticksPerSecond;       /* Calibrated TSC frequency */
+    uint64_t reserved;
+} SecurityAuditHeader;
+
+/*
+ * Logger configuration
+ */
+typedef struct
+{
+    size_t   ringCapacity;         /* Entries per thread (rounded to a power of two) */
+    uint32_t flushIntervalMs;      /* Writer wake-up period */
+    uint32_t sampleEvery[SECURITY_AUDIT_EVENT_COUNT];  /* 0 = every occurrence, as 1 */
+} SecurityAuditConfig;
+
+#ifndef SECURITY_AUDIT_RING_CAPACITY
+#define SECURITY_AUDIT_RING_CAPACITY 4096
+#endif
+
+#ifndef SECURITY_AUDIT_FLUSH_MS
+#define SECURITY_AUDIT_FLUSH_MS 100
+#endif
+
+typedef struct SecurityAuditLogger SecurityAuditLogger;
+
+/*
+ * Logger lifecycle. Close stops the writer, drains every ring and closes
+ * the file; no thread may record into the logger once Close has begun.
+ */
+SecurityAuditLogger *SecurityAuditLoggerOpen(const char *path,
+                                             const SecurityAuditConfig *config);
+void                 SecurityAuditLoggerClose(SecurityAuditLogger *logger);
+
+/*
+ * Record an event from the calling thread. Lock-free, and allocation-free
+ * after the thread's first record into this logger: that one allocates
+ * the thread's ring and links it in with a CAS loop.
+ */
+void     SecurityAuditLoggerRecord(SecurityAuditLogger *logger,
+                                   SecurityAuditEvent event, uint32_t slotId);
+
+/*
+ * Keep one in every `every` occurrences of an event per thread
+ * (0 or 1 = all, as in SecurityAuditConfig)
+ */
+void     SecurityAuditLoggerSetSampling(SecurityAuditLogger *logger,
+                                        SecurityAuditEvent event, uint32_t every);
+
+/*
+ * Entries dropped because a ring was full, and entries written so far
+ */
+uint64_t SecurityAuditLoggerDropped(const SecurityAuditLogger *logger);
+uint64_t SecurityAuditLoggerWritten(const SecurityAuditLogger *logger);
+
+/*
+ * Event metadata
+ */
+const char *SecurityAuditEventName(SecurityAuditEvent event);
+bool        SecurityAuditEventIsRoutine(SecurityAuditEvent event);
+
+#endif /* PERGYRA_SECURITY_AUDIT_H */
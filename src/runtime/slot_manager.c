@@ -54,13 +54,17 @@ typedef struct
     size_t          totalBlocks;
     bool           *freeBlocks;
     pthread_mutex_t mutex;
+    
+    /* NULL when poolStart came from aligned_alloc */
+    SlotPoolRegionRelease releaseRegion;
 } MemoryPool;
 
 /*
- * Create a new slot manager instance
+ * Create a slot manager over the given block storage (internal function)
  */
-SlotManager *
-SlotManagerCreate(size_t maxSlots, size_t memoryPoolSize)
+static SlotManager *
+SlotManagerCreateWithPool(size_t maxSlots, void *poolStart, size_t memoryPoolSize,
+                          SlotPoolRegionRelease release)
 {
     SlotManager *manager;
     MemoryPool  *pool;
@@ -91,14 +95,11 @@ SlotManagerCreate(size_t maxSlots, size_t memoryPoolSize)
     pool->poolSize = memoryPoolSize;
     pool->blockSize = 64; /* 64-byte blocks */
     pool->totalBlocks = memoryPoolSize / pool->blockSize;
-    pool->poolStart = aligned_alloc(64, memoryPoolSize); /* 64-byte aligned */
+    pool->poolStart = poolStart;
+    pool->releaseRegion = release;
     pool->freeBlocks = calloc(pool->totalBlocks, sizeof(bool));
     
-    if (pool->poolStart == NULL || pool->freeBlocks == NULL) {
-        if (pool->poolStart != NULL)
-            free(pool->poolStart);
-        if (pool->freeBlocks != NULL)
-            free(pool->freeBlocks);
+    if (pool->freeBlocks == NULL) {
         free(pool);
         free(manager->slotTable);
         free(manager);
@@ -118,6 +119,51 @@ SlotManagerCreate(size_t maxSlots, size_t memoryPoolSize)
     manager->activeSlots = 0;
     manager->cacheHits = 0;
     manager->cacheMisses = 0;
+    manager->auditLogger = NULL;
+    
+    return manager;
+}
+
+/*
+ * Create a new slot manager instance
+ */
+SlotManager *
+SlotManagerCreate(size_t maxSlots, size_t memoryPoolSize)
+{
+    SlotManager *manager;
+    void        *poolStart;
+    
+    poolStart = aligned_alloc(64, memoryPoolSize); /* 64-byte aligned */
+    if (poolStart == NULL)
+        return NULL;
+    
+    manager = SlotManagerCreateWithPool(maxSlots, poolStart, memoryPoolSize, NULL);
+    if (manager == NULL)
+        free(poolStart);
+    
+    return manager;
+}
+
+/*
+ * Create a slot manager that adopts existing block storage
+ */
+SlotManager *
+SlotManagerCreateFromRegion(size_t maxSlots, void *base, size_t size,
+                            const bool *usedBlocks, SlotPoolRegionRelease release)
+{
+    SlotManager *manager;
+    MemoryPool  *pool;
+    
+    if (base == NULL || ((uintptr_t)base & 63) != 0)
+        return NULL;
+    
+    manager = SlotManagerCreateWithPool(maxSlots, base, size, release);
+    if (manager == NULL)
+        return NULL;
+    
+    pool = (MemoryPool *)manager->memoryPool;
+    if (usedBlocks != NULL)
+        memcpy(pool->freeBlocks, usedBlocks, pool->totalBlocks * sizeof(bool));
     
     return manager;
 }
@@ -137,7 +183,9 @@ SlotManagerDestroy(SlotManager *manager)
     if (manager->memoryPool != NULL) {
         pool = (MemoryPool *)manager->memoryPool;
         pthread_mutex_destroy(&pool->mutex);
-        if (pool->poolStart != NULL)
+        if (pool->releaseRegion != NULL)
+            pool->releaseRegion(pool->poolStart, pool->poolSize);
+        else if (pool->poolStart != NULL)
             free(pool->poolStart);
         if (pool->freeBlocks != NULL)
             free(pool->freeBlocks);
@@ -235,6 +283,21 @@ DeallocateMemoryBlock(SlotManager *manager, void *ptr, size_t size)
     pthread_mutex_unlock(&pool->mutex);
 }
 
+/*
+ * Pool bytes held by a slot's data block. Encrypted slots also store the
+ * nonce and tag, whether or not security is still enabled on them.
+ */
+static size_t
+SlotEntryBlockSize(const SlotEntry *entry)
+{
+    size_t size = TypeGetSize(entry->typeTag);
+    
+    if (entry->securityLevel == SECURITY_LEVEL_ENCRYPTED)
+        size += SECURITY_PAYLOAD_OVERHEAD;
+    
+    return size;
+}
+
 /*
  * Claim a new slot (C implementation for general case)
  */
@@ -247,9 +310,11 @@ SlotClaim(SlotManager *manager, TypeTag type, SlotHandle *handle)
     if (manager == NULL || handle == NULL)
         return SLOT_ERROR_INVALID_HANDLE;
     
+#ifndef PERGYRA_NO_SLOT_ASM
     /* Use assembly optimized version for simple types */
     if (type <= TYPE_CUSTOM)
         return SlotClaimFast(manager, type, handle);
+#endif
     
     pthread_mutex_lock((pthread_mutex_t *)manager->mutex);
     
@@ -298,9 +363,11 @@ SlotWrite(SlotManager *manager, const SlotHandle *handle,
     if (manager == NULL || handle == NULL || data == NULL)
         return SLOT_ERROR_INVALID_HANDLE;
     
+#ifndef PERGYRA_NO_SLOT_ASM
     /* Use assembly version for simple types */
     if (dataSize <= 256 && handle->typeTag <= TYPE_CUSTOM)
         return SlotWriteFast(manager, handle, data, dataSize);
+#endif
     
     pthread_mutex_lock((pthread_mutex_t *)manager->mutex);
     
@@ -419,7 +486,7 @@ SlotRelease(SlotManager *manager, const SlotHandle *handle)
         if (entry->slotId == handle->slotId && entry->occupied) {
             /* Free memory block */
             if (entry->dataBlockRef != NULL) {
-                blockSize = TypeGetSize(entry->typeTag);
+                blockSize = SlotEntryBlockSize(entry);
                 DeallocateMemoryBlock(manager, entry->dataBlockRef, blockSize);
             }
             
@@ -478,6 +545,26 @@ SlotManagerGetUtilization(const SlotManager *manager)
     return (double)manager->activeSlots / (double)manager->tableSize;
 }
 
+/*
+ * Describe the memory pool backing slot data blocks
+ */
+bool
+SlotManagerGetPoolRegion(const SlotManager *manager, SlotPoolRegion *region)
+{
+    MemoryPool *pool;
+    
+    if (manager == NULL || manager->memoryPool == NULL || region == NULL)
+        return false;
+    
+    pool = (MemoryPool *)manager->memoryPool;
+    region->base = pool->poolStart;
+    region->size = pool->poolSize;
+    region->blockSize = pool->blockSize;
+    region->usedBlocks = pool->freeBlocks;  /* true = in use */
+    region->blockCount = pool->totalBlocks;
+    return true;
+}
+
 /*
  * Get type size in bytes
  */
@@ -561,37 +648,620 @@ static inline void
 SlotMemoryBarrier(void)
 {
     SlotMemoryBarrierAsm();
-}                                   handle->slotId, "Token lacks read permission");
+}
+
+/*
+ * ==================================================================
+ * SECURITY MANAGEMENT
+ * ==================================================================
+ */
+
+/*
+ * Enable token-based access control for subsequently claimed slots
+ */
+SlotError
+SlotManagerEnableSecurity(SlotManager *manager, SecurityLevel level)
+{
+    if (manager == NULL)
+        return SLOT_ERROR_INVALID_HANDLE;
+    
+    if (manager->securityContext == NULL) {
+        manager->securityContext = SecurityContextCreate(level);
+        if (manager->securityContext == NULL)
+            return SLOT_ERROR_OUT_OF_MEMORY;
+    }
+    
+    manager->defaultSecurityLevel = level;
+    manager->securityEnabled = true;
+    
+    return SLOT_SUCCESS;
+}
+
+/*
+ * Disable security and wipe every stored token. Encrypted payloads cannot
+ * outlive their key, so those blocks are wiped as well.
+ */
+SlotError
+SlotManagerDisableSecurity(SlotManager *manager)
+{
+    if (manager == NULL)
+        return SLOT_ERROR_INVALID_HANDLE;
+    
+    for (size_t i = 0; i < manager->tableSize; i++) {
+        SlotEntry *entry = &manager->slotTable[i];
+        if (entry->securityEnabled) {
+            if (entry->securityLevel == SECURITY_LEVEL_ENCRYPTED &&
+                entry->dataBlockRef != NULL)
+                SecureMemoryWipe(entry->dataBlockRef, SlotEntryBlockSize(entry));
+            SecureMemoryWipe(&entry->writeToken, sizeof(EncryptedToken));
+            entry->securityEnabled = false;
+            entry->tokenGeneration = 0;
+        }
+    }
+    
+    SecurityContextDestroy(manager->securityContext);
+    manager->securityContext = NULL;
+    manager->securityEnabled = false;
+    
+    return SLOT_SUCCESS;
+}
+
+bool
+SlotManagerIsSecurityEnabled(const SlotManager *manager)
+{
+    return manager != NULL && manager->securityEnabled &&
+           manager->securityContext != NULL;
+}
+
+SlotError
+SlotManagerSetDefaultSecurityLevel(SlotManager *manager, SecurityLevel level)
+{
+    if (manager == NULL)
+        return SLOT_ERROR_INVALID_HANDLE;
+    
+    manager->defaultSecurityLevel = level;
+    return SLOT_SUCCESS;
+}
+
+/*
+ * ==================================================================
+ * VALIDATED TOKEN CACHE
+ * ==================================================================
+ */
+
+/*
+ * Secure slots are accessed many times with the same capability. Each
+ * thread keeps the capabilities it has fully validated in a small
+ * direct-mapped cache indexed by slot ID. A repeat access compares the
+ * presented capability with the cached copy and checks expiry, so it
+ * skips the MAC. The slot's live generation is compared on every access,
+ * hit or miss. SlotRefreshToken and SlotRevokeToken change it, which
+ * invalidates older tokens on all threads at once. Lines are tagged with
+ * the context's epoch, not its address, which a later context may reuse.
+ * Hits count towards the context's tokensValidated like full checks.
+ */
+#define SLOT_TOKEN_CACHE_SIZE 16
+
+typedef struct
+{
+    uint32_t        epoch;           /* cipherEpoch of the validating context */
+    TokenCapability capability;
+    bool            valid;
+} SlotTokenCacheLine;
+
+static __thread SlotTokenCacheLine tlsTokenCache[SLOT_TOKEN_CACHE_SIZE];
+
+static bool
+SlotTokenCacheMatches(const TokenCapability *cached, const TokenCapability *token)
+{
+    return cached->slotId == token->slotId &&
+           cached->token.generation == token->token.generation &&
+           cached->expiryTime == token->expiryTime &&
+           cached->issuedTime == token->issuedTime &&
+           cached->level == token->level &&
+           cached->canRead == token->canRead &&
+           cached->canWrite == token->canWrite &&
+           cached->canTransfer == token->canTransfer &&
+           cached->token.checksum == token->token.checksum &&
+           memcmp(cached->token.tokenData, token->token.tokenData,
+                  sizeof(token->token.tokenData)) == 0;
+}
+
+/*
+ * Validate a capability against a secure slot entry
+ */
+static SecurityError
+SlotTokenValidate(SlotManager *manager, const SlotEntry *entry,
+                  const TokenCapability *token)
+{
+    SecurityContext *context = manager->securityContext;
+    
+    /* Superseded or revoked tokens never reach the cache */
+    if (entry->tokenGeneration == 0 ||
+        token->token.generation != entry->tokenGeneration ||
+        token->slotId != entry->slotId)
+        return SECURITY_ERROR_INVALID_TOKEN;
+    
+    SlotTokenCacheLine *line = &tlsTokenCache[entry->slotId % SLOT_TOKEN_CACHE_SIZE];
+    if (line->valid && line->epoch == context->cipherEpoch &&
+        SlotTokenCacheMatches(&line->capability, token)) {
+        context->tokensValidated++;
+        
+        if (token->expiryTime > 0 && SecureTimestamp() > token->expiryTime) {
+            line->valid = false;
+            context->validationFailures++;
+            return SECURITY_ERROR_TOKEN_EXPIRED;
+        }
+        
+        if (token->level >= SECURITY_LEVEL_HARDWARE &&
+            !SecurityContextHardwareMatches(context)) {
+            context->validationFailures++;
+            return SECURITY_ERROR_HARDWARE_MISMATCH;
+        }
+        
+        return SECURITY_SUCCESS;
+    }
+    
+    SecurityError result = TokenValidate(context, entry->slotId, token);
+    if (result == SECURITY_SUCCESS) {
+        line->epoch = context->cipherEpoch;
+        line->capability = *token;
+        line->valid = true;
+    }
+    
+    return result;
+}
+
+static SlotError
+SlotErrorFromSecurity(SecurityError error)
+{
+    switch (error) {
+        case SECURITY_SUCCESS:
+            return SLOT_SUCCESS;
+        case SECURITY_ERROR_TOKEN_EXPIRED:
+            return SLOT_ERROR_TTL_EXPIRED;
+        case SECURITY_ERROR_HARDWARE_MISMATCH:
+        case SECURITY_ERROR_INVALID_TOKEN:
+        default:
+            return SLOT_ERROR_PERMISSION_DENIED;
+    }
+}
+
+/*
+ * Record a security event. With an audit logger attached this is a ring
+ * push; without one, only non-routine events are logged as text.
+ */
+static void
+SlotManagerAudit(SlotManager *manager, SecurityAuditEvent event,
+                 uint32_t slotId, const char *details)
+{
+    if (manager->auditLogger != NULL) {
+        SecurityAuditLoggerRecord(manager->auditLogger, event, slotId);
+        return;
+    }
+    
+    if (!SecurityAuditEventIsRoutine(event))
+        SlotManagerLogSecurityEvent(manager, SecurityAuditEventName(event),
+                                   slotId, details);
+}
+
+/*
+ * ==================================================================
+ * ENCRYPTED PAYLOADS
+ * ==================================================================
+ */
+
+/*
+ * An encrypted slot's block is nonce || tag || ciphertext of the full
+ * type width, sealed with the slot ID as associated data; plaintext
+ * never reaches the pool. Sealing and opening hold the manager mutex so
+ * concurrent writers cannot interleave on a block.
+ */
+static bool
+SlotEntryIsSealed(const SlotEntry *entry)
+{
+    return entry->securityEnabled &&
+           entry->securityLevel == SECURITY_LEVEL_ENCRYPTED;
+}
+
+/*
+ * Allocate an encrypted slot's block. Called with the manager mutex held.
+ */
+static SlotError
+SlotPrepareSealedBlock(SlotManager *manager, SlotEntry *entry)
+{
+    if (entry->dataBlockRef == NULL) {
+        entry->dataBlockRef = AllocateMemoryBlock(manager, SlotEntryBlockSize(entry));
+        if (entry->dataBlockRef == NULL)
+            return SLOT_ERROR_OUT_OF_MEMORY;
+    }
+    
+    return SLOT_SUCCESS;
+}
+
+static SlotError
+SlotSealPayload(SlotManager *manager, SlotEntry *entry, const SlotHandle *handle,
+                const void *data, size_t dataSize)
+{
+    size_t capacity = TypeGetSize(entry->typeTag);
+    
+    if (entry->typeTag != handle->typeTag || dataSize > capacity)
+        return SLOT_ERROR_TYPE_MISMATCH;
+    
+    pthread_mutex_lock((pthread_mutex_t *)manager->mutex);
+    
+    SlotError result = SlotPrepareSealedBlock(manager, entry);
+    if (result == SLOT_SUCCESS &&
+        SecurePayloadSeal(manager->securityContext, entry->slotId, data, dataSize,
+                          capacity, entry->dataBlockRef) != SECURITY_SUCCESS)
+        result = SLOT_ERROR_OUT_OF_MEMORY;
+    
+    pthread_mutex_unlock((pthread_mutex_t *)manager->mutex);
+    return result;
+}
+
+static SlotError
+SlotOpenPayload(SlotManager *manager, SlotEntry *entry, const SlotHandle *handle,
+                void *buffer, size_t bufferSize, size_t *bytesRead)
+{
+    size_t capacity = TypeGetSize(entry->typeTag);
+    
+    if (entry->typeTag != handle->typeTag)
+        return SLOT_ERROR_TYPE_MISMATCH;
+    
+    pthread_mutex_lock((pthread_mutex_t *)manager->mutex);
+    
+    if (entry->dataBlockRef == NULL) {
+        pthread_mutex_unlock((pthread_mutex_t *)manager->mutex);
+        return SLOT_ERROR_SLOT_NOT_FOUND;
+    }
+    
+    SecurityError secResult = SecurePayloadOpen(manager->securityContext,
+                                                entry->slotId, entry->dataBlockRef,
+                                                capacity, buffer, bufferSize);
+    if (secResult == SECURITY_SUCCESS)
+        manager->cacheHits++;
+    
+    pthread_mutex_unlock((pthread_mutex_t *)manager->mutex);
+    
+    if (secResult != SECURITY_SUCCESS) {
+        manager->securityViolations++;
+        SlotManagerAudit(manager, SECURITY_AUDIT_PAYLOAD_REJECTED,
+                         handle->slotId, "Encrypted payload failed authentication");
+        return SLOT_ERROR_PERMISSION_DENIED;
+    }
+    
+    if (bytesRead != NULL)
+        *bytesRead = capacity < bufferSize ? capacity : bufferSize;
+    
+    return SLOT_SUCCESS;
+}
+
+/*
+ * ==================================================================
+ * SECURE SLOT OPERATIONS
+ * ==================================================================
+ */
+
+/*
+ * Claim a slot and issue its access token
+ */
+SlotError
+SlotClaimSecure(SlotManager *manager, TypeTag type, SecurityLevel level,
+               SlotHandle *handle, TokenCapability *token)
+{
+    SlotEntry *entry = NULL;
+    size_t slotIndex;
+    SecurityError secResult;
+    
+    if (manager == NULL || handle == NULL || token == NULL)
+        return SLOT_ERROR_INVALID_HANDLE;
+    
+    if (!SlotManagerIsSecurityEnabled(manager))
+        return SLOT_ERROR_PERMISSION_DENIED;
+    
+    SlotError result = SlotClaim(manager, type, handle);
+    if (result != SLOT_SUCCESS)
+        return result;
+    
+    /* Find the slot entry */
+    for (slotIndex = 0; slotIndex < manager->tableSize; slotIndex++) {
+        if (manager->slotTable[slotIndex].slotId == handle->slotId) {
+            entry = &manager->slotTable[slotIndex];
+            break;
+        }
+    }
+    
+    if (entry == NULL || !entry->occupied)
+        return SLOT_ERROR_SLOT_NOT_FOUND;
+    
+    /* Issue the token */
+    secResult = TokenGenerate(manager->securityContext, handle->slotId, level, token);
+    if (secResult != SECURITY_SUCCESS) {
+        SlotRelease(manager, handle);
+        return SLOT_ERROR_OUT_OF_MEMORY;
+    }
+    
+    /* Keep an encrypted copy with the slot */
+    SecureToken plainToken = token->token;
+    secResult = TokenEncrypt(manager->securityContext, &plainToken,
+                           &entry->writeToken);
+    SecureMemoryWipe(&plainToken, sizeof(SecureToken));
+    if (secResult != SECURITY_SUCCESS) {
+        SecureMemoryWipe(token, sizeof(TokenCapability));
+        SlotRelease(manager, handle);
+        return SLOT_ERROR_OUT_OF_MEMORY;
+    }
+    
+    entry->securityLevel = level;
+    entry->tokenGeneration = token->token.generation;
+    entry->securityEnabled = true;
+    entry->lastAccessTime = SecureTimestamp();
+    entry->accessCount = 0;
+    
+    SlotManagerAudit(manager, SECURITY_AUDIT_SECURE_CLAIM,
+                     handle->slotId, "Secure slot claimed");
+    
+    return SLOT_SUCCESS;
+}
+
+/*
+ * Find a slot and check that the token may write to it. Slots whose
+ * security has been turned off are returned without checks, for the
+ * caller to write through the plain path.
+ */
+static SlotError
+SlotWriteSecureBegin(SlotManager *manager, const SlotHandle *handle,
+                     const TokenCapability *token, SlotEntry **entryOut)
+{
+    SlotEntry *entry = NULL;
+    size_t slotIndex;
+    SecurityError secResult;
+    
+    /* Find the slot entry */
+    for (slotIndex = 0; slotIndex < manager->tableSize; slotIndex++) {
+        if (manager->slotTable[slotIndex].slotId == handle->slotId) {
+            entry = &manager->slotTable[slotIndex];
+            break;
+        }
+    }
+    
+    if (entry == NULL || !entry->occupied)
+        return SLOT_ERROR_SLOT_NOT_FOUND;
+    
+    *entryOut = entry;
+    if (!entry->securityEnabled)
+        return SLOT_SUCCESS;
+    
+    /* Check write permission */
+    if (!token->canWrite) {
+        manager->securityViolations++;
+        SlotManagerAudit(manager, SECURITY_AUDIT_WRITE_DENIED,
+                         handle->slotId, "Token lacks write permission");
         return SLOT_ERROR_PERMISSION_DENIED;
     }
     
     /* Validate token */
-    secResult = TokenValidate(manager->securityContext, handle->slotId, token);
+    secResult = SlotTokenValidate(manager, entry, token);
     if (secResult != SECURITY_SUCCESS) {
         manager->securityViolations++;
-        SlotManagerLogSecurityEvent(manager, "TOKEN_VALIDATION_FAILED", 
-                                   handle->slotId, "Invalid or expired token");
+        SlotManagerAudit(manager, SECURITY_AUDIT_TOKEN_INVALID,
+                         handle->slotId, "Invalid or expired token");
+        return SlotErrorFromSecurity(secResult);
+    }
+    
+    /* Update access statistics */
+    entry->lastAccessTime = SecureTimestamp();
+    entry->accessCount++;
+    
+    return SLOT_SUCCESS;
+}
+
+/*
+ * Write to a secure slot with token validation
+ */
+SlotError
+SlotWriteSecure(SlotManager *manager, const SlotHandle *handle,
+               const void *data, size_t dataSize,
+               const TokenCapability *token)
+{
+    SlotEntry *entry = NULL;
+    
+    if (manager == NULL || handle == NULL || data == NULL || token == NULL)
+        return SLOT_ERROR_INVALID_HANDLE;
+    
+    if (!SlotManagerIsSecurityEnabled(manager))
+        return SLOT_ERROR_PERMISSION_DENIED;
+    
+    SlotError result = SlotWriteSecureBegin(manager, handle, token, &entry);
+    if (result != SLOT_SUCCESS)
+        return result;
+    
+    if (!entry->securityEnabled)
+        return SlotWrite(manager, handle, data, dataSize);
+    
+    /* Perform the actual write */
+    if (SlotEntryIsSealed(entry))
+        result = SlotSealPayload(manager, entry, handle, data, dataSize);
+    else
+        result = SlotWrite(manager, handle, data, dataSize);
+    
+    if (result == SLOT_SUCCESS) {
+        SlotManagerAudit(manager, SECURITY_AUDIT_SECURE_WRITE,
+                         handle->slotId, "Secure write completed");
+    }
+    
+    return result;
+}
+
+/*
+ * Write many secure slots. Encrypted payloads are sealed in chunks, each
+ * under one lock acquisition with one cipher context lookup.
+ */
+#define SLOT_SEAL_BATCH 64
+
+size_t
+SlotWriteSecureBatch(SlotManager *manager, const SlotWriteRequest *requests,
+                     size_t count, SlotError *results)
+{
+    SecurePayloadItem items[SLOT_SEAL_BATCH];
+    SlotEntry *itemEntries[SLOT_SEAL_BATCH];
+    size_t itemRequests[SLOT_SEAL_BATCH];
+    size_t written = 0;
+    
+    if (manager == NULL || requests == NULL || results == NULL)
+        return 0;
+    
+    for (size_t base = 0; base < count; base += SLOT_SEAL_BATCH) {
+        size_t end = count - base < SLOT_SEAL_BATCH ? count : base + SLOT_SEAL_BATCH;
+        size_t itemCount = 0;
+        
+        /* Check every request; anything not encrypted is written directly */
+        for (size_t i = base; i < end; i++) {
+            const SlotWriteRequest *request = &requests[i];
+            SlotEntry *entry = NULL;
+            
+            if (request->handle == NULL || request->data == NULL || request->token == NULL)
+                results[i] = SLOT_ERROR_INVALID_HANDLE;
+            else if (!SlotManagerIsSecurityEnabled(manager))
+                results[i] = SLOT_ERROR_PERMISSION_DENIED;
+            else
+                results[i] = SlotWriteSecureBegin(manager, request->handle,
+                                                  request->token, &entry);
+            
+            if (results[i] != SLOT_SUCCESS)
+                continue;
+            
+            if (!SlotEntryIsSealed(entry)) {
+                bool audited = entry->securityEnabled;
+                results[i] = SlotWrite(manager, request->handle, request->data,
+                                       request->dataSize);
+                if (results[i] == SLOT_SUCCESS && audited)
+                    SlotManagerAudit(manager, SECURITY_AUDIT_SECURE_WRITE,
+                                     request->handle->slotId, "Secure write completed");
+                continue;
+            }
+            
+            size_t capacity = TypeGetSize(entry->typeTag);
+            if (entry->typeTag != request->handle->typeTag ||
+                request->dataSize > capacity) {
+                results[i] = SLOT_ERROR_TYPE_MISMATCH;
+                continue;
+            }
+            
+            items[itemCount].slotId = entry->slotId;
+            items[itemCount].plaintext = request->data;
+            items[itemCount].size = request->dataSize;
+            items[itemCount].capacity = capacity;
+            items[itemCount].sealed = NULL;
+            itemEntries[itemCount] = entry;
+            itemRequests[itemCount] = i;
+            itemCount++;
+        }
+        
+        if (itemCount == 0)
+            continue;
+        
+        /* Seal the encrypted payloads together */
+        pthread_mutex_lock((pthread_mutex_t *)manager->mutex);
+        
+        for (size_t k = 0; k < itemCount; k++) {
+            if (SlotPrepareSealedBlock(manager, itemEntries[k]) == SLOT_SUCCESS)
+                items[k].sealed = itemEntries[k]->dataBlockRef;
+            else
+                results[itemRequests[k]] = SLOT_ERROR_OUT_OF_MEMORY;
+        }
         
-        switch (secResult) {
-            case SECURITY_ERROR_TOKEN_EXPIRED:
-                return SLOT_ERROR_TTL_EXPIRED;
-            case SECURITY_ERROR_HARDWARE_MISMATCH:
-            case SECURITY_ERROR_INVALID_TOKEN:
-            default:
-                return SLOT_ERROR_PERMISSION_DENIED;
+        SecurePayloadSealBatch(manager->securityContext, items, itemCount);
+        
+        pthread_mutex_unlock((pthread_mutex_t *)manager->mutex);
+        
+        for (size_t k = 0; k < itemCount; k++) {
+            size_t i = itemRequests[k];
+            if (results[i] != SLOT_SUCCESS)
+                continue;
+            
+            if (items[k].result != SECURITY_SUCCESS) {
+                results[i] = SLOT_ERROR_OUT_OF_MEMORY;
+                continue;
+            }
+            
+            SlotManagerAudit(manager, SECURITY_AUDIT_SECURE_WRITE,
+                             items[k].slotId, "Secure write completed");
         }
     }
     
+    for (size_t i = 0; i < count; i++) {
+        if (results[i] == SLOT_SUCCESS)
+            written++;
+    }
+    
+    return written;
+}
+
+/*
+ * Read from a secure slot with token validation
+ */
+SlotError
+SlotReadSecure(SlotManager *manager, const SlotHandle *handle,
+              void *buffer, size_t bufferSize, size_t *bytesRead,
+              const TokenCapability *token)
+{
+    SlotEntry *entry = NULL;
+    size_t slotIndex;
+    SecurityError secResult;
+    
+    if (manager == NULL || handle == NULL || buffer == NULL || token == NULL)
+        return SLOT_ERROR_INVALID_HANDLE;
+    
+    if (!SlotManagerIsSecurityEnabled(manager))
+        return SLOT_ERROR_PERMISSION_DENIED;
+    
+    /* Find the slot entry */
+    for (slotIndex = 0; slotIndex < manager->tableSize; slotIndex++) {
+        if (manager->slotTable[slotIndex].slotId == handle->slotId) {
+            entry = &manager->slotTable[slotIndex];
+            break;
+        }
+    }
+    
+    if (entry == NULL || !entry->occupied)
+        return SLOT_ERROR_SLOT_NOT_FOUND;
+    
+    if (!entry->securityEnabled)
+        return SlotRead(manager, handle, buffer, bufferSize, bytesRead);
+    
+    /* Check read permission */
+    if (!token->canRead) {
+        manager->securityViolations++;
+        SlotManagerAudit(manager, SECURITY_AUDIT_READ_DENIED,
+                         handle->slotId, "Token lacks read permission");
+        return SLOT_ERROR_PERMISSION_DENIED;
+    }
+    
+    /* Validate token */
+    secResult = SlotTokenValidate(manager, entry, token);
+    if (secResult != SECURITY_SUCCESS) {
+        manager->securityViolations++;
+        SlotManagerAudit(manager, SECURITY_AUDIT_TOKEN_INVALID,
+                         handle->slotId, "Invalid or expired token");
+        return SlotErrorFromSecurity(secResult);
+    }
+    
     /* Update access statistics */
     entry->lastAccessTime = SecureTimestamp();
     entry->accessCount++;
     
     /* Perform the actual read */
-    SlotError result = SlotRead(manager, handle, buffer, bufferSize, bytesRead);
+    SlotError result;
+    if (SlotEntryIsSealed(entry))
+        result = SlotOpenPayload(manager, entry, handle, buffer, bufferSize, bytesRead);
+    else
+        result = SlotRead(manager, handle, buffer, bufferSize, bytesRead);
     
     if (result == SLOT_SUCCESS) {
-        SlotManagerLogSecurityEvent(manager, "SECURE_READ_SUCCESS", 
-                                   handle->slotId, "Secure read completed");
+        SlotManagerAudit(manager, SECURITY_AUDIT_SECURE_READ,
+                         handle->slotId, "Secure read completed");
     }
     
     return result;
@@ -627,11 +1297,11 @@ SlotReleaseSecure(SlotManager *manager, const SlotHandle *handle,
     
     if (entry->securityEnabled) {
         /* Validate token for secure release */
-        secResult = TokenValidate(manager->securityContext, handle->slotId, token);
+        secResult = SlotTokenValidate(manager, entry, token);
         if (secResult != SECURITY_SUCCESS) {
             manager->securityViolations++;
-            SlotManagerLogSecurityEvent(manager, "RELEASE_TOKEN_VALIDATION_FAILED", 
-                                       handle->slotId, "Cannot release slot without valid token");
+            SlotManagerAudit(manager, SECURITY_AUDIT_RELEASE_DENIED,
+                             handle->slotId, "Cannot release slot without valid token");
             return SLOT_ERROR_PERMISSION_DENIED;
         }
         
@@ -640,8 +1310,8 @@ SlotReleaseSecure(SlotManager *manager, const SlotHandle *handle,
         entry->securityEnabled = false;
         entry->tokenGeneration = 0;
         
-        SlotManagerLogSecurityEvent(manager, "SECURE_RELEASE_SUCCESS", 
-                                   handle->slotId, "Secure slot released");
+        SlotManagerAudit(manager, SECURITY_AUDIT_SECURE_RELEASE,
+                         handle->slotId, "Secure slot released");
     }
     
     /* Perform the actual release */
@@ -695,7 +1365,7 @@ SlotRefreshToken(SlotManager *manager, const SlotHandle *handle,
         return SLOT_ERROR_SLOT_NOT_FOUND;
     
     /* Validate current token first */
-    secResult = TokenValidate(manager->securityContext, handle->slotId, token);
+    secResult = SlotTokenValidate(manager, entry, token);
     if (secResult != SECURITY_SUCCESS)
         return SLOT_ERROR_PERMISSION_DENIED;
     
@@ -715,8 +1385,8 @@ SlotRefreshToken(SlotManager *manager, const SlotHandle *handle,
         return SLOT_ERROR_OUT_OF_MEMORY;
     }
     
-    /* Update token generation */
-    entry->tokenGeneration++;
+    /* Supersede the old token; cached copies stop matching */
+    entry->tokenGeneration = newToken.token.generation;
     
     /* Copy new token to output */
     *token = newToken;
@@ -724,8 +1394,8 @@ SlotRefreshToken(SlotManager *manager, const SlotHandle *handle,
     /* Wipe temporary data */
     SecureMemoryWipe(&plainToken, sizeof(SecureToken));
     
-    SlotManagerLogSecurityEvent(manager, "TOKEN_REFRESHED", 
-                               handle->slotId, "Token successfully refreshed");
+    SlotManagerAudit(manager, SECURITY_AUDIT_TOKEN_REFRESHED,
+                     handle->slotId, "Token successfully refreshed");
     
     return SLOT_SUCCESS;
 }
@@ -757,12 +1427,12 @@ SlotRevokeToken(SlotManager *manager, const SlotHandle *handle)
         return SLOT_ERROR_SLOT_NOT_FOUND;
     
     if (entry->securityEnabled) {
-        /* Securely wipe token data */
+        /* Securely wipe token data; generation 0 matches no token */
         SecureMemoryWipe(&entry->writeToken, sizeof(EncryptedToken));
         entry->tokenGeneration = 0;
         
-        SlotManagerLogSecurityEvent(manager, "TOKEN_REVOKED", 
-                                   handle->slotId, "Token revoked by administrator");
+        SlotManagerAudit(manager, SECURITY_AUDIT_TOKEN_REVOKED,
+                         handle->slotId, "Token revoked by administrator");
     }
     
     return SLOT_SUCCESS;
@@ -771,6 +1441,15 @@ SlotRevokeToken(SlotManager *manager, const SlotHandle *handle)
 /*
  * Security audit and monitoring functions
  */
+void
+SlotManagerSetAuditLogger(SlotManager *manager, SecurityAuditLogger *logger)
+{
+    if (manager == NULL)
+        return;
+    
+    manager->auditLogger = logger;
+}
+
 void
 SlotManagerLogSecurityEvent(SlotManager *manager, const char *event,
                            uint32_t slotId, const char *details)
@@ -807,8 +1486,8 @@ SlotManagerDetectAnomalies(SlotManager *manager)
     
     /* Check for excessive security violations */
     if (manager->securityViolations > SECURITY_MAX_VALIDATION_FAILURES) {
-        SlotManagerLogSecurityEvent(manager, "ANOMALY_EXCESSIVE_VIOLATIONS", 
-                                   0, "Too many security violations detected");
+        SlotManagerAudit(manager, SECURITY_AUDIT_ANOMALY_VIOLATIONS,
+                         0, "Too many security violations detected");
         anomalyDetected = true;
     }
     
@@ -820,15 +1499,15 @@ SlotManagerDetectAnomalies(SlotManager *manager)
             /* Check for rapid successive accesses (potential automation) */
             if (entry->accessCount > 1000 && 
                 (currentTime - entry->lastAccessTime) < 1000000) { /* 1 second */
-                SlotManagerLogSecurityEvent(manager, "ANOMALY_RAPID_ACCESS", 
-                                           entry->slotId, "Suspicious rapid access pattern");
+                SlotManagerAudit(manager, SECURITY_AUDIT_ANOMALY_RAPID_ACCESS,
+                                 entry->slotId, "Suspicious rapid access pattern");
                 anomalyDetected = true;
             }
             
             /* Check for very old slots that haven't been accessed */
             if ((currentTime - entry->lastAccessTime) > 86400000000ULL) { /* 1 day */
-                SlotManagerLogSecurityEvent(manager, "ANOMALY_STALE_SLOT", 
-                                           entry->slotId, "Slot not accessed for extended period");
+                SlotManagerAudit(manager, SECURITY_AUDIT_ANOMALY_STALE_SLOT,
+                                 entry->slotId, "Slot not accessed for extended period");
             }
         }
     }
@@ -946,14 +1625,14 @@ SlotManagerDestroySecure(SlotManager *manager)
 /*
  * Scope-based secure slot claiming with automatic cleanup
  */
-typedef struct SecureSlotScope {
+struct SecureSlotScope {
     SlotManager *manager;
     SlotHandle *handles;
     TokenCapability *tokens;
     size_t count;
     size_t capacity;
     bool autoCleanup;
-} SecureSlotScope;
+};
 
 SecureSlotScope *
 SecureSlotScopeCreate(SlotManager *manager, size_t capacity)
@@ -1042,13 +1721,6 @@ SecureSlotScopeDestroy(SecureSlotScope *scope)
  * These functions provide the interface that the Pergyra compiler will use
  */
 
-typedef struct PergyraSecureSlot {
-    SlotHandle handle;
-    TokenCapability token;
-    TypeTag typeTag;
-    bool isValid;
-} PergyraSecureSlot;
-
 /*
  * claim_secure_slot<Type>() equivalent
  */
@@ -1144,10 +1816,10 @@ pergyra_slot_release_secure(PergyraSecureSlot *slot)
 /*
  * Scope-based syntax: with slot<Type> as s { ... }
  */
-typedef struct PergyraSlotScope {
+struct PergyraSlotScope {
     SecureSlotScope *scope;
     SlotManager *manager;
-} PergyraSlotScope;
+};
 
 PergyraSlotScope *
 pergyra_scope_begin(SlotManager *manager)
@@ -34,6 +34,7 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include "slot_security.h"
+#include "security_audit.h"
 
 /*
  * Slot table entry structure
@@ -51,7 +52,7 @@ typedef struct
     /* Security extensions */
     SecurityLevel securityLevel;     /* Security level for this slot */
     EncryptedToken writeToken;       /* Encrypted write access token */
-    uint32_t tokenGeneration;        /* Token generation counter */
+    uint32_t tokenGeneration;        /* Generation of the live token (0 = revoked) */
     bool     securityEnabled;        /* Whether security is active */
     uint64_t lastAccessTime;         /* Last access timestamp */
     uint32_t accessCount;            /* Access counter for anomaly detection */
@@ -77,6 +78,7 @@ typedef struct
     SecurityContext *securityContext;  /* Security management */
     bool             securityEnabled;  /* Global security toggle */
     SecurityLevel    defaultSecurityLevel; /* Default security level */
+    SecurityAuditLogger *auditLogger;  /* Binary audit trail (not owned) */
     
     /* Statistics */
     uint64_t totalAllocations;
@@ -179,6 +181,27 @@ void   SlotManagerPrintStats(const SlotManager *manager);
 size_t SlotManagerGetActiveCount(const SlotManager *manager);
 double SlotManagerGetUtilization(const SlotManager *manager);
 
+/*
+ * Memory pool region backing slot data blocks (used by world snapshots)
+ */
+typedef struct
+{
+    void       *base;          /* 64-byte aligned block storage */
+    size_t      size;
+    size_t      blockSize;
+    const bool *usedBlocks;    /* One flag per block */
+    size_t      blockCount;
+} SlotPoolRegion;
+
+typedef void (*SlotPoolRegionRelease)(void *base, size_t size);
+
+bool         SlotManagerGetPoolRegion(const SlotManager *manager, SlotPoolRegion *region);
+
+/* Adopt existing block storage, e.g. a mapped snapshot; release frees it */
+SlotManager *SlotManagerCreateFromRegion(size_t maxSlots, void *base, size_t size,
+                                         const bool *usedBlocks,
+                                         SlotPoolRegionRelease release);
+
 /*
  * Type utility functions
  */
@@ -195,8 +218,19 @@ static inline bool     SlotCompareAndSwap(volatile uint32_t *ptr,
                                          uint32_t expected, uint32_t newVal);
 static inline void     SlotMemoryBarrier(void);
 
+/*
+ * Slot manager lifecycle with optional security
+ */
+SlotManager *SlotManagerCreateSecure(size_t maxSlots, size_t memoryPoolSize,
+                                     bool enableSecurity, SecurityLevel defaultLevel);
+void         SlotManagerDestroySecure(SlotManager *manager);
+
 /*
  * Secure slot operations with token-based access control
+ *
+ * SECURITY_LEVEL_ENCRYPTED slots hold their data sealed in the pool:
+ * writes encrypt the value, zero-padded to the type size, and reads
+ * decrypt and authenticate it. Disabling security wipes them.
  */
 SlotError SlotClaimSecure(SlotManager *manager, TypeTag type, 
                          SecurityLevel level, SlotHandle *handle, 
@@ -210,6 +244,22 @@ SlotError SlotReadSecure(SlotManager *manager, const SlotHandle *handle,
 SlotError SlotReleaseSecure(SlotManager *manager, const SlotHandle *handle,
                            const TokenCapability *token);
 
+/*
+ * Batched secure writes. Each request is checked as by SlotWriteSecure;
+ * encrypted payloads are then sealed together under one lock. results[i]
+ * receives each request's outcome. Returns the number written.
+ */
+typedef struct
+{
+    const SlotHandle      *handle;
+    const void            *data;
+    size_t                 dataSize;
+    const TokenCapability *token;
+} SlotWriteRequest;
+
+size_t    SlotWriteSecureBatch(SlotManager *manager, const SlotWriteRequest *requests,
+                              size_t count, SlotError *results);
+
 /*
  * Token validation and management
  */
@@ -229,12 +279,58 @@ SlotError SlotManagerSetDefaultSecurityLevel(SlotManager *manager, SecurityLevel
 
 /*
  * Security audit and monitoring
+ *
+ * With an audit logger attached, events go to its binary trail; without
+ * one, denials and anomalies are logged as text and successes are not.
+ * Detach the logger before closing it.
  */
+void      SlotManagerSetAuditLogger(SlotManager *manager, SecurityAuditLogger *logger);
 void      SlotManagerLogSecurityEvent(SlotManager *manager, const char *event,
                                      uint32_t slotId, const char *details);
 bool      SlotManagerDetectAnomalies(SlotManager *manager);
 void      SlotManagerPrintSecurityStats(const SlotManager *manager);
 
+/*
+ * Scope-based secure slots: destroying the scope releases every slot
+ * claimed through it and wipes their tokens
+ */
+typedef struct SecureSlotScope SecureSlotScope;
+
+SecureSlotScope *SecureSlotScopeCreate(SlotManager *manager, size_t capacity);
+SlotError        SecureSlotScopeClaimSlot(SecureSlotScope *scope, TypeTag type,
+                                          SecurityLevel level, SlotHandle **handle,
+                                          TokenCapability **token);
+void             SecureSlotScopeDestroy(SecureSlotScope *scope);
+
+/*
+ * Language-level API used by compiled Pergyra code. Reads, writes and
+ * releases go through g_pergyraSlotManager.
+ */
+typedef struct PergyraSecureSlot {
+    SlotHandle      handle;
+    TokenCapability token;
+    TypeTag         typeTag;
+    bool            isValid;
+} PergyraSecureSlot;
+
+typedef struct PergyraSlotScope PergyraSlotScope;
+
+extern SlotManager *g_pergyraSlotManager;
+
+PergyraSecureSlot *pergyra_claim_secure_slot(SlotManager *manager, const char *typeName,
+                                             SecurityLevel level);
+bool               pergyra_slot_write_secure(PergyraSecureSlot *slot, const void *data,
+                                             size_t dataSize);
+bool               pergyra_slot_read_secure(PergyraSecureSlot *slot, void *buffer,
+                                            size_t bufferSize, size_t *bytesRead);
+void               pergyra_slot_release_secure(PergyraSecureSlot *slot);
+
+PergyraSlotScope  *pergyra_scope_begin(SlotManager *manager);
+PergyraSecureSlot *pergyra_scope_claim_slot(PergyraSlotScope *pscope, const char *typeName,
+                                            SecurityLevel level);
+void               pergyra_scope_end(PergyraSlotScope *pscope);
+void               pergyra_security_audit_usage_example(void);
+
 /*
  * Assembly implementation prototypes
  */
@@ -27,6 +27,8 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
+#define _GNU_SOURCE
+
 #include "slot_pool.h"
 #include <stdlib.h>
 #include <string.h>
@@ -8,11 +8,15 @@
  * preventing external memory manipulation tools from modifying slot values.
  */
 
+#define _GNU_SOURCE
+
 #include "slot_security.h"
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
 #include <time.h>
 #include <stdio.h>
+#include <stdatomic.h>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -30,11 +34,17 @@
 #include <ifaddrs.h>
 #include <net/if.h>
 #include <netpacket/packet.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
 #endif
 
 #include <openssl/evp.h>
 #include <openssl/rand.h>
 #include <openssl/sha.h>
+#include <openssl/hmac.h>
 #include <openssl/aes.h>
 
 /*
@@ -52,6 +62,242 @@ static const uint8_t SECURITY_MAGIC[] = {
 
 static const uint32_t SECURITY_VERSION = 0x00010001;
 
+/*
+ * Hardware monitor
+ *
+ * Generating a fingerprint reads DMI and walks the interface list, which
+ * is far too slow for every validation. The monitor keeps the result of
+ * the last comparison in an atomic flag; validation only loads it. On
+ * Linux a thread refreshes it on an interval and on rtnetlink link
+ * events. Elsewhere the refresh happens lazily once the interval expires.
+ *
+ * Contexts created at SECURITY_LEVEL_HARDWARE or above start the monitor
+ * up front. Others start it on their first hardware-bound validation, so
+ * they pay for no thread or socket unless they issue such tokens.
+ */
+struct HardwareMonitor
+{
+    SecurityContext      *context;
+    atomic_bool           matches;        /* Last comparison result */
+    _Atomic uint64_t      lastCheck;      /* SecureTimestamp of last check */
+#ifdef __linux__
+    pthread_t             thread;
+    bool                  threadStarted;
+    atomic_bool           running;
+    int                   wakeFds[2];     /* Stop / interval change */
+    int                   netlinkFd;      /* -1 if unavailable */
+#endif
+};
+
+#ifdef __linux__
+static int
+HardwareMonitorOpenNetlink(void)
+{
+    int fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC | SOCK_NONBLOCK,
+                    NETLINK_ROUTE);
+    if (fd < 0)
+        return -1;
+    
+    struct sockaddr_nl addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.nl_family = AF_NETLINK;
+    addr.nl_groups = RTMGRP_LINK;
+    
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+    
+    return fd;
+}
+
+static void
+HardwareMonitorDrain(int fd)
+{
+    char buffer[4096];
+    while (recv(fd, buffer, sizeof(buffer), MSG_DONTWAIT) > 0)
+        ;
+}
+
+static SecurityError HardwareMonitorCheck(SecurityContext *context, HardwareMonitor *monitor);
+
+static void *
+HardwareMonitorThread(void *arg)
+{
+    HardwareMonitor *monitor = arg;
+    SecurityContext *context = monitor->context;
+    
+    while (atomic_load(&monitor->running)) {
+        struct pollfd fds[2] = {
+            { .fd = monitor->wakeFds[0], .events = POLLIN },
+            { .fd = monitor->netlinkFd, .events = POLLIN }
+        };
+        
+        uint64_t intervalMs = __atomic_load_n(&context->hardwareCheckMs,
+                                              __ATOMIC_RELAXED);
+        int timeout = intervalMs == 0 ? -1 :
+                      intervalMs > INT32_MAX ? INT32_MAX : (int)intervalMs;
+        
+        int ready = poll(fds, 2, timeout);
+        if (ready < 0)
+            continue;
+        
+        if (fds[0].revents & POLLIN) {
+            /* Stop request or new interval; re-evaluate before checking */
+            char drain[64];
+            while (read(monitor->wakeFds[0], drain, sizeof(drain)) > 0)
+                ;
+            continue;
+        }
+        
+        if (fds[1].revents & POLLIN)
+            HardwareMonitorDrain(monitor->netlinkFd);
+        
+        HardwareMonitorCheck(context, monitor);
+    }
+    
+    return NULL;
+}
+
+static void
+HardwareMonitorWake(HardwareMonitor *monitor)
+{
+    char byte = 0;
+    ssize_t written = write(monitor->wakeFds[1], &byte, 1);
+    (void)written;
+}
+#endif
+
+static HardwareMonitor *
+HardwareMonitorGet(const SecurityContext *context)
+{
+    return __atomic_load_n(&context->hwMonitor, __ATOMIC_ACQUIRE);
+}
+
+/* Build a monitor and start its thread; not yet visible to validation */
+static HardwareMonitor *
+HardwareMonitorCreate(SecurityContext *context)
+{
+    HardwareMonitor *monitor = calloc(1, sizeof(HardwareMonitor));
+    if (monitor == NULL)
+        return NULL;
+    
+    monitor->context = context;
+    atomic_init(&monitor->matches, true);
+    atomic_init(&monitor->lastCheck, SecureTimestamp());
+    
+#ifdef __linux__
+    atomic_init(&monitor->running, true);
+    monitor->netlinkFd = -1;
+    
+    if (pipe2(monitor->wakeFds, O_CLOEXEC | O_NONBLOCK) != 0) {
+        /* No thread; TokenValidate falls back to interval checks */
+        monitor->wakeFds[0] = monitor->wakeFds[1] = -1;
+        return monitor;
+    }
+    
+    monitor->netlinkFd = HardwareMonitorOpenNetlink();
+    monitor->threadStarted = pthread_create(&monitor->thread, NULL,
+                                            HardwareMonitorThread, monitor) == 0;
+#endif
+    
+    return monitor;
+}
+
+static void
+HardwareMonitorFree(HardwareMonitor *monitor)
+{
+#ifdef __linux__
+    if (monitor->threadStarted) {
+        atomic_store(&monitor->running, false);
+        HardwareMonitorWake(monitor);
+        pthread_join(monitor->thread, NULL);
+    }
+    
+    if (monitor->netlinkFd >= 0)
+        close(monitor->netlinkFd);
+    if (monitor->wakeFds[0] >= 0) {
+        close(monitor->wakeFds[0]);
+        close(monitor->wakeFds[1]);
+    }
+#endif
+    
+    free(monitor);
+}
+
+/*
+ * The context's monitor, started if it has none. Validations may race
+ * to start it; the first to publish wins and the others stop their own.
+ */
+static HardwareMonitor *
+HardwareMonitorStart(SecurityContext *context)
+{
+    HardwareMonitor *monitor = HardwareMonitorGet(context);
+    if (monitor != NULL)
+        return monitor;
+    
+    HardwareMonitor *created = HardwareMonitorCreate(context);
+    if (created == NULL)
+        return NULL;
+    
+    if (__atomic_compare_exchange_n(&context->hwMonitor, &monitor, created, false,
+                                    __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+        return created;
+    
+    HardwareMonitorFree(created);
+    return monitor;
+}
+
+/* Called once no validation can run on the context */
+static void
+HardwareMonitorStop(SecurityContext *context)
+{
+    HardwareMonitor *monitor = HardwareMonitorGet(context);
+    if (monitor == NULL)
+        return;
+    
+    HardwareMonitorFree(monitor);
+    context->hwMonitor = NULL;
+}
+
+/*
+ * True if the hardware matched the bound fingerprint at the last check.
+ * Touches only memory unless there is no monitor thread and the interval
+ * has expired.
+ */
+bool
+SecurityContextHardwareMatches(SecurityContext *context)
+{
+    HardwareMonitor *monitor = HardwareMonitorGet(context);
+    if (monitor == NULL) {
+        /* First hardware-bound validation: start watching, check now */
+        monitor = HardwareMonitorStart(context);
+        if (monitor == NULL)
+            return false;
+        HardwareMonitorCheck(context, monitor);
+    }
+    
+#ifdef __linux__
+    if (monitor->threadStarted)
+        return atomic_load_explicit(&monitor->matches, memory_order_acquire);
+#endif
+    
+    uint64_t intervalMs = context->hardwareCheckMs;
+    if (intervalMs > 0 &&
+        SecureTimestamp() - atomic_load(&monitor->lastCheck) > intervalMs * 1000)
+        HardwareMonitorCheck(context, monitor);
+    
+    return atomic_load_explicit(&monitor->matches, memory_order_acquire);
+}
+
+/*
+ * Payload cipher selection and per-thread cipher state (see below)
+ */
+static _Atomic uint32_t g_nextCipherEpoch = 1;
+
+static SecurityCipher SecureCipherSelect(void);
+static void           SecureCipherCacheRelease(const SecurityContext *context);
+
 /*
  * Security context management
  */
@@ -67,39 +313,129 @@ SecurityContextCreate(SecurityLevel defaultLevel)
     memset(context, 0, sizeof(SecurityContext));
     context->defaultLevel = defaultLevel;
     context->initialized = false;
+    context->hardwareCheckMs = SECURITY_HARDWARE_CHECK_MS;
     
-    /* Initialize hardware fingerprint */
-    if (HardwareFingerprintGenerate(&context->hwFingerprint) != SECURITY_SUCCESS) {
-        free(context);
+    if (SecurityContextInitialize(context) != SECURITY_SUCCESS) {
+        SecurityContextDestroy(context);
         return NULL;
     }
     
-    /* Generate master key from hardware fingerprint */
+    g_securityContext = context;
+    
+    return context;
+}
+
+SecurityError
+SecurityContextInitialize(SecurityContext *context)
+{
+    if (context == NULL)
+        return SECURITY_ERROR_CONTEXT_NOT_INITIALIZED;
+    
+    if (context->initialized)
+        return SECURITY_SUCCESS;
+    
+    /* Take the hardware fingerprint once; validation uses the cached copy */
+    SecurityError result = HardwareFingerprintGenerate(&context->hwFingerprint);
+    if (result != SECURITY_SUCCESS)
+        return result;
+    
     context->keySize = 32; /* 256-bit key */
     context->masterKey = malloc(context->keySize);
-    if (context->masterKey == NULL) {
-        free(context);
-        return NULL;
-    }
+    if (context->masterKey == NULL)
+        return SECURITY_ERROR_CONTEXT_NOT_INITIALIZED;
     
-    /* Derive master key from hardware fingerprint and compile-time constants */
-    uint8_t keyMaterial[64];
-    memcpy(keyMaterial, &context->hwFingerprint, sizeof(HardwareFingerprint));
-    memcpy(keyMaterial + sizeof(HardwareFingerprint), SECURITY_MAGIC, 
+    /*
+     * The secret is per-context random key material; the fingerprint and
+     * compile-time constants only bind the key to this machine, since
+     * anyone on it can read them.
+     */
+    uint8_t secret[32];
+    uint8_t binding[64];
+    memset(binding, 0, sizeof(binding));
+    memcpy(binding, &context->hwFingerprint, sizeof(HardwareFingerprint));
+    memcpy(binding + sizeof(HardwareFingerprint), SECURITY_MAGIC, 
            sizeof(SECURITY_MAGIC));
     
-    SecureHashSHA256(keyMaterial, sizeof(keyMaterial), context->masterKey);
+    unsigned int keyLength = 0;
+    result = SecureRandomGenerate(secret, sizeof(secret));
+    if (result == SECURITY_SUCCESS &&
+        (HMAC(EVP_sha256(), secret, (int)sizeof(secret), binding, sizeof(binding),
+              context->masterKey, &keyLength) == NULL || keyLength != context->keySize))
+        result = SECURITY_ERROR_CRYPTOGRAPHY_FAILED;
     
     /* Securely wipe key material */
-    SecureMemoryWipe(keyMaterial, sizeof(keyMaterial));
+    SecureMemoryWipe(secret, sizeof(secret));
+    SecureMemoryWipe(binding, sizeof(binding));
+    if (result != SECURITY_SUCCESS)
+        return result;
     
     /* Lock master key in memory */
     SecureMemoryLock(context->masterKey, context->keySize);
     
+    /* Fixed for the context's lifetime; sealed data names no cipher */
+    context->cipher = SecureCipherSelect();
+    context->cipherEpoch = atomic_fetch_add(&g_nextCipherEpoch, 1);
+    
+    if (context->defaultLevel >= SECURITY_LEVEL_HARDWARE &&
+        HardwareMonitorStart(context) == NULL)
+        return SECURITY_ERROR_CONTEXT_NOT_INITIALIZED;
+    
     context->initialized = true;
-    g_securityContext = context;
     
-    return context;
+    return SECURITY_SUCCESS;
+}
+
+/*
+ * Re-take the hardware fingerprint and record whether it still matches
+ * the one the context is bound to.
+ */
+static SecurityError
+HardwareMonitorCheck(SecurityContext *context, HardwareMonitor *monitor)
+{
+    HardwareFingerprint currentFingerprint;
+    SecurityError result = HardwareFingerprintGenerate(&currentFingerprint);
+    if (result != SECURITY_SUCCESS)
+        return result;
+    
+    bool matches = HardwareFingerprintCompare(&context->hwFingerprint,
+                                              &currentFingerprint);
+    atomic_store_explicit(&monitor->matches, matches, memory_order_release);
+    atomic_store(&monitor->lastCheck, SecureTimestamp());
+    
+    return matches ? SECURITY_SUCCESS : SECURITY_ERROR_HARDWARE_MISMATCH;
+}
+
+/*
+ * Force a check, e.g. after resuming from suspend. Starts the monitor
+ * if the context has none yet.
+ */
+SecurityError
+SecurityContextUpdateHardware(SecurityContext *context)
+{
+    if (context == NULL || !context->initialized)
+        return SECURITY_ERROR_CONTEXT_NOT_INITIALIZED;
+    
+    HardwareMonitor *monitor = HardwareMonitorStart(context);
+    if (monitor == NULL)
+        return SECURITY_ERROR_CONTEXT_NOT_INITIALIZED;
+    
+    return HardwareMonitorCheck(context, monitor);
+}
+
+void
+SecurityContextSetHardwareCheckInterval(SecurityContext *context,
+                                        uint64_t intervalMs)
+{
+    if (context == NULL)
+        return;
+    
+    __atomic_store_n(&context->hardwareCheckMs, intervalMs, __ATOMIC_RELAXED);
+    
+#ifdef __linux__
+    HardwareMonitor *monitor = HardwareMonitorGet(context);
+    if (monitor != NULL && monitor->threadStarted)
+        HardwareMonitorWake(monitor);
+#endif
 }
 
 void
@@ -108,6 +444,9 @@ SecurityContextDestroy(SecurityContext *context)
     if (context == NULL)
         return;
     
+    HardwareMonitorStop(context);
+    SecureCipherCacheRelease(context);
+    
     if (context->masterKey != NULL) {
         SecureMemoryWipe(context->masterKey, context->keySize);
         SecureMemoryUnlock(context->masterKey, context->keySize);
@@ -186,6 +525,66 @@ HardwareFingerprintCompare(const HardwareFingerprint *fp1,
     return SecureCompareConstantTime(fp1, fp2, sizeof(HardwareFingerprint));
 }
 
+/*
+ * Token MAC
+ *
+ * Tokens are HMAC-SHA256 tags over the capability fields, so a token can
+ * be checked with one MAC and no other state. The fields are packed into
+ * a fixed little-endian layout so struct padding never reaches the MAC.
+ */
+#define TOKEN_MAC_SIZE       32
+#define TOKEN_MAC_INPUT_SIZE 32
+
+static void
+TokenPackU32(uint8_t *out, uint32_t value)
+{
+    for (int i = 0; i < 4; i++)
+        out[i] = (uint8_t)(value >> (8 * i));
+}
+
+static uint32_t
+TokenUnpackU32(const uint8_t *in)
+{
+    uint32_t value = 0;
+    for (int i = 0; i < 4; i++)
+        value |= (uint32_t)in[i] << (8 * i);
+    return value;
+}
+
+static void
+TokenPackU64(uint8_t *out, uint64_t value)
+{
+    for (int i = 0; i < 8; i++)
+        out[i] = (uint8_t)(value >> (8 * i));
+}
+
+static SecurityError
+TokenComputeMac(const SecurityContext *context, const TokenCapability *capability,
+               uint8_t mac[TOKEN_MAC_SIZE])
+{
+    if (context->masterKey == NULL || context->keySize == 0)
+        return SECURITY_ERROR_CONTEXT_NOT_INITIALIZED;
+    
+    uint8_t input[TOKEN_MAC_INPUT_SIZE];
+    TokenPackU32(input, capability->slotId);
+    TokenPackU32(input + 4, capability->token.generation);
+    TokenPackU64(input + 8, capability->issuedTime);
+    TokenPackU64(input + 16, capability->expiryTime);
+    TokenPackU32(input + 24, (uint32_t)capability->level);
+    input[28] = capability->canRead ? 1 : 0;
+    input[29] = capability->canWrite ? 1 : 0;
+    input[30] = capability->canTransfer ? 1 : 0;
+    input[31] = 0;
+    
+    unsigned int macSize = 0;
+    if (HMAC(EVP_sha256(), context->masterKey, (int)context->keySize,
+             input, sizeof(input), mac, &macSize) == NULL ||
+        macSize != TOKEN_MAC_SIZE)
+        return SECURITY_ERROR_CRYPTOGRAPHY_FAILED;
+    
+    return SECURITY_SUCCESS;
+}
+
 /*
  * Token generation and validation
  */
@@ -223,42 +622,13 @@ TokenGenerate(SecurityContext *context, uint32_t slotId,
     capability->canWrite = true;
     capability->canTransfer = false;
     
-    /* Generate secure token */
-    uint8_t tokenMaterial[64];
-    
-    /* Hardware fingerprint */
-    memcpy(tokenMaterial, &context->hwFingerprint, sizeof(HardwareFingerprint));
-    
-    /* Slot ID and timestamp */
-    memcpy(tokenMaterial + sizeof(HardwareFingerprint), &slotId, sizeof(uint32_t));
-    memcpy(tokenMaterial + sizeof(HardwareFingerprint) + sizeof(uint32_t), 
-           &capability->issuedTime, sizeof(uint64_t));
-    
-    /* Secure random data */
-    SecurityError result = SecureRandomGenerate(
-        tokenMaterial + sizeof(HardwareFingerprint) + sizeof(uint32_t) + sizeof(uint64_t),
-        64 - sizeof(HardwareFingerprint) - sizeof(uint32_t) - sizeof(uint64_t)
-    );
-    
-    if (result != SECURITY_SUCCESS)
-        return result;
-    
-    /* Hash the token material */
-    result = SecureHashSHA256(tokenMaterial, sizeof(tokenMaterial), 
-                            capability->token.tokenData);
-    
-    if (result != SECURITY_SUCCESS)
-        return result;
-    
     /* Set token generation and checksum */
-    capability->token.generation = ++context->tokensIssued;
+    capability->token.generation = (uint32_t)++context->tokensIssued;
     capability->token.checksum = HardwareFingerprintHash(&context->hwFingerprint) ^
                                 capability->token.generation;
     
-    /* Securely wipe token material */
-    SecureMemoryWipe(tokenMaterial, sizeof(tokenMaterial));
-    
-    return SECURITY_SUCCESS;
+    /* The token is a MAC over the capability, keyed by the master key */
+    return TokenComputeMac(context, capability, capability->token.tokenData);
 }
 
 SecurityError
@@ -284,17 +654,11 @@ TokenValidate(SecurityContext *context, uint32_t slotId,
         return SECURITY_ERROR_INVALID_TOKEN;
     }
     
-    /* Validate hardware binding for HARDWARE level and above */
-    if (capability->level >= SECURITY_LEVEL_HARDWARE) {
-        HardwareFingerprint currentFingerprint;
-        SecurityError result = HardwareFingerprintGenerate(&currentFingerprint);
-        if (result != SECURITY_SUCCESS)
-            return result;
-        
-        if (!HardwareFingerprintCompare(&context->hwFingerprint, &currentFingerprint)) {
-            context->securityViolations++;
-            return SECURITY_ERROR_HARDWARE_MISMATCH;
-        }
+    /* Validate hardware binding for HARDWARE level and above (cached) */
+    if (capability->level >= SECURITY_LEVEL_HARDWARE &&
+        !SecurityContextHardwareMatches(context)) {
+        context->securityViolations++;
+        return SECURITY_ERROR_HARDWARE_MISMATCH;
     }
     
     /* Validate token checksum */
@@ -307,15 +671,20 @@ TokenValidate(SecurityContext *context, uint32_t slotId,
         return SECURITY_ERROR_INVALID_TOKEN;
     }
     
-    /* Re-generate token to validate */
-    TokenCapability testCapability;
-    SecurityError result = TokenGenerate(context, slotId, capability->level, 
-                                       &testCapability);
+    /*
+     * Recompute the MAC over the presented fields. Any change to the slot,
+     * generation, expiry or permissions since issue makes it differ.
+     */
+    uint8_t expectedMac[TOKEN_MAC_SIZE];
+    SecurityError result = TokenComputeMac(context, capability, expectedMac);
     if (result != SECURITY_SUCCESS)
         return result;
     
-    /* Compare tokens using constant-time comparison */
-    if (!TokenCompareSecure(&capability->token, &testCapability.token)) {
+    bool match = SecureCompareConstantTime(capability->token.tokenData, expectedMac,
+                                           TOKEN_MAC_SIZE);
+    SecureMemoryWipe(expectedMac, sizeof(expectedMac));
+    
+    if (!match) {
         context->validationFailures++;
         context->securityViolations++;
         return SECURITY_ERROR_INVALID_TOKEN;
@@ -336,6 +705,557 @@ TokenCompareSecure(const SecureToken *token1, const SecureToken *token2)
     return SecureCompareConstantTime(token1, token2, sizeof(SecureToken));
 }
 
+/*
+ * Authenticated encryption
+ *
+ * Allocating and keying an EVP_CIPHER_CTX costs far more than sealing a
+ * small slot, so each thread keeps an encrypt/decrypt pair keyed for the
+ * context it used last and only sets a fresh nonce per message. OpenSSL
+ * dispatches AES-GCM to its AES-NI/PCLMULQDQ code when the CPU has them;
+ * without them ChaCha20-Poly1305 is the faster choice. Nonces are a
+ * random per-thread prefix followed by a counter, and the prefix is
+ * redrawn on every rekey and whenever the counter wraps.
+ */
+#define SECURE_CIPHER_KEY_SIZE    32
+#define SECURE_CIPHER_PREFIX_SIZE 8
+#define SECURE_CIPHER_PAD_CHUNK   64
+#define TOKEN_SEALED_SIZE         36      /* tokenData + generation */
+#define TOKEN_KEY_FORMAT          1
+
+typedef struct
+{
+    EVP_CIPHER_CTX *encrypt;
+    EVP_CIPHER_CTX *decrypt;
+    EVP_CIPHER_CTX *raw;                  /* AES256Encrypt/Decrypt, keyed per call */
+    uint32_t        epoch;                /* cipherEpoch keyed for, 0 = none */
+    uint8_t         noncePrefix[SECURE_CIPHER_PREFIX_SIZE];
+    uint32_t        nonceCounter;
+} SecureCipherCache;
+
+static const uint8_t SECURE_CIPHER_KEY_LABEL[] = "PERGYRA-SLOT-PAYLOAD";
+static const uint8_t SECURE_CIPHER_ZERO[SECURE_CIPHER_PAD_CHUNK];
+
+static __thread SecureCipherCache *tlsCipherCache = NULL;
+
+#ifdef __linux__
+static pthread_key_t  g_cipherCacheKey;
+static pthread_once_t g_cipherCacheOnce = PTHREAD_ONCE_INIT;
+#endif
+
+static SecurityCipher
+SecureCipherSelect(void)
+{
+    if (SECURITY_PAYLOAD_CIPHER != SECURITY_CIPHER_AUTO)
+        return SECURITY_PAYLOAD_CIPHER;
+    
+    bool accelerated = true;
+#if defined(__linux__) && (defined(__x86_64__) || defined(__i386__))
+    unsigned int eax, ebx, ecx, edx;
+    accelerated = __get_cpuid(1, &eax, &ebx, &ecx, &edx) &&
+                  (ecx & bit_AES) && (ecx & bit_PCLMUL);
+#elif defined(_WIN32) && (defined(_M_X64) || defined(_M_IX86))
+    int info[4];
+    __cpuid(info, 1);
+    accelerated = (info[2] & (1 << 25)) && (info[2] & (1 << 1));
+#endif
+    
+#ifndef OPENSSL_NO_CHACHA
+    if (!accelerated)
+        return SECURITY_CIPHER_CHACHA20_POLY1305;
+#endif
+    return SECURITY_CIPHER_AES_256_GCM;
+}
+
+static const EVP_CIPHER *
+SecureCipherEvp(SecurityCipher cipher)
+{
+#ifndef OPENSSL_NO_CHACHA
+    if (cipher == SECURITY_CIPHER_CHACHA20_POLY1305)
+        return EVP_chacha20_poly1305();
+#endif
+    return EVP_aes_256_gcm();
+}
+
+const char *
+SecurityCipherName(SecurityCipher cipher)
+{
+    switch (cipher) {
+        case SECURITY_CIPHER_AES_256_GCM:
+            return "AES-256-GCM";
+        case SECURITY_CIPHER_CHACHA20_POLY1305:
+            return "ChaCha20-Poly1305";
+        default:
+            return "auto";
+    }
+}
+
+static void
+SecureCipherCacheFree(void *arg)
+{
+    SecureCipherCache *cache = arg;
+    
+    /* Freeing a context cleanses its key schedule */
+    EVP_CIPHER_CTX_free(cache->encrypt);
+    EVP_CIPHER_CTX_free(cache->decrypt);
+    EVP_CIPHER_CTX_free(cache->raw);
+    SecureMemoryWipe(cache, sizeof(SecureCipherCache));
+    free(cache);
+}
+
+#ifdef __linux__
+static void
+SecureCipherCacheKeyCreate(void)
+{
+    pthread_key_create(&g_cipherCacheKey, SecureCipherCacheFree);
+}
+#endif
+
+/*
+ * The calling thread's cipher state, created on first use. On Linux it
+ * is freed when the thread exits.
+ */
+static SecureCipherCache *
+SecureCipherCacheThread(void)
+{
+    SecureCipherCache *cache = tlsCipherCache;
+    if (cache != NULL)
+        return cache;
+    
+    cache = calloc(1, sizeof(SecureCipherCache));
+    if (cache == NULL)
+        return NULL;
+    
+    cache->encrypt = EVP_CIPHER_CTX_new();
+    cache->decrypt = EVP_CIPHER_CTX_new();
+    cache->raw = EVP_CIPHER_CTX_new();
+    if (cache->encrypt == NULL || cache->decrypt == NULL || cache->raw == NULL) {
+        SecureCipherCacheFree(cache);
+        return NULL;
+    }
+    
+#ifdef __linux__
+    pthread_once(&g_cipherCacheOnce, SecureCipherCacheKeyCreate);
+    pthread_setspecific(g_cipherCacheKey, cache);
+#endif
+    
+    tlsCipherCache = cache;
+    return cache;
+}
+
+static SecurityError
+SecureCipherCacheRekey(SecureCipherCache *cache, const SecurityContext *context)
+{
+    const EVP_CIPHER *cipher = SecureCipherEvp(context->cipher);
+    uint8_t key[SECURE_CIPHER_KEY_SIZE];
+    unsigned int keySize = 0;
+    
+    cache->epoch = 0;
+    
+    /* Payloads get their own key, separate from the token MAC key */
+    if (HMAC(EVP_sha256(), context->masterKey, (int)context->keySize,
+             SECURE_CIPHER_KEY_LABEL, sizeof(SECURE_CIPHER_KEY_LABEL) - 1,
+             key, &keySize) == NULL || keySize != sizeof(key))
+        return SECURITY_ERROR_CRYPTOGRAPHY_FAILED;
+    
+    bool keyed = EVP_EncryptInit_ex(cache->encrypt, cipher, NULL, key, NULL) == 1 &&
+                 EVP_DecryptInit_ex(cache->decrypt, cipher, NULL, key, NULL) == 1;
+    SecureMemoryWipe(key, sizeof(key));
+    if (!keyed)
+        return SECURITY_ERROR_CRYPTOGRAPHY_FAILED;
+    
+    SecurityError result = SecureRandomGenerate(cache->noncePrefix,
+                                                sizeof(cache->noncePrefix));
+    if (result != SECURITY_SUCCESS)
+        return result;
+    
+    cache->nonceCounter = 0;
+    cache->epoch = context->cipherEpoch;
+    
+    return SECURITY_SUCCESS;
+}
+
+static SecureCipherCache *
+SecureCipherCacheKeyed(const SecurityContext *context)
+{
+    SecureCipherCache *cache = SecureCipherCacheThread();
+    if (cache == NULL)
+        return NULL;
+    
+    if (cache->epoch != context->cipherEpoch &&
+        SecureCipherCacheRekey(cache, context) != SECURITY_SUCCESS)
+        return NULL;
+    
+    return cache;
+}
+
+/*
+ * Drop the calling thread's key schedule for a context being destroyed.
+ * Other threads rekey (or free theirs) on their next use or exit.
+ */
+static void
+SecureCipherCacheRelease(const SecurityContext *context)
+{
+    SecureCipherCache *cache = tlsCipherCache;
+    if (cache == NULL || cache->epoch == 0 || cache->epoch != context->cipherEpoch)
+        return;
+    
+    EVP_CIPHER_CTX_reset(cache->encrypt);
+    EVP_CIPHER_CTX_reset(cache->decrypt);
+    cache->epoch = 0;
+}
+
+static SecurityError
+SecureCipherNextNonce(SecureCipherCache *cache, uint8_t nonce[SECURITY_PAYLOAD_NONCE_SIZE])
+{
+    if (cache->nonceCounter == UINT32_MAX) {
+        SecurityError result = SecureRandomGenerate(cache->noncePrefix,
+                                                    sizeof(cache->noncePrefix));
+        if (result != SECURITY_SUCCESS)
+            return result;
+        cache->nonceCounter = 0;
+    }
+    
+    cache->nonceCounter++;
+    memcpy(nonce, cache->noncePrefix, SECURE_CIPHER_PREFIX_SIZE);
+    TokenPackU32(nonce + SECURE_CIPHER_PREFIX_SIZE, cache->nonceCounter);
+    
+    return SECURITY_SUCCESS;
+}
+
+/*
+ * Encrypt size bytes, then zeros up to capacity, under a fresh nonce
+ */
+static SecurityError
+SecureCipherSeal(SecureCipherCache *cache, const uint8_t *aad, size_t aadSize,
+                 const uint8_t *plaintext, size_t size, size_t capacity,
+                 uint8_t *nonce, uint8_t *tag, uint8_t *ciphertext)
+{
+    EVP_CIPHER_CTX *ctx = cache->encrypt;
+    int outSize;
+    
+    if (capacity < size || capacity > INT_MAX)
+        return SECURITY_ERROR_INVALID_TOKEN;
+    
+    SecurityError result = SecureCipherNextNonce(cache, nonce);
+    if (result != SECURITY_SUCCESS)
+        return result;
+    
+    bool ok = EVP_EncryptInit_ex(ctx, NULL, NULL, NULL, nonce) == 1 &&
+              EVP_EncryptUpdate(ctx, NULL, &outSize, aad, (int)aadSize) == 1 &&
+              (size == 0 ||
+               EVP_EncryptUpdate(ctx, ciphertext, &outSize, plaintext, (int)size) == 1);
+    
+    for (size_t offset = size; ok && offset < capacity; ) {
+        size_t chunk = capacity - offset;
+        if (chunk > SECURE_CIPHER_PAD_CHUNK)
+            chunk = SECURE_CIPHER_PAD_CHUNK;
+        ok = EVP_EncryptUpdate(ctx, ciphertext + offset, &outSize,
+                               SECURE_CIPHER_ZERO, (int)chunk) == 1;
+        offset += chunk;
+    }
+    
+    ok = ok &&
+         EVP_EncryptFinal_ex(ctx, ciphertext + capacity, &outSize) == 1 &&
+         EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_GET_TAG,
+                             SECURITY_PAYLOAD_TAG_SIZE, tag) == 1;
+    
+    return ok ? SECURITY_SUCCESS : SECURITY_ERROR_CRYPTOGRAPHY_FAILED;
+}
+
+/*
+ * Decrypt and authenticate capacity bytes, keeping the first plaintextSize.
+ * Nothing decrypted is left in the output unless the tag verifies.
+ */
+static SecurityError
+SecureCipherOpen(SecureCipherCache *cache, const uint8_t *aad, size_t aadSize,
+                 const uint8_t *nonce, const uint8_t *tag,
+                 const uint8_t *ciphertext, size_t capacity,
+                 uint8_t *plaintext, size_t plaintextSize)
+{
+    EVP_CIPHER_CTX *ctx = cache->decrypt;
+    uint8_t discard[SECURE_CIPHER_PAD_CHUNK];
+    size_t keep = plaintextSize < capacity ? plaintextSize : capacity;
+    int outSize;
+    
+    if (capacity > INT_MAX)
+        return SECURITY_ERROR_INVALID_TOKEN;
+    
+    bool ok = EVP_DecryptInit_ex(ctx, NULL, NULL, NULL, nonce) == 1 &&
+              EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_TAG,
+                                  SECURITY_PAYLOAD_TAG_SIZE, (void *)tag) == 1 &&
+              EVP_DecryptUpdate(ctx, NULL, &outSize, aad, (int)aadSize) == 1 &&
+              (keep == 0 ||
+               EVP_DecryptUpdate(ctx, plaintext, &outSize, ciphertext, (int)keep) == 1);
+    
+    /* Bytes the caller has no room for still go through the MAC */
+    for (size_t offset = keep; ok && offset < capacity; ) {
+        size_t chunk = capacity - offset;
+        if (chunk > sizeof(discard))
+            chunk = sizeof(discard);
+        ok = EVP_DecryptUpdate(ctx, discard, &outSize, ciphertext + offset,
+                               (int)chunk) == 1;
+        offset += chunk;
+    }
+    
+    ok = ok && EVP_DecryptFinal_ex(ctx, discard, &outSize) == 1;
+    SecureMemoryWipe(discard, sizeof(discard));
+    
+    if (!ok) {
+        SecureMemoryWipe(plaintext, keep);
+        return SECURITY_ERROR_CRYPTOGRAPHY_FAILED;
+    }
+    
+    return SECURITY_SUCCESS;
+}
+
+/*
+ * Slot payloads: nonce || tag || ciphertext, with the slot ID as AAD so a
+ * sealed block cannot be replayed into another slot
+ */
+static void
+SecurePayloadAad(uint8_t aad[5], uint32_t slotId)
+{
+    aad[0] = 'P';
+    TokenPackU32(aad + 1, slotId);
+}
+
+SecurityError
+SecurePayloadSeal(SecurityContext *context, uint32_t slotId,
+                  const void *plaintext, size_t size,
+                  size_t capacity, uint8_t *sealed)
+{
+    SecurePayloadItem item = {
+        .slotId = slotId,
+        .plaintext = plaintext,
+        .size = size,
+        .capacity = capacity,
+        .sealed = sealed
+    };
+    
+    SecurePayloadSealBatch(context, &item, 1);
+    return item.result;
+}
+
+/*
+ * Seal many payloads with one cipher lookup. Each item's result is set;
+ * returns the number sealed successfully.
+ */
+size_t
+SecurePayloadSealBatch(SecurityContext *context, SecurePayloadItem *items,
+                       size_t count)
+{
+    SecureCipherCache *cache = NULL;
+    SecurityError failure = SECURITY_ERROR_CONTEXT_NOT_INITIALIZED;
+    size_t sealedCount = 0;
+    
+    if (items == NULL)
+        return 0;
+    
+    if (context != NULL && context->initialized) {
+        cache = SecureCipherCacheKeyed(context);
+        failure = SECURITY_ERROR_CRYPTOGRAPHY_FAILED;
+    }
+    
+    for (size_t i = 0; i < count; i++) {
+        SecurePayloadItem *item = &items[i];
+        
+        if (cache == NULL) {
+            item->result = failure;
+            continue;
+        }
+        
+        if (item->sealed == NULL || (item->plaintext == NULL && item->size > 0)) {
+            item->result = SECURITY_ERROR_INVALID_TOKEN;
+            continue;
+        }
+        
+        uint8_t aad[5];
+        SecurePayloadAad(aad, item->slotId);
+        item->result = SecureCipherSeal(cache, aad, sizeof(aad),
+                                        item->plaintext, item->size, item->capacity,
+                                        item->sealed,
+                                        item->sealed + SECURITY_PAYLOAD_NONCE_SIZE,
+                                        item->sealed + SECURITY_PAYLOAD_OVERHEAD);
+        if (item->result == SECURITY_SUCCESS)
+            sealedCount++;
+    }
+    
+    return sealedCount;
+}
+
+SecurityError
+SecurePayloadOpen(SecurityContext *context, uint32_t slotId,
+                  const uint8_t *sealed, size_t capacity,
+                  void *plaintext, size_t plaintextSize)
+{
+    if (context == NULL || !context->initialized)
+        return SECURITY_ERROR_CONTEXT_NOT_INITIALIZED;
+    
+    if (sealed == NULL || (plaintext == NULL && plaintextSize > 0))
+        return SECURITY_ERROR_INVALID_TOKEN;
+    
+    SecureCipherCache *cache = SecureCipherCacheKeyed(context);
+    if (cache == NULL)
+        return SECURITY_ERROR_CRYPTOGRAPHY_FAILED;
+    
+    uint8_t aad[5];
+    SecurePayloadAad(aad, slotId);
+    return SecureCipherOpen(cache, aad, sizeof(aad), sealed,
+                            sealed + SECURITY_PAYLOAD_NONCE_SIZE,
+                            sealed + SECURITY_PAYLOAD_OVERHEAD, capacity,
+                            plaintext, plaintextSize);
+}
+
+/*
+ * Token storage. encryptedToken holds nonce || E(tokenData || generation);
+ * the checksum follows from the generation and is recomputed on decrypt.
+ * keyVersion records the format and cipher so a token sealed under a
+ * different cipher is refused rather than misread.
+ */
+static uint32_t
+TokenKeyVersion(const SecurityContext *context)
+{
+    return (TOKEN_KEY_FORMAT << 8) | (uint32_t)context->cipher;
+}
+
+SecurityError
+TokenEncrypt(SecurityContext *context, const SecureToken *plainToken,
+             EncryptedToken *encryptedToken)
+{
+    static const uint8_t aad[] = { 'T' };
+    
+    if (context == NULL || !context->initialized)
+        return SECURITY_ERROR_CONTEXT_NOT_INITIALIZED;
+    
+    if (plainToken == NULL || encryptedToken == NULL)
+        return SECURITY_ERROR_INVALID_TOKEN;
+    
+    SecureCipherCache *cache = SecureCipherCacheKeyed(context);
+    if (cache == NULL)
+        return SECURITY_ERROR_CRYPTOGRAPHY_FAILED;
+    
+    uint8_t plain[TOKEN_SEALED_SIZE];
+    memcpy(plain, plainToken->tokenData, sizeof(plainToken->tokenData));
+    TokenPackU32(plain + sizeof(plainToken->tokenData), plainToken->generation);
+    
+    SecurityError result = SecureCipherSeal(cache, aad, sizeof(aad),
+                                            plain, sizeof(plain), sizeof(plain),
+                                            encryptedToken->encryptedToken,
+                                            encryptedToken->authTag,
+                                            encryptedToken->encryptedToken +
+                                            SECURITY_PAYLOAD_NONCE_SIZE);
+    SecureMemoryWipe(plain, sizeof(plain));
+    
+    if (result != SECURITY_SUCCESS)
+        return result;
+    
+    encryptedToken->keyVersion = TokenKeyVersion(context);
+    return SECURITY_SUCCESS;
+}
+
+SecurityError
+TokenDecrypt(SecurityContext *context, const EncryptedToken *encryptedToken,
+             SecureToken *plainToken)
+{
+    static const uint8_t aad[] = { 'T' };
+    
+    if (context == NULL || !context->initialized)
+        return SECURITY_ERROR_CONTEXT_NOT_INITIALIZED;
+    
+    if (encryptedToken == NULL || plainToken == NULL ||
+        encryptedToken->keyVersion != TokenKeyVersion(context))
+        return SECURITY_ERROR_INVALID_TOKEN;
+    
+    SecureCipherCache *cache = SecureCipherCacheKeyed(context);
+    if (cache == NULL)
+        return SECURITY_ERROR_CRYPTOGRAPHY_FAILED;
+    
+    uint8_t plain[TOKEN_SEALED_SIZE];
+    SecurityError result = SecureCipherOpen(cache, aad, sizeof(aad),
+                                            encryptedToken->encryptedToken,
+                                            encryptedToken->authTag,
+                                            encryptedToken->encryptedToken +
+                                            SECURITY_PAYLOAD_NONCE_SIZE,
+                                            sizeof(plain), plain, sizeof(plain));
+    if (result != SECURITY_SUCCESS)
+        return SECURITY_ERROR_INVALID_TOKEN;
+    
+    memcpy(plainToken->tokenData, plain, sizeof(plainToken->tokenData));
+    plainToken->generation = TokenUnpackU32(plain + sizeof(plainToken->tokenData));
+    plainToken->checksum = HardwareFingerprintHash(&context->hwFingerprint) ^
+                           plainToken->generation;
+    SecureMemoryWipe(plain, sizeof(plain));
+    
+    return SECURITY_SUCCESS;
+}
+
+/*
+ * AES-256-GCM with a caller-supplied key and 128-bit IV
+ */
+SecurityError
+AES256Encrypt(const uint8_t key[32], const uint8_t iv[16],
+              const uint8_t *plaintext, size_t plaintextSize,
+              uint8_t *ciphertext, uint8_t authTag[16])
+{
+    if (key == NULL || iv == NULL || ciphertext == NULL || authTag == NULL ||
+        (plaintext == NULL && plaintextSize > 0) || plaintextSize > INT_MAX)
+        return SECURITY_ERROR_INVALID_TOKEN;
+    
+    SecureCipherCache *cache = SecureCipherCacheThread();
+    if (cache == NULL)
+        return SECURITY_ERROR_CRYPTOGRAPHY_FAILED;
+    
+    EVP_CIPHER_CTX *ctx = cache->raw;
+    int outSize;
+    bool ok = EVP_EncryptInit_ex(ctx, EVP_aes_256_gcm(), NULL, NULL, NULL) == 1 &&
+              EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_IVLEN, 16, NULL) == 1 &&
+              EVP_EncryptInit_ex(ctx, NULL, NULL, key, iv) == 1 &&
+              (plaintextSize == 0 ||
+               EVP_EncryptUpdate(ctx, ciphertext, &outSize, plaintext,
+                                 (int)plaintextSize) == 1) &&
+              EVP_EncryptFinal_ex(ctx, ciphertext + plaintextSize, &outSize) == 1 &&
+              EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_GET_TAG, 16, authTag) == 1;
+    
+    /* The caller's key must not outlive the call */
+    EVP_CIPHER_CTX_reset(ctx);
+    
+    return ok ? SECURITY_SUCCESS : SECURITY_ERROR_CRYPTOGRAPHY_FAILED;
+}
+
+SecurityError
+AES256Decrypt(const uint8_t key[32], const uint8_t iv[16],
+              const uint8_t *ciphertext, size_t ciphertextSize,
+              const uint8_t authTag[16], uint8_t *plaintext)
+{
+    if (key == NULL || iv == NULL || authTag == NULL || plaintext == NULL ||
+        (ciphertext == NULL && ciphertextSize > 0) || ciphertextSize > INT_MAX)
+        return SECURITY_ERROR_INVALID_TOKEN;
+    
+    SecureCipherCache *cache = SecureCipherCacheThread();
+    if (cache == NULL)
+        return SECURITY_ERROR_CRYPTOGRAPHY_FAILED;
+    
+    EVP_CIPHER_CTX *ctx = cache->raw;
+    int outSize;
+    bool ok = EVP_DecryptInit_ex(ctx, EVP_aes_256_gcm(), NULL, NULL, NULL) == 1 &&
+              EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_IVLEN, 16, NULL) == 1 &&
+              EVP_DecryptInit_ex(ctx, NULL, NULL, key, iv) == 1 &&
+              EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_TAG, 16, (void *)authTag) == 1 &&
+              (ciphertextSize == 0 ||
+               EVP_DecryptUpdate(ctx, plaintext, &outSize, ciphertext,
+                                 (int)ciphertextSize) == 1) &&
+              EVP_DecryptFinal_ex(ctx, plaintext + ciphertextSize, &outSize) == 1;
+    
+    EVP_CIPHER_CTX_reset(ctx);
+    
+    if (!ok) {
+        SecureMemoryWipe(plaintext, ciphertextSize);
+        return SECURITY_ERROR_CRYPTOGRAPHY_FAILED;
+    }
+    
+    return SECURITY_SUCCESS;
+}
+
 /*
  * Cryptographic utilities
  */
@@ -445,6 +1365,55 @@ SecureMemoryWipe(void *addr, size_t size)
 #endif
 }
 
+/*
+ * Security audit and logging
+ *
+ * Slot-level events go to the SecurityAuditLogger; these cover the
+ * context-wide counters that the slot manager reports alongside them.
+ */
+void
+SecurityAuditLog(SecurityContext *context, const char *event,
+                 const char *details)
+{
+    if (context == NULL || event == NULL)
+        return;
+
+    /* The caller already wrote the line; only violations move a counter */
+    if (strstr(event, "VIOLATION") != NULL || strstr(event, "violation") != NULL)
+        context->securityViolations++;
+
+    (void)details;
+}
+
+void
+SecurityPrintStatistics(const SecurityContext *context)
+{
+    if (context == NULL)
+        return;
+
+    printf("Tokens Issued: %llu\n", (unsigned long long)context->tokensIssued);
+    printf("Tokens Validated: %llu\n", (unsigned long long)context->tokensValidated);
+    printf("Validation Failures: %llu\n",
+           (unsigned long long)context->validationFailures);
+    printf("Security Violations: %llu\n",
+           (unsigned long long)context->securityViolations);
+    printf("Payload Cipher: %s\n", SecurityCipherName(context->cipher));
+}
+
+bool
+SecurityDetectAnomalies(const SecurityContext *context)
+{
+    if (context == NULL)
+        return false;
+
+    /* Many violations, or a failure rate above one in four validations */
+    if (context->securityViolations > SECURITY_MAX_VALIDATION_FAILURES)
+        return true;
+
+    return context->tokensValidated > SECURITY_MAX_VALIDATION_FAILURES &&
+           context->validationFailures * 4 > context->tokensValidated;
+}
+
 /*
  * Platform-specific hardware detection
  */
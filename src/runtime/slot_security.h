@@ -28,11 +28,13 @@ typedef enum
 
 /*
  * Secure token structure (256-bit total)
+ * tokenData is an HMAC-SHA256 tag, keyed by the context master key, over the
+ * owning capability's slot, generation, timestamps, level and permissions.
  * Never stored in plaintext in memory when SECURITY_LEVEL_ENCRYPTED is used
  */
 typedef struct
 {
-    uint8_t  tokenData[32];        /* 256-bit cryptographic token */
+    uint8_t  tokenData[32];        /* HMAC-SHA256 capability tag */
     uint32_t generation;           /* Token generation counter */
     uint32_t checksum;             /* Integrity checksum */
 } SecureToken;
@@ -74,8 +76,30 @@ typedef struct
     uint32_t keyVersion;           /* Encryption key version */
 } EncryptedToken;
 
+/*
+ * AEAD cipher for encrypted tokens and slot payloads. AUTO picks AES-GCM
+ * when the CPU has AES-NI and PCLMULQDQ, ChaCha20-Poly1305 otherwise.
+ */
+typedef enum
+{
+    SECURITY_CIPHER_AUTO = 0,
+    SECURITY_CIPHER_AES_256_GCM,
+    SECURITY_CIPHER_CHACHA20_POLY1305
+} SecurityCipher;
+
+/*
+ * Background hardware re-verification state (private to slot_security.c)
+ */
+typedef struct HardwareMonitor HardwareMonitor;
+
 /*
  * Security context for token operations
+ *
+ * The fingerprint is taken once at initialization. Hardware-bound tokens
+ * are then checked against a cached result, which a monitor refreshes
+ * every hardwareCheckMs and, on Linux, whenever a network link changes.
+ * Below SECURITY_LEVEL_HARDWARE the monitor starts with the first
+ * hardware-bound validation.
  */
 typedef struct
 {
@@ -84,10 +108,14 @@ typedef struct
     size_t              keySize;        /* Master key size */
     SecurityLevel       defaultLevel;   /* Default security level */
     bool                initialized;    /* Context initialization status */
+    uint64_t            hardwareCheckMs; /* Re-verification interval (0 = events only) */
+    HardwareMonitor    *hwMonitor;      /* Cached fingerprint check */
+    SecurityCipher      cipher;         /* Resolved at initialization */
+    uint32_t            cipherEpoch;    /* Identifies the key to per-thread cipher and token caches */
     
     /* Security statistics */
     uint64_t           tokensIssued;
-    uint64_t           tokensValidated;
+    uint64_t           tokensValidated; /* Token cache hits included */
     uint64_t           validationFailures;
     uint64_t           securityViolations;
 } SecurityContext;
@@ -115,6 +143,9 @@ SecurityContext *SecurityContextCreate(SecurityLevel defaultLevel);
 void             SecurityContextDestroy(SecurityContext *context);
 SecurityError    SecurityContextInitialize(SecurityContext *context);
 SecurityError    SecurityContextUpdateHardware(SecurityContext *context);
+void             SecurityContextSetHardwareCheckInterval(SecurityContext *context,
+                                                         uint64_t intervalMs);
+bool             SecurityContextHardwareMatches(SecurityContext *context);
 
 /*
  * Hardware fingerprinting
@@ -143,6 +174,38 @@ SecurityError TokenEncrypt(SecurityContext *context, const SecureToken *plainTok
 SecurityError TokenDecrypt(SecurityContext *context, const EncryptedToken *encryptedToken,
                           SecureToken *plainToken);
 
+/*
+ * Encrypted payloads
+ *
+ * A sealed payload is nonce || tag || ciphertext, keyed by a key derived
+ * from the master key, with the slot ID as associated data. Plaintext
+ * shorter than the capacity is zero-padded, so a slot's sealed size never
+ * depends on what was written. Each thread reuses a keyed cipher context.
+ */
+#define SECURITY_PAYLOAD_NONCE_SIZE 12
+#define SECURITY_PAYLOAD_TAG_SIZE   16
+#define SECURITY_PAYLOAD_OVERHEAD   (SECURITY_PAYLOAD_NONCE_SIZE + SECURITY_PAYLOAD_TAG_SIZE)
+
+typedef struct
+{
+    uint32_t       slotId;         /* Bound as associated data */
+    const void    *plaintext;
+    size_t         size;           /* Plaintext bytes */
+    size_t         capacity;       /* Ciphertext bytes (>= size) */
+    uint8_t       *sealed;         /* capacity + SECURITY_PAYLOAD_OVERHEAD bytes */
+    SecurityError  result;         /* Set by SecurePayloadSealBatch */
+} SecurePayloadItem;
+
+SecurityError SecurePayloadSeal(SecurityContext *context, uint32_t slotId,
+                               const void *plaintext, size_t size,
+                               size_t capacity, uint8_t *sealed);
+size_t        SecurePayloadSealBatch(SecurityContext *context,
+                                    SecurePayloadItem *items, size_t count);
+SecurityError SecurePayloadOpen(SecurityContext *context, uint32_t slotId,
+                               const uint8_t *sealed, size_t capacity,
+                               void *plaintext, size_t plaintextSize);
+const char   *SecurityCipherName(SecurityCipher cipher);
+
 /*
  * Cryptographic utilities
  */
@@ -202,6 +265,14 @@ extern uint64_t SecureTimestamp(void);
 #define SECURITY_DEFAULT_TOKEN_TTL_MS 300000  /* 5 minutes */
 #endif
 
+#ifndef SECURITY_HARDWARE_CHECK_MS
+#define SECURITY_HARDWARE_CHECK_MS 30000  /* 30 seconds */
+#endif
+
+#ifndef SECURITY_PAYLOAD_CIPHER
+#define SECURITY_PAYLOAD_CIPHER SECURITY_CIPHER_AUTO
+#endif
+
 #ifndef SECURITY_MAX_VALIDATION_FAILURES
 #define SECURITY_MAX_VALIDATION_FAILURES 10
 #endif
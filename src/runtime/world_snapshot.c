@@ -0,0 +1,1033 @@
+/*
+ * Copyright (c) 2025 Pergyra Language Project
+ * World Snapshot Implementation
+ */
+
+#define _GNU_SOURCE
+
+#include "world_snapshot.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <time.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define SNAPSHOT_MAGIC      0x31504e5357475050ULL   /* "PPGWSNP1" */
+#define SNAPSHOT_VERSION    2
+#define SNAPSHOT_NONE       UINT64_MAX
+#define SNAPSHOT_SLOTS      2                       /* Header pages, one per image */
+
+static uint64_t GetTimeNanos(void);
+
+/* ============= File Format ============= */
+
+/*
+ * [header A][header B][image][image]
+ *
+ * Each header page describes one image: pool pages followed by metadata
+ * pages. The pool starts on a page boundary so that it can be mapped on
+ * its own. Metadata (slot table, world, systemics, parties, accesses,
+ * strings) is rebuilt every checkpoint; both regions are rewritten page
+ * by page, only where the contents changed since that image was last
+ * written. Records are in host byte order and hold offsets, never
+ * pointers.
+ *
+ * Checkpoints alternate between the two headers. A checkpoint rewrites
+ * the image of the older generation, syncs it, and only then writes its
+ * header, so a crash at any point leaves the newer generation intact.
+ * Headers carry a checksum; open takes the newest one that verifies.
+ */
+
+typedef enum {
+    SECTION_POOL,
+    SECTION_POOL_BLOCKS,             /* One byte per block, non-zero = used */
+    SECTION_SLOTS,
+    SECTION_WORLD,
+    SECTION_SYSTEMICS,
+    SECTION_PARTIES,
+    SECTION_ACCESSES,
+    SECTION_STRINGS,
+    SECTION_COUNT
+} SnapshotSectionId;
+
+typedef struct {
+    uint64_t offset;                 /* From the start of the file */
+    uint64_t size;
+} SnapshotSection;
+
+typedef struct {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t pageSize;
+    uint64_t generation;
+    uint32_t headerSlot;             /* Header page this was written to */
+    uint32_t hasSlots;
+    uint64_t imageOffset;            /* Pages owned by this generation */
+    uint64_t imageEnd;
+
+    /* Slot manager */
+    uint64_t maxSlots;
+    uint64_t blockSize;
+    uint64_t totalAllocations;
+    uint64_t totalDeallocations;
+    uint64_t activeSlots;
+    uint32_t nextSlotId;
+    uint32_t reserved;
+
+    SnapshotSection sections[SECTION_COUNT];
+    uint64_t checksum;               /* Of the header with this field zeroed */
+} SnapshotHeader;
+
+typedef struct {
+    uint64_t dataOffset;             /* Into the pool, SNAPSHOT_NONE if unset */
+    uint64_t allocationTime;
+    uint64_t lastAccessTime;
+    uint32_t slotId;
+    uint32_t typeTag;
+    uint32_t ttl;
+    uint32_t threadAffinity;
+    uint32_t securityLevel;
+    uint32_t tokenGeneration;
+    uint32_t accessCount;
+    uint8_t occupied;
+    uint8_t securityEnabled;
+    uint8_t reserved[2];
+    EncryptedToken writeToken;
+} SnapshotSlotRecord;
+
+typedef struct {
+    uint64_t nameOffset;             /* Into the string section */
+    uint64_t frameCount;
+    uint64_t availableMemory;
+    double replanThreshold;
+    uint32_t systemicCount;
+    uint32_t replanInterval;
+    uint32_t availableCpuCores;
+    uint32_t availableGpuUnits;
+    uint32_t preferLatency;
+    uint32_t reserved;
+} SnapshotWorldRecord;
+
+typedef struct {
+    uint64_t slotNameOffset;
+    uint64_t nameOffset;
+    uint64_t typeOffset;
+    uint64_t totalExecutions;
+    uint64_t sampledExecutions;
+    uint64_t totalTimeNs;
+    uint32_t firstParty;
+    uint32_t partyCount;
+    uint32_t partitionCount;
+    uint32_t errorCount;
+} SnapshotSystemicRecord;
+
+typedef struct {
+    uint64_t slotNameOffset;
+    uint64_t partyTypeOffset;
+    uint64_t partitionKey;
+    uint64_t executions;
+    uint64_t sampledExecutions;
+    uint64_t totalTimeNs;
+    uint64_t costEwmaNs;
+    uint32_t firstAccess;
+    uint32_t accessCount;
+    uint32_t worker;
+    uint32_t reserved;
+} SnapshotPartyRecord;
+
+typedef struct {
+    uint64_t fieldNameOffset;
+    uint32_t access;
+    uint32_t reserved;
+} SnapshotAccessRecord;
+
+/* ============= Buffers ============= */
+
+typedef struct {
+    uint8_t* data;
+    size_t size;
+    size_t capacity;
+    bool failed;                     /* A string could not be added */
+} SnapshotBuffer;
+
+/* Append zeroed space at the given alignment; returns its offset (SIZE_MAX on failure) */
+static size_t SnapshotBufferAppend(SnapshotBuffer* buffer, size_t size, size_t alignment)
+{
+    size_t offset = (buffer->size + alignment - 1) / alignment * alignment;
+
+    if (offset + size > buffer->capacity) {
+        size_t capacity = buffer->capacity ? buffer->capacity : 4096;
+        while (capacity < offset + size) capacity *= 2;
+        uint8_t* data = (uint8_t*)realloc(buffer->data, capacity);
+        if (!data) return SIZE_MAX;
+        buffer->data = data;
+        buffer->capacity = capacity;
+    }
+
+    memset(buffer->data + buffer->size, 0, offset + size - buffer->size);
+    buffer->size = offset + size;
+    return offset;
+}
+
+static uint64_t SnapshotAddString(SnapshotBuffer* strings, const char* str)
+{
+    if (!str) str = "";
+
+    size_t length = strlen(str) + 1;
+    if (strings->size + length > strings->capacity) {
+        size_t capacity = strings->capacity ? strings->capacity : 4096;
+        while (capacity < strings->size + length) capacity *= 2;
+        uint8_t* data = (uint8_t*)realloc(strings->data, capacity);
+        if (!data) {
+            strings->failed = true;
+            return SNAPSHOT_NONE;
+        }
+        strings->data = data;
+        strings->capacity = capacity;
+    }
+
+    uint64_t offset = strings->size;
+    memcpy(strings->data + strings->size, str, length);
+    strings->size += length;
+    return offset;
+}
+
+/* ============= Dirty Pages ============= */
+
+typedef struct {
+    uint64_t* hashes;
+    size_t count;
+    bool valid;                      /* False forces every page out */
+} SnapshotPageHashes;
+
+/*
+ * Word-at-a-time hash. Each step is a bijection of the running state for
+ * a fixed word, so a page differing in a single word always hashes
+ * differently; wider changes collide with probability ~2^-64.
+ */
+static uint64_t HashPage(const uint8_t* page, size_t size)
+{
+    uint64_t hash = 0x9E3779B97F4A7C15ULL ^ size;
+    size_t words = size / sizeof(uint64_t);
+
+    for (size_t i = 0; i < words; i++) {
+        uint64_t word;
+        memcpy(&word, page + i * sizeof(uint64_t), sizeof(word));
+        hash = (hash ^ word) * 0xFF51AFD7ED558CCDULL;
+        hash ^= hash >> 32;
+    }
+
+    if (size % sizeof(uint64_t)) {
+        uint64_t word = 0;
+        memcpy(&word, page + words * sizeof(uint64_t), size % sizeof(uint64_t));
+        hash = (hash ^ word) * 0xFF51AFD7ED558CCDULL;
+        hash ^= hash >> 32;
+    }
+
+    return hash;
+}
+
+static bool SnapshotPageHashesResize(SnapshotPageHashes* hashes, size_t count)
+{
+    if (hashes->count == count) return true;
+
+    uint64_t* resized = (uint64_t*)realloc(hashes->hashes, (count ? count : 1) * sizeof(uint64_t));
+    if (!resized) return false;
+
+    hashes->hashes = resized;
+    hashes->count = count;
+    hashes->valid = false;
+    return true;
+}
+
+static bool SnapshotWriteAll(int fd, const void* data, size_t size, uint64_t offset)
+{
+    const uint8_t* bytes = (const uint8_t*)data;
+
+    while (size > 0) {
+        ssize_t written = pwrite(fd, bytes, size, (off_t)offset);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        bytes += written;
+        size -= (size_t)written;
+        offset += (uint64_t)written;
+    }
+    return true;
+}
+
+/* ============= Headers ============= */
+
+static uint64_t SnapshotHeaderChecksum(const SnapshotHeader* header)
+{
+    SnapshotHeader copy = *header;
+    copy.checksum = 0;
+    return HashPage((const uint8_t*)&copy, sizeof(copy));
+}
+
+/* Read header slot `slot`; false if it is torn, foreign or reaches past fileSize */
+static bool SnapshotReadHeader(int fd, uint32_t slot, uint64_t fileSize, SnapshotHeader* header)
+{
+    uint64_t pageSize = (uint64_t)sysconf(_SC_PAGESIZE);
+
+    if (pread(fd, header, sizeof(*header), (off_t)(slot * pageSize)) != (ssize_t)sizeof(*header)) {
+        return false;
+    }
+
+    bool valid = header->magic == SNAPSHOT_MAGIC &&
+        header->version == SNAPSHOT_VERSION &&
+        header->checksum == SnapshotHeaderChecksum(header) &&
+        header->headerSlot == slot &&
+        header->pageSize == (uint32_t)pageSize &&
+        header->imageOffset >= SNAPSHOT_SLOTS * pageSize &&
+        header->imageOffset <= header->imageEnd &&
+        header->imageEnd <= fileSize;
+
+    for (int s = 0; valid && s < SECTION_COUNT; s++) {
+        const SnapshotSection* section = &header->sections[s];
+        valid = section->offset >= header->imageOffset &&
+                section->offset <= header->imageEnd &&
+                section->size <= header->imageEnd - section->offset;
+    }
+
+    return valid;
+}
+
+/* Read both header slots; returns the one with the newest generation, -1 if neither verifies */
+static int SnapshotReadHeaders(int fd, uint64_t fileSize, SnapshotHeader headers[SNAPSHOT_SLOTS],
+                               bool valid[SNAPSHOT_SLOTS])
+{
+    int newest = -1;
+
+    for (uint32_t s = 0; s < SNAPSHOT_SLOTS; s++) {
+        valid[s] = SnapshotReadHeader(fd, s, fileSize, &headers[s]);
+        if (valid[s] && (newest < 0 || headers[s].generation > headers[newest].generation)) {
+            newest = (int)s;
+        }
+    }
+    return newest;
+}
+
+/* ============= Checkpoint ============= */
+
+/* The pages behind one header slot */
+typedef struct {
+    uint64_t offset;
+    uint64_t end;                    /* 0 if the slot holds no image */
+    SnapshotPageHashes poolHashes;
+    SnapshotPageHashes metaHashes;
+    const void* poolBase;            /* Pool the hashes describe */
+    uint64_t metaOffset;
+} SnapshotImage;
+
+struct WorldSnapshotWriter {
+    int fd;
+    size_t pageSize;
+    uint64_t generation;
+    uint64_t fileSize;
+
+    uint32_t newest;                 /* Header slot of the last complete generation */
+    SnapshotImage images[SNAPSHOT_SLOTS];
+
+    /* Reused across checkpoints */
+    SnapshotBuffer meta;
+    SnapshotBuffer strings;
+
+    WorldSnapshotStats stats;
+};
+
+WorldSnapshotWriter* WorldSnapshotWriterOpen(const char* path)
+{
+    if (!path) return NULL;
+
+    WorldSnapshotWriter* writer = (WorldSnapshotWriter*)calloc(1, sizeof(WorldSnapshotWriter));
+    if (!writer) return NULL;
+
+    /* No O_TRUNC: a pool restored from this file may still map its pages */
+    writer->fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (writer->fd < 0) {
+        free(writer);
+        return NULL;
+    }
+
+    struct stat st;
+    if (fstat(writer->fd, &st) != 0) {
+        close(writer->fd);
+        free(writer);
+        return NULL;
+    }
+
+    writer->pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    writer->fileSize = (uint64_t)st.st_size;
+    writer->newest = SNAPSHOT_SLOTS - 1;
+
+    /* Continue the generation count of an existing snapshot and keep clear of its images */
+    SnapshotHeader headers[SNAPSHOT_SLOTS];
+    bool valid[SNAPSHOT_SLOTS];
+    int newest = SnapshotReadHeaders(writer->fd, writer->fileSize, headers, valid);
+
+    for (uint32_t s = 0; s < SNAPSHOT_SLOTS; s++) {
+        if (!valid[s]) continue;
+        writer->images[s].offset = headers[s].imageOffset;
+        writer->images[s].end = headers[s].imageEnd;
+    }
+    if (newest >= 0) {
+        writer->newest = (uint32_t)newest;
+        writer->generation = headers[newest].generation;
+    }
+
+    return writer;
+}
+
+/*
+ * Write the pages of [data, data + size) whose hash changed since the
+ * last call, coalescing neighbours into one pwrite.
+ */
+static bool SnapshotWriteRegion(
+    WorldSnapshotWriter* writer,
+    const uint8_t* data,
+    size_t size,
+    uint64_t fileOffset,
+    SnapshotPageHashes* hashes)
+{
+    size_t pageSize = writer->pageSize;
+    size_t pages = (size + pageSize - 1) / pageSize;
+
+    if (!SnapshotPageHashesResize(hashes, pages)) return false;
+
+    size_t runStart = SIZE_MAX;
+    for (size_t p = 0; p <= pages; p++) {
+        bool dirty = false;
+
+        if (p < pages) {
+            size_t begin = p * pageSize;
+            size_t length = size - begin < pageSize ? size - begin : pageSize;
+            uint64_t hash = HashPage(data + begin, length);
+
+            dirty = !hashes->valid || hashes->hashes[p] != hash;
+            hashes->hashes[p] = hash;
+            writer->stats.pagesScanned++;
+        }
+
+        if (dirty && runStart == SIZE_MAX) {
+            runStart = p;
+        } else if (!dirty && runStart != SIZE_MAX) {
+            size_t begin = runStart * pageSize;
+            size_t end = p * pageSize < size ? p * pageSize : size;
+
+            if (!SnapshotWriteAll(writer->fd, data + begin, end - begin, fileOffset + begin)) {
+                hashes->valid = false;
+                return false;
+            }
+
+            writer->stats.pagesWritten += p - runStart;
+            writer->stats.bytesWritten += end - begin;
+            runStart = SIZE_MAX;
+        }
+    }
+
+    hashes->valid = true;
+    return true;
+}
+
+static bool SnapshotBuildSlots(WorldSnapshotWriter* writer, SlotManager* slots,
+                               const SlotPoolRegion* region, SnapshotHeader* header)
+{
+    SnapshotBuffer* meta = &writer->meta;
+
+    size_t blocks = SnapshotBufferAppend(meta, region->blockCount, 8);
+    if (blocks == SIZE_MAX) return false;
+    for (size_t b = 0; b < region->blockCount; b++) {
+        meta->data[blocks + b] = region->usedBlocks[b] ? 1 : 0;
+    }
+    header->sections[SECTION_POOL_BLOCKS] = (SnapshotSection){ blocks, region->blockCount };
+
+    size_t recordsSize = slots->tableSize * sizeof(SnapshotSlotRecord);
+    size_t records = SnapshotBufferAppend(meta, recordsSize, 8);
+    if (records == SIZE_MAX) return false;
+    header->sections[SECTION_SLOTS] = (SnapshotSection){ records, recordsSize };
+
+    SnapshotSlotRecord* record = (SnapshotSlotRecord*)(meta->data + records);
+    for (size_t i = 0; i < slots->tableSize; i++, record++) {
+        const SlotEntry* entry = &slots->slotTable[i];
+
+        record->dataOffset = entry->dataBlockRef ?
+            (uint64_t)((const uint8_t*)entry->dataBlockRef - (const uint8_t*)region->base) :
+            SNAPSHOT_NONE;
+        record->allocationTime = entry->allocationTime;
+        record->lastAccessTime = entry->lastAccessTime;
+        record->slotId = entry->slotId;
+        record->typeTag = entry->typeTag;
+        record->ttl = entry->ttl;
+        record->threadAffinity = entry->threadAffinity;
+        record->securityLevel = (uint32_t)entry->securityLevel;
+        record->tokenGeneration = entry->tokenGeneration;
+        record->accessCount = entry->accessCount;
+        record->occupied = entry->occupied;
+        record->securityEnabled = entry->securityEnabled;
+        record->writeToken = entry->writeToken;
+    }
+
+    header->hasSlots = 1;
+    header->maxSlots = slots->tableSize;
+    header->blockSize = region->blockSize;
+    header->totalAllocations = slots->totalAllocations;
+    header->totalDeallocations = slots->totalDeallocations;
+    header->activeSlots = slots->activeSlots;
+    header->nextSlotId = slots->nextSlotId;
+    return true;
+}
+
+static bool SnapshotBuildWorld(WorldSnapshotWriter* writer, WorldContext* world,
+                               SnapshotHeader* header)
+{
+    SnapshotBuffer* meta = &writer->meta;
+    SnapshotBuffer* strings = &writer->strings;
+
+    size_t partyCount = 0;
+    size_t accessCount = 0;
+    for (size_t s = 0; s < world->systemicCount; s++) {
+        SystemicContext* systemic = world->systemics[s].instance;
+        partyCount += systemic->partyCount;
+        for (size_t p = 0; p < systemic->partyCount; p++) {
+            accessCount += systemic->partySlots[p].accessCount;
+        }
+    }
+    if (partyCount >= UINT32_MAX || accessCount >= UINT32_MAX) return false;
+
+    size_t worldAt = SnapshotBufferAppend(meta, sizeof(SnapshotWorldRecord), 8);
+    size_t systemicsAt = SnapshotBufferAppend(meta, world->systemicCount * sizeof(SnapshotSystemicRecord), 8);
+    size_t partiesAt = SnapshotBufferAppend(meta, partyCount * sizeof(SnapshotPartyRecord), 8);
+    size_t accessesAt = SnapshotBufferAppend(meta, accessCount * sizeof(SnapshotAccessRecord), 8);
+    if (worldAt == SIZE_MAX || systemicsAt == SIZE_MAX ||
+        partiesAt == SIZE_MAX || accessesAt == SIZE_MAX) {
+        return false;
+    }
+
+    header->sections[SECTION_WORLD] = (SnapshotSection){ worldAt, sizeof(SnapshotWorldRecord) };
+    header->sections[SECTION_SYSTEMICS] = (SnapshotSection){ systemicsAt,
+        world->systemicCount * sizeof(SnapshotSystemicRecord) };
+    header->sections[SECTION_PARTIES] = (SnapshotSection){ partiesAt,
+        partyCount * sizeof(SnapshotPartyRecord) };
+    header->sections[SECTION_ACCESSES] = (SnapshotSection){ accessesAt,
+        accessCount * sizeof(SnapshotAccessRecord) };
+
+    /* Strings live in their own buffer, so record pointers stay put */
+    SnapshotWorldRecord* worldRecord = (SnapshotWorldRecord*)(meta->data + worldAt);
+    worldRecord->nameOffset = SnapshotAddString(strings, world->name);
+    worldRecord->frameCount = world->frameCount;
+    worldRecord->availableMemory = world->planConstraints.availableMemory;
+    worldRecord->replanThreshold = world->replanThreshold;
+    worldRecord->systemicCount = (uint32_t)world->systemicCount;
+    worldRecord->replanInterval = world->replanInterval;
+    worldRecord->availableCpuCores = world->planConstraints.availableCpuCores;
+    worldRecord->availableGpuUnits = world->planConstraints.availableGpuUnits;
+    worldRecord->preferLatency = world->planConstraints.preferLatency;
+
+    SnapshotSystemicRecord* systemicRecord = (SnapshotSystemicRecord*)(meta->data + systemicsAt);
+    SnapshotPartyRecord* partyRecord = (SnapshotPartyRecord*)(meta->data + partiesAt);
+    SnapshotAccessRecord* accessRecord = (SnapshotAccessRecord*)(meta->data + accessesAt);
+    uint32_t partyIndex = 0;
+    uint32_t accessIndex = 0;
+
+    for (size_t s = 0; s < world->systemicCount; s++, systemicRecord++) {
+        SystemicContext* systemic = world->systemics[s].instance;
+
+        systemicRecord->slotNameOffset = SnapshotAddString(strings, world->systemics[s].slotName);
+        systemicRecord->nameOffset = SnapshotAddString(strings, systemic->name);
+        systemicRecord->typeOffset = SnapshotAddString(strings, systemic->systemType);
+        systemicRecord->totalExecutions = systemic->totalExecutions;
+        systemicRecord->sampledExecutions = systemic->sampledExecutions;
+        systemicRecord->totalTimeNs = systemic->totalTimeNs;
+        systemicRecord->firstParty = partyIndex;
+        systemicRecord->partyCount = (uint32_t)systemic->partyCount;
+        systemicRecord->partitionCount = systemic->partitioning ?
+            systemic->partitioning->partitionCount : 0;
+        systemicRecord->errorCount = systemic->errorCount;
+
+        for (size_t p = 0; p < systemic->partyCount; p++, partyRecord++, partyIndex++) {
+            SystemicPartySlot* slot = &systemic->partySlots[p];
+
+            partyRecord->slotNameOffset = SnapshotAddString(strings, slot->slotName);
+            partyRecord->partyTypeOffset = SnapshotAddString(strings, slot->partyType);
+            partyRecord->partitionKey = slot->partitionKey;
+            partyRecord->executions = slot->executions;
+            partyRecord->sampledExecutions = slot->sampledExecutions;
+            partyRecord->totalTimeNs = slot->totalTimeNs;
+            partyRecord->costEwmaNs = slot->costEwmaNs;
+            partyRecord->firstAccess = accessIndex;
+            partyRecord->accessCount = (uint32_t)slot->accessCount;
+            partyRecord->worker = slot->worker;
+
+            for (size_t a = 0; a < slot->accessCount; a++, accessRecord++, accessIndex++) {
+                accessRecord->fieldNameOffset = SnapshotAddString(strings,
+                    GetFieldNameById(slot->accesses[a].fieldId));
+                accessRecord->access = (uint32_t)slot->accesses[a].access;
+            }
+        }
+    }
+
+    return true;
+}
+
+/* Build the metadata image; section offsets come out relative to the image */
+static bool SnapshotBuildMetadata(WorldSnapshotWriter* writer, WorldContext* world,
+                                  SlotManager* slots, const SlotPoolRegion* region,
+                                  SnapshotHeader* header)
+{
+    writer->meta.size = 0;
+    writer->strings.size = 0;
+    writer->strings.failed = false;
+
+    if (slots && !SnapshotBuildSlots(writer, slots, region, header)) return false;
+    if (world && !SnapshotBuildWorld(writer, world, header)) return false;
+
+    if (writer->strings.failed) return false;
+
+    size_t stringsAt = SnapshotBufferAppend(&writer->meta, writer->strings.size, 8);
+    if (stringsAt == SIZE_MAX) return false;
+    if (writer->strings.size) {
+        memcpy(writer->meta.data + stringsAt, writer->strings.data, writer->strings.size);
+    }
+    header->sections[SECTION_STRINGS] = (SnapshotSection){ stringsAt, writer->strings.size };
+
+    /* Pad to whole pages so trailing bytes hash deterministically */
+    return SnapshotBufferAppend(&writer->meta, 0, writer->pageSize) != SIZE_MAX;
+}
+
+/*
+ * Where an image of `size` bytes goes in `slot`: where it was, if that
+ * stays clear of the other slot's image, else the first gap that does.
+ */
+static uint64_t SnapshotPlaceImage(const WorldSnapshotWriter* writer, uint32_t slot, uint64_t size)
+{
+    const SnapshotImage* own = &writer->images[slot];
+    const SnapshotImage* other = &writer->images[slot ^ 1];
+    uint64_t pageSize = writer->pageSize;
+    uint64_t first = SNAPSHOT_SLOTS * pageSize;
+
+    if (other->end == 0) return own->end ? own->offset : first;
+
+    if (own->end && (own->offset + size <= other->offset || own->offset >= other->end)) {
+        return own->offset;
+    }
+    if (first + size <= other->offset) return first;
+    return (other->end + pageSize - 1) / pageSize * pageSize;
+}
+
+bool WorldSnapshotCheckpoint(WorldSnapshotWriter* writer, WorldContext* world, SlotManager* slots)
+{
+    if (!writer || (!world && !slots)) return false;
+
+    uint64_t startTime = GetTimeNanos();
+    size_t pageSize = writer->pageSize;
+
+    SlotPoolRegion region = {0};
+    if (slots && !SlotManagerGetPoolRegion(slots, &region)) return false;
+
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = SNAPSHOT_MAGIC;
+    header.version = SNAPSHOT_VERSION;
+    header.pageSize = (uint32_t)pageSize;
+    header.generation = writer->generation + 1;
+
+    /* Overwrite the older generation; the newer one stays untouched */
+    uint32_t slot = writer->newest ^ 1;
+    SnapshotImage* image = &writer->images[slot];
+    const SnapshotImage* other = &writer->images[slot ^ 1];
+    header.headerSlot = slot;
+
+    if (!SnapshotBuildMetadata(writer, world, slots, &region, &header)) return false;
+
+    uint64_t poolPages = (region.size + pageSize - 1) / pageSize;
+    uint64_t poolOffset = SnapshotPlaceImage(writer, slot, poolPages * pageSize + writer->meta.size);
+    uint64_t metaOffset = poolOffset + poolPages * pageSize;
+
+    header.sections[SECTION_POOL] = (SnapshotSection){ poolOffset, region.size };
+    for (int s = SECTION_POOL_BLOCKS; s < SECTION_COUNT; s++) {
+        header.sections[s].offset += metaOffset;
+    }
+    header.imageOffset = poolOffset;
+    header.imageEnd = metaOffset + writer->meta.size;
+
+    /* A different pool or layout invalidates what the image holds */
+    if (region.base != image->poolBase || poolOffset != image->offset) image->poolHashes.valid = false;
+    if (metaOffset != image->metaOffset) image->metaHashes.valid = false;
+    image->poolBase = region.base;
+    image->offset = poolOffset;
+    image->metaOffset = metaOffset;
+    image->end = header.imageEnd;
+
+    writer->stats.pagesScanned = 0;
+    writer->stats.pagesWritten = 0;
+    writer->stats.bytesWritten = 0;
+
+    if (!SnapshotWriteRegion(writer, (const uint8_t*)region.base, region.size,
+                             poolOffset, &image->poolHashes) ||
+        !SnapshotWriteRegion(writer, writer->meta.data, writer->meta.size,
+                             metaOffset, &image->metaHashes)) {
+        return false;
+    }
+
+    uint64_t fileSize = header.imageEnd > other->end ? header.imageEnd : other->end;
+    if (writer->fileSize != fileSize) {
+        if (ftruncate(writer->fd, (off_t)fileSize) != 0) return false;
+        writer->fileSize = fileSize;
+    }
+
+    /* The pages must be on disk before the header that vouches for them */
+    if (fdatasync(writer->fd) != 0) return false;
+
+    header.checksum = SnapshotHeaderChecksum(&header);
+    if (!SnapshotWriteAll(writer->fd, &header, sizeof(header), (uint64_t)slot * pageSize) ||
+        fdatasync(writer->fd) != 0) {
+        return false;
+    }
+
+    writer->newest = slot;
+    writer->generation = header.generation;
+    writer->stats.generation = header.generation;
+    writer->stats.checkpoints++;
+    writer->stats.lastCheckpointNs = GetTimeNanos() - startTime;
+    return true;
+}
+
+void WorldSnapshotWriterGetStats(const WorldSnapshotWriter* writer, WorldSnapshotStats* stats)
+{
+    if (!stats) return;
+
+    if (writer) {
+        *stats = writer->stats;
+    } else {
+        memset(stats, 0, sizeof(WorldSnapshotStats));
+    }
+}
+
+void WorldSnapshotWriterClose(WorldSnapshotWriter* writer)
+{
+    if (!writer) return;
+
+    close(writer->fd);
+    for (uint32_t s = 0; s < SNAPSHOT_SLOTS; s++) {
+        free(writer->images[s].poolHashes.hashes);
+        free(writer->images[s].metaHashes.hashes);
+    }
+    free(writer->meta.data);
+    free(writer->strings.data);
+    free(writer);
+}
+
+/* ============= Restore ============= */
+
+struct WorldSnapshot {
+    int fd;
+    const uint8_t* map;              /* Whole file, read-only */
+    size_t mapSize;
+    SnapshotHeader header;
+};
+
+WorldSnapshot* WorldSnapshotOpen(const char* path)
+{
+    if (!path) return NULL;
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return NULL;
+
+    /* A header torn mid-write fails its checksum; the other slot still verifies */
+    struct stat st;
+    SnapshotHeader headers[SNAPSHOT_SLOTS];
+    bool valid[SNAPSHOT_SLOTS];
+    int newest = fstat(fd, &st) == 0 ?
+        SnapshotReadHeaders(fd, (uint64_t)st.st_size, headers, valid) : -1;
+
+    if (newest < 0) {
+        close(fd);
+        return NULL;
+    }
+    const SnapshotHeader* header = &headers[newest];
+
+    WorldSnapshot* snapshot = (WorldSnapshot*)calloc(1, sizeof(WorldSnapshot));
+    if (!snapshot) {
+        close(fd);
+        return NULL;
+    }
+
+    /* Pages fault in on first access */
+    void* map = mmap(NULL, (size_t)header->imageEnd, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map == MAP_FAILED) {
+        free(snapshot);
+        close(fd);
+        return NULL;
+    }
+
+    snapshot->fd = fd;
+    snapshot->map = (const uint8_t*)map;
+    snapshot->mapSize = (size_t)header->imageEnd;
+    snapshot->header = *header;
+    return snapshot;
+}
+
+static const void* SnapshotSectionData(const WorldSnapshot* snapshot, SnapshotSectionId id,
+                                       size_t recordSize, size_t* count)
+{
+    const SnapshotSection* section = &snapshot->header.sections[id];
+    *count = (size_t)section->size / recordSize;
+    return snapshot->map + section->offset;
+}
+
+/* NULL unless the offset names a terminated string inside the section */
+static const char* SnapshotString(const WorldSnapshot* snapshot, uint64_t offset)
+{
+    const SnapshotSection* section = &snapshot->header.sections[SECTION_STRINGS];
+    if (offset >= section->size) return NULL;
+
+    const char* str = (const char*)snapshot->map + section->offset + offset;
+    return memchr(str, '\0', (size_t)(section->size - offset)) ? str : NULL;
+}
+
+static void SnapshotReleaseRegion(void* base, size_t size)
+{
+    munmap(base, size);
+}
+
+SlotManager* WorldSnapshotRestoreSlots(WorldSnapshot* snapshot)
+{
+    if (!snapshot || !snapshot->header.hasSlots) return NULL;
+
+    const SnapshotHeader* header = &snapshot->header;
+    const SnapshotSection* pool = &header->sections[SECTION_POOL];
+
+    size_t blockCount;
+    const uint8_t* blocks = (const uint8_t*)SnapshotSectionData(snapshot, SECTION_POOL_BLOCKS,
+                                                                1, &blockCount);
+    size_t recordCount;
+    const SnapshotSlotRecord* records = (const SnapshotSlotRecord*)SnapshotSectionData(
+        snapshot, SECTION_SLOTS, sizeof(SnapshotSlotRecord), &recordCount);
+    if (recordCount != header->maxSlots || pool->size == 0 ||
+        pool->offset % header->pageSize != 0) {
+        return NULL;
+    }
+
+    bool* usedBlocks = (bool*)malloc(blockCount ? blockCount * sizeof(bool) : 1);
+    if (!usedBlocks) return NULL;
+    for (size_t b = 0; b < blockCount; b++) {
+        usedBlocks[b] = blocks[b] != 0;
+    }
+
+    /* Private writable mapping: slot writes copy pages, the file stays intact */
+    void* base = mmap(NULL, (size_t)pool->size, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                      snapshot->fd, (off_t)pool->offset);
+    if (base == MAP_FAILED) {
+        free(usedBlocks);
+        return NULL;
+    }
+
+    SlotManager* manager = NULL;
+    SlotPoolRegion region;
+    if (blockCount * header->blockSize <= pool->size) {
+        manager = SlotManagerCreateFromRegion((size_t)header->maxSlots, base, (size_t)pool->size,
+                                              usedBlocks, SnapshotReleaseRegion);
+    }
+    free(usedBlocks);
+
+    if (!manager) {
+        munmap(base, (size_t)pool->size);
+        return NULL;
+    }
+
+    if (!SlotManagerGetPoolRegion(manager, &region) ||
+        region.blockSize != header->blockSize || region.blockCount != blockCount) {
+        SlotManagerDestroy(manager);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < recordCount; i++) {
+        const SnapshotSlotRecord* record = &records[i];
+        SlotEntry* entry = &manager->slotTable[i];
+
+        if (record->dataOffset != SNAPSHOT_NONE && record->dataOffset >= pool->size) {
+            SlotManagerDestroy(manager);
+            return NULL;
+        }
+
+        entry->slotId = record->slotId;
+        entry->typeTag = record->typeTag;
+        entry->occupied = record->occupied != 0;
+        entry->dataBlockRef = record->dataOffset != SNAPSHOT_NONE ?
+            (uint8_t*)base + record->dataOffset : NULL;
+        entry->ttl = record->ttl;
+        entry->threadAffinity = record->threadAffinity;
+        entry->allocationTime = record->allocationTime;
+        entry->securityLevel = (SecurityLevel)record->securityLevel;
+        entry->writeToken = record->writeToken;
+        entry->tokenGeneration = record->tokenGeneration;
+        entry->securityEnabled = record->securityEnabled != 0;
+        entry->lastAccessTime = record->lastAccessTime;
+        entry->accessCount = record->accessCount;
+    }
+
+    manager->nextSlotId = header->nextSlotId;
+    manager->totalAllocations = header->totalAllocations;
+    manager->totalDeallocations = header->totalDeallocations;
+    manager->activeSlots = header->activeSlots;
+    manager->securityContext = NULL;
+    manager->securityEnabled = false;
+    manager->defaultSecurityLevel = SECURITY_LEVEL_BASIC;
+    manager->securityViolations = 0;
+    return manager;
+}
+
+/* Restored systemics belong to the caller, so unwind them here on failure */
+static void SnapshotDiscardWorld(WorldContext* world)
+{
+    for (size_t s = 0; s < world->systemicCount; s++) {
+        FreeSystemicContext(world->systemics[s].instance);
+    }
+    FreeWorldContext(world);
+}
+
+static bool SnapshotRestoreSystemic(
+    WorldSnapshot* snapshot,
+    WorldContext* world,
+    const SnapshotSystemicRecord* record,
+    const WorldSnapshotBindings* bindings)
+{
+    size_t partyCount;
+    const SnapshotPartyRecord* parties = (const SnapshotPartyRecord*)SnapshotSectionData(
+        snapshot, SECTION_PARTIES, sizeof(SnapshotPartyRecord), &partyCount);
+    size_t accessCount;
+    const SnapshotAccessRecord* accesses = (const SnapshotAccessRecord*)SnapshotSectionData(
+        snapshot, SECTION_ACCESSES, sizeof(SnapshotAccessRecord), &accessCount);
+
+    const char* slotName = SnapshotString(snapshot, record->slotNameOffset);
+    const char* name = SnapshotString(snapshot, record->nameOffset);
+    const char* type = SnapshotString(snapshot, record->typeOffset);
+    if (!slotName || !name || !type) return false;
+    if (record->firstParty > partyCount || record->partyCount > partyCount - record->firstParty) {
+        return false;
+    }
+
+    SystemicContext* systemic = CreateSystemic(type, name);
+    if (!systemic) return false;
+    if (!WorldAddSystemic(world, slotName, systemic)) {
+        FreeSystemicContext(systemic);
+        return false;
+    }
+
+    systemic->totalExecutions = record->totalExecutions;
+    systemic->sampledExecutions = record->sampledExecutions;
+    systemic->totalTimeNs = record->totalTimeNs;
+    systemic->errorCount = record->errorCount;
+
+    for (uint32_t p = 0; p < record->partyCount; p++) {
+        const SnapshotPartyRecord* party = &parties[record->firstParty + p];
+        const char* partySlot = SnapshotString(snapshot, party->slotNameOffset);
+        const char* partyType = SnapshotString(snapshot, party->partyTypeOffset);
+        if (!partySlot || !partyType) return false;
+
+        void* instance = NULL;
+        PartyContext* context = NULL;
+        if (!bindings->bindParty(systemic, partySlot, partyType, &instance, &context,
+                                 bindings->userData) ||
+            !SystemicAddPartyWithKey(systemic, partySlot, instance, context, party->partitionKey)) {
+            return false;
+        }
+
+        SystemicPartySlot* slot = &systemic->partySlots[systemic->partyCount - 1];
+        slot->executions = party->executions;
+        slot->sampledExecutions = party->sampledExecutions;
+        slot->totalTimeNs = party->totalTimeNs;
+        slot->costEwmaNs = party->costEwmaNs;
+        slot->worker = party->worker;
+
+        if (party->firstAccess > accessCount ||
+            party->accessCount > accessCount - party->firstAccess) {
+            return false;
+        }
+        for (uint32_t a = 0; a < party->accessCount; a++) {
+            const SnapshotAccessRecord* access = &accesses[party->firstAccess + a];
+            const char* fieldName = SnapshotString(snapshot, access->fieldNameOffset);
+            if (!fieldName ||
+                !SystemicDeclareAccess(systemic, partySlot, fieldName, (FieldAccess)access->access)) {
+                return false;
+            }
+        }
+    }
+
+    if (bindings->bindSystemic &&
+        !bindings->bindSystemic(systemic, slotName, record->partitionCount, bindings->userData)) {
+        return false;
+    }
+
+    return true;
+}
+
+WorldContext* WorldSnapshotRestoreWorld(WorldSnapshot* snapshot, const WorldSnapshotBindings* bindings)
+{
+    if (!snapshot || !bindings || !bindings->bindParty) return NULL;
+
+    size_t worldCount;
+    const SnapshotWorldRecord* record = (const SnapshotWorldRecord*)SnapshotSectionData(
+        snapshot, SECTION_WORLD, sizeof(SnapshotWorldRecord), &worldCount);
+    if (worldCount != 1) return NULL;
+
+    size_t systemicCount;
+    const SnapshotSystemicRecord* systemics = (const SnapshotSystemicRecord*)SnapshotSectionData(
+        snapshot, SECTION_SYSTEMICS, sizeof(SnapshotSystemicRecord), &systemicCount);
+    const char* name = SnapshotString(snapshot, record->nameOffset);
+    if (!name || record->systemicCount != systemicCount) return NULL;
+
+    WorldContext* world = CreateWorld(name);
+    if (!world) return NULL;
+
+    world->frameCount = record->frameCount;
+    if (record->replanInterval > 0) {
+        ExecutionPlanConstraints constraints = {
+            .availableCpuCores = record->availableCpuCores,
+            .availableGpuUnits = record->availableGpuUnits,
+            .availableMemory = (size_t)record->availableMemory,
+            .preferLatency = record->preferLatency != 0
+        };
+        WorldEnableAutoPlanning(world, &constraints, record->replanInterval,
+                                record->replanThreshold);
+    }
+
+    for (size_t s = 0; s < systemicCount; s++) {
+        if (!SnapshotRestoreSystemic(snapshot, world, &systemics[s], bindings)) {
+            SnapshotDiscardWorld(world);
+            return NULL;
+        }
+    }
+
+    return world;
+}
+
+uint64_t WorldSnapshotGeneration(const WorldSnapshot* snapshot)
+{
+    return snapshot ? snapshot->header.generation : 0;
+}
+
+/* Slot managers restored from the snapshot keep their own pool mapping */
+void WorldSnapshotClose(WorldSnapshot* snapshot)
+{
+    if (!snapshot) return;
+
+    munmap((void*)snapshot->map, snapshot->mapSize);
+    close(snapshot->fd);
+    free(snapshot);
+}
+
+/* ============= Helpers ============= */
+
+static uint64_t GetTimeNanos(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2025 Pergyra Language Project
+ * World Snapshot
+ * Checkpoint/restore of a world and its slot manager to a mapped file
+ */
+
+#ifndef PERGYRA_WORLD_SNAPSHOT_H
+#define PERGYRA_WORLD_SNAPSHOT_H
+
+#include "world_systemic.h"
+
+/*
+ * One file holds the slot manager's block pool, its slot table and the
+ * world/systemic/party metadata. Every reference inside the file is an
+ * offset, so it can be mapped anywhere. The pool section is page aligned
+ * and is mapped copy-on-write on restore: pages fault in lazily the
+ * first time a slot touches them.
+ *
+ * The file keeps the last two generations side by side and a checkpoint
+ * only ever overwrites the older one, so a crash mid-checkpoint leaves
+ * the previous generation to restore from.
+ *
+ * Runtime objects (party instances, PartyContexts, fiber maps, key
+ * functions, handlers, buffered state) are not serializable. The restore
+ * hands each recorded party to the caller to bind a live one.
+ */
+
+typedef struct WorldSnapshotWriter WorldSnapshotWriter;
+typedef struct WorldSnapshot WorldSnapshot;
+
+typedef struct {
+    uint64_t checkpoints;
+    uint64_t generation;             /* Of the last complete checkpoint */
+    uint64_t pagesScanned;           /* Last checkpoint */
+    uint64_t pagesWritten;           /* Last checkpoint */
+    uint64_t bytesWritten;           /* Last checkpoint */
+    uint64_t lastCheckpointNs;
+} WorldSnapshotStats;
+
+/* ============= Checkpoint ============= */
+
+/* Open (or create) a snapshot file for checkpointing */
+WorldSnapshotWriter* WorldSnapshotWriterOpen(const char* path);
+
+/*
+ * Write a checkpoint of world and/or slots (either may be NULL). The
+ * first two checkpoints of a writer write every page; later ones write
+ * only pages whose contents changed since the checkpoint before the
+ * previous one, whose pages they replace. Returns once the new
+ * generation is on disk. Call it between frames, when no role is running.
+ */
+bool WorldSnapshotCheckpoint(
+    WorldSnapshotWriter* writer,
+    WorldContext* world,
+    SlotManager* slots
+);
+
+void WorldSnapshotWriterGetStats(const WorldSnapshotWriter* writer, WorldSnapshotStats* stats);
+void WorldSnapshotWriterClose(WorldSnapshotWriter* writer);
+
+/* ============= Restore ============= */
+
+/* Map the newest complete generation (NULL if missing, torn or incompatible) */
+WorldSnapshot* WorldSnapshotOpen(const char* path);
+
+/*
+ * Slot manager over a private mapping of the snapshot's pool. The
+ * manager owns the mapping and outlives the snapshot. Security is left
+ * disabled: master keys are never written, so re-enable it explicitly.
+ */
+SlotManager* WorldSnapshotRestoreSlots(WorldSnapshot* snapshot);
+
+typedef struct {
+    /* Required: supply the live instance and context for a recorded party */
+    bool (*bindParty)(
+        SystemicContext* systemic,
+        const char* partySlot,
+        const char* partyType,
+        void** partyInstance,
+        PartyContext** partyContext,
+        void* userData
+    );
+
+    /* Optional: reattach runtime state once all the systemic's parties are back */
+    bool (*bindSystemic)(
+        SystemicContext* systemic,
+        const char* systemicSlot,
+        uint32_t partitionCount,     /* 0 if it was not partitioned */
+        void* userData
+    );
+
+    void* userData;
+} WorldSnapshotBindings;
+
+/*
+ * Rebuild the world: systemics, parties in their original order (so
+ * PartyHandles stay valid), declared accesses, cost estimates, planned
+ * workers and auto-planning settings. Systemics are owned by the caller,
+ * as with WorldAddSystemic.
+ */
+WorldContext* WorldSnapshotRestoreWorld(
+    WorldSnapshot* snapshot,
+    const WorldSnapshotBindings* bindings
+);
+
+uint64_t WorldSnapshotGeneration(const WorldSnapshot* snapshot);
+void WorldSnapshotClose(WorldSnapshot* snapshot);
+
+#endif /* PERGYRA_WORLD_SNAPSHOT_H */
@@ -0,0 +1,2926 @@
+/*
+ * Copyright (c) 2025 Pergyra Language Project
+ * World-Systemic Runtime Implementation
+ */
+
+#define _GNU_SOURCE
+
+#include "world_systemic.h"
+#include "async/scheduler.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <time.h>
+#include <errno.h>
+#include <unistd.h>
+
+#define FRAME_NODE_NONE ((size_t)-1)
+
+/* Pacing: sleep until this close to the deadline, then spin */
+#define WORLD_SPIN_NS           50000ULL
+
+/* Adaptive sync: overrun frames before shedding more, fast frames before restoring */
+#define WORLD_SHED_AFTER        2
+#define WORLD_RESTORE_AFTER     30
+
+/* Party cost smoothing: ewma += (sample - ewma) / 2^shift */
+#define PARTY_COST_EWMA_SHIFT   3
+
+static uint64_t GetTimeNanos(void);
+static void FrameHistogramRecord(FrameHistogram* histogram, uint64_t valueNs);
+static inline void CpuRelax(void);
+static void WorldMaybeReplan(WorldContext* world);
+static void SystemicCommitFrame(SystemicContext* systemic);
+static void SystemicPartitioningDestroy(SystemicPartitioning* partitioning);
+static bool PartitionAssign(SystemicContext* systemic, size_t partyIndex);
+static uint64_t HashPartitionKey(const char* name);
+static void PartitionDeliverMessages(SystemicContext* systemic, SystemicPartition* partition);
+
+/* ============= Frame Graph ============= */
+
+/*
+ * Dependency DAG over every party of a set of systemics. Built from the
+ * declared shared-field accesses and cached until the topology changes.
+ * Each frame a node counts down its unfinished predecessors; the one that
+ * reaches zero spawns the node's roles, and the last role to finish
+ * releases the node's successors. The frame's caller only waits on a
+ * JOIN_ALL latch with one entry per node.
+ *
+ * A partitioned systemic becomes entry -> partitions -> exit. The entry
+ * carries the accesses of all its parties and takes the incoming edges;
+ * the exit stands in for it as the source of outgoing edges.
+ */
+
+typedef enum {
+    FRAME_NODE_PARTY,
+    FRAME_NODE_PARTITION,
+    FRAME_NODE_ENTRY,                /* Partitioned systemic, no work */
+    FRAME_NODE_EXIT
+} FrameNodeKind;
+
+typedef struct FrameNode FrameNode;
+
+/* One role of one party, preallocated for every frame */
+typedef struct {
+    FrameNode* node;
+    FiberMapEntry* entry;
+    FiberResult* result;
+    InternId roleNameId;             /* FiberStats key, resolved at build */
+} FrameRoleTask;
+
+struct FrameNode {
+    struct FrameGraph* graph;
+    FrameNodeKind kind;
+    SystemicContext* systemic;
+    SystemicPartySlot* party;        /* FRAME_NODE_PARTY */
+    SystemicPartition* partition;    /* FRAME_NODE_PARTITION */
+    const char* label;
+    size_t index;                    /* Latch entry */
+    size_t exitNode;                 /* Source of this node's outgoing edges */
+    size_t systemicIndex;
+    SystemicPartyResult* result;     /* Filled by the node itself; NULL if structural */
+
+    size_t* successors;
+    size_t successorCount;
+    size_t predecessorCount;
+
+    FrameRoleTask* tasks;
+    size_t taskCount;
+    FiberResult* results;
+    SchedulerPriority priority;      /* Highest role priority, for shedding */
+
+    /* Per-frame state */
+    bool deferred;
+    bool cancelled;                  /* Skipped by a cancelled async frame */
+    atomic_size_t pendingInputs;     /* Predecessors still running */
+    atomic_size_t pendingRoles;
+    atomic_bool failed;
+    uint64_t startTimeNs;
+    uint64_t finishTimeNs;
+};
+
+typedef struct FrameGraph {
+    /* Topology the graph was built from */
+    SystemicContext** systemics;
+    uint64_t* systemicVersions;
+    size_t* systemicNodeCounts;
+    size_t systemicCount;
+    FrameSharedState* worldState;    /* World's buffered fields, if any */
+    uint64_t ownerVersion;           /* World topology version (0 for a systemic) */
+
+    FrameNode* nodes;
+    size_t nodeCount;
+    size_t* roots;
+    size_t rootCount;
+    size_t edgeCount;
+    size_t depth;                    /* Longest path, in nodes */
+    size_t width;                    /* Most nodes sharing one depth */
+
+    /* Per-frame settings and aggregates, written by the finishing workers */
+    SchedulerPriority shedBelow;
+    bool sampled;                    /* Timings and stats taken this frame */
+    atomic_size_t deferredCount;     /* Nodes shed in the last frame */
+    atomic_bool* systemicFailed;
+    atomic_bool* cancel;             /* Async frame's cancel flag, NULL if synchronous */
+    struct SystemicHandle* asyncFrame;  /* Completed by the latch's ready hook, if set */
+
+    /* Backing storage */
+    size_t* edges;
+    FrameRoleTask* tasks;
+    FiberResult* roleResults;
+
+    /* Frame join and per-frame results */
+    DispatchLatch latch;
+    FiberResult* nodeResults;
+    SystemicPartyResult* partyResults;
+    SystemicExecutionResult* systemicResults;
+    WorldSystemicResult* worldResults;
+} FrameGraph;
+
+/* A dependency edge before it is packed into successor lists */
+typedef struct {
+    size_t from;
+    size_t to;
+} FrameEdge;
+
+typedef struct {
+    FrameEdge* edges;
+    size_t count;
+    size_t capacity;
+} FrameEdgeList;
+
+/* Readers of a field since its last write, linked through a pool */
+typedef struct {
+    size_t node;
+    size_t next;
+} FrameReader;
+
+typedef struct {
+    size_t lastWriter;
+    size_t firstReader;
+} FrameFieldState;
+
+static bool FrameEdgeAdd(FrameEdgeList* list, size_t from, size_t to)
+{
+    if (from == to) return true;
+
+    if (list->count == list->capacity) {
+        size_t capacity = list->capacity ? list->capacity * 2 : 64;
+        FrameEdge* edges = (FrameEdge*)realloc(list->edges, capacity * sizeof(FrameEdge));
+        if (!edges) return false;
+        list->edges = edges;
+        list->capacity = capacity;
+    }
+
+    list->edges[list->count].from = from;
+    list->edges[list->count].to = to;
+    list->count++;
+    return true;
+}
+
+static int CompareFrameEdges(const void* a, const void* b)
+{
+    const FrameEdge* x = (const FrameEdge*)a;
+    const FrameEdge* y = (const FrameEdge*)b;
+
+    if (x->from != y->from) return x->from < y->from ? -1 : 1;
+    if (x->to != y->to) return x->to < y->to ? -1 : 1;
+    return 0;
+}
+
+static bool FrameFieldIsBuffered(FrameGraph* graph, FrameNode* node, InternId fieldId)
+{
+    const FrameSharedState* systemicState = node->systemic->bufferedState;
+
+    return (graph->worldState && graph->worldState->fieldIndex[fieldId]) ||
+           (systemicState && systemicState->fieldIndex[fieldId]);
+}
+
+/* Scratch state while deriving edges from declared accesses */
+typedef struct {
+    FrameFieldState* fields;
+    FrameReader* readers;
+    size_t readerCount;
+} FrameAccessScan;
+
+/* Make 'to' depend on node 'from', through its exit node */
+static bool FrameGraphDepend(FrameGraph* graph, FrameEdgeList* list, size_t from, size_t to)
+{
+    if (from == to) return true;
+    return FrameEdgeAdd(list, graph->nodes[from].exitNode, to);
+}
+
+/*
+ * Add the edges for one access of node 'n', in node order: RAW, WAR and
+ * WAW. Reads of buffered fields see the previous frame, so only their
+ * writers are ordered.
+ */
+static bool FrameGraphAddAccess(FrameGraph* graph, FrameEdgeList* list, FrameAccessScan* scan,
+                                size_t n, const FieldAccessDecl* decl)
+{
+    if (decl->fieldId >= MAX_INTERNED_FIELD_NAMES) return true;
+
+    FrameFieldState* field = &scan->fields[decl->fieldId];
+    FrameReader* readers = scan->readers;
+    bool ok = true;
+
+    if (FrameFieldIsBuffered(graph, &graph->nodes[n], decl->fieldId)) {
+        if (decl->access & FIELD_ACCESS_WRITE) {
+            if (field->lastWriter != FRAME_NODE_NONE) {
+                ok = FrameGraphDepend(graph, list, field->lastWriter, n);
+            }
+            field->lastWriter = n;
+        }
+    } else if (decl->access & FIELD_ACCESS_WRITE) {
+        /* Write after read, or after the previous write */
+        for (size_t r = field->firstReader; r != FRAME_NODE_NONE && ok; r = readers[r].next) {
+            ok = FrameGraphDepend(graph, list, readers[r].node, n);
+        }
+        if (field->lastWriter != FRAME_NODE_NONE && ok) {
+            ok = FrameGraphDepend(graph, list, field->lastWriter, n);
+        }
+
+        field->lastWriter = n;
+        field->firstReader = FRAME_NODE_NONE;
+    } else {
+        /* Read after write */
+        if (field->lastWriter != FRAME_NODE_NONE) {
+            ok = FrameGraphDepend(graph, list, field->lastWriter, n);
+        }
+
+        readers[scan->readerCount].node = n;
+        readers[scan->readerCount].next = field->firstReader;
+        field->firstReader = scan->readerCount++;
+    }
+
+    return ok;
+}
+
+static bool FrameGraphCollectEdges(FrameGraph* graph, FrameEdgeList* list)
+{
+    size_t accessCount = 0;
+    for (size_t n = 0; n < graph->nodeCount; n++) {
+        FrameNode* node = &graph->nodes[n];
+        if (node->kind == FRAME_NODE_PARTY) {
+            accessCount += node->party->accessCount;
+        } else if (node->kind == FRAME_NODE_ENTRY) {
+            for (size_t p = 0; p < node->systemic->partyCount; p++) {
+                accessCount += node->systemic->partySlots[p].accessCount;
+            }
+        }
+    }
+
+    FrameAccessScan scan = {
+        .fields = (FrameFieldState*)malloc(MAX_INTERNED_FIELD_NAMES * sizeof(FrameFieldState)),
+        .readers = (FrameReader*)malloc((accessCount ? accessCount : 1) * sizeof(FrameReader))
+    };
+    if (!scan.fields || !scan.readers) {
+        free(scan.fields);
+        free(scan.readers);
+        return false;
+    }
+
+    for (size_t f = 0; f < MAX_INTERNED_FIELD_NAMES; f++) {
+        scan.fields[f].lastWriter = FRAME_NODE_NONE;
+        scan.fields[f].firstReader = FRAME_NODE_NONE;
+    }
+
+    bool ok = true;
+
+    for (size_t n = 0; n < graph->nodeCount && ok; n++) {
+        FrameNode* node = &graph->nodes[n];
+
+        switch (node->kind) {
+            case FRAME_NODE_PARTY:
+                for (size_t a = 0; a < node->party->accessCount && ok; a++) {
+                    ok = FrameGraphAddAccess(graph, list, &scan, n, &node->party->accesses[a]);
+                }
+                break;
+
+            case FRAME_NODE_ENTRY:
+                /* Declares for every party of the partitioned systemic */
+                for (size_t p = 0; p < node->systemic->partyCount && ok; p++) {
+                    SystemicPartySlot* party = &node->systemic->partySlots[p];
+                    for (size_t a = 0; a < party->accessCount && ok; a++) {
+                        ok = FrameGraphAddAccess(graph, list, &scan, n, &party->accesses[a]);
+                    }
+                }
+                break;
+
+            case FRAME_NODE_PARTITION: {
+                /* Partitions sit between their entry and exit */
+                size_t entry = n - node->partition->index - 1;
+                ok = FrameEdgeAdd(list, entry, n) &&
+                     FrameEdgeAdd(list, n, graph->nodes[entry].exitNode);
+                break;
+            }
+
+            case FRAME_NODE_EXIT:
+                break;
+        }
+    }
+
+    free(scan.fields);
+    free(scan.readers);
+    return ok;
+}
+
+/* Pack deduplicated edges into successor lists; record roots, depth and width */
+static bool FrameGraphLink(FrameGraph* graph, FrameEdgeList* list)
+{
+    if (list->count > 0) qsort(list->edges, list->count, sizeof(FrameEdge), CompareFrameEdges);
+
+    size_t unique = 0;
+    for (size_t e = 0; e < list->count; e++) {
+        if (unique > 0 &&
+            list->edges[unique - 1].from == list->edges[e].from &&
+            list->edges[unique - 1].to == list->edges[e].to) {
+            continue;
+        }
+        list->edges[unique++] = list->edges[e];
+    }
+
+    graph->edgeCount = unique;
+    graph->edges = (size_t*)malloc((unique ? unique : 1) * sizeof(size_t));
+    graph->roots = (size_t*)malloc((graph->nodeCount ? graph->nodeCount : 1) * sizeof(size_t));
+    size_t* levels = (size_t*)calloc(graph->nodeCount ? graph->nodeCount : 1, sizeof(size_t));
+    size_t* levelWidths = (size_t*)calloc(graph->nodeCount + 1, sizeof(size_t));
+    if (!graph->edges || !graph->roots || !levels || !levelWidths) {
+        free(levels);
+        free(levelWidths);
+        return false;
+    }
+
+    /* Edges are sorted by source, so each node's successors are contiguous */
+    for (size_t e = 0; e < unique; e++) {
+        FrameNode* from = &graph->nodes[list->edges[e].from];
+        if (from->successorCount == 0) {
+            from->successors = &graph->edges[e];
+        }
+        from->successors[from->successorCount++] = list->edges[e].to;
+        graph->nodes[list->edges[e].to].predecessorCount++;
+    }
+
+    /* Edges only point forward in node order, which is a topological order */
+    for (size_t n = 0; n < graph->nodeCount; n++) {
+        FrameNode* node = &graph->nodes[n];
+        if (node->predecessorCount == 0) {
+            graph->roots[graph->rootCount++] = n;
+        }
+
+        for (size_t s = 0; s < node->successorCount; s++) {
+            size_t next = node->successors[s];
+            if (levels[next] < levels[n] + 1) {
+                levels[next] = levels[n] + 1;
+            }
+        }
+
+        levelWidths[levels[n]]++;
+        if (levels[n] + 1 > graph->depth) graph->depth = levels[n] + 1;
+        if (levelWidths[levels[n]] > graph->width) graph->width = levelWidths[levels[n]];
+    }
+
+    free(levels);
+    free(levelWidths);
+    return true;
+}
+
+static void FrameGraphDestroy(FrameGraph* graph)
+{
+    if (!graph) return;
+
+    if (graph->latch.entryState) {
+        DispatchLatchDestroy(&graph->latch);
+    }
+
+    free(graph->systemics);
+    free(graph->systemicVersions);
+    free(graph->systemicNodeCounts);
+    free(graph->nodes);
+    free(graph->roots);
+    free(graph->edges);
+    free(graph->tasks);
+    free(graph->roleResults);
+    free(graph->nodeResults);
+    free(graph->partyResults);
+    free(graph->systemicResults);
+    free(graph->worldResults);
+    free(graph->systemicFailed);
+    free(graph);
+}
+
+/* Nodes a systemic contributes: one per party, or entry + partitions + exit */
+static size_t SystemicNodeCount(SystemicContext* systemic)
+{
+    if (systemic->partitioning) {
+        return systemic->partitioning->partitionCount + 2;
+    }
+    return systemic->partyCount;
+}
+
+static void FrameNodeInit(FrameGraph* graph, size_t n, FrameNodeKind kind,
+                          SystemicContext* systemic, const char* label)
+{
+    FrameNode* node = &graph->nodes[n];
+
+    node->graph = graph;
+    node->kind = kind;
+    node->systemic = systemic;
+    node->label = label;
+    node->index = n;
+    node->exitNode = n;
+    node->priority = PRIORITY_CRITICAL;
+}
+
+static FrameGraph* FrameGraphBuild(SystemicContext** systemics, size_t systemicCount,
+                                   FrameSharedState* worldState, uint64_t ownerVersion)
+{
+    FrameGraph* graph = (FrameGraph*)calloc(1, sizeof(FrameGraph));
+    if (!graph) return NULL;
+
+    graph->worldState = worldState;
+    graph->ownerVersion = ownerVersion;
+
+    size_t nodeCount = 0;
+    size_t taskCount = 0;
+    for (size_t s = 0; s < systemicCount; s++) {
+        nodeCount += SystemicNodeCount(systemics[s]);
+
+        if (systemics[s]->partitioning) {
+            taskCount += systemics[s]->partitioning->partitionCount;
+            continue;
+        }
+        for (size_t p = 0; p < systemics[s]->partyCount; p++) {
+            FiberMap* map = systemics[s]->partySlots[p].fiberMap;
+            taskCount += map ? map->entryCount : 0;
+        }
+    }
+
+    size_t sizeNodes = nodeCount ? nodeCount : 1;
+    size_t sizeSystemics = systemicCount ? systemicCount : 1;
+    graph->systemics = (SystemicContext**)malloc(sizeSystemics * sizeof(SystemicContext*));
+    graph->systemicVersions = (uint64_t*)malloc(sizeSystemics * sizeof(uint64_t));
+    graph->systemicNodeCounts = (size_t*)malloc(sizeSystemics * sizeof(size_t));
+    graph->nodes = (FrameNode*)calloc(sizeNodes, sizeof(FrameNode));
+    graph->tasks = (FrameRoleTask*)calloc(taskCount ? taskCount : 1, sizeof(FrameRoleTask));
+    graph->roleResults = (FiberResult*)calloc(taskCount ? taskCount : 1, sizeof(FiberResult));
+    graph->nodeResults = (FiberResult*)calloc(sizeNodes, sizeof(FiberResult));
+    graph->partyResults = (SystemicPartyResult*)calloc(sizeNodes, sizeof(SystemicPartyResult));
+    graph->systemicResults = (SystemicExecutionResult*)calloc(sizeSystemics,
+        sizeof(SystemicExecutionResult));
+    graph->worldResults = (WorldSystemicResult*)calloc(sizeSystemics, sizeof(WorldSystemicResult));
+    graph->systemicFailed = (atomic_bool*)calloc(sizeSystemics, sizeof(atomic_bool));
+    if (!graph->systemics || !graph->systemicVersions || !graph->systemicNodeCounts ||
+        !graph->nodes || !graph->tasks || !graph->roleResults || !graph->nodeResults ||
+        !graph->partyResults || !graph->systemicResults || !graph->worldResults ||
+        !graph->systemicFailed || !DispatchLatchInit(&graph->latch, nodeCount)) {
+        FrameGraphDestroy(graph);
+        return NULL;
+    }
+
+    graph->systemicCount = systemicCount;
+    graph->nodeCount = nodeCount;
+
+    /* Nodes in systemic, then party (or partition), order */
+    size_t n = 0;
+    size_t t = 0;
+    for (size_t s = 0; s < systemicCount; s++) {
+        SystemicContext* systemic = systemics[s];
+        SystemicPartitioning* partitioning = systemic->partitioning;
+
+        graph->systemics[s] = systemic;
+        graph->systemicVersions[s] = systemic->topologyVersion;
+        graph->systemicNodeCounts[s] = SystemicNodeCount(systemic);
+
+        if (partitioning) {
+            size_t entry = n;
+            size_t exit = n + partitioning->partitionCount + 1;
+
+            FrameNodeInit(graph, entry, FRAME_NODE_ENTRY, systemic, systemic->name);
+            graph->nodes[entry].exitNode = exit;
+            n++;
+
+            /* One task per partition, never shed: messages must drain every frame */
+            for (uint32_t k = 0; k < partitioning->partitionCount; k++, n++, t++) {
+                FrameNode* node = &graph->nodes[n];
+                FrameNodeInit(graph, n, FRAME_NODE_PARTITION, systemic,
+                              partitioning->partitions[k].name);
+                node->partition = &partitioning->partitions[k];
+                node->tasks = &graph->tasks[t];
+                node->results = &graph->roleResults[t];
+                node->taskCount = 1;
+
+                graph->tasks[t].node = node;
+                graph->tasks[t].result = &graph->roleResults[t];
+            }
+
+            FrameNodeInit(graph, exit, FRAME_NODE_EXIT, systemic, systemic->name);
+            n++;
+            continue;
+        }
+
+        for (size_t p = 0; p < systemic->partyCount; p++, n++) {
+            FrameNode* node = &graph->nodes[n];
+            FrameNodeInit(graph, n, FRAME_NODE_PARTY, systemic, systemic->partySlots[p].slotName);
+            node->party = &systemic->partySlots[p];
+            node->tasks = &graph->tasks[t];
+            node->results = &graph->roleResults[t];
+
+            FiberMap* map = node->party->fiberMap;
+            node->taskCount = map ? map->entryCount : 0;
+            node->priority = PRIORITY_IDLE;
+            for (size_t i = 0; i < node->taskCount; i++, t++) {
+                graph->tasks[t].node = node;
+                graph->tasks[t].entry = &map->entries[i];
+                graph->tasks[t].result = &graph->roleResults[t];
+                graph->tasks[t].roleNameId = map->entries[i].roleNameId ?
+                    map->entries[i].roleNameId : InternSlotName(map->entries[i].roleId);
+                if (map->entries[i].priority > node->priority) {
+                    node->priority = map->entries[i].priority;
+                }
+            }
+        }
+    }
+
+    /* Result slots are fixed per graph; each node fills its own every frame */
+    size_t r = 0;
+    n = 0;
+    for (size_t s = 0; s < systemicCount; s++) {
+        SystemicExecutionResult* systemicResult = &graph->systemicResults[s];
+        systemicResult->partyResults = &graph->partyResults[r];
+
+        for (size_t i = 0; i < graph->systemicNodeCounts[s]; i++, n++) {
+            FrameNode* node = &graph->nodes[n];
+            node->systemicIndex = s;
+            if (node->kind == FRAME_NODE_ENTRY || node->kind == FRAME_NODE_EXIT) continue;
+
+            node->result = &graph->partyResults[r++];
+            node->result->partySlot = node->label;
+            node->result->result.results = node->results;
+            systemicResult->resultCount++;
+        }
+    }
+
+    FrameEdgeList list = {0};
+    bool ok = FrameGraphCollectEdges(graph, &list) && FrameGraphLink(graph, &list);
+    free(list.edges);
+
+    if (!ok) {
+        FrameGraphDestroy(graph);
+        return NULL;
+    }
+
+    /* Armed for the first frame; afterwards each node re-arms itself on start */
+    for (size_t i = 0; i < nodeCount; i++) {
+        atomic_init(&graph->nodes[i].pendingInputs, graph->nodes[i].predecessorCount);
+    }
+
+    return graph;
+}
+
+static bool FrameGraphIsCurrent(FrameGraph* graph, SystemicContext** systemics,
+                                size_t systemicCount, uint64_t ownerVersion)
+{
+    if (!graph || graph->ownerVersion != ownerVersion) return false;
+    if (graph->systemicCount != systemicCount) return false;
+
+    for (size_t s = 0; s < systemicCount; s++) {
+        if (graph->systemics[s] != systemics[s] ||
+            graph->systemicVersions[s] != systemics[s]->topologyVersion) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* ============= Frame Execution ============= */
+
+/* Fold a frame's task CPU time into a smoothed cost */
+static void UpdateCostEwmaSample(uint64_t* costEwmaNs, uint64_t sample)
+{
+    if (*costEwmaNs == 0) {
+        *costEwmaNs = sample;
+    } else if (sample >= *costEwmaNs) {
+        *costEwmaNs += (sample - *costEwmaNs) >> PARTY_COST_EWMA_SHIFT;
+    } else {
+        *costEwmaNs -= (*costEwmaNs - sample) >> PARTY_COST_EWMA_SHIFT;
+    }
+}
+
+static void UpdateCostEwma(uint64_t* costEwmaNs, const FiberResult* results, size_t count)
+{
+    uint64_t sample = 0;
+    for (size_t i = 0; i < count; i++) {
+        sample += results[i].executionTimeNs;
+    }
+
+    UpdateCostEwmaSample(costEwmaNs, sample);
+}
+
+static void FrameNodeStart(FrameNode* node);
+
+/*
+ * Fold a finished node into its result slot and its party's counters.
+ * Runs on whichever worker finished the node, so the accounting for a
+ * frame is spread over the pool instead of a pass on the frame thread;
+ * each node has exactly one writer per frame and the latch orders frames.
+ */
+static void FrameNodeRecord(FrameNode* node)
+{
+    FrameGraph* graph = node->graph;
+    DispatchResult* result = &node->result->result;
+    bool failed = atomic_load_explicit(&node->failed, memory_order_relaxed);
+
+    node->result->deferred = node->deferred;
+    result->resultCount = node->deferred || node->cancelled ? 0 : node->taskCount;
+    result->allSucceeded = !failed;
+    result->totalExecutionTimeNs = graph->sampled ? node->finishTimeNs - node->startTimeNs : 0;
+
+    if (failed) {
+        atomic_store_explicit(&graph->systemicFailed[node->systemicIndex], true,
+                              memory_order_relaxed);
+    }
+
+    if (node->partition) {
+        if (graph->sampled) {
+            UpdateCostEwma(&node->partition->costEwmaNs, node->results, node->taskCount);
+        }
+        return;
+    }
+
+    SystemicPartySlot* party = node->party;
+    if (node->cancelled) return;
+    if (node->deferred) {
+        party->deferredFrames++;
+        return;
+    }
+
+    party->deferredFrames = 0;
+    party->executions++;
+    if (graph->sampled) {
+        party->sampledExecutions++;
+        party->totalTimeNs += result->totalExecutionTimeNs;
+        UpdateCostEwma(&party->costEwmaNs, node->results, node->taskCount);
+    }
+}
+
+static void FrameNodeFinish(FrameNode* node)
+{
+    FrameGraph* graph = node->graph;
+    if (graph->sampled) node->finishTimeNs = GetTimeNanos();
+    if (node->result) FrameNodeRecord(node);
+
+    /* Start every successor whose last input this was */
+    for (size_t s = 0; s < node->successorCount; s++) {
+        FrameNode* next = &graph->nodes[node->successors[s]];
+        if (atomic_fetch_sub(&next->pendingInputs, 1) == 1) {
+            FrameNodeStart(next);
+        }
+    }
+
+    /* Last touch of the graph by this fiber; the frame may end here */
+    FiberResult done = {
+        .roleId = node->label,
+        .success = !atomic_load(&node->failed)
+    };
+    DispatchLatchSignal(&graph->latch, node->index, &done);
+}
+
+static void FrameRoleComplete(FrameRoleTask* task, const FiberResult* result)
+{
+    FrameNode* node = task->node;
+
+    *task->result = *result;
+    if (!result->success) {
+        atomic_store(&node->failed, true);
+    }
+
+    if (atomic_fetch_sub(&node->pendingRoles, 1) == 1) {
+        FrameNodeFinish(node);
+    }
+}
+
+static void FrameRoleFunction(void* userData)
+{
+    FrameRoleTask* task = (FrameRoleTask*)userData;
+    FiberMapEntry* entry = task->entry;
+    bool sampled = task->node->graph->sampled;
+    uint64_t startTime = sampled ? GetTimeNanos() : 0;
+
+    FiberResult result = { .roleId = entry->roleId };
+
+    void* roleInstance = GetSlotPointer(entry->instanceSlotId);
+    if (!roleInstance) {
+        result.error = "Failed to load role instance";
+    } else {
+        entry->parallelFn(roleInstance, task->node->party->partyContext);
+        result.success = true;
+    }
+
+    /* Into this worker's FiberStats shard; merged only when read */
+    if (sampled) {
+        result.executionTimeNs = GetTimeNanos() - startTime;
+        RecordFiberStats(task->roleNameId, &result);
+    }
+
+    FrameRoleComplete(task, &result);
+}
+
+/* Set while a partition task runs, so posts know their source */
+static __thread SystemicContext* tlsPartitionSystemic = NULL;
+static __thread SystemicPartition* tlsPartition = NULL;
+
+/*
+ * Whole partition on one worker: last frame's messages, then every
+ * party's roles back to back. Roles must not yield: the source partition
+ * of their posts is thread-local.
+ */
+static void PartitionTaskFunction(void* userData)
+{
+    FrameRoleTask* task = (FrameRoleTask*)userData;
+    SystemicContext* systemic = task->node->systemic;
+    SystemicPartition* partition = task->node->partition;
+    bool sampled = task->node->graph->sampled;
+    uint64_t startTime = sampled ? GetTimeNanos() : 0;
+
+    FiberResult result = { .roleId = partition->name, .success = true };
+
+    tlsPartitionSystemic = systemic;
+    tlsPartition = partition;
+
+    PartitionDeliverMessages(systemic, partition);
+
+    for (size_t i = 0; i < partition->partyCount; i++) {
+        SystemicPartySlot* party = &systemic->partySlots[partition->parties[i]];
+        FiberMap* map = party->fiberMap;
+        uint64_t partyTimeNs = 0;
+
+        for (size_t e = 0; map && e < map->entryCount; e++) {
+            FiberMapEntry* entry = &map->entries[e];
+            FiberResult roleResult = { .roleId = entry->roleId };
+            uint64_t roleStart = sampled ? GetTimeNanos() : 0;
+
+            void* roleInstance = GetSlotPointer(entry->instanceSlotId);
+            if (!roleInstance) {
+                result.success = false;
+                result.error = roleResult.error = "Failed to load role instance";
+            } else {
+                entry->parallelFn(roleInstance, party->partyContext);
+                roleResult.success = true;
+            }
+
+            /* Same per-role and per-party accounting as an unpartitioned frame */
+            if (sampled) {
+                roleResult.executionTimeNs = GetTimeNanos() - roleStart;
+                partyTimeNs += roleResult.executionTimeNs;
+                RecordFiberStats(entry->roleNameId ? entry->roleNameId :
+                                 LookupSlotNameId(entry->roleId), &roleResult);
+            }
+        }
+
+        party->executions++;
+        if (sampled) {
+            party->sampledExecutions++;
+            party->totalTimeNs += partyTimeNs;
+            UpdateCostEwmaSample(&party->costEwmaNs, partyTimeNs);
+        }
+    }
+
+    tlsPartitionSystemic = NULL;
+    tlsPartition = NULL;
+
+    if (sampled) result.executionTimeNs = GetTimeNanos() - startTime;
+    FrameRoleComplete(task, &result);
+}
+
+static void FrameNodeStart(FrameNode* node)
+{
+    FrameGraph* graph = node->graph;
+    if (graph->sampled) node->startTimeNs = GetTimeNanos();
+
+    /* Every input has arrived: re-arm for the next frame, decide on shedding */
+    atomic_store_explicit(&node->pendingInputs, node->predecessorCount, memory_order_relaxed);
+
+    /* A cancelled frame skips parties; partitions still run to drain their messages */
+    node->cancelled = node->party && graph->cancel &&
+                      atomic_load_explicit(graph->cancel, memory_order_relaxed);
+    atomic_store_explicit(&node->failed, node->cancelled, memory_order_relaxed);
+    node->deferred = !node->cancelled && node->party && node->taskCount > 0 &&
+                     node->priority < graph->shedBelow &&
+                     node->party->deferredFrames < WORLD_MAX_DEFERRED_FRAMES;
+    if (node->deferred) {
+        atomic_fetch_add_explicit(&graph->deferredCount, 1, memory_order_relaxed);
+    }
+
+    /* The last role spawned may end the frame; only locals after that */
+    FrameRoleTask* tasks = node->tasks;
+    size_t taskCount = node->taskCount;
+    uint32_t worker = node->party ? node->party->worker : PLAN_WORKER_ANY;
+
+    /* Deferred and cancelled nodes still release their successors */
+    if (taskCount == 0 || node->deferred || node->cancelled) {
+        FrameNodeFinish(node);
+        return;
+    }
+
+    atomic_store(&node->pendingRoles, taskCount);
+
+    if (node->partition) {
+        /* The same worker every frame unless a plan moved the partition */
+        SystemicPartition* partition = node->partition;
+        FiberScheduler* scheduler = GetSchedulerForTag(SCHEDULER_CPU_FIBER);
+        uint32_t owner = partition->worker != PLAN_WORKER_ANY ? partition->worker : partition->index;
+
+        if (!scheduler) {
+            FiberResult failed = { .roleId = partition->name, .error = "Scheduler not found" };
+            FrameRoleComplete(&tasks[0], &failed);
+            return;
+        }
+
+        if (!SchedulerSpawnOnWorker(scheduler, owner, PartitionTaskFunction, &tasks[0],
+                PRIORITY_NORMAL)) {
+            FiberResult failed = { .roleId = partition->name, .error = "Failed to create fiber" };
+            FrameRoleComplete(&tasks[0], &failed);
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < taskCount; i++) {
+        FiberMapEntry* entry = tasks[i].entry;
+        FiberScheduler* scheduler = GetSchedulerForTag(entry->schedulerTag);
+
+        if (!scheduler) {
+            FiberResult failed = { .roleId = entry->roleId, .error = "Scheduler not found" };
+            FrameRoleComplete(&tasks[i], &failed);
+            continue;
+        }
+
+        bool spawned;
+        if (worker != PLAN_WORKER_ANY && entry->schedulerTag != SCHEDULER_GPU_FIBER) {
+            spawned = SchedulerSpawnOnWorker(scheduler, worker, FrameRoleFunction, &tasks[i],
+                (uint32_t)entry->priority);
+        } else {
+            spawned = SchedulerSpawnWithPriority(scheduler, FrameRoleFunction, &tasks[i],
+                (uint32_t)entry->priority);
+        }
+
+        /* Completes the task with an error so the node and its successors still finish */
+        if (!spawned) {
+            FiberResult failed = { .roleId = entry->roleId, .error = "Failed to create fiber" };
+            FrameRoleComplete(&tasks[i], &failed);
+        }
+    }
+}
+
+/*
+ * Start one frame of the graph. Parties whose roles are all below
+ * 'shedBelow' are deferred, unless they already were for
+ * WORLD_MAX_DEFERRED_FRAMES frames in a row. Nodes fill their own
+ * results and counters; only per-systemic totals are left to
+ * FrameGraphFold, and spans are only measured on sampled frames.
+ */
+static void FrameGraphStart(FrameGraph* graph, SchedulerPriority shedBelow, bool sampled,
+                            atomic_bool* cancel)
+{
+    DispatchLatchArm(&graph->latch, JOIN_ALL, NULL, graph->nodeResults, graph->nodeCount);
+
+    graph->shedBelow = shedBelow;
+    graph->sampled = sampled;
+    graph->cancel = cancel;
+    atomic_store_explicit(&graph->deferredCount, 0, memory_order_relaxed);
+    for (size_t s = 0; s < graph->systemicCount; s++) {
+        atomic_store_explicit(&graph->systemicFailed[s], false, memory_order_relaxed);
+    }
+
+    for (size_t r = 0; r < graph->rootCount; r++) {
+        FrameNodeStart(&graph->nodes[graph->roots[r]]);
+    }
+}
+
+/* Fold per-systemic totals once every node has finished */
+static void FrameGraphFold(FrameGraph* graph)
+{
+    bool sampled = graph->sampled;
+    size_t n = 0;
+    for (size_t s = 0; s < graph->systemicCount; s++) {
+        SystemicExecutionResult* systemicResult = &graph->systemicResults[s];
+        SystemicContext* systemic = graph->systemics[s];
+
+        systemicResult->allSucceeded = !atomic_load_explicit(&graph->systemicFailed[s],
+                                                             memory_order_relaxed);
+        systemicResult->totalExecutionTimeNs = 0;
+
+        if (sampled) {
+            uint64_t firstStart = UINT64_MAX;
+            uint64_t lastFinish = 0;
+
+            for (size_t i = 0; i < graph->systemicNodeCounts[s]; i++) {
+                FrameNode* node = &graph->nodes[n + i];
+                if (!node->result) continue;
+                if (node->startTimeNs < firstStart) firstStart = node->startTimeNs;
+                if (node->finishTimeNs > lastFinish) lastFinish = node->finishTimeNs;
+            }
+
+            systemicResult->totalExecutionTimeNs =
+                lastFinish > firstStart ? lastFinish - firstStart : 0;
+            systemic->sampledExecutions++;
+            systemic->totalTimeNs += systemicResult->totalExecutionTimeNs;
+        }
+        n += graph->systemicNodeCounts[s];
+
+        systemic->totalExecutions++;
+        if (!systemicResult->allSucceeded) systemic->errorCount++;
+    }
+}
+
+/* Synchronous frame: the caller blocks on the latch */
+static bool FrameGraphRun(FrameGraph* graph, SchedulerPriority shedBelow, bool sampled)
+{
+    /* No hook: the graph may be freed as soon as the waiter returns */
+    DispatchLatchSetReady(&graph->latch, NULL, NULL);
+    FrameGraphStart(graph, shedBelow, sampled, NULL);
+
+    bool allSucceeded = DispatchLatchWait(&graph->latch, NULL, NULL);
+    DispatchLatchWaitIdle(&graph->latch);
+
+    FrameGraphFold(graph);
+    return allSucceeded;
+}
+
+/* ============= Frame-Buffered Shared State ============= */
+
+#define FRAME_SHARED_ALIGN      16
+#define FRAME_SHARED_STRIDE     64    /* Buffers never share a cache line */
+
+FrameSharedState* FrameSharedStateCreate(uint32_t bufferCount)
+{
+    FrameSharedState* state = (FrameSharedState*)calloc(1, sizeof(FrameSharedState));
+    if (!state) return NULL;
+
+    state->fieldIndex = (uint16_t*)calloc(MAX_INTERNED_FIELD_NAMES, sizeof(uint16_t));
+    if (!state->fieldIndex) {
+        free(state);
+        return NULL;
+    }
+
+    state->bufferCount = bufferCount < 2 ? 2 : bufferCount;
+    atomic_init(&state->frame, 0);
+    return state;
+}
+
+void FrameSharedStateDestroy(FrameSharedState* state)
+{
+    if (!state) return;
+
+    free(state->fields);
+    free(state->fieldIndex);
+    free(state->buffers);
+    free(state);
+}
+
+bool FrameSharedStateAddField(
+    FrameSharedState* state,
+    const char* fieldName,
+    size_t size,
+    const void* initialValue)
+{
+    if (!state || !fieldName || size == 0 || state->sealed) return false;
+    if (state->fieldCount >= UINT16_MAX) return false;
+
+    InternId fieldId = InternFieldName(fieldName);
+    if (fieldId >= MAX_INTERNED_FIELD_NAMES || state->fieldIndex[fieldId]) return false;
+
+    FrameSharedField* fields = (FrameSharedField*)realloc(state->fields,
+        (state->fieldCount + 1) * sizeof(FrameSharedField));
+    if (!fields) return false;
+    state->fields = fields;
+
+    /* Relayout every buffer with the new field appended */
+    size_t used = 0;
+    if (state->fieldCount > 0) {
+        FrameSharedField* last = &fields[state->fieldCount - 1];
+        used = last->offset + last->size;
+    }
+    size_t offset = (used + FRAME_SHARED_ALIGN - 1) & ~(size_t)(FRAME_SHARED_ALIGN - 1);
+    size_t stride = (offset + size + FRAME_SHARED_STRIDE - 1) & ~(size_t)(FRAME_SHARED_STRIDE - 1);
+
+    uint8_t* buffers = state->buffers;
+    if (stride != state->stride) {
+        buffers = (uint8_t*)calloc(state->bufferCount, stride);
+        if (!buffers) return false;
+
+        for (uint32_t b = 0; b < state->bufferCount && state->buffers; b++) {
+            memcpy(buffers + b * stride, state->buffers + b * state->stride, used);
+        }
+        free(state->buffers);
+    }
+
+    for (uint32_t b = 0; b < state->bufferCount; b++) {
+        if (initialValue) {
+            memcpy(buffers + b * stride + offset, initialValue, size);
+        } else {
+            memset(buffers + b * stride + offset, 0, size);
+        }
+    }
+
+    fields[state->fieldCount].fieldId = fieldId;
+    fields[state->fieldCount].offset = offset;
+    fields[state->fieldCount].size = size;
+    state->fieldCount++;
+    state->fieldIndex[fieldId] = (uint16_t)state->fieldCount;
+
+    state->buffers = buffers;
+    state->stride = stride;
+    return true;
+}
+
+void FrameSharedStateCommit(FrameSharedState* state)
+{
+    if (!state || state->fieldCount == 0) return;
+
+    /* This frame's back buffer becomes the front; the next frame writes the one after it */
+    uint64_t frame = atomic_load_explicit(&state->frame, memory_order_relaxed);
+    size_t committed = (size_t)(frame % state->bufferCount);
+    size_t nextBack = (size_t)((frame + 1) % state->bufferCount);
+
+    state->sealed = true;
+    atomic_store_explicit(&state->frame, frame + 1, memory_order_release);
+
+    /* Fields nobody writes next frame keep their committed value */
+    memcpy(state->buffers + nextBack * state->stride,
+           state->buffers + committed * state->stride, state->stride);
+}
+
+/* ============= Slot Name Index ============= */
+
+static uint32_t HashSlotName(const char* name)
+{
+    uint32_t hash = 2166136261u;
+    while (*name) {
+        hash ^= (uint8_t)*name++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static uint32_t SlotNameIndexFind(const SlotNameIndex* index, const char* name)
+{
+    if (index->capacity == 0) return SLOT_INDEX_NONE;
+
+    uint32_t hash = HashSlotName(name);
+    size_t mask = index->capacity - 1;
+
+    for (size_t i = hash & mask; index->names[i]; i = (i + 1) & mask) {
+        if (index->hashes[i] == hash && strcmp(index->names[i], name) == 0) {
+            return index->indices[i];
+        }
+    }
+    return SLOT_INDEX_NONE;
+}
+
+static void SlotNameIndexPlace(SlotNameIndex* index, const char* name, uint32_t hash, uint32_t value)
+{
+    size_t mask = index->capacity - 1;
+    size_t i = hash & mask;
+    while (index->names[i]) i = (i + 1) & mask;
+
+    index->names[i] = name;
+    index->hashes[i] = hash;
+    index->indices[i] = value;
+}
+
+/* Grow ahead of an insert so the slot itself can be added without failing */
+static bool SlotNameIndexReserve(SlotNameIndex* index)
+{
+    /* Keep load at or below one half so probes stay short */
+    if ((index->count + 1) * 2 > index->capacity) {
+        size_t capacity = index->capacity ? index->capacity * 2 : 16;
+        const char** names = (const char**)calloc(capacity, sizeof(const char*));
+        uint32_t* hashes = (uint32_t*)malloc(capacity * sizeof(uint32_t));
+        uint32_t* indices = (uint32_t*)malloc(capacity * sizeof(uint32_t));
+        if (!names || !hashes || !indices) {
+            free(names);
+            free(hashes);
+            free(indices);
+            return false;
+        }
+
+        SlotNameIndex grown = { names, hashes, indices, capacity, index->count };
+        for (size_t i = 0; i < index->capacity; i++) {
+            if (index->names[i]) {
+                SlotNameIndexPlace(&grown, index->names[i], index->hashes[i], index->indices[i]);
+            }
+        }
+
+        free(index->names);
+        free(index->hashes);
+        free(index->indices);
+        *index = grown;
+    }
+    return true;
+}
+
+/* Name must outlive the entry; callers pass the slot's own copy */
+static void SlotNameIndexInsert(SlotNameIndex* index, const char* name, uint32_t value)
+{
+    SlotNameIndexPlace(index, name, HashSlotName(name), value);
+    index->count++;
+}
+
+static void SlotNameIndexDestroy(SlotNameIndex* index)
+{
+    free(index->names);
+    free(index->hashes);
+    free(index->indices);
+    memset(index, 0, sizeof(SlotNameIndex));
+}
+
+/* ============= Systemic Level ============= */
+
+SystemicContext* CreateSystemic(const char* systemicType, const char* instanceName)
+{
+    SystemicContext* systemic = (SystemicContext*)calloc(1, sizeof(SystemicContext));
+    if (!systemic) return NULL;
+
+    systemic->name = strdup(instanceName ? instanceName : "");
+    systemic->systemType = strdup(systemicType ? systemicType : "");
+    if (!systemic->name || !systemic->systemType) {
+        FreeSystemicContext(systemic);
+        return NULL;
+    }
+
+    atomic_init(&systemic->lastFrame, NULL);
+    return systemic;
+}
+
+static SystemicPartySlot* SystemicFindSlot(SystemicContext* systemic, const char* slotName)
+{
+    uint32_t index = SlotNameIndexFind(&systemic->partyIndex, slotName);
+    return index != SLOT_INDEX_NONE ? &systemic->partySlots[index] : NULL;
+}
+
+bool SystemicAddParty(
+    SystemicContext* systemic,
+    const char* slotName,
+    void* partyInstance,
+    PartyContext* partyContext)
+{
+    if (!slotName) return false;
+
+    return SystemicAddPartyWithKey(systemic, slotName, partyInstance, partyContext,
+                                   HashPartitionKey(slotName));
+}
+
+bool SystemicAddPartyWithKey(
+    SystemicContext* systemic,
+    const char* slotName,
+    void* partyInstance,
+    PartyContext* partyContext,
+    uint64_t partitionKey)
+{
+    if (!systemic || !slotName || !partyContext) return false;
+    if (systemic->partyCount >= SLOT_INDEX_NONE) return false;
+    if (SystemicFindSlot(systemic, slotName)) return false;
+    if (!SlotNameIndexReserve(&systemic->partyIndex)) return false;
+
+    if (systemic->partyCount == systemic->partyCapacity) {
+        size_t capacity = systemic->partyCapacity ? systemic->partyCapacity * 2 : 8;
+        SystemicPartySlot* slots = (SystemicPartySlot*)realloc(systemic->partySlots,
+            capacity * sizeof(SystemicPartySlot));
+        if (!slots) return false;
+        systemic->partySlots = slots;
+        systemic->partyCapacity = capacity;
+    }
+
+    SystemicPartySlot* slot = &systemic->partySlots[systemic->partyCount];
+    memset(slot, 0, sizeof(SystemicPartySlot));
+    slot->slotName = strdup(slotName);
+    if (!slot->slotName) return false;
+    slot->partyType = partyContext->partyName;
+    slot->partyInstance = partyInstance;
+    slot->partyContext = partyContext;
+    slot->worker = PLAN_WORKER_ANY;
+    slot->partitionKey = partitionKey;
+
+    if (systemic->partitioning && !PartitionAssign(systemic, systemic->partyCount)) {
+        free((void*)slot->slotName);
+        return false;
+    }
+
+    SlotNameIndexInsert(&systemic->partyIndex, slot->slotName, (uint32_t)systemic->partyCount);
+
+    systemic->partyCount++;
+    systemic->topologyVersion++;
+    return true;
+}
+
+bool SystemicSetBufferedState(SystemicContext* systemic, FrameSharedState* state)
+{
+    if (!systemic) return false;
+
+    if (state) state->sealed = true;
+    systemic->bufferedState = state;
+    systemic->topologyVersion++;
+    return true;
+}
+
+bool SystemicSetPartyFiberMap(SystemicContext* systemic, const char* slotName, FiberMap* map)
+{
+    if (!systemic || !slotName) return false;
+
+    SystemicPartySlot* slot = SystemicFindSlot(systemic, slotName);
+    if (!slot) return false;
+
+    FiberMap* previous = slot->fiberMap;
+    slot->fiberMap = RetainFiberMap(map);
+    FreeFiberMap(previous);
+
+    systemic->topologyVersion++;
+    return true;
+}
+
+bool SystemicDeclareAccess(
+    SystemicContext* systemic,
+    const char* partySlot,
+    const char* fieldName,
+    FieldAccess access)
+{
+    if (!systemic || !partySlot || !fieldName) return false;
+    if (!(access & FIELD_ACCESS_READ_WRITE)) return false;
+
+    SystemicPartySlot* slot = SystemicFindSlot(systemic, partySlot);
+    if (!slot) return false;
+
+    InternId fieldId = InternFieldName(fieldName);
+    if (fieldId == INTERN_ID_NONE) return false;
+
+    /* Merge repeated declarations of the same field */
+    for (size_t i = 0; i < slot->accessCount; i++) {
+        if (slot->accesses[i].fieldId == fieldId) {
+            slot->accesses[i].access |= access;
+            systemic->topologyVersion++;
+            return true;
+        }
+    }
+
+    FieldAccessDecl* accesses = (FieldAccessDecl*)realloc(slot->accesses,
+        (slot->accessCount + 1) * sizeof(FieldAccessDecl));
+    if (!accesses) return false;
+
+    accesses[slot->accessCount].fieldId = fieldId;
+    accesses[slot->accessCount].access = access;
+    slot->accesses = accesses;
+    slot->accessCount++;
+
+    systemic->topologyVersion++;
+    return true;
+}
+
+/* Frame boundary for a systemic: publish buffered fields, flip outboxes */
+static void SystemicCommitFrame(SystemicContext* systemic)
+{
+    FrameSharedStateCommit(systemic->bufferedState);
+    if (systemic->partitioning) {
+        /* External posters pick their outbox parity under this lock */
+        pthread_mutex_lock(&systemic->partitioning->externalMutex);
+        systemic->partitioning->frame++;
+        pthread_mutex_unlock(&systemic->partitioning->externalMutex);
+    }
+}
+
+SystemicExecutionResult ExecuteSystemic(
+    SystemicContext* systemic,
+    JoinStrategy defaultStrategy,
+    DispatcherConfig* config)
+{
+    SystemicExecutionResult result = {0};
+
+    /* Frames join every role: dependents need all writes to have landed */
+    (void)defaultStrategy;
+    (void)config;
+
+    if (!systemic) return result;
+
+    if (!FrameGraphIsCurrent(systemic->frameGraph, &systemic, 1, 0)) {
+        FrameGraphDestroy(systemic->frameGraph);
+        systemic->frameGraph = FrameGraphBuild(&systemic, 1, NULL, 0);
+        if (!systemic->frameGraph) return result;
+    }
+
+    uint64_t startTime = GetTimeNanos();
+    bool allSucceeded = FrameGraphRun(systemic->frameGraph, PRIORITY_IDLE, true);
+    SystemicCommitFrame(systemic);
+
+    result = systemic->frameGraph->systemicResults[0];
+    result.allSucceeded = allSucceeded;
+    result.totalExecutionTimeNs = GetTimeNanos() - startTime;
+    return result;
+}
+
+/* ============= Async Systemic Execution ============= */
+
+typedef struct SystemicContinuation {
+    struct SystemicContinuation* next;
+    SystemicCallback callback;
+    void* userData;
+} SystemicContinuation;
+
+/*
+ * An async frame starts when its start count reaches zero: one for the
+ * submission, one per dependency, one for the systemic's previous frame.
+ * It completes from the latch's ready hook on the last node's worker.
+ */
+struct SystemicHandle {
+    atomic_size_t refs;              /* Caller, lastFrame slot, one until completion */
+    SystemicContext* systemic;
+    atomic_size_t pendingStarts;
+    atomic_bool cancelled;
+    uint64_t startTimeNs;
+    SystemicExecutionResult result;
+
+    pthread_mutex_t mutex;
+    pthread_cond_t completed;        /* CLOCK_MONOTONIC */
+    bool done;
+    SystemicContinuation* continuations;   /* Newest first */
+};
+
+void ReleaseSystemicHandle(SystemicHandle* handle)
+{
+    if (!handle || atomic_fetch_sub(&handle->refs, 1) != 1) return;
+
+    pthread_mutex_destroy(&handle->mutex);
+    pthread_cond_destroy(&handle->completed);
+    free(handle);
+}
+
+static void SystemicHandleComplete(SystemicHandle* handle)
+{
+    /* Idle again, unless a newer frame is already queued behind this one */
+    SystemicHandle* expected = handle;
+    if (atomic_compare_exchange_strong(&handle->systemic->lastFrame, &expected, NULL)) {
+        ReleaseSystemicHandle(handle);
+    }
+
+    pthread_mutex_lock(&handle->mutex);
+    handle->done = true;
+    SystemicContinuation* pending = handle->continuations;
+    handle->continuations = NULL;
+    pthread_cond_broadcast(&handle->completed);
+    pthread_mutex_unlock(&handle->mutex);
+
+    /* Registration order; these may start the next frames */
+    SystemicContinuation* ordered = NULL;
+    while (pending) {
+        SystemicContinuation* next = pending->next;
+        pending->next = ordered;
+        ordered = pending;
+        pending = next;
+    }
+    while (ordered) {
+        SystemicContinuation* next = ordered->next;
+        ordered->callback(handle, &handle->result, ordered->userData);
+        free(ordered);
+        ordered = next;
+    }
+
+    ReleaseSystemicHandle(handle);
+}
+
+/* Latch hook of an async frame: its last node has finished */
+static void FrameGraphReady(DispatchLatch* latch, void* userData)
+{
+    FrameGraph* graph = (FrameGraph*)userData;
+    SystemicHandle* handle = graph->asyncFrame;
+    graph->asyncFrame = NULL;
+
+    bool allSucceeded = DispatchLatchClose(latch, NULL, NULL);
+    FrameGraphFold(graph);
+    SystemicCommitFrame(handle->systemic);
+
+    handle->result = graph->systemicResults[0];
+    handle->result.allSucceeded = allSucceeded;
+    handle->result.totalExecutionTimeNs = GetTimeNanos() - handle->startTimeNs;
+    SystemicHandleComplete(handle);
+}
+
+static void SystemicFrameStart(SystemicHandle* handle)
+{
+    SystemicContext* systemic = handle->systemic;
+    handle->startTimeNs = GetTimeNanos();
+
+    if (atomic_load(&handle->cancelled)) {
+        SystemicHandleComplete(handle);
+        return;
+    }
+
+    /* Safe here: the systemic's previous frame has completed */
+    if (!FrameGraphIsCurrent(systemic->frameGraph, &systemic, 1, 0)) {
+        FrameGraphDestroy(systemic->frameGraph);
+        systemic->frameGraph = FrameGraphBuild(&systemic, 1, NULL, 0);
+        if (!systemic->frameGraph) {
+            SystemicHandleComplete(handle);
+            return;
+        }
+    }
+
+    /* Once started, the frame may complete and the next one rebuild the graph */
+    FrameGraph* graph = systemic->frameGraph;
+    bool empty = graph->nodeCount == 0;
+    graph->asyncFrame = handle;
+    DispatchLatchSetReady(&graph->latch, FrameGraphReady, graph);
+    FrameGraphStart(graph, PRIORITY_IDLE, true, &handle->cancelled);
+
+    /* A systemic without parties has no node to decide the latch */
+    if (empty) DispatchLatchPoll(&graph->latch);
+}
+
+static void SystemicHandleArrive(SystemicHandle* handle)
+{
+    if (atomic_fetch_sub(&handle->pendingStarts, 1) == 1) {
+        SystemicFrameStart(handle);
+    }
+}
+
+static bool SystemicHandleWaitDone(SystemicHandle* handle, uint64_t timeoutMs)
+{
+    uint64_t deadlineNs = GetTimeNanos() + timeoutMs * 1000000ULL;
+    struct timespec deadline = {
+        .tv_sec = (time_t)(deadlineNs / 1000000000ULL),
+        .tv_nsec = (long)(deadlineNs % 1000000000ULL)
+    };
+
+    pthread_mutex_lock(&handle->mutex);
+    while (!handle->done) {
+        if (timeoutMs == 0) {
+            pthread_cond_wait(&handle->completed, &handle->mutex);
+        } else if (pthread_cond_timedwait(&handle->completed, &handle->mutex,
+                                          &deadline) == ETIMEDOUT) {
+            break;
+        }
+    }
+    bool done = handle->done;
+    pthread_mutex_unlock(&handle->mutex);
+    return done;
+}
+
+/* The systemic's previous frame is done: only ordering, no cancellation */
+static void SystemicPreviousDone(SystemicHandle* previous, const SystemicExecutionResult* result,
+                                 void* userData)
+{
+    (void)previous;
+    (void)result;
+
+    SystemicHandle* handle = (SystemicHandle*)userData;
+    SystemicHandleArrive(handle);
+    ReleaseSystemicHandle(handle);
+}
+
+static void SystemicDependencyDone(SystemicHandle* dependency,
+                                   const SystemicExecutionResult* result, void* userData)
+{
+    (void)result;
+
+    SystemicHandle* handle = (SystemicHandle*)userData;
+    if (atomic_load(&dependency->cancelled)) {
+        atomic_store(&handle->cancelled, true);
+    }
+    SystemicHandleArrive(handle);
+    ReleaseSystemicHandle(handle);
+}
+
+static void SystemicHandleAwait(SystemicHandle* handle, SystemicHandle* dependency,
+                                SystemicCallback onDone)
+{
+    atomic_fetch_add(&handle->pendingStarts, 1);
+    atomic_fetch_add(&handle->refs, 1);
+
+    /* Without memory for a continuation, wait for the dependency here */
+    if (!SystemicThen(dependency, onDone, handle)) {
+        SystemicHandleWaitDone(dependency, 0);
+        onDone(dependency, &dependency->result, handle);
+    }
+}
+
+SystemicHandle* ExecuteSystemicAfter(
+    SystemicContext* systemic,
+    SystemicHandle* const* after,
+    size_t afterCount,
+    JoinStrategy defaultStrategy,
+    DispatcherConfig* config)
+{
+    /* Frames join every role, as in ExecuteSystemic */
+    (void)defaultStrategy;
+    (void)config;
+
+    if (!systemic || (afterCount > 0 && !after)) return NULL;
+
+    SystemicHandle* handle = (SystemicHandle*)calloc(1, sizeof(SystemicHandle));
+    if (!handle) return NULL;
+
+    handle->systemic = systemic;
+    atomic_init(&handle->refs, 3);
+    atomic_init(&handle->pendingStarts, 1);
+    atomic_init(&handle->cancelled, false);
+    pthread_mutex_init(&handle->mutex, NULL);
+
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&handle->completed, &attr);
+    pthread_condattr_destroy(&attr);
+
+    /* Queue behind the systemic's previous frame; its slot reference passes to us */
+    SystemicHandle* previous = atomic_exchange(&systemic->lastFrame, handle);
+    if (previous) {
+        SystemicHandleAwait(handle, previous, SystemicPreviousDone);
+        ReleaseSystemicHandle(previous);
+    }
+
+    for (size_t i = 0; i < afterCount; i++) {
+        if (after[i]) {
+            SystemicHandleAwait(handle, after[i], SystemicDependencyDone);
+        }
+    }
+
+    SystemicHandleArrive(handle);
+    return handle;
+}
+
+SystemicHandle* ExecuteSystemicAsync(
+    SystemicContext* systemic,
+    JoinStrategy defaultStrategy,
+    DispatcherConfig* config)
+{
+    return ExecuteSystemicAfter(systemic, NULL, 0, defaultStrategy, config);
+}
+
+bool SystemicThen(SystemicHandle* handle, SystemicCallback callback, void* userData)
+{
+    if (!handle || !callback) return false;
+
+    pthread_mutex_lock(&handle->mutex);
+
+    if (handle->done) {
+        pthread_mutex_unlock(&handle->mutex);
+        callback(handle, &handle->result, userData);
+        return true;
+    }
+
+    SystemicContinuation* continuation =
+        (SystemicContinuation*)malloc(sizeof(SystemicContinuation));
+    if (continuation) {
+        continuation->callback = callback;
+        continuation->userData = userData;
+        continuation->next = handle->continuations;
+        handle->continuations = continuation;
+    }
+
+    pthread_mutex_unlock(&handle->mutex);
+    return continuation != NULL;
+}
+
+bool SystemicIsComplete(SystemicHandle* handle)
+{
+    if (!handle) return false;
+
+    pthread_mutex_lock(&handle->mutex);
+    bool done = handle->done;
+    pthread_mutex_unlock(&handle->mutex);
+    return done;
+}
+
+void CancelSystemic(SystemicHandle* handle)
+{
+    /* Nodes check the flag as they start; dependents inherit it on completion */
+    if (handle) atomic_store(&handle->cancelled, true);
+}
+
+SystemicExecutionResult WaitForSystemic(SystemicHandle* handle, uint64_t timeoutMs)
+{
+    SystemicExecutionResult result = {0};
+    if (!handle || !SystemicHandleWaitDone(handle, timeoutMs)) return result;
+
+    result = handle->result;
+    ReleaseSystemicHandle(handle);
+    return result;
+}
+
+PartyContext* SystemicFindParty(SystemicContext* systemic, const char* partySlot)
+{
+    if (!systemic || !partySlot) return NULL;
+
+    SystemicPartySlot* slot = SystemicFindSlot(systemic, partySlot);
+    return slot ? slot->partyContext : NULL;
+}
+
+uint32_t SystemicResolveParty(SystemicContext* systemic, const char* partySlot)
+{
+    if (!systemic || !partySlot) return SLOT_INDEX_NONE;
+
+    return SlotNameIndexFind(&systemic->partyIndex, partySlot);
+}
+
+/* ============= Partitioned Systemics ============= */
+
+static uint64_t HashPartitionKey(const char* name)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    while (*name) {
+        hash ^= (uint8_t)*name++;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+/* Finalizer so sequential keys spread over partitions */
+static uint64_t MixPartitionKey(uint64_t key)
+{
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+    return key;
+}
+
+uint32_t SystemicPartitionOf(SystemicContext* systemic, uint64_t key)
+{
+    if (!systemic || !systemic->partitioning) return 0;
+
+    SystemicPartitioning* partitioning = systemic->partitioning;
+    if (partitioning->keyFunction) {
+        return partitioning->keyFunction(key, partitioning->partitionCount,
+                                         partitioning->keyUserData) % partitioning->partitionCount;
+    }
+    return (uint32_t)(MixPartitionKey(key) % partitioning->partitionCount);
+}
+
+static PartitionOutbox* PartitionOutboxAt(SystemicPartitioning* partitioning, uint64_t parity,
+                                          uint32_t source, uint32_t destination)
+{
+    size_t count = partitioning->partitionCount;
+    return &partitioning->outboxes[((parity & 1) * (count + 1) + source) * count + destination];
+}
+
+static bool PartitionAssign(SystemicContext* systemic, size_t partyIndex)
+{
+    SystemicPartySlot* slot = &systemic->partySlots[partyIndex];
+    uint32_t index = SystemicPartitionOf(systemic, slot->partitionKey);
+    SystemicPartition* partition = &systemic->partitioning->partitions[index];
+
+    if (partition->partyCount == partition->partyCapacity) {
+        size_t capacity = partition->partyCapacity ? partition->partyCapacity * 2 : 16;
+        size_t* parties = (size_t*)realloc(partition->parties, capacity * sizeof(size_t));
+        if (!parties) return false;
+        partition->parties = parties;
+        partition->partyCapacity = capacity;
+    }
+
+    partition->parties[partition->partyCount++] = partyIndex;
+    slot->partition = index;
+    return true;
+}
+
+static void SystemicPartitioningDestroy(SystemicPartitioning* partitioning)
+{
+    if (!partitioning) return;
+
+    if (partitioning->partitions) {
+        for (uint32_t k = 0; k < partitioning->partitionCount; k++) {
+            free(partitioning->partitions[k].parties);
+        }
+    }
+
+    if (partitioning->outboxes) {
+        size_t outboxCount = 2 * ((size_t)partitioning->partitionCount + 1) *
+                             partitioning->partitionCount;
+        for (size_t i = 0; i < outboxCount; i++) {
+            free(partitioning->outboxes[i].data);
+        }
+    }
+
+    pthread_mutex_destroy(&partitioning->externalMutex);
+    free(partitioning->partitions);
+    free(partitioning->outboxes);
+    free(partitioning);
+}
+
+/* Messages are 8-byte aligned: header, then payload */
+static size_t PartitionMessageSpan(uint32_t size)
+{
+    return (sizeof(PartitionMessage) + size + 7) & ~(size_t)7;
+}
+
+static bool PartitionOutboxAppend(PartitionOutbox* outbox, const PartitionMessage* message,
+                                  const void* payload);
+
+/*
+ * Re-queue every undelivered message of 'previous' under the systemic's new
+ * partitioning. They go to the external source row, old sources in order,
+ * so each source's posting order is kept.
+ */
+static bool PartitionMigrateMessages(SystemicContext* systemic, SystemicPartitioning* previous)
+{
+    SystemicPartitioning* partitioning = systemic->partitioning;
+
+    for (uint64_t parity = 0; parity < 2; parity++) {
+        for (uint32_t source = 0; source <= previous->partitionCount; source++) {
+            for (uint32_t destination = 0; destination < previous->partitionCount; destination++) {
+                PartitionOutbox* outbox = PartitionOutboxAt(previous, parity, source, destination);
+
+                for (size_t offset = 0; offset < outbox->size; ) {
+                    const PartitionMessage* message = (const PartitionMessage*)(outbox->data + offset);
+                    uint32_t target = SystemicPartitionOf(systemic, message->targetKey);
+                    PartitionOutbox* moved = PartitionOutboxAt(partitioning, parity,
+                        partitioning->partitionCount, target);
+
+                    if (!PartitionOutboxAppend(moved, message, message + 1)) return false;
+                    offset += PartitionMessageSpan(message->size);
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+bool SystemicEnablePartitioning(
+    SystemicContext* systemic,
+    uint32_t partitionCount,
+    PartitionKeyFunction keyFunction,
+    void* userData)
+{
+    if (!systemic || partitionCount == 0) return false;
+
+    SystemicPartitioning* partitioning = (SystemicPartitioning*)calloc(1,
+        sizeof(SystemicPartitioning));
+    if (!partitioning) return false;
+
+    pthread_mutex_init(&partitioning->externalMutex, NULL);
+    partitioning->partitionCount = partitionCount;
+    partitioning->keyFunction = keyFunction;
+    partitioning->keyUserData = userData;
+    partitioning->partitions = (SystemicPartition*)calloc(partitionCount, sizeof(SystemicPartition));
+    partitioning->outboxes = (PartitionOutbox*)calloc(2 * ((size_t)partitionCount + 1) * partitionCount,
+        sizeof(PartitionOutbox));
+    if (!partitioning->partitions || !partitioning->outboxes) {
+        SystemicPartitioningDestroy(partitioning);
+        return false;
+    }
+
+    for (uint32_t k = 0; k < partitionCount; k++) {
+        partitioning->partitions[k].index = k;
+        partitioning->partitions[k].worker = PLAN_WORKER_ANY;
+        snprintf(partitioning->partitions[k].name, sizeof(partitioning->partitions[k].name),
+                 "partition-%u", k);
+    }
+
+    /* Keep the handler across a reshard */
+    SystemicPartitioning* previous = systemic->partitioning;
+    if (previous) {
+        partitioning->handler = previous->handler;
+        partitioning->handlerUserData = previous->handlerUserData;
+    }
+
+    systemic->partitioning = partitioning;
+    bool resharded = true;
+    for (size_t p = 0; p < systemic->partyCount && resharded; p++) {
+        resharded = PartitionAssign(systemic, p);
+    }
+
+    /* Messages not yet delivered follow their target keys, on the same frame parity */
+    if (previous && resharded) {
+        partitioning->frame = previous->frame;
+        resharded = PartitionMigrateMessages(systemic, previous);
+    }
+
+    if (!resharded) {
+        systemic->partitioning = previous;
+        for (uint32_t k = 0; previous && k < previous->partitionCount; k++) {
+            for (size_t i = 0; i < previous->partitions[k].partyCount; i++) {
+                systemic->partySlots[previous->partitions[k].parties[i]].partition = k;
+            }
+        }
+        SystemicPartitioningDestroy(partitioning);
+        return false;
+    }
+
+    SystemicPartitioningDestroy(previous);
+    systemic->topologyVersion++;
+    return true;
+}
+
+bool SystemicSetMessageHandler(
+    SystemicContext* systemic,
+    PartitionMessageHandler handler,
+    void* userData)
+{
+    if (!systemic || !systemic->partitioning) return false;
+
+    systemic->partitioning->handler = handler;
+    systemic->partitioning->handlerUserData = userData;
+    return true;
+}
+
+static bool PartitionOutboxAppend(PartitionOutbox* outbox, const PartitionMessage* message,
+                                  const void* payload)
+{
+    size_t span = PartitionMessageSpan(message->size);
+
+    if (outbox->size + span > outbox->capacity) {
+        size_t capacity = outbox->capacity ? outbox->capacity * 2 : 256;
+        while (capacity < outbox->size + span) {
+            capacity *= 2;
+        }
+        uint8_t* data = (uint8_t*)realloc(outbox->data, capacity);
+        if (!data) return false;
+        outbox->data = data;
+        outbox->capacity = capacity;
+    }
+
+    memcpy(outbox->data + outbox->size, message, sizeof(PartitionMessage));
+    if (message->size > 0) {
+        memcpy(outbox->data + outbox->size + sizeof(PartitionMessage), payload, message->size);
+    }
+    outbox->size += span;
+    return true;
+}
+
+bool SystemicPostMessage(
+    SystemicContext* systemic,
+    uint64_t targetKey,
+    const void* payload,
+    uint32_t size)
+{
+    if (!systemic || !systemic->partitioning || (size > 0 && !payload)) return false;
+
+    SystemicPartitioning* partitioning = systemic->partitioning;
+    bool external = tlsPartitionSystemic != systemic;
+
+    PartitionMessage message = {
+        .targetKey = targetKey,
+        .sourcePartition = external ? PARTITION_EXTERNAL : tlsPartition->index,
+        .size = size
+    };
+
+    /* A partition owns its outboxes for the frame; everyone else shares one */
+    uint32_t source = external ? partitioning->partitionCount : tlsPartition->index;
+    uint32_t destination = SystemicPartitionOf(systemic, targetKey);
+
+    if (external) {
+        pthread_mutex_lock(&partitioning->externalMutex);
+    }
+
+    PartitionOutbox* outbox = PartitionOutboxAt(partitioning, partitioning->frame, source, destination);
+    bool queued = PartitionOutboxAppend(outbox, &message, payload);
+
+    if (external) {
+        pthread_mutex_unlock(&partitioning->externalMutex);
+    }
+
+    return queued;
+}
+
+/* Hand last frame's messages for this partition to the handler, source by source */
+static void PartitionDeliverMessages(SystemicContext* systemic, SystemicPartition* partition)
+{
+    SystemicPartitioning* partitioning = systemic->partitioning;
+    uint64_t previous = partitioning->frame + 1;
+
+    for (uint32_t source = 0; source <= partitioning->partitionCount; source++) {
+        PartitionOutbox* outbox = PartitionOutboxAt(partitioning, previous, source, partition->index);
+
+        for (size_t offset = 0; offset < outbox->size && partitioning->handler; ) {
+            const PartitionMessage* message = (const PartitionMessage*)(outbox->data + offset);
+            partitioning->handler(systemic, partition->index, message, message + 1,
+                                  partitioning->handlerUserData);
+            offset += PartitionMessageSpan(message->size);
+        }
+
+        outbox->size = 0;
+    }
+}
+
+/* ============= World Level ============= */
+
+WorldContext* CreateWorld(const char* worldName)
+{
+    WorldContext* world = (WorldContext*)calloc(1, sizeof(WorldContext));
+    if (!world) return NULL;
+
+    world->name = strdup(worldName ? worldName : "");
+    if (!world->name) {
+        free(world);
+        return NULL;
+    }
+
+    atomic_init(&world->isRunning, false);
+    world->shedBelow = PRIORITY_IDLE;
+    world->statsSampleInterval = 1;
+    pthread_mutex_init(&world->statsMutex, NULL);
+
+    return world;
+}
+
+bool WorldAddSystemic(WorldContext* world, const char* slotName, SystemicContext* systemic)
+{
+    if (!world || !slotName || !systemic) return false;
+    if (world->systemicCount >= SLOT_INDEX_NONE) return false;
+    if (WorldFindSystemic(world, slotName)) return false;
+    if (!SlotNameIndexReserve(&world->systemicIndex)) return false;
+
+    if (world->systemicCount == world->systemicCapacity) {
+        size_t capacity = world->systemicCapacity ? world->systemicCapacity * 2 : 8;
+        WorldSystemicSlot* slots = (WorldSystemicSlot*)realloc(world->systemics,
+            capacity * sizeof(WorldSystemicSlot));
+        if (!slots) return false;
+        world->systemics = slots;
+        world->systemicCapacity = capacity;
+    }
+
+    WorldSystemicSlot* slot = &world->systemics[world->systemicCount];
+    slot->slotName = strdup(slotName);
+    if (!slot->slotName) return false;
+    slot->systemicType = systemic->systemType;
+    slot->instance = systemic;
+    SlotNameIndexInsert(&world->systemicIndex, slot->slotName, (uint32_t)world->systemicCount);
+
+    world->systemicCount++;
+    world->topologyVersion++;
+    return true;
+}
+
+bool WorldSetBufferedState(WorldContext* world, FrameSharedState* state)
+{
+    if (!world) return false;
+
+    if (state) state->sealed = true;
+    world->bufferedState = state;
+    world->topologyVersion++;
+    return true;
+}
+
+void WorldSetStatsSampling(WorldContext* world, uint32_t everyNFrames)
+{
+    if (!world) return;
+    world->statsSampleInterval = everyNFrames ? everyNFrames : 1;
+}
+
+/* Current graph for the world, rebuilt when any systemic changed */
+static FrameGraph* WorldAcquireFrameGraph(WorldContext* world)
+{
+    SystemicContext* stackSystemics[16];
+    SystemicContext** systemics = world->systemicCount <= 16 ? stackSystemics :
+        (SystemicContext**)malloc(world->systemicCount * sizeof(SystemicContext*));
+    if (!systemics) return NULL;
+
+    for (size_t s = 0; s < world->systemicCount; s++) {
+        systemics[s] = world->systemics[s].instance;
+    }
+
+    if (!FrameGraphIsCurrent(world->frameGraph, systemics, world->systemicCount,
+                             world->topologyVersion)) {
+        FrameGraphDestroy(world->frameGraph);
+        world->frameGraph = FrameGraphBuild(systemics, world->systemicCount,
+                                            world->bufferedState, world->topologyVersion);
+
+        if (world->frameGraph) {
+            for (size_t s = 0; s < world->systemicCount; s++) {
+                world->frameGraph->worldResults[s].systemicSlot = world->systemics[s].slotName;
+            }
+        }
+    }
+
+    if (systemics != stackSystemics) {
+        free(systemics);
+    }
+
+    return world->frameGraph;
+}
+
+WorldFrameResult ExecuteWorldFrame(WorldContext* world, DispatcherConfig* config)
+{
+    WorldFrameResult result = {0};
+    (void)config;
+
+    if (!world) return result;
+
+    FrameGraph* graph = WorldAcquireFrameGraph(world);
+    if (!graph) return result;
+
+    uint64_t startTime = GetTimeNanos();
+    if (world->startTime == 0) {
+        world->startTime = startTime;
+    }
+
+    /* Instrument 1 in statsSampleInterval frames */
+    bool sampled = world->statsSampleInterval <= 1 ||
+                   world->frameCount % world->statsSampleInterval == 0;
+    result.allSucceeded = FrameGraphRun(graph, world->shedBelow, sampled);
+
+    /* Frame boundary: this frame's writes become next frame's reads */
+    FrameSharedStateCommit(world->bufferedState);
+    for (size_t s = 0; s < graph->systemicCount; s++) {
+        SystemicCommitFrame(graph->systemics[s]);
+    }
+    result.frameTimeNs = GetTimeNanos() - startTime;
+
+    pthread_mutex_lock(&world->statsMutex);
+    FrameHistogramRecord(&world->frameTimes, result.frameTimeNs);
+    world->deferredParties += atomic_load(&graph->deferredCount);
+    if (sampled) world->sampledFrames++;
+    pthread_mutex_unlock(&world->statsMutex);
+
+    for (size_t s = 0; s < graph->systemicCount; s++) {
+        graph->worldResults[s].result = graph->systemicResults[s];
+    }
+
+    result.systemicResults = graph->worldResults;
+    result.resultCount = graph->systemicCount;
+    result.totalFrames = ++world->frameCount;
+
+    WorldMaybeReplan(world);
+    return result;
+}
+
+/* Sleep to just short of an absolute deadline, then spin out the rest */
+static void WaitUntil(uint64_t deadlineNs)
+{
+    uint64_t now = GetTimeNanos();
+
+    if (deadlineNs > now + WORLD_SPIN_NS) {
+        uint64_t wakeNs = deadlineNs - WORLD_SPIN_NS;
+        struct timespec wake = {
+            .tv_sec = (time_t)(wakeNs / 1000000000ULL),
+            .tv_nsec = (long)(wakeNs % 1000000000ULL)
+        };
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, NULL) == EINTR) {
+        }
+    }
+
+    while (GetTimeNanos() < deadlineNs) {
+        CpuRelax();
+    }
+}
+
+static void ReportSystemicErrors(WorldFrameResult* result, WorldLoopConfig* loopConfig)
+{
+    for (size_t s = 0; s < result->resultCount; s++) {
+        SystemicExecutionResult* systemic = &result->systemicResults[s].result;
+        if (systemic->allSucceeded) continue;
+
+        /* First failing role explains the systemic */
+        const char* error = NULL;
+        for (size_t p = 0; p < systemic->resultCount && !error; p++) {
+            DispatchResult* party = &systemic->partyResults[p].result;
+            for (size_t r = 0; r < party->resultCount && !error; r++) {
+                if (!party->results[r].success) {
+                    error = party->results[r].error;
+                }
+            }
+        }
+
+        loopConfig->onSystemicError(result->systemicResults[s].systemicSlot,
+                                    error ? error : "Party failed");
+    }
+}
+
+/* Shed one more priority level after sustained overruns, restore after sustained slack */
+static void AdaptShedding(WorldContext* world, uint64_t frameTimeNs, uint64_t targetNs,
+                          uint32_t* overruns, uint32_t* underruns)
+{
+    if (frameTimeNs > targetNs) {
+        *underruns = 0;
+        if (++(*overruns) >= WORLD_SHED_AFTER && world->shedBelow < PRIORITY_NORMAL) {
+            world->shedBelow = world->shedBelow < PRIORITY_LOW ? PRIORITY_LOW : PRIORITY_NORMAL;
+            *overruns = 0;
+        }
+    } else if (frameTimeNs < targetNs - targetNs / 4) {
+        *overruns = 0;
+        if (++(*underruns) >= WORLD_RESTORE_AFTER && world->shedBelow > PRIORITY_IDLE) {
+            world->shedBelow = world->shedBelow > PRIORITY_LOW ? PRIORITY_LOW : PRIORITY_IDLE;
+            *underruns = 0;
+        }
+    }
+}
+
+void RunWorldLoop(
+    WorldContext* world,
+    WorldLoopConfig* loopConfig,
+    DispatcherConfig* dispatchConfig)
+{
+    if (!world || !loopConfig) return;
+
+    uint64_t targetNs = loopConfig->targetFrameTimeNs;
+    uint64_t frames = 0;
+    uint32_t overruns = 0;
+    uint32_t underruns = 0;
+
+    atomic_store(&world->isRunning, true);
+    uint64_t deadline = GetTimeNanos() + targetNs;
+
+    while (atomic_load(&world->isRunning) &&
+           (loopConfig->maxFrames == 0 || frames < loopConfig->maxFrames)) {
+        uint64_t frameStart = GetTimeNanos();
+
+        if (loopConfig->onFrameStart) {
+            loopConfig->onFrameStart(world, world->frameCount + 1);
+        }
+
+        WorldFrameResult result = ExecuteWorldFrame(world, dispatchConfig);
+
+        if (!result.allSucceeded && loopConfig->onSystemicError) {
+            ReportSystemicErrors(&result, loopConfig);
+        }
+        if (loopConfig->onFrameEnd) {
+            loopConfig->onFrameEnd(world, &result);
+        }
+
+        frames++;
+        if (targetNs == 0) continue;
+
+        uint64_t frameEnd = GetTimeNanos();
+        bool missed = frameEnd > deadline;
+
+        pthread_mutex_lock(&world->statsMutex);
+        if (missed) {
+            world->missedDeadlines++;
+        } else {
+            FrameHistogramRecord(&world->slack, deadline - frameEnd);
+        }
+        pthread_mutex_unlock(&world->statsMutex);
+
+        if (loopConfig->adaptiveSync) {
+            AdaptShedding(world, frameEnd - frameStart, targetNs, &overruns, &underruns);
+        }
+
+        if (missed) {
+            /* Re-anchor rather than run late frames back to back */
+            deadline = frameEnd + targetNs;
+        } else {
+            WaitUntil(deadline);
+            deadline += targetNs;
+        }
+    }
+
+    world->shedBelow = PRIORITY_IDLE;
+    atomic_store(&world->isRunning, false);
+}
+
+void StopWorld(WorldContext* world)
+{
+    if (!world) return;
+
+    atomic_store(&world->isRunning, false);
+}
+
+/* ============= Cross-Level Communication ============= */
+
+SystemicContext* WorldFindSystemic(WorldContext* world, const char* systemicSlot)
+{
+    if (!world || !systemicSlot) return NULL;
+
+    return WorldGetSystemic(world, SlotNameIndexFind(&world->systemicIndex, systemicSlot));
+}
+
+PartyContext* WorldFindParty(
+    WorldContext* world,
+    const char* systemicSlot,
+    const char* partySlot)
+{
+    return SystemicFindParty(WorldFindSystemic(world, systemicSlot), partySlot);
+}
+
+uint32_t WorldResolveSystemic(WorldContext* world, const char* systemicSlot)
+{
+    if (!world || !systemicSlot) return SLOT_INDEX_NONE;
+
+    return SlotNameIndexFind(&world->systemicIndex, systemicSlot);
+}
+
+PartyHandle WorldResolveParty(
+    WorldContext* world,
+    const char* systemicSlot,
+    const char* partySlot)
+{
+    uint32_t systemicIndex = WorldResolveSystemic(world, systemicSlot);
+    if (systemicIndex == SLOT_INDEX_NONE) return PARTY_HANDLE_INVALID;
+
+    uint32_t partyIndex = SystemicResolveParty(world->systemics[systemicIndex].instance, partySlot);
+    if (partyIndex == SLOT_INDEX_NONE) return PARTY_HANDLE_INVALID;
+
+    return (PartyHandle)systemicIndex << 32 | partyIndex;
+}
+
+/* ============= Hierarchical Execution ============= */
+
+/* Measured cost if the party has run, else the roles' recorded averages */
+static uint64_t PartyEstimateCost(FrameNode* node)
+{
+    if (node->partition) {
+        return node->partition->costEwmaNs > 0 ? node->partition->costEwmaNs : 1;
+    }
+    if (node->party->costEwmaNs > 0) {
+        return node->party->costEwmaNs;
+    }
+
+    uint64_t cost = 0;
+    for (size_t i = 0; i < node->taskCount; i++) {
+        cost += GetFiberStats(node->tasks[i].entry->roleId).avgTimeNs;
+    }
+
+    /* Unknown parties weigh the same as each other */
+    return cost > 0 ? cost : 1;
+}
+
+HierarchicalExecutionPlan* GenerateWorldExecutionPlan(WorldContext* world)
+{
+    if (!world) return NULL;
+
+    FrameGraph* graph = WorldAcquireFrameGraph(world);
+    if (!graph) return NULL;
+
+    HierarchicalExecutionPlan* plan = (HierarchicalExecutionPlan*)calloc(1,
+        sizeof(HierarchicalExecutionPlan));
+    if (!plan) return NULL;
+
+    plan->worldName = world->name;
+    plan->systemicCount = graph->systemicCount;
+    plan->systemics = calloc(graph->systemicCount ? graph->systemicCount : 1,
+        sizeof(*plan->systemics));
+    if (!plan->systemics) {
+        free(plan);
+        return NULL;
+    }
+
+    size_t n = 0;
+    bool crossSystemicEdges = false;
+
+    for (size_t s = 0; s < graph->systemicCount; s++) {
+        SystemicContext* systemic = graph->systemics[s];
+
+        /* A partitioned systemic is planned per partition */
+        size_t nodeCount = graph->systemicNodeCounts[s];
+        size_t unitCount = systemic->partitioning ? systemic->partitioning->partitionCount :
+                                                    systemic->partyCount;
+
+        plan->systemics[s].systemicName = systemic->name;
+        plan->systemics[s].partyCount = unitCount;
+        plan->systemics[s].parties = calloc(unitCount ? unitCount : 1,
+            sizeof(*plan->systemics[s].parties));
+        if (!plan->systemics[s].parties) {
+            FreeExecutionPlan(plan);
+            return NULL;
+        }
+
+        size_t p = 0;
+        for (size_t i = 0; i < nodeCount; i++, n++) {
+            FrameNode* node = &graph->nodes[n];
+
+            for (size_t e = 0; e < node->successorCount; e++) {
+                if (graph->nodes[node->successors[e]].systemic != systemic) {
+                    crossSystemicEdges = true;
+                }
+            }
+
+            if (node->kind == FRAME_NODE_ENTRY || node->kind == FRAME_NODE_EXIT) continue;
+
+            PlannedParty* planned = &plan->systemics[s].parties[p++];
+            planned->partyName = node->label;
+            planned->estimatedCostNs = PartyEstimateCost(node);
+
+            if (node->partition) {
+                planned->partition = node->partition;
+                planned->worker = node->partition->worker;
+
+                /* Partition roles run inline in one CPU fiber */
+                for (size_t k = 0; k < node->partition->partyCount; k++) {
+                    FiberMap* map = systemic->partySlots[node->partition->parties[k]].fiberMap;
+                    planned->roleCount += map ? map->entryCount : 0;
+                }
+                plan->estimatedCpuFibers++;
+            } else {
+                planned->fiberMap = node->party->fiberMap;
+                planned->roleCount = node->taskCount;
+                planned->slot = node->party;
+                planned->worker = node->party->worker;
+
+                for (size_t t = 0; t < node->taskCount; t++) {
+                    if (node->tasks[t].entry->schedulerTag == SCHEDULER_GPU_FIBER) {
+                        plan->estimatedGpuFibers++;
+                    } else {
+                        plan->estimatedCpuFibers++;
+                    }
+                }
+            }
+
+            plan->totalRoles += planned->roleCount;
+        }
+
+        plan->totalParties += unitCount;
+    }
+
+    /* One fiber per role (per partition when partitioned) */
+    plan->totalFibers = plan->estimatedCpuFibers + plan->estimatedGpuFibers;
+    plan->canParallelizeSystemics = graph->systemicCount > 1 && !crossSystemicEdges;
+    plan->canParallelizeParties = graph->width > 1;
+
+    return plan;
+}
+
+/* Union-find over plan parties, for co-location */
+static size_t PlanFindGroup(size_t* parent, size_t i)
+{
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+/* Merge unless the result would exceed 'cap' parties; the lower index stays the root */
+static void PlanUnion(size_t* parent, size_t* size, size_t a, size_t b, size_t cap)
+{
+    a = PlanFindGroup(parent, a);
+    b = PlanFindGroup(parent, b);
+    if (a == b || size[a] + size[b] > cap) return;
+
+    size_t root = a < b ? a : b;
+    size_t child = a < b ? b : a;
+    parent[child] = root;
+    size[root] += size[child];
+}
+
+/* A set of parties placed as one unit; members are linked through 'next' */
+typedef struct {
+    uint64_t costNs;
+    size_t first;
+} PlanItem;
+
+static int ComparePlanItems(const void* a, const void* b)
+{
+    const PlanItem* x = (const PlanItem*)a;
+    const PlanItem* y = (const PlanItem*)b;
+
+    /* Longest first; ties by first party keep the plan deterministic */
+    if (x->costNs != y->costNs) return x->costNs > y->costNs ? -1 : 1;
+    return x->first < y->first ? -1 : (x->first > y->first);
+}
+
+/* Scratch buffers for one planning pass */
+typedef struct {
+    PlannedParty** parties;
+    size_t* parent;
+    size_t* groupSize;               /* Parties per union-find root */
+    size_t* next;
+    size_t* head;
+    uint64_t* groupCost;
+    PlanItem* items;
+    size_t* fieldOwner;
+    bool* fieldWritten;
+    PartyContext** contextKeys;      /* Open-addressed, contextCapacity slots */
+    size_t* contextOwner;
+    size_t contextCapacity;          /* Power of two, at least twice the parties */
+    uint64_t* loads;
+} PlanScratch;
+
+/* First party seen with 'context', or FRAME_NODE_NONE after recording 'party' */
+static size_t PlanContextOwner(PlanScratch* scratch, PartyContext* context, size_t party)
+{
+    size_t mask = scratch->contextCapacity - 1;
+    size_t i = (size_t)MixPartitionKey((uint64_t)(uintptr_t)context) & mask;
+
+    while (scratch->contextKeys[i]) {
+        if (scratch->contextKeys[i] == context) return scratch->contextOwner[i];
+        i = (i + 1) & mask;
+    }
+
+    scratch->contextKeys[i] = context;
+    scratch->contextOwner[i] = party;
+    return FRAME_NODE_NONE;
+}
+
+static void PlanAssignWorkers(HierarchicalExecutionPlan* plan, PlanScratch* scratch,
+                              uint32_t workerCount, bool preferLatency)
+{
+    size_t count = plan->totalParties;
+    PlannedParty** parties = scratch->parties;
+    size_t* parent = scratch->parent;
+    size_t* groupSize = scratch->groupSize;
+    size_t* next = scratch->next;
+    size_t* head = scratch->head;
+    uint64_t* loads = scratch->loads;
+
+    size_t n = 0;
+    for (size_t s = 0; s < plan->systemicCount; s++) {
+        for (size_t p = 0; p < plan->systemics[s].partyCount; p++) {
+            parties[n] = &plan->systemics[s].parties[p];
+            parent[n] = n;
+            groupSize[n] = 1;
+            head[n] = FRAME_NODE_NONE;
+            n++;
+        }
+    }
+
+    /*
+     * Co-locate parties that share a context, and the accessors of a field
+     * somebody writes. Read-only fields join nobody: their readers already
+     * run concurrently. Field groups stop growing at a worker's share of
+     * the parties, so one hot field cannot pull the world onto one worker.
+     */
+    size_t fieldCap = (count + workerCount - 1) / workerCount;
+    if (fieldCap < 2) fieldCap = 2;
+
+    for (size_t f = 0; f < MAX_INTERNED_FIELD_NAMES; f++) {
+        scratch->fieldOwner[f] = FRAME_NODE_NONE;
+        scratch->fieldWritten[f] = false;
+    }
+    for (size_t i = 0; i < count; i++) {
+        SystemicPartySlot* slot = parties[i]->slot;
+        for (size_t a = 0; slot && a < slot->accessCount; a++) {
+            InternId fieldId = slot->accesses[a].fieldId;
+            if (fieldId < MAX_INTERNED_FIELD_NAMES &&
+                (slot->accesses[a].access & FIELD_ACCESS_WRITE)) {
+                scratch->fieldWritten[fieldId] = true;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        SystemicPartySlot* slot = parties[i]->slot;
+        if (!slot) continue;
+
+        size_t owner = PlanContextOwner(scratch, slot->partyContext, i);
+        if (owner != FRAME_NODE_NONE) {
+            PlanUnion(parent, groupSize, i, owner, SIZE_MAX);
+        }
+
+        for (size_t a = 0; a < slot->accessCount; a++) {
+            InternId fieldId = slot->accesses[a].fieldId;
+            if (fieldId >= MAX_INTERNED_FIELD_NAMES || !scratch->fieldWritten[fieldId]) continue;
+
+            if (scratch->fieldOwner[fieldId] == FRAME_NODE_NONE) {
+                scratch->fieldOwner[fieldId] = i;
+            } else {
+                PlanUnion(parent, groupSize, i, scratch->fieldOwner[fieldId], fieldCap);
+            }
+        }
+    }
+
+    /* GPU-only parties take no CPU worker */
+    uint64_t totalCost = 0;
+    for (size_t i = 0; i < count; i++) {
+        FiberMap* map = parties[i]->fiberMap;
+        bool cpu = parties[i]->partition != NULL;
+        for (size_t e = 0; map && e < map->entryCount && !cpu; e++) {
+            cpu = map->entries[e].schedulerTag != SCHEDULER_GPU_FIBER;
+        }
+
+        parties[i]->worker = PLAN_WORKER_ANY;
+        if (!cpu) continue;
+
+        size_t group = PlanFindGroup(parent, i);
+        next[i] = head[group];
+        head[group] = i;
+        scratch->groupCost[group] += parties[i]->estimatedCostNs;
+        totalCost += parties[i]->estimatedCostNs;
+    }
+
+    /* Groups become items; for latency, oversized groups are split up */
+    uint64_t fairShare = totalCost / workerCount;
+    size_t itemCount = 0;
+    for (size_t g = 0; g < count; g++) {
+        if (head[g] == FRAME_NODE_NONE) continue;
+
+        PlanItem* items = scratch->items;
+        if (preferLatency && scratch->groupCost[g] > fairShare && next[head[g]] != FRAME_NODE_NONE) {
+            for (size_t i = head[g]; i != FRAME_NODE_NONE; ) {
+                size_t following = next[i];
+                next[i] = FRAME_NODE_NONE;
+                items[itemCount].costNs = parties[i]->estimatedCostNs;
+                items[itemCount].first = i;
+                itemCount++;
+                i = following;
+            }
+        } else {
+            items[itemCount].costNs = scratch->groupCost[g];
+            items[itemCount].first = head[g];
+            itemCount++;
+        }
+    }
+
+    /* LPT: biggest item to the least loaded worker */
+    qsort(scratch->items, itemCount, sizeof(PlanItem), ComparePlanItems);
+
+    for (size_t it = 0; it < itemCount; it++) {
+        uint32_t target = 0;
+        for (uint32_t w = 1; w < workerCount; w++) {
+            if (loads[w] < loads[target]) target = w;
+        }
+
+        loads[target] += scratch->items[it].costNs;
+        for (size_t i = scratch->items[it].first; i != FRAME_NODE_NONE; i = next[i]) {
+            parties[i]->worker = target;
+        }
+    }
+
+    uint64_t makespan = 0;
+    for (uint32_t w = 0; w < workerCount; w++) {
+        if (loads[w] > makespan) makespan = loads[w];
+    }
+
+    plan->workerCount = workerCount;
+    plan->makespanNs = makespan;
+    plan->imbalance = totalCost > 0 ? (double)makespan * workerCount / (double)totalCost : 1.0;
+}
+
+void OptimizeExecutionPlan(
+    HierarchicalExecutionPlan* plan,
+    const ExecutionPlanConstraints* constraints)
+{
+    if (!plan || plan->totalParties == 0) return;
+
+    uint32_t workerCount = constraints ? constraints->availableCpuCores : 0;
+    if (workerCount == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        workerCount = cpus > 0 ? (uint32_t)cpus : 1;
+    }
+
+    size_t count = plan->totalParties;
+    size_t contextCapacity = 16;
+    while (contextCapacity < count * 2) {
+        contextCapacity *= 2;
+    }
+
+    PlanScratch scratch = {
+        .parties = (PlannedParty**)malloc(count * sizeof(PlannedParty*)),
+        .parent = (size_t*)malloc(count * sizeof(size_t)),
+        .groupSize = (size_t*)malloc(count * sizeof(size_t)),
+        .next = (size_t*)malloc(count * sizeof(size_t)),
+        .head = (size_t*)malloc(count * sizeof(size_t)),
+        .groupCost = (uint64_t*)calloc(count, sizeof(uint64_t)),
+        .items = (PlanItem*)malloc(count * sizeof(PlanItem)),
+        .fieldOwner = (size_t*)malloc(MAX_INTERNED_FIELD_NAMES * sizeof(size_t)),
+        .fieldWritten = (bool*)malloc(MAX_INTERNED_FIELD_NAMES * sizeof(bool)),
+        .contextKeys = (PartyContext**)calloc(contextCapacity, sizeof(PartyContext*)),
+        .contextOwner = (size_t*)malloc(contextCapacity * sizeof(size_t)),
+        .contextCapacity = contextCapacity,
+        .loads = (uint64_t*)calloc(workerCount, sizeof(uint64_t))
+    };
+
+    if (scratch.parties && scratch.parent && scratch.groupSize && scratch.next &&
+        scratch.head && scratch.groupCost && scratch.items && scratch.fieldOwner &&
+        scratch.fieldWritten && scratch.contextKeys && scratch.contextOwner && scratch.loads) {
+        PlanAssignWorkers(plan, &scratch, workerCount, constraints && constraints->preferLatency);
+
+        /* The plan keeps the per-worker loads */
+        free(plan->workerLoadNs);
+        plan->workerLoadNs = scratch.loads;
+        scratch.loads = NULL;
+    }
+
+    free(scratch.parties);
+    free(scratch.parent);
+    free(scratch.groupSize);
+    free(scratch.next);
+    free(scratch.head);
+    free(scratch.groupCost);
+    free(scratch.items);
+    free(scratch.fieldOwner);
+    free(scratch.fieldWritten);
+    free(scratch.contextKeys);
+    free(scratch.contextOwner);
+    free(scratch.loads);
+}
+
+void ApplyExecutionPlan(HierarchicalExecutionPlan* plan)
+{
+    if (!plan) return;
+
+    for (size_t s = 0; s < plan->systemicCount; s++) {
+        for (size_t p = 0; p < plan->systemics[s].partyCount; p++) {
+            PlannedParty* planned = &plan->systemics[s].parties[p];
+            if (planned->slot) {
+                planned->slot->worker = planned->worker;
+            } else if (planned->partition) {
+                planned->partition->worker = planned->worker;
+            }
+        }
+    }
+}
+
+void WorldEnableAutoPlanning(
+    WorldContext* world,
+    const ExecutionPlanConstraints* constraints,
+    uint32_t replanIntervalFrames,
+    double imbalanceThreshold)
+{
+    if (!world) return;
+
+    memset(&world->planConstraints, 0, sizeof(world->planConstraints));
+    if (constraints) {
+        world->planConstraints = *constraints;
+    }
+    world->replanInterval = replanIntervalFrames;
+    world->replanThreshold = imbalanceThreshold;
+    world->replans = 0;
+}
+
+/* Max / mean worker load under the current placement, from measured costs */
+static double WorldMeasureImbalance(WorldContext* world, uint32_t workerCount)
+{
+    uint64_t* loads = (uint64_t*)calloc(workerCount, sizeof(uint64_t));
+    if (!loads) return 0.0;
+
+    uint64_t total = 0;
+    for (size_t s = 0; s < world->systemicCount; s++) {
+        SystemicContext* systemic = world->systemics[s].instance;
+
+        if (systemic->partitioning) {
+            for (uint32_t k = 0; k < systemic->partitioning->partitionCount; k++) {
+                SystemicPartition* partition = &systemic->partitioning->partitions[k];
+                uint32_t owner = partition->worker != PLAN_WORKER_ANY ? partition->worker : k;
+
+                loads[owner % workerCount] += partition->costEwmaNs;
+                total += partition->costEwmaNs;
+            }
+            continue;
+        }
+
+        for (size_t p = 0; p < systemic->partyCount; p++) {
+            SystemicPartySlot* party = &systemic->partySlots[p];
+            if (party->worker == PLAN_WORKER_ANY) continue;
+
+            loads[party->worker % workerCount] += party->costEwmaNs;
+            total += party->costEwmaNs;
+        }
+    }
+
+    uint64_t maxLoad = 0;
+    for (uint32_t w = 0; w < workerCount; w++) {
+        if (loads[w] > maxLoad) maxLoad = loads[w];
+    }
+
+    free(loads);
+    return total > 0 ? (double)maxLoad * workerCount / (double)total : 0.0;
+}
+
+/* Between frames: re-plan placement when the interval is up and load has drifted */
+static void WorldMaybeReplan(WorldContext* world)
+{
+    if (world->replanInterval == 0 || world->frameCount % world->replanInterval != 0) return;
+
+    if (world->replans > 0) {
+        uint32_t workers = world->planConstraints.availableCpuCores;
+        if (workers == 0) {
+            long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+            workers = cpus > 0 ? (uint32_t)cpus : 1;
+        }
+        if (WorldMeasureImbalance(world, workers) <= world->replanThreshold) return;
+    }
+
+    HierarchicalExecutionPlan* plan = GenerateWorldExecutionPlan(world);
+    if (!plan) return;
+
+    OptimizeExecutionPlan(plan, &world->planConstraints);
+    ApplyExecutionPlan(plan);
+    FreeExecutionPlan(plan);
+    world->replans++;
+}
+
+/* ============= Monitoring & Debugging ============= */
+
+WorldStatistics* GetWorldStatistics(WorldContext* world)
+{
+    if (!world) return NULL;
+
+    WorldStatistics* stats = (WorldStatistics*)calloc(1, sizeof(WorldStatistics));
+    if (!stats) return NULL;
+
+    pthread_mutex_lock(&world->statsMutex);
+    stats->frameTimeHistogram = world->frameTimes;
+    stats->slackHistogram = world->slack;
+    stats->missedDeadlines = world->missedDeadlines;
+    stats->deferredParties = world->deferredParties;
+    stats->sampledFrames = world->sampledFrames;
+    pthread_mutex_unlock(&world->statsMutex);
+    stats->sampleInterval = world->statsSampleInterval;
+
+    stats->totalFrames = stats->frameTimeHistogram.count;
+    stats->maxFrameTimeNs = stats->frameTimeHistogram.maxNs;
+    if (stats->totalFrames > 0) {
+        stats->avgFrameTimeNs = stats->frameTimeHistogram.totalNs / stats->totalFrames;
+    }
+
+    /* Per-systemic counters are written by the frame thread; read between frames */
+    stats->systemicCount = world->systemicCount;
+    stats->systemicStats = calloc(world->systemicCount ? world->systemicCount : 1,
+        sizeof(*stats->systemicStats));
+    if (!stats->systemicStats) {
+        free(stats);
+        return NULL;
+    }
+
+    /* Role stats are merged from the worker shards once per role name, on demand */
+    FiberStats** roleCache = (FiberStats**)calloc(MAX_INTERNED_SLOT_NAMES, sizeof(FiberStats*));
+    if (!roleCache) {
+        FreeWorldStatistics(stats);
+        return NULL;
+    }
+
+    bool ok = true;
+    for (size_t s = 0; s < world->systemicCount && ok; s++) {
+        SystemicContext* systemic = world->systemics[s].instance;
+
+        stats->systemicStats[s].systemicName = systemic->name;
+        stats->systemicStats[s].totalExecutions = systemic->totalExecutions;
+        stats->systemicStats[s].errorCount = systemic->errorCount;
+        if (systemic->sampledExecutions > 0) {
+            stats->systemicStats[s].avgExecutionTimeNs =
+                systemic->totalTimeNs / systemic->sampledExecutions;
+        }
+
+        stats->systemicStats[s].partyCount = systemic->partyCount;
+        stats->systemicStats[s].partyStats = calloc(systemic->partyCount ? systemic->partyCount : 1,
+            sizeof(*stats->systemicStats[s].partyStats));
+        if (!stats->systemicStats[s].partyStats) {
+            ok = false;
+            break;
+        }
+
+        for (size_t p = 0; p < systemic->partyCount && ok; p++) {
+            SystemicPartySlot* party = &systemic->partySlots[p];
+            FiberMap* map = party->fiberMap;
+
+            stats->systemicStats[s].partyStats[p].partyName = party->slotName;
+            if (party->sampledExecutions > 0) {
+                stats->systemicStats[s].partyStats[p].avgPartyTimeNs =
+                    party->totalTimeNs / party->sampledExecutions;
+            }
+
+            if (!map || map->entryCount == 0) continue;
+
+            FiberStats* roleStats = (FiberStats*)calloc(map->entryCount, sizeof(FiberStats));
+            if (!roleStats) {
+                ok = false;
+                break;
+            }
+            stats->systemicStats[s].partyStats[p].roleStats = roleStats;
+            stats->systemicStats[s].partyStats[p].roleCount = map->entryCount;
+
+            for (size_t e = 0; e < map->entryCount; e++) {
+                FiberMapEntry* entry = &map->entries[e];
+                InternId roleNameId = entry->roleNameId ?
+                    entry->roleNameId : LookupSlotNameId(entry->roleId);
+                if (roleNameId == INTERN_ID_NONE || roleNameId >= MAX_INTERNED_SLOT_NAMES) {
+                    roleStats[e].roleId = entry->roleId;
+                    continue;
+                }
+
+                if (!roleCache[roleNameId]) {
+                    roleCache[roleNameId] = (FiberStats*)malloc(sizeof(FiberStats));
+                    if (!roleCache[roleNameId]) {
+                        ok = false;
+                        break;
+                    }
+                    *roleCache[roleNameId] = GetFiberStatsById(roleNameId);
+                }
+                roleStats[e] = *roleCache[roleNameId];
+            }
+        }
+    }
+
+    for (size_t id = 0; id < MAX_INTERNED_SLOT_NAMES; id++) {
+        free(roleCache[id]);
+    }
+    free(roleCache);
+
+    if (!ok) {
+        FreeWorldStatistics(stats);
+        return NULL;
+    }
+    return stats;
+}
+
+bool WorldGetPartyStatistics(WorldContext* world, PartyHandle handle, PartyStatistics* stats)
+{
+    if (!stats) return false;
+
+    SystemicContext* systemic = WorldGetSystemic(world, (uint32_t)(handle >> 32));
+    if (!systemic || (uint32_t)handle >= systemic->partyCount) return false;
+
+    const SystemicPartySlot* party = &systemic->partySlots[(uint32_t)handle];
+    stats->executions = party->executions;
+    stats->avgTimeNs = party->sampledExecutions ? party->totalTimeNs / party->sampledExecutions : 0;
+    stats->costEwmaNs = party->costEwmaNs;
+    stats->deferredFrames = party->deferredFrames;
+    stats->worker = party->worker;
+    return true;
+}
+
+/* ============= Memory Management ============= */
+
+void FreeSystemicContext(SystemicContext* systemic)
+{
+    if (!systemic) return;
+
+    FrameGraphDestroy(systemic->frameGraph);
+    SystemicPartitioningDestroy(systemic->partitioning);
+
+    for (size_t i = 0; i < systemic->partyCount; i++) {
+        free((void*)systemic->partySlots[i].slotName);
+        free(systemic->partySlots[i].accesses);
+        FreeFiberMap(systemic->partySlots[i].fiberMap);
+    }
+
+    SlotNameIndexDestroy(&systemic->partyIndex);
+    free(systemic->partySlots);
+    free((void*)systemic->name);
+    free((void*)systemic->systemType);
+    free(systemic);
+}
+
+/* Systemics are owned by their creators, not by the world */
+void FreeWorldContext(WorldContext* world)
+{
+    if (!world) return;
+
+    FrameGraphDestroy(world->frameGraph);
+
+    for (size_t i = 0; i < world->systemicCount; i++) {
+        free((void*)world->systemics[i].slotName);
+    }
+
+    SlotNameIndexDestroy(&world->systemicIndex);
+    pthread_mutex_destroy(&world->statsMutex);
+    free(world->systemics);
+    free((void*)world->name);
+    free(world);
+}
+
+void FreeExecutionPlan(HierarchicalExecutionPlan* plan)
+{
+    if (!plan) return;
+
+    if (plan->systemics) {
+        for (size_t s = 0; s < plan->systemicCount; s++) {
+            free(plan->systemics[s].parties);
+        }
+        free(plan->systemics);
+    }
+
+    free(plan->workerLoadNs);
+    free(plan);
+}
+
+void FreeWorldStatistics(WorldStatistics* stats)
+{
+    if (!stats) return;
+
+    if (stats->systemicStats) {
+        for (size_t s = 0; s < stats->systemicCount; s++) {
+            if (!stats->systemicStats[s].partyStats) continue;
+            for (size_t p = 0; p < stats->systemicStats[s].partyCount; p++) {
+                free(stats->systemicStats[s].partyStats[p].roleStats);
+            }
+            free(stats->systemicStats[s].partyStats);
+        }
+        free(stats->systemicStats);
+    }
+
+    free(stats);
+}
+
+/* ============= Helper Functions ============= */
+
+static void FrameHistogramRecord(FrameHistogram* histogram, uint64_t valueNs)
+{
+    uint64_t us = valueNs / 1000;
+    size_t bucket = 0;
+    while (us > 1 && bucket < FRAME_HISTOGRAM_BUCKETS - 1) {
+        us >>= 1;
+        bucket++;
+    }
+
+    histogram->buckets[bucket]++;
+    histogram->count++;
+    histogram->totalNs += valueNs;
+    if (valueNs > histogram->maxNs) histogram->maxNs = valueNs;
+}
+
+static inline void CpuRelax(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+static uint64_t GetTimeNanos(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
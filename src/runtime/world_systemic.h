@@ -8,24 +8,143 @@
 #define PERGYRA_WORLD_SYSTEMIC_H
 
 #include "party_runtime.h"
-#include "../slot_manager.h"
+#include <pthread.h>
+#include "../runtime/slot_manager.h"
+
+/* Party not pinned to a worker by the execution plan */
+#define PLAN_WORKER_ANY UINT32_MAX
+
+/* ============= Frame-Buffered Shared State ============= */
+
+/*
+ * Opt-in N-buffered shared fields. During frame N every read sees the
+ * values committed at the end of frame N-1 and every write goes to the
+ * back buffer, which becomes the front at the frame boundary. Reads need
+ * no locks and do not depend on party order, so the frame DAG only
+ * orders writers of a buffered field. Fields are laid out once: the
+ * state is sealed when attached to a world or systemic.
+ *
+ * Readers outside the frame (e.g. a render thread) may keep a read
+ * pointer for bufferCount - 2 frame boundaries; use 3+ buffers for them.
+ */
+typedef struct {
+    InternId fieldId;
+    size_t offset;
+    size_t size;
+} FrameSharedField;
+
+typedef struct {
+    FrameSharedField* fields;
+    size_t fieldCount;
+    uint16_t* fieldIndex;            /* InternId -> field index + 1 (0 = absent) */
+    
+    uint8_t* buffers;                /* bufferCount blocks of 'stride' bytes */
+    size_t stride;
+    uint32_t bufferCount;
+    
+    atomic_uint_fast64_t frame;      /* Back buffer is frame % bufferCount */
+    bool sealed;
+} FrameSharedState;
+
+/* Create with 'bufferCount' buffers (at least 2) */
+FrameSharedState* FrameSharedStateCreate(uint32_t bufferCount);
+void FrameSharedStateDestroy(FrameSharedState* state);
+
+/* Add a field of 'size' bytes, copying 'initialValue' (may be NULL) into every buffer */
+bool FrameSharedStateAddField(
+    FrameSharedState* state,
+    const char* fieldName,
+    size_t size,
+    const void* initialValue
+);
+
+/* Committed value from the previous frame (NULL if the field is not buffered) */
+static inline const void* FrameSharedRead(const FrameSharedState* state, InternId fieldId)
+{
+    if (fieldId >= MAX_INTERNED_FIELD_NAMES || !state->fieldIndex[fieldId]) return NULL;
+    
+    uint64_t frame = atomic_load_explicit(&state->frame, memory_order_acquire);
+    size_t front = (size_t)((frame + state->bufferCount - 1) % state->bufferCount);
+    const FrameSharedField* field = &state->fields[state->fieldIndex[fieldId] - 1];
+    return state->buffers + front * state->stride + field->offset;
+}
+
+/* Back-buffer storage for this frame's value (NULL if the field is not buffered) */
+static inline void* FrameSharedWrite(FrameSharedState* state, InternId fieldId)
+{
+    if (fieldId >= MAX_INTERNED_FIELD_NAMES || !state->fieldIndex[fieldId]) return NULL;
+    
+    uint64_t frame = atomic_load_explicit(&state->frame, memory_order_relaxed);
+    size_t back = (size_t)(frame % state->bufferCount);
+    const FrameSharedField* field = &state->fields[state->fieldIndex[fieldId] - 1];
+    return state->buffers + back * state->stride + field->offset;
+}
+
+/* Publish the back buffer; called by the frame executor between frames */
+void FrameSharedStateCommit(FrameSharedState* state);
 
 /* ============= Systemic Level ============= */
 
+/* Declared access of a party to a shared field */
+typedef enum {
+    FIELD_ACCESS_READ = 1,
+    FIELD_ACCESS_WRITE = 2,
+    FIELD_ACCESS_READ_WRITE = FIELD_ACCESS_READ | FIELD_ACCESS_WRITE
+} FieldAccess;
+
+typedef struct {
+    InternId fieldId;               /* Interned shared-field name */
+    FieldAccess access;
+} FieldAccessDecl;
+
+/* Open-addressed name -> slot index table (linear probing, power-of-two) */
+typedef struct {
+    const char** names;         /* Borrowed from the slots */
+    uint32_t* hashes;
+    uint32_t* indices;
+    size_t capacity;            /* 0 until the first insert */
+    size_t count;
+} SlotNameIndex;
+
+/* Party slot of a systemic */
+typedef struct {
+    const char* slotName;
+    const char* partyType;
+    void* partyInstance;        /* Runtime party instance */
+    PartyContext* partyContext; /* Party's context */
+    bool isArray;               /* If true, partyInstance is array */
+    size_t arraySize;
+    
+    FiberMap* fiberMap;         /* Roles run each frame (referenced) */
+    FieldAccessDecl* accesses;  /* Shared fields read/written by the roles */
+    size_t accessCount;
+    
+    /* Frame statistics (times only on sampled frames) */
+    uint64_t executions;
+    uint64_t sampledExecutions;
+    uint64_t totalTimeNs;
+    uint32_t deferredFrames;    /* Consecutive frames shed by adaptive sync */
+    uint64_t costEwmaNs;        /* Smoothed role CPU time per frame */
+    
+    uint32_t worker;            /* Planned worker (PLAN_WORKER_ANY = unplaced) */
+    
+    /* Partitioned mode */
+    uint64_t partitionKey;      /* Spatial cell, entity hash, ... */
+    uint32_t partition;
+} SystemicPartySlot;
+
+struct FrameGraph;
+struct SystemicPartitioning;
+
 /* Systemic: Collection of related parties forming a system */
 typedef struct {
     const char* name;
     
     /* Party slots */
-    struct {
-        const char* slotName;
-        const char* partyType;
-        void* partyInstance;        /* Runtime party instance */
-        PartyContext* partyContext; /* Party's context */
-        bool isArray;               /* If true, partyInstance is array */
-        size_t arraySize;
-    }* partySlots;
+    SystemicPartySlot* partySlots;
     size_t partyCount;
+    size_t partyCapacity;
+    SlotNameIndex partyIndex;   /* slotName -> partySlots index */
     
     /* Shared system data */
     struct {
@@ -35,9 +154,23 @@ typedef struct {
     }* sharedFields;
     size_t sharedFieldCount;
     
+    FrameSharedState* bufferedState;  /* Optional, committed every frame */
+    struct SystemicPartitioning* partitioning;  /* NULL unless partitioned */
+    
     /* System metadata */
     const char* systemType;
     void* customData;
+    
+    /* Frame executor */
+    uint64_t topologyVersion;        /* Bumped when parties or accesses change */
+    struct FrameGraph* frameGraph;   /* Cached by ExecuteSystemic */
+    _Atomic(struct SystemicHandle*) lastFrame;  /* Newest async frame until it completes */
+    
+    /* Frame statistics (times only on sampled frames) */
+    uint64_t totalExecutions;
+    uint64_t sampledExecutions;
+    uint64_t totalTimeNs;
+    uint32_t errorCount;
 } SystemicContext;
 
 /* Create a new systemic instance */
@@ -54,10 +187,43 @@ bool SystemicAddParty(
     PartyContext* partyContext
 );
 
+/* Attach frame-buffered shared state (caller keeps ownership) */
+bool SystemicSetBufferedState(SystemicContext* systemic, FrameSharedState* state);
+
+/* Add party with an explicit partition key (SystemicAddParty hashes the slot name) */
+bool SystemicAddPartyWithKey(
+    SystemicContext* systemic,
+    const char* slotName,
+    void* partyInstance,
+    PartyContext* partyContext,
+    uint64_t partitionKey
+);
+
+/* Set the FiberMap whose roles run for a party each frame */
+bool SystemicSetPartyFiberMap(
+    SystemicContext* systemic,
+    const char* slotName,
+    FiberMap* map
+);
+
+/*
+ * Declare that a party's roles read and/or write a shared field. The
+ * frame executor orders parties by these declarations (in systemic and
+ * party order): readers follow the last writer, a writer follows the
+ * readers and writer before it, everything else runs concurrently.
+ */
+bool SystemicDeclareAccess(
+    SystemicContext* systemic,
+    const char* partySlot,
+    const char* fieldName,
+    FieldAccess access
+);
+
 /* Execute all parties in systemic */
 typedef struct {
     const char* partySlot;
     DispatchResult result;
+    bool deferred;              /* Shed this frame; roles did not run */
 } SystemicPartyResult;
 
 typedef struct {
@@ -67,13 +233,22 @@ typedef struct {
     uint64_t totalExecutionTimeNs;
 } SystemicExecutionResult;
 
+/* Run one frame of a single systemic (same DAG rules as a world frame) */
 SystemicExecutionResult ExecuteSystemic(
     SystemicContext* systemic,
     JoinStrategy defaultStrategy,
     DispatcherConfig* config
 );
 
-/* Async execution */
+/*
+ * Async execution. The handle completes on the worker of the systemic's
+ * last finishing party, which commits the frame and runs the handle's
+ * continuations. Frames of one systemic never overlap: one submitted
+ * while another is in flight starts when that one completes. Party
+ * results are overwritten by the systemic's next frame. Do not mix with
+ * ExecuteSystemic or a world frame over the same systemic while a handle
+ * is pending.
+ */
 typedef struct SystemicHandle SystemicHandle;
 
 SystemicHandle* ExecuteSystemicAsync(
@@ -82,24 +257,181 @@ SystemicHandle* ExecuteSystemicAsync(
     DispatcherConfig* config
 );
 
+/*
+ * Start the frame once every handle in 'after' has completed, e.g. a
+ * consumer's frame N+1 as soon as its producers have committed frame N.
+ * A cancelled dependency cancels this frame too; a failed one does not.
+ */
+SystemicHandle* ExecuteSystemicAfter(
+    SystemicContext* systemic,
+    SystemicHandle* const* after,
+    size_t afterCount,
+    JoinStrategy defaultStrategy,
+    DispatcherConfig* config
+);
+
+/* Run on the completing worker, or right away if the frame already completed */
+typedef void (*SystemicCallback)(SystemicHandle* handle, const SystemicExecutionResult* result,
+                                 void* userData);
+
+bool SystemicThen(SystemicHandle* handle, SystemicCallback callback, void* userData);
+bool SystemicIsComplete(SystemicHandle* handle);
+
+/*
+ * Cancel an async frame. Parties that have not started are skipped
+ * (partitions still run: their messages must drain) and roles already
+ * running finish their call. Frames waiting on it through
+ * ExecuteSystemicAfter complete as cancelled without running.
+ */
+void CancelSystemic(SystemicHandle* handle);
+
+/*
+ * Wait for an async frame (timeoutMs 0 = no limit). Once it completed the
+ * handle is released; on timeout the result is empty and the handle stays valid.
+ */
 SystemicExecutionResult WaitForSystemic(
     SystemicHandle* handle,
     uint64_t timeoutMs
 );
 
+/* Drop the caller's reference without waiting */
+void ReleaseSystemicHandle(SystemicHandle* handle);
+
+/* ============= Partitioned Systemics ============= */
+
+/*
+ * A partitioned systemic shards its parties by key. Each frame, every
+ * partition runs as one task on one worker, executing its parties' roles
+ * back to back, so a partition's data is never touched by two workers
+ * in a frame. Partitions of a systemic do not order against each other;
+ * against other systemics they are ordered by the union of their
+ * parties' declared accesses.
+ *
+ * Parties talk across partitions with messages. A message posted in
+ * frame N goes to an outbox owned by the sending partition and is
+ * delivered, batched, to the target partition's handler at the start of
+ * its task in frame N+1.
+ */
+
+/* Map a key to a partition (NULL = hash the key) */
+typedef uint32_t (*PartitionKeyFunction)(uint64_t key, uint32_t partitionCount, void* userData);
+
+typedef struct {
+    uint64_t targetKey;
+    uint32_t sourcePartition;        /* PARTITION_EXTERNAL if posted outside a partition */
+    uint32_t size;                   /* Payload bytes */
+} PartitionMessage;
+
+#define PARTITION_EXTERNAL UINT32_MAX
+
+/* Called on the target partition's worker for each message, in posting order per source */
+typedef void (*PartitionMessageHandler)(
+    SystemicContext* systemic,
+    uint32_t partition,
+    const PartitionMessage* message,
+    const void* payload,
+    void* userData
+);
+
+/* Growable message batch for one (source, destination) pair */
+typedef struct {
+    uint8_t* data;
+    size_t size;
+    size_t capacity;
+} PartitionOutbox;
+
+typedef struct {
+    uint32_t index;
+    char name[24];                   /* Result label, "partition-N" */
+    
+    size_t* parties;                 /* Indices into partySlots */
+    size_t partyCount;
+    size_t partyCapacity;
+    
+    uint64_t costEwmaNs;
+    uint32_t worker;
+} SystemicPartition;
+
+typedef struct SystemicPartitioning {
+    SystemicPartition* partitions;
+    uint32_t partitionCount;
+    PartitionKeyFunction keyFunction;
+    void* keyUserData;
+    
+    PartitionMessageHandler handler;
+    void* handlerUserData;
+    
+    /* outboxes[parity][source][destination]; source partitionCount is external */
+    PartitionOutbox* outboxes;
+    pthread_mutex_t externalMutex;
+    uint64_t frame;                  /* Parity of the outboxes being written */
+} SystemicPartitioning;
+
+/*
+ * Switch to partitioned mode, or reshard; existing parties are resharded
+ * by their keys and undelivered messages follow their target keys. Call
+ * between frames.
+ */
+bool SystemicEnablePartitioning(
+    SystemicContext* systemic,
+    uint32_t partitionCount,
+    PartitionKeyFunction keyFunction,
+    void* userData
+);
+
+bool SystemicSetMessageHandler(
+    SystemicContext* systemic,
+    PartitionMessageHandler handler,
+    void* userData
+);
+
+/* Queue a message for the partition owning 'targetKey' (delivered next frame) */
+bool SystemicPostMessage(
+    SystemicContext* systemic,
+    uint64_t targetKey,
+    const void* payload,
+    uint32_t size
+);
+
+/* Partition that owns a key */
+uint32_t SystemicPartitionOf(SystemicContext* systemic, uint64_t key);
+
 /* ============= World Level ============= */
 
+/* Resources an execution plan may use */
+typedef struct {
+    uint32_t availableCpuCores;      /* 0 = online CPUs */
+    uint32_t availableGpuUnits;
+    size_t availableMemory;
+    bool preferLatency;              /* vs throughput */
+} ExecutionPlanConstraints;
+
+/* Log2 histogram of frame durations; bucket i counts [2^i, 2^(i+1)) us */
+#define FRAME_HISTOGRAM_BUCKETS 24
+
+typedef struct {
+    uint64_t buckets[FRAME_HISTOGRAM_BUCKETS];
+    uint64_t count;
+    uint64_t totalNs;
+    uint64_t maxNs;
+} FrameHistogram;
+
+/* Systemic slot of a world */
+typedef struct {
+    const char* slotName;
+    const char* systemicType;
+    SystemicContext* instance;
+} WorldSystemicSlot;
+
 /* World: The top-level container of all systemics */
 typedef struct {
     const char* name;
     
     /* Systemic instances */
-    struct {
-        const char* slotName;
-        const char* systemicType;
-        SystemicContext* instance;
-    }* systemics;
+    WorldSystemicSlot* systemics;
     size_t systemicCount;
+    size_t systemicCapacity;
+    SlotNameIndex systemicIndex;  /* slotName -> systemics index */
     
     /* World-level shared data */
     struct {
@@ -108,14 +440,39 @@ typedef struct {
         void* value;
     }* sharedFields;
     size_t sharedFieldCount;
+    FrameSharedState* bufferedState;  /* Optional, committed every frame */
     
     /* World state */
-    bool isRunning;
+    atomic_bool isRunning;
     uint64_t startTime;
     uint64_t frameCount;
     
+    /* Adaptive sync: parties whose roles are all below this are shed */
+    SchedulerPriority shedBelow;
+    
+    /* Frame pacing statistics, published once per frame */
+    pthread_mutex_t statsMutex;
+    FrameHistogram frameTimes;
+    FrameHistogram slack;            /* Time left before each deadline */
+    uint64_t missedDeadlines;
+    uint64_t deferredParties;
+    
+    /* Role and party timing is taken 1 in statsSampleInterval frames */
+    uint32_t statsSampleInterval;
+    uint64_t sampledFrames;
+    
     /* Custom world data */
     void* customData;
+    
+    /* Frame executor */
+    uint64_t topologyVersion;        /* Bumped when systemics are added */
+    struct FrameGraph* frameGraph;   /* Dependency DAG, rebuilt on change */
+    
+    /* Auto-planning (see WorldEnableAutoPlanning) */
+    ExecutionPlanConstraints planConstraints;
+    uint32_t replanInterval;
+    double replanThreshold;
+    uint64_t replans;
 } WorldContext;
 
 /* Create a new world */
@@ -128,6 +485,9 @@ bool WorldAddSystemic(
     SystemicContext* systemic
 );
 
+/* Attach frame-buffered world state (caller keeps ownership) */
+bool WorldSetBufferedState(WorldContext* world, FrameSharedState* state);
+
 /* World execution result */
 typedef struct {
     const char* systemicSlot;
@@ -142,17 +502,43 @@ typedef struct {
     uint64_t totalFrames;
 } WorldFrameResult;
 
-/* Execute one world frame */
+/*
+ * Execute one world frame. Parties are nodes of a cached dependency DAG.
+ * Every role of a node runs once, on its tagged scheduler, and a node
+ * starts the moment its last predecessor finishes; there are no
+ * level-wide barriers. Results are owned by the world and stay valid
+ * until the next frame.
+ */
 WorldFrameResult ExecuteWorldFrame(
     WorldContext* world,
     DispatcherConfig* config
 );
 
+/*
+ * Re-plan party placement every 'replanIntervalFrames' frames when the
+ * measured worker imbalance (max load / mean load) exceeds 'imbalanceThreshold'.
+ * The first check always plans. An interval of 0 disables auto-planning.
+ */
+void WorldEnableAutoPlanning(
+    WorldContext* world,
+    const ExecutionPlanConstraints* constraints,
+    uint32_t replanIntervalFrames,
+    double imbalanceThreshold
+);
+
+/*
+ * Time roles and parties on 1 in 'everyNFrames' frames (1 = every frame,
+ * the default). Unsampled frames still count executions, successes and
+ * shedding but take no clock readings, report zero execution times and
+ * leave cost estimates alone.
+ */
+void WorldSetStatsSampling(WorldContext* world, uint32_t everyNFrames);
+
 /* Main world loop */
 typedef struct {
     uint64_t targetFrameTimeNs;  /* Target frame duration */
     uint64_t maxFrames;          /* 0 = infinite */
-    bool adaptiveSync;           /* Adjust to maintain framerate */
+    bool adaptiveSync;           /* Shed low-priority parties to hold the budget */
     
     /* Callbacks */
     void (*onFrameStart)(WorldContext* world, uint64_t frameNum);
@@ -160,14 +546,23 @@ typedef struct {
     void (*onSystemicError)(const char* systemic, const char* error);
 } WorldLoopConfig;
 
-/* Run world loop */
+/*
+ * Run frames until StopWorld or maxFrames. Each frame is paced to an
+ * absolute deadline: sleep until just before it, then spin the rest.
+ * A frame that overruns moves the schedule forward instead of bursting
+ * to catch up. With adaptiveSync, sustained overruns defer parties whose
+ * roles are all PRIORITY_IDLE, then PRIORITY_LOW; a deferred party still
+ * runs at least every WORLD_MAX_DEFERRED_FRAMES frames.
+ */
+#define WORLD_MAX_DEFERRED_FRAMES 4
+
 void RunWorldLoop(
     WorldContext* world,
     WorldLoopConfig* loopConfig,
     DispatcherConfig* dispatchConfig
 );
 
-/* Stop world loop */
+/* Stop world loop after the current frame (any thread) */
 void StopWorld(WorldContext* world);
 
 /* ============= Cross-Level Communication ============= */
@@ -191,8 +586,68 @@ PartyContext* WorldFindParty(
     const char* partySlot
 );
 
+/*
+ * Stable references for hot paths. Slots are append-only, so an index
+ * resolved once stays valid for the lifetime of its systemic or world;
+ * roles resolve at setup and skip hashing every frame afterwards.
+ */
+#define SLOT_INDEX_NONE UINT32_MAX
+
+/* systemicIndex << 32 | partyIndex */
+typedef uint64_t PartyHandle;
+#define PARTY_HANDLE_INVALID UINT64_MAX
+
+/* Party slot index in systemic, SLOT_INDEX_NONE if absent */
+uint32_t SystemicResolveParty(
+    SystemicContext* systemic,
+    const char* partySlot
+);
+
+/* Systemic slot index in world, SLOT_INDEX_NONE if absent */
+uint32_t WorldResolveSystemic(
+    WorldContext* world,
+    const char* systemicSlot
+);
+
+/* Handle to a party of a world, PARTY_HANDLE_INVALID if absent */
+PartyHandle WorldResolveParty(
+    WorldContext* world,
+    const char* systemicSlot,
+    const char* partySlot
+);
+
+static inline PartyContext* SystemicGetParty(SystemicContext* systemic, uint32_t partyIndex)
+{
+    if (!systemic || partyIndex >= systemic->partyCount) return NULL;
+    return systemic->partySlots[partyIndex].partyContext;
+}
+
+static inline SystemicContext* WorldGetSystemic(WorldContext* world, uint32_t systemicIndex)
+{
+    if (!world || systemicIndex >= world->systemicCount) return NULL;
+    return world->systemics[systemicIndex].instance;
+}
+
+static inline PartyContext* WorldGetParty(WorldContext* world, PartyHandle handle)
+{
+    return SystemicGetParty(WorldGetSystemic(world, (uint32_t)(handle >> 32)),
+                            (uint32_t)handle);
+}
+
 /* ============= Hierarchical Execution ============= */
 
+/* Party entry of an execution plan */
+typedef struct {
+    const char* partyName;
+    FiberMap* fiberMap;
+    size_t roleCount;
+    
+    SystemicPartySlot* slot;         /* NULL for a partition */
+    SystemicPartition* partition;    /* Set for partitioned systemics */
+    uint64_t estimatedCostNs;        /* EWMA, else FiberStats average */
+    uint32_t worker;                 /* Assigned by OptimizeExecutionPlan */
+} PlannedParty;
+
 /* Execution plan for entire hierarchy */
 typedef struct {
     /* World level */
@@ -202,14 +657,10 @@ typedef struct {
     /* Per-systemic plans */
     struct {
         const char* systemicName;
-        size_t partyCount;
+        size_t partyCount;               /* Partitions, if partitioned */
         
         /* Per-party fiber maps */
-        struct {
-            const char* partyName;
-            FiberMap* fiberMap;
-            size_t roleCount;
-        }* parties;
+        PlannedParty* parties;
     }* systemics;
     
     /* Total counts */
@@ -222,6 +673,12 @@ typedef struct {
     bool canParallelizeParties;
     size_t estimatedCpuFibers;
     size_t estimatedGpuFibers;
+    
+    /* Worker placement */
+    uint32_t workerCount;
+    uint64_t* workerLoadNs;
+    uint64_t makespanNs;             /* Most loaded worker */
+    double imbalance;                /* Max load / mean load */
 } HierarchicalExecutionPlan;
 
 /* Generate execution plan for world */
@@ -229,17 +686,22 @@ HierarchicalExecutionPlan* GenerateWorldExecutionPlan(
     WorldContext* world
 );
 
-/* Optimize execution plan */
+/*
+ * Assign parties to CPU workers, longest processing time first. Parties
+ * that share a PartyContext are placed together, as are the accessors of
+ * a field some party writes (up to a worker's share of the parties);
+ * readers of a read-only field are placed independently. With
+ * preferLatency a group larger than a fair share of the work is split
+ * so it cannot set the makespan. GPU-only parties stay unplaced.
+ */
 void OptimizeExecutionPlan(
     HierarchicalExecutionPlan* plan,
-    const struct {
-        uint32_t availableCpuCores;
-        uint32_t availableGpuUnits;
-        size_t availableMemory;
-        bool preferLatency;  /* vs throughput */
-    }* constraints
+    const ExecutionPlanConstraints* constraints
 );
 
+/* Pin the plan's parties to their assigned workers */
+void ApplyExecutionPlan(HierarchicalExecutionPlan* plan);
+
 /* ============= Monitoring & Debugging ============= */
 
 /* Hierarchical statistics */
@@ -248,6 +710,12 @@ typedef struct {
     uint64_t totalFrames;
     uint64_t avgFrameTimeNs;
     uint64_t maxFrameTimeNs;
+    FrameHistogram frameTimeHistogram;
+    FrameHistogram slackHistogram;
+    uint64_t missedDeadlines;
+    uint64_t deferredParties;        /* Party-frames shed by adaptive sync */
+    uint32_t sampleInterval;
+    uint64_t sampledFrames;          /* Averages below are over these */
     
     /* Per-systemic stats */
     struct {
@@ -261,7 +729,7 @@ typedef struct {
             const char* partyName;
             uint64_t avgPartyTimeNs;
             
-            /* Role-level stats (from FiberStats) */
+            /* Role-level stats (from FiberStats, per role name across parties) */
             FiberStats* roleStats;
             size_t roleCount;
         }* partyStats;
@@ -270,10 +738,21 @@ typedef struct {
     size_t systemicCount;
 } WorldStatistics;
 
-/* Get world statistics */
+/* Get world statistics (builds the whole tree; call between frames) */
 WorldStatistics* GetWorldStatistics(WorldContext* world);
 
-/* Dump world state */
+/* Counters of one party, read in place without building the tree */
+typedef struct {
+    uint64_t executions;
+    uint64_t avgTimeNs;              /* Over sampled frames */
+    uint64_t costEwmaNs;
+    uint32_t deferredFrames;
+    uint32_t worker;
+} PartyStatistics;
+
+bool WorldGetPartyStatistics(WorldContext* world, PartyHandle handle, PartyStatistics* stats);
+
+/* Dump world state as text to stdout (see world_visualization.h) */
 void DumpWorldState(
     WorldContext* world,
     bool includeSystemics,
@@ -281,7 +760,7 @@ void DumpWorldState(
     bool includeRoles
 );
 
-/* Visualize world hierarchy */
+/* Visualize world hierarchy into one string (streaming: WriteWorldVisualization) */
 char* GenerateWorldVisualization(
     WorldContext* world,
     const char* format  /* "dot", "json", "text" */
@@ -0,0 +1,816 @@
+/*
+ * Copyright (c) 2025 Pergyra Language Project
+ * World Visualization Implementation
+ */
+
+#include "world_visualization.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <errno.h>
+#include <unistd.h>
+
+/* ============= Records ============= */
+
+/*
+ * What the writer emits for each level. The live walk fills them on the
+ * stack straight from the world; a job keeps them in flat arrays with
+ * every string copied into one block.
+ */
+typedef struct {
+    const char* name;
+    uint64_t frames;
+    uint64_t sampledFrames;
+    uint32_t sampleInterval;
+    size_t systemicCount;
+} VisWorld;
+
+typedef struct {
+    const char* slot;
+    const char* type;
+    size_t partyCount;
+    uint32_t partitionCount;
+    uint64_t executions;
+    uint64_t avgTimeNs;
+    uint32_t errorCount;
+} VisSystemic;
+
+typedef struct {
+    const char* slot;
+    const char* type;
+    uint64_t executions;
+    uint64_t avgTimeNs;
+    uint64_t costEwmaNs;
+    uint32_t deferredFrames;
+    uint32_t worker;
+    const FieldAccessDecl* accesses;
+    size_t accessCount;
+    const FiberMapEntry* roles;
+    size_t roleCount;
+} VisParty;
+
+static void VisWorldFromContext(VisWorld* record, const WorldContext* world)
+{
+    record->name = world->name;
+    record->frames = world->frameCount;
+    record->sampledFrames = world->sampledFrames;
+    record->sampleInterval = world->statsSampleInterval;
+    record->systemicCount = world->systemicCount;
+}
+
+static void VisSystemicFromSlot(VisSystemic* record, const WorldSystemicSlot* slot)
+{
+    const SystemicContext* systemic = slot->instance;
+
+    record->slot = slot->slotName;
+    record->type = slot->systemicType;
+    record->partyCount = systemic->partyCount;
+    record->partitionCount = systemic->partitioning ? systemic->partitioning->partitionCount : 0;
+    record->executions = systemic->totalExecutions;
+    record->avgTimeNs = systemic->sampledExecutions ?
+        systemic->totalTimeNs / systemic->sampledExecutions : 0;
+    record->errorCount = systemic->errorCount;
+}
+
+static void VisPartyFromSlot(VisParty* record, const SystemicPartySlot* party)
+{
+    record->slot = party->slotName;
+    record->type = party->partyType;
+    record->executions = party->executions;
+    record->avgTimeNs = party->sampledExecutions ?
+        party->totalTimeNs / party->sampledExecutions : 0;
+    record->costEwmaNs = party->costEwmaNs;
+    record->deferredFrames = party->deferredFrames;
+    record->worker = party->worker;
+    record->accesses = party->accesses;
+    record->accessCount = party->accessCount;
+    record->roles = party->fiberMap ? party->fiberMap->entries : NULL;
+    record->roleCount = party->fiberMap ? party->fiberMap->entryCount : 0;
+}
+
+static bool VisMatch(const char* filter, const char* name)
+{
+    if (!filter) return true;
+    if (!name) return false;
+
+    size_t length = strlen(filter);
+    if (length > 0 && filter[length - 1] == '*') {
+        return strncmp(filter, name, length - 1) == 0;
+    }
+    return strcmp(filter, name) == 0;
+}
+
+/* ============= Buffered Output ============= */
+
+typedef struct {
+    WorldVisualizationFormat format;
+    WorldVisualizationDepth depth;
+    WorldVisualizationOutput output;
+    bool failed;
+
+    size_t systemicIndex;            /* Written so far: DOT node IDs, JSON separators */
+    size_t partyIndex;               /* Within the current systemic */
+
+    size_t used;
+    char buffer[WORLD_VISUALIZATION_BUFFER_SIZE];
+} VisWriter;
+
+static VisWriter* VisWriterCreate(const WorldVisualizationOptions* options,
+                                  const WorldVisualizationOutput* output)
+{
+    if (!options || !output) return NULL;
+    if (options->format > WORLD_VISUALIZATION_TEXT) return NULL;
+    if (options->depth > WORLD_VISUALIZATION_ROLES) return NULL;
+
+    VisWriter* writer = (VisWriter*)malloc(sizeof(VisWriter));
+    if (!writer) return NULL;
+
+    writer->format = options->format;
+    writer->depth = options->depth == WORLD_VISUALIZATION_ALL ?
+        WORLD_VISUALIZATION_ROLES : options->depth;
+    writer->output = *output;
+    writer->failed = false;
+    writer->systemicIndex = 0;
+    writer->partyIndex = 0;
+    writer->used = 0;
+    return writer;
+}
+
+static bool VisWriteFd(int fd, const char* data, size_t size)
+{
+    while (size > 0) {
+        ssize_t written = write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += written;
+        size -= (size_t)written;
+    }
+    return true;
+}
+
+static void VisFlush(VisWriter* writer)
+{
+    if (writer->failed || writer->used == 0) return;
+
+    bool ok = writer->output.write ?
+        writer->output.write(writer->buffer, writer->used, writer->output.userData) :
+        VisWriteFd(writer->output.fd, writer->buffer, writer->used);
+
+    writer->used = 0;
+    if (!ok) writer->failed = true;
+}
+
+static void VisPut(VisWriter* writer, const char* data, size_t size)
+{
+    while (size > 0 && !writer->failed) {
+        if (writer->used == sizeof(writer->buffer)) VisFlush(writer);
+
+        size_t chunk = sizeof(writer->buffer) - writer->used;
+        if (chunk > size) chunk = size;
+        memcpy(writer->buffer + writer->used, data, chunk);
+        writer->used += chunk;
+        data += chunk;
+        size -= chunk;
+    }
+}
+
+static void VisText(VisWriter* writer, const char* text)
+{
+    VisPut(writer, text, strlen(text));
+}
+
+/* Fixed text and numbers only; names go through VisString */
+static void VisPrintf(VisWriter* writer, const char* format, ...)
+{
+    char line[256];
+    va_list args;
+
+    va_start(args, format);
+    int length = vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+
+    if (length < 0) {
+        writer->failed = true;
+        return;
+    }
+    VisPut(writer, line, (size_t)length < sizeof(line) ? (size_t)length : sizeof(line) - 1);
+}
+
+/* A name as the format needs it: a JSON string, the inside of a DOT string, or raw text */
+static void VisString(VisWriter* writer, const char* name)
+{
+    if (!name) {
+        VisText(writer, writer->format == WORLD_VISUALIZATION_JSON ? "null" : "?");
+        return;
+    }
+
+    if (writer->format == WORLD_VISUALIZATION_TEXT) {
+        VisText(writer, name);
+        return;
+    }
+
+    bool json = writer->format == WORLD_VISUALIZATION_JSON;
+    if (json) VisPut(writer, "\"", 1);
+
+    const char* run = name;
+    for (const char* c = name; *c; c++) {
+        unsigned char ch = (unsigned char)*c;
+        if (ch != '"' && ch != '\\' && ch >= 0x20) continue;
+
+        VisPut(writer, run, (size_t)(c - run));
+        run = c + 1;
+
+        if (ch == '"' || ch == '\\') {
+            char escaped[2] = { '\\', (char)ch };
+            VisPut(writer, escaped, 2);
+        } else if (json) {
+            VisPrintf(writer, "\\u%04x", ch);
+        } else if (ch == '\n') {
+            VisText(writer, "\\n");
+        }
+    }
+    VisPut(writer, run, strlen(run));
+
+    if (json) VisPut(writer, "\"", 1);
+}
+
+/* ============= Formats ============= */
+
+static void VisBeginWorld(VisWriter* writer, const VisWorld* world)
+{
+    switch (writer->format) {
+    case WORLD_VISUALIZATION_DOT:
+        VisText(writer, "digraph \"");
+        VisString(writer, world->name);
+        VisText(writer, "\" {\n  node [shape=box];\n  w [label=\"");
+        VisString(writer, world->name);
+        VisPrintf(writer, "\\n%llu frames\"];\n", (unsigned long long)world->frames);
+        break;
+
+    case WORLD_VISUALIZATION_JSON:
+        VisText(writer, "{\"world\":");
+        VisString(writer, world->name);
+        VisPrintf(writer, ",\"frames\":%llu,\"sampledFrames\":%llu,\"sampleInterval\":%u,"
+                  "\"systemicCount\":%zu",
+                  (unsigned long long)world->frames, (unsigned long long)world->sampledFrames,
+                  world->sampleInterval, world->systemicCount);
+        if (writer->depth >= WORLD_VISUALIZATION_SYSTEMICS) VisText(writer, ",\"systemics\":[");
+        break;
+
+    case WORLD_VISUALIZATION_TEXT:
+        VisText(writer, "World '");
+        VisString(writer, world->name);
+        VisPrintf(writer, "': %llu frames (%llu sampled), %zu systemics\n",
+                  (unsigned long long)world->frames, (unsigned long long)world->sampledFrames,
+                  world->systemicCount);
+        break;
+    }
+}
+
+static void VisBeginSystemic(VisWriter* writer, const VisSystemic* systemic)
+{
+    size_t s = writer->systemicIndex;
+    writer->partyIndex = 0;
+
+    switch (writer->format) {
+    case WORLD_VISUALIZATION_DOT:
+        VisPrintf(writer, "  w -> s%zu;\n  subgraph cluster_s%zu {\n    label=\"", s, s);
+        VisString(writer, systemic->slot);
+        VisPrintf(writer, "\";\n    s%zu [label=\"", s);
+        VisString(writer, systemic->slot);
+        VisText(writer, " (");
+        VisString(writer, systemic->type);
+        VisPrintf(writer, ")\\n%zu parties, %llu executions, avg %llu ns",
+                  systemic->partyCount, (unsigned long long)systemic->executions,
+                  (unsigned long long)systemic->avgTimeNs);
+        if (systemic->partitionCount) {
+            VisPrintf(writer, "\\n%u partitions", systemic->partitionCount);
+        }
+        if (systemic->errorCount) {
+            VisPrintf(writer, "\\n%u errors", systemic->errorCount);
+        }
+        VisText(writer, "\"];\n");
+        break;
+
+    case WORLD_VISUALIZATION_JSON:
+        VisText(writer, s > 0 ? ",\n{\"slot\":" : "\n{\"slot\":");
+        VisString(writer, systemic->slot);
+        VisText(writer, ",\"type\":");
+        VisString(writer, systemic->type);
+        VisPrintf(writer, ",\"partyCount\":%zu,\"partitions\":%u,\"executions\":%llu,"
+                  "\"avgTimeNs\":%llu,\"errors\":%u",
+                  systemic->partyCount, systemic->partitionCount,
+                  (unsigned long long)systemic->executions,
+                  (unsigned long long)systemic->avgTimeNs, systemic->errorCount);
+        if (writer->depth >= WORLD_VISUALIZATION_PARTIES) VisText(writer, ",\"parties\":[");
+        break;
+
+    case WORLD_VISUALIZATION_TEXT:
+        VisText(writer, "  Systemic '");
+        VisString(writer, systemic->slot);
+        VisText(writer, "' (");
+        VisString(writer, systemic->type);
+        VisPrintf(writer, "): %zu parties, %llu executions, avg %llu ns",
+                  systemic->partyCount, (unsigned long long)systemic->executions,
+                  (unsigned long long)systemic->avgTimeNs);
+        if (systemic->partitionCount) {
+            VisPrintf(writer, ", %u partitions", systemic->partitionCount);
+        }
+        if (systemic->errorCount) {
+            VisPrintf(writer, ", %u errors", systemic->errorCount);
+        }
+        VisText(writer, "\n");
+        break;
+    }
+}
+
+static bool VisHasAccess(const VisParty* party, FieldAccess access)
+{
+    for (size_t i = 0; i < party->accessCount; i++) {
+        if (party->accesses[i].access & access) return true;
+    }
+    return false;
+}
+
+static void VisAccessList(VisWriter* writer, const VisParty* party, FieldAccess access)
+{
+    const char* separator = writer->format == WORLD_VISUALIZATION_JSON ? "," : ", ";
+    bool first = true;
+
+    for (size_t i = 0; i < party->accessCount; i++) {
+        if (!(party->accesses[i].access & access)) continue;
+        if (!first) VisText(writer, separator);
+        VisString(writer, GetFieldNameById(party->accesses[i].fieldId));
+        first = false;
+    }
+}
+
+static void VisEmitPartyDot(VisWriter* writer, const VisParty* party)
+{
+    size_t s = writer->systemicIndex;
+    size_t p = writer->partyIndex;
+
+    VisPrintf(writer, "    s%zup%zu [label=\"", s, p);
+    VisString(writer, party->slot);
+    VisPrintf(writer, "\\n%llu executions, avg %llu ns",
+              (unsigned long long)party->executions, (unsigned long long)party->avgTimeNs);
+    if (party->worker != PLAN_WORKER_ANY) VisPrintf(writer, "\\nworker %u", party->worker);
+    if (party->deferredFrames) VisPrintf(writer, "\\ndeferred %u", party->deferredFrames);
+    if (VisHasAccess(party, FIELD_ACCESS_READ)) {
+        VisText(writer, "\\nreads ");
+        VisAccessList(writer, party, FIELD_ACCESS_READ);
+    }
+    if (VisHasAccess(party, FIELD_ACCESS_WRITE)) {
+        VisText(writer, "\\nwrites ");
+        VisAccessList(writer, party, FIELD_ACCESS_WRITE);
+    }
+    VisPrintf(writer, "\"];\n    s%zu -> s%zup%zu;\n", s, s, p);
+
+    if (writer->depth < WORLD_VISUALIZATION_ROLES) return;
+
+    for (size_t r = 0; r < party->roleCount; r++) {
+        VisPrintf(writer, "    s%zup%zur%zu [shape=ellipse, label=\"", s, p, r);
+        VisString(writer, party->roles[r].roleId);
+        VisPrintf(writer, "\\npriority %d\"];\n    s%zup%zu -> s%zup%zur%zu;\n",
+                  (int)party->roles[r].priority, s, p, s, p, r);
+    }
+}
+
+static void VisEmitPartyJson(VisWriter* writer, const VisParty* party)
+{
+    VisText(writer, writer->partyIndex > 0 ? ",\n{\"slot\":" : "\n{\"slot\":");
+    VisString(writer, party->slot);
+    VisText(writer, ",\"type\":");
+    VisString(writer, party->type);
+    VisPrintf(writer, ",\"executions\":%llu,\"avgTimeNs\":%llu,\"costEwmaNs\":%llu,"
+              "\"deferredFrames\":%u,",
+              (unsigned long long)party->executions, (unsigned long long)party->avgTimeNs,
+              (unsigned long long)party->costEwmaNs, party->deferredFrames);
+    if (party->worker != PLAN_WORKER_ANY) {
+        VisPrintf(writer, "\"worker\":%u", party->worker);
+    } else {
+        VisText(writer, "\"worker\":null");
+    }
+
+    VisText(writer, ",\"reads\":[");
+    VisAccessList(writer, party, FIELD_ACCESS_READ);
+    VisText(writer, "],\"writes\":[");
+    VisAccessList(writer, party, FIELD_ACCESS_WRITE);
+    VisText(writer, "]");
+
+    if (writer->depth >= WORLD_VISUALIZATION_ROLES) {
+        VisText(writer, ",\"roles\":[");
+        for (size_t r = 0; r < party->roleCount; r++) {
+            VisText(writer, r > 0 ? ",{\"role\":" : "{\"role\":");
+            VisString(writer, party->roles[r].roleId);
+            VisPrintf(writer, ",\"priority\":%d,\"scheduler\":%d}",
+                      (int)party->roles[r].priority, (int)party->roles[r].schedulerTag);
+        }
+        VisText(writer, "]");
+    }
+    VisText(writer, "}");
+}
+
+static void VisEmitPartyText(VisWriter* writer, const VisParty* party)
+{
+    VisText(writer, "    Party '");
+    VisString(writer, party->slot);
+    VisPrintf(writer, "': %llu executions, avg %llu ns, cost %llu ns",
+              (unsigned long long)party->executions, (unsigned long long)party->avgTimeNs,
+              (unsigned long long)party->costEwmaNs);
+    if (party->worker != PLAN_WORKER_ANY) VisPrintf(writer, ", worker %u", party->worker);
+    if (party->deferredFrames) VisPrintf(writer, ", deferred %u", party->deferredFrames);
+    VisText(writer, "\n");
+
+    if (VisHasAccess(party, FIELD_ACCESS_READ)) {
+        VisText(writer, "      reads: ");
+        VisAccessList(writer, party, FIELD_ACCESS_READ);
+        VisText(writer, "\n");
+    }
+    if (VisHasAccess(party, FIELD_ACCESS_WRITE)) {
+        VisText(writer, "      writes: ");
+        VisAccessList(writer, party, FIELD_ACCESS_WRITE);
+        VisText(writer, "\n");
+    }
+
+    if (writer->depth < WORLD_VISUALIZATION_ROLES) return;
+
+    for (size_t r = 0; r < party->roleCount; r++) {
+        VisText(writer, "      Role '");
+        VisString(writer, party->roles[r].roleId);
+        VisPrintf(writer, "': priority %d, scheduler %d\n",
+                  (int)party->roles[r].priority, (int)party->roles[r].schedulerTag);
+    }
+}
+
+static void VisEmitParty(VisWriter* writer, const VisParty* party)
+{
+    switch (writer->format) {
+    case WORLD_VISUALIZATION_DOT:  VisEmitPartyDot(writer, party); break;
+    case WORLD_VISUALIZATION_JSON: VisEmitPartyJson(writer, party); break;
+    case WORLD_VISUALIZATION_TEXT: VisEmitPartyText(writer, party); break;
+    }
+    writer->partyIndex++;
+}
+
+static void VisEndSystemic(VisWriter* writer)
+{
+    if (writer->format == WORLD_VISUALIZATION_DOT) {
+        VisText(writer, "  }\n");
+    } else if (writer->format == WORLD_VISUALIZATION_JSON) {
+        VisText(writer, writer->depth >= WORLD_VISUALIZATION_PARTIES ? "]}" : "}");
+    }
+    writer->systemicIndex++;
+}
+
+static bool VisEndWorld(VisWriter* writer)
+{
+    if (writer->format == WORLD_VISUALIZATION_DOT) {
+        VisText(writer, "}\n");
+    } else if (writer->format == WORLD_VISUALIZATION_JSON) {
+        VisText(writer, writer->depth >= WORLD_VISUALIZATION_SYSTEMICS ? "]}\n" : "}\n");
+    }
+
+    VisFlush(writer);
+    return !writer->failed;
+}
+
+/* ============= Live Writing ============= */
+
+bool WriteWorldVisualization(
+    WorldContext* world,
+    const WorldVisualizationOptions* options,
+    const WorldVisualizationOutput* output)
+{
+    if (!world) return false;
+
+    VisWriter* writer = VisWriterCreate(options, output);
+    if (!writer) return false;
+
+    VisWorld worldRecord;
+    VisWorldFromContext(&worldRecord, world);
+    VisBeginWorld(writer, &worldRecord);
+
+    for (size_t s = 0; writer->depth >= WORLD_VISUALIZATION_SYSTEMICS &&
+                       s < world->systemicCount && !writer->failed; s++) {
+        const WorldSystemicSlot* slot = &world->systemics[s];
+        if (!VisMatch(options->systemicFilter, slot->slotName)) continue;
+
+        VisSystemic systemicRecord;
+        VisSystemicFromSlot(&systemicRecord, slot);
+        VisBeginSystemic(writer, &systemicRecord);
+
+        const SystemicContext* systemic = slot->instance;
+        for (size_t p = 0; writer->depth >= WORLD_VISUALIZATION_PARTIES &&
+                           p < systemic->partyCount; p++) {
+            if (!VisMatch(options->partyFilter, systemic->partySlots[p].slotName)) continue;
+
+            VisParty partyRecord;
+            VisPartyFromSlot(&partyRecord, &systemic->partySlots[p]);
+            VisEmitParty(writer, &partyRecord);
+        }
+
+        VisEndSystemic(writer);
+    }
+
+    bool ok = VisEndWorld(writer);
+    free(writer);
+    return ok;
+}
+
+/* ============= Off-Thread Writing ============= */
+
+/*
+ * Flat copy of the records a job will write. Built in two passes over
+ * the world: the first sizes every array, the second fills them.
+ */
+typedef struct {
+    VisWorld world;
+    VisSystemic* systemics;
+    size_t* systemicPartyCounts;
+    size_t systemicCount;
+    VisParty* parties;
+    size_t partyCount;
+    FiberMapEntry* roles;
+    size_t roleCount;
+    FieldAccessDecl* accesses;
+    size_t accessCount;
+    char* strings;
+    size_t stringSize;
+} VisCapture;
+
+struct WorldVisualizationJob {
+    VisCapture capture;
+    VisWriter* writer;
+    pthread_t thread;
+    atomic_bool done;
+    bool succeeded;
+};
+
+static const char* VisCaptureString(VisCapture* capture, const char* str, bool fill)
+{
+    if (!str) return NULL;
+
+    size_t size = strlen(str) + 1;
+    char* copy = fill ? memcpy(capture->strings + capture->stringSize, str, size) : NULL;
+    capture->stringSize += size;
+    return copy;
+}
+
+static void VisCaptureWalk(VisCapture* capture, WorldContext* world,
+                           const WorldVisualizationOptions* options,
+                           WorldVisualizationDepth depth, bool fill)
+{
+    capture->systemicCount = 0;
+    capture->partyCount = 0;
+    capture->roleCount = 0;
+    capture->accessCount = 0;
+    capture->stringSize = 0;
+
+    VisWorldFromContext(&capture->world, world);
+    capture->world.name = VisCaptureString(capture, world->name, fill);
+    if (depth < WORLD_VISUALIZATION_SYSTEMICS) return;
+
+    for (size_t s = 0; s < world->systemicCount; s++) {
+        const WorldSystemicSlot* slot = &world->systemics[s];
+        if (!VisMatch(options->systemicFilter, slot->slotName)) continue;
+
+        size_t si = capture->systemicCount++;
+        VisSystemic* systemicRecord = fill ? &capture->systemics[si] : NULL;
+        if (fill) {
+            VisSystemicFromSlot(systemicRecord, slot);
+            capture->systemicPartyCounts[si] = 0;
+        }
+        const char* slotName = VisCaptureString(capture, slot->slotName, fill);
+        const char* typeName = VisCaptureString(capture, slot->systemicType, fill);
+        if (fill) {
+            systemicRecord->slot = slotName;
+            systemicRecord->type = typeName;
+        }
+        if (depth < WORLD_VISUALIZATION_PARTIES) continue;
+
+        const SystemicContext* systemic = slot->instance;
+        for (size_t p = 0; p < systemic->partyCount; p++) {
+            const SystemicPartySlot* party = &systemic->partySlots[p];
+            if (!VisMatch(options->partyFilter, party->slotName)) continue;
+
+            size_t pi = capture->partyCount++;
+            VisParty record;
+            VisPartyFromSlot(&record, party);
+            record.slot = VisCaptureString(capture, party->slotName, fill);
+            record.type = VisCaptureString(capture, party->partyType, fill);
+
+            if (fill && record.accessCount > 0) {
+                memcpy(&capture->accesses[capture->accessCount], record.accesses,
+                       record.accessCount * sizeof(FieldAccessDecl));
+                record.accesses = &capture->accesses[capture->accessCount];
+            }
+            capture->accessCount += record.accessCount;
+
+            if (depth < WORLD_VISUALIZATION_ROLES) {
+                record.roles = NULL;
+                record.roleCount = 0;
+            }
+            const FiberMapEntry* roles = record.roles;
+            if (fill && record.roleCount > 0) {
+                record.roles = &capture->roles[capture->roleCount];
+            }
+            for (size_t r = 0; r < record.roleCount; r++, capture->roleCount++) {
+                const char* roleId = VisCaptureString(capture, roles[r].roleId, fill);
+                if (fill) {
+                    capture->roles[capture->roleCount] = roles[r];
+                    capture->roles[capture->roleCount].roleId = roleId;
+                }
+            }
+
+            if (fill) {
+                capture->parties[pi] = record;
+                capture->systemicPartyCounts[si]++;
+            }
+        }
+    }
+}
+
+static void VisCaptureDestroy(VisCapture* capture)
+{
+    free(capture->systemics);
+    free(capture->systemicPartyCounts);
+    free(capture->parties);
+    free(capture->roles);
+    free(capture->accesses);
+    free(capture->strings);
+}
+
+static bool VisCaptureCreate(VisCapture* capture, WorldContext* world,
+                             const WorldVisualizationOptions* options,
+                             WorldVisualizationDepth depth)
+{
+    memset(capture, 0, sizeof(VisCapture));
+    VisCaptureWalk(capture, world, options, depth, false);
+
+    /* +1 so that empty arrays still allocate and a NULL means failure */
+    capture->systemics = (VisSystemic*)malloc((capture->systemicCount + 1) * sizeof(VisSystemic));
+    capture->systemicPartyCounts = (size_t*)malloc((capture->systemicCount + 1) * sizeof(size_t));
+    capture->parties = (VisParty*)malloc((capture->partyCount + 1) * sizeof(VisParty));
+    capture->roles = (FiberMapEntry*)malloc((capture->roleCount + 1) * sizeof(FiberMapEntry));
+    capture->accesses = (FieldAccessDecl*)malloc((capture->accessCount + 1) * sizeof(FieldAccessDecl));
+    capture->strings = (char*)malloc(capture->stringSize + 1);
+
+    if (!capture->systemics || !capture->systemicPartyCounts || !capture->parties ||
+        !capture->roles || !capture->accesses || !capture->strings) {
+        VisCaptureDestroy(capture);
+        return false;
+    }
+
+    VisCaptureWalk(capture, world, options, depth, true);
+    return true;
+}
+
+static void* VisJobThread(void* arg)
+{
+    WorldVisualizationJob* job = (WorldVisualizationJob*)arg;
+    VisCapture* capture = &job->capture;
+    VisWriter* writer = job->writer;
+
+    VisBeginWorld(writer, &capture->world);
+
+    size_t p = 0;
+    for (size_t s = 0; s < capture->systemicCount && !writer->failed; s++) {
+        VisBeginSystemic(writer, &capture->systemics[s]);
+        for (size_t end = p + capture->systemicPartyCounts[s]; p < end; p++) {
+            VisEmitParty(writer, &capture->parties[p]);
+        }
+        VisEndSystemic(writer);
+    }
+
+    job->succeeded = VisEndWorld(writer);
+    atomic_store_explicit(&job->done, true, memory_order_release);
+    return NULL;
+}
+
+WorldVisualizationJob* WriteWorldVisualizationAsync(
+    WorldContext* world,
+    const WorldVisualizationOptions* options,
+    const WorldVisualizationOutput* output)
+{
+    if (!world) return NULL;
+
+    WorldVisualizationJob* job = (WorldVisualizationJob*)calloc(1, sizeof(WorldVisualizationJob));
+    if (!job) return NULL;
+
+    job->writer = VisWriterCreate(options, output);
+    if (!job->writer) {
+        free(job);
+        return NULL;
+    }
+
+    if (!VisCaptureCreate(&job->capture, world, options, job->writer->depth)) {
+        free(job->writer);
+        free(job);
+        return NULL;
+    }
+
+    atomic_init(&job->done, false);
+    if (pthread_create(&job->thread, NULL, VisJobThread, job) != 0) {
+        VisCaptureDestroy(&job->capture);
+        free(job->writer);
+        free(job);
+        return NULL;
+    }
+
+    return job;
+}
+
+bool WorldVisualizationJobDone(const WorldVisualizationJob* job)
+{
+    return !job || atomic_load_explicit(&job->done, memory_order_acquire);
+}
+
+bool WorldVisualizationJobWait(WorldVisualizationJob* job)
+{
+    if (!job) return false;
+
+    pthread_join(job->thread, NULL);
+    bool succeeded = job->succeeded;
+
+    VisCaptureDestroy(&job->capture);
+    free(job->writer);
+    free(job);
+    return succeeded;
+}
+
+/* ============= Monitoring & Debugging ============= */
+
+typedef struct {
+    char* data;
+    size_t size;
+    size_t capacity;
+} VisStringBuffer;
+
+static bool VisAppend(const char* data, size_t size, void* userData)
+{
+    VisStringBuffer* buffer = (VisStringBuffer*)userData;
+
+    if (buffer->size + size + 1 > buffer->capacity) {
+        size_t capacity = buffer->capacity ? buffer->capacity : 4096;
+        while (capacity < buffer->size + size + 1) capacity *= 2;
+
+        char* grown = (char*)realloc(buffer->data, capacity);
+        if (!grown) return false;
+        buffer->data = grown;
+        buffer->capacity = capacity;
+    }
+
+    memcpy(buffer->data + buffer->size, data, size);
+    buffer->size += size;
+    buffer->data[buffer->size] = '\0';
+    return true;
+}
+
+char* GenerateWorldVisualization(WorldContext* world, const char* format)
+{
+    if (!world || !format) return NULL;
+
+    WorldVisualizationOptions options = { 0 };
+    if (strcmp(format, "dot") == 0) {
+        options.format = WORLD_VISUALIZATION_DOT;
+    } else if (strcmp(format, "json") == 0) {
+        options.format = WORLD_VISUALIZATION_JSON;
+    } else if (strcmp(format, "text") == 0) {
+        options.format = WORLD_VISUALIZATION_TEXT;
+    } else {
+        return NULL;
+    }
+
+    VisStringBuffer buffer = { 0 };
+    WorldVisualizationOutput output = { .write = VisAppend, .userData = &buffer };
+
+    if (!WriteWorldVisualization(world, &options, &output) || !buffer.data) {
+        free(buffer.data);
+        return NULL;
+    }
+    return buffer.data;
+}
+
+void DumpWorldState(WorldContext* world, bool includeSystemics, bool includeParties,
+                    bool includeRoles)
+{
+    WorldVisualizationOptions options = { .format = WORLD_VISUALIZATION_TEXT };
+    if (!includeSystemics) {
+        options.depth = WORLD_VISUALIZATION_WORLD;
+    } else if (!includeParties) {
+        options.depth = WORLD_VISUALIZATION_SYSTEMICS;
+    } else if (!includeRoles) {
+        options.depth = WORLD_VISUALIZATION_PARTIES;
+    } else {
+        options.depth = WORLD_VISUALIZATION_ROLES;
+    }
+
+    /* The writer bypasses stdio */
+    fflush(stdout);
+    WorldVisualizationOutput output = { .fd = STDOUT_FILENO };
+    WriteWorldVisualization(world, &options, &output);
+}
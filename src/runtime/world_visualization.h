@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2025 Pergyra Language Project
+ * World Visualization
+ * Streaming DOT/JSON/text writer for the world hierarchy
+ */
+
+#ifndef PERGYRA_WORLD_VISUALIZATION_H
+#define PERGYRA_WORLD_VISUALIZATION_H
+
+#include "world_systemic.h"
+
+/*
+ * The writer walks the hierarchy once and emits it through a fixed-size
+ * buffer, so memory does not grow with the world. GenerateWorldVisualization
+ * and DumpWorldState are built on it.
+ */
+
+#define WORLD_VISUALIZATION_BUFFER_SIZE (16 * 1024)
+
+typedef enum {
+    WORLD_VISUALIZATION_DOT,
+    WORLD_VISUALIZATION_JSON,
+    WORLD_VISUALIZATION_TEXT
+} WorldVisualizationFormat;
+
+/* Deepest level written */
+typedef enum {
+    WORLD_VISUALIZATION_ALL = 0,     /* Same as ROLES */
+    WORLD_VISUALIZATION_WORLD,
+    WORLD_VISUALIZATION_SYSTEMICS,
+    WORLD_VISUALIZATION_PARTIES,
+    WORLD_VISUALIZATION_ROLES
+} WorldVisualizationDepth;
+
+/*
+ * Slot filters match a whole name, or a prefix when they end in '*'
+ * ("enemy*"). NULL keeps everything.
+ */
+typedef struct {
+    WorldVisualizationFormat format;
+    WorldVisualizationDepth depth;
+    const char* systemicFilter;
+    const char* partyFilter;
+} WorldVisualizationOptions;
+
+/* Receives the output in chunks of at most the buffer size; return false to stop */
+typedef bool (*WorldVisualizationWrite)(const char* data, size_t size, void* userData);
+
+typedef struct {
+    WorldVisualizationWrite write;   /* NULL = write to fd */
+    void* userData;
+    int fd;
+} WorldVisualizationOutput;
+
+/* Write the world as it is now; call between frames */
+bool WriteWorldVisualization(
+    WorldContext* world,
+    const WorldVisualizationOptions* options,
+    const WorldVisualizationOutput* output
+);
+
+/* ============= Off-Thread Writing ============= */
+
+typedef struct WorldVisualizationJob WorldVisualizationJob;
+
+/*
+ * Copy the filtered part of the world into one flat snapshot and write
+ * it on a background thread, so the world loop only pays for the copy.
+ * Call between frames; the output describes the world at that point.
+ * The output must stay valid until the job is waited on.
+ */
+WorldVisualizationJob* WriteWorldVisualizationAsync(
+    WorldContext* world,
+    const WorldVisualizationOptions* options,
+    const WorldVisualizationOutput* output
+);
+
+bool WorldVisualizationJobDone(const WorldVisualizationJob* job);
+
+/* Join the writer and free the job; true if all output was written */
+bool WorldVisualizationJobWait(WorldVisualizationJob* job);
+
+#endif /* PERGYRA_WORLD_VISUALIZATION_H */
@@ -0,0 +1,640 @@
+/*
+ * Copyright (c) 2025 Pergyra Language Project
+ * All rights reserved.
+ *
+ * Party Runtime Contention Benchmark
+ *
+ * Hammers the PartyContext lookup API from many role fibers at once
+ * while a writer keeps publishing new shared-field versions:
+ * - ContextGetRoleById (interned IDs)
+ * - ContextGetRole (string shim)
+ * - ContextGetShared under concurrent ContextSetShared
+ * - FiberMapCache hits, misses and CLOCK eviction
+ * - DispatchArena reuse across frames
+ * - DispatchLatch ready hooks (async completion and cancellation)
+ *
+ * and checks the dispatcher end to end: joins, losers stopping without
+ * stranding arena memory, periodic roles, async cancellation and
+ * resident rounds.
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "runtime/party_runtime.h"
+#include "runtime/slot_manager.h"
+#include "runtime/async/epoch.h"
+
+#define NUM_ROLE_FIBERS     64
+#define LOOKUPS_PER_FIBER   200000
+#define NUM_ROLES           8
+#define NUM_DISPATCH_ROLES  4
+#define DISPATCH_FRAMES     10
+#define RESIDENT_ROUNDS     100
+
+/* No slot manager: role instances come from GetSlotPointer below */
+SlotManager *g_pergyraSlotManager = NULL;
+
+/* Test statistics */
+static int g_totalTests = 0;
+static int g_failedTests = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        g_totalTests++; \
+        if (condition) { \
+            printf("[PASS] %s\n", message); \
+        } else { \
+            g_failedTests++; \
+            printf("[FAIL] %s\n", message); \
+        } \
+    } while(0)
+
+/* Party fixture */
+static int g_roleInstances[NUM_ROLES];
+static int g_sharedValues[2];
+
+static const char* g_slotNames[NUM_ROLES] = {
+    "tank", "healer", "dps1", "dps2", "support", "scout", "mage", "summoner"
+};
+
+static const char* g_tankAbilities[] = { "Tankable", "Damageable" };
+static const char* g_otherAbilities[] = { "DamageDealing", "Damageable" };
+
+typedef struct {
+    const char* slotName;
+    uint32_t slotId;
+    void* roleInstance;
+    const char** abilities;
+    size_t abilityCount;
+} BenchRole;
+
+typedef struct {
+    const char* fieldName;
+    uint32_t slotId;
+    void* value;
+} BenchField;
+
+static BenchRole g_roles[NUM_ROLES];
+static BenchField g_fields[1];
+static PartyContext g_context;
+
+/* Benchmark state */
+static atomic_uint g_finishedFibers = 0;
+static atomic_uint_fast64_t g_failedLookups = 0;
+static atomic_bool g_stopWriter = false;
+
+typedef struct {
+    uint32_t index;
+    bool byId;
+} RoleFiberArgs;
+
+static RoleFiberArgs g_fiberArgs[NUM_ROLE_FIBERS];
+
+static uint64_t GetTimeNanos(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void SetupContext(void)
+{
+    for (size_t i = 0; i < NUM_ROLES; i++) {
+        g_roles[i].slotName = g_slotNames[i];
+        g_roles[i].slotId = (uint32_t)i;
+        g_roles[i].roleInstance = &g_roleInstances[i];
+        g_roles[i].abilities = i == 0 ? g_tankAbilities : g_otherAbilities;
+        g_roles[i].abilityCount = 2;
+    }
+
+    g_fields[0].fieldName = "inCombat";
+    g_fields[0].value = &g_sharedValues[0];
+
+    memset(&g_context, 0, sizeof(g_context));
+    g_context.roles = (void*)g_roles;
+    g_context.roleCount = NUM_ROLES;
+    g_context.sharedFields = (void*)g_fields;
+    g_context.sharedFieldCount = 1;
+    g_context.partyName = "BenchParty";
+}
+
+/* Role fiber body: resolve the tank and a shared field in a tight loop */
+static void RoleFiber(void* arg)
+{
+    RoleFiberArgs* args = (RoleFiberArgs*)arg;
+    InternId tankId = LookupSlotNameId("tank");
+    InternId damageableId = LookupAbilityNameId("Damageable");
+    InternId fieldId = LookupFieldNameId("inCombat");
+    uint64_t failures = 0;
+
+    for (uint32_t i = 0; i < LOOKUPS_PER_FIBER; i++) {
+        void* tank;
+        if (args->byId) {
+            tank = ContextGetRoleById(&g_context, tankId, damageableId);
+        } else {
+            tank = ContextGetRole(&g_context, "tank", "Damageable");
+        }
+
+        void* shared = ContextGetSharedById(&g_context, fieldId);
+        if (tank != &g_roleInstances[0] ||
+            (shared != &g_sharedValues[0] && shared != &g_sharedValues[1])) {
+            failures++;
+        }
+    }
+
+    atomic_fetch_add(&g_failedLookups, failures);
+    atomic_fetch_add(&g_finishedFibers, 1);
+}
+
+/* Writer: keep flipping a shared field to force table republication */
+static void* WriterThread(void* arg)
+{
+    uint64_t* publishes = (uint64_t*)arg;
+
+    while (!atomic_load(&g_stopWriter)) {
+        ContextSetShared(&g_context, "inCombat", &g_sharedValues[*publishes & 1]);
+        (*publishes)++;
+        sched_yield();
+    }
+
+    return NULL;
+}
+
+static void NoopParallel(void* role, void* context)
+{
+    (void)role;
+    (void)context;
+}
+
+/* Dispatch fixture: instance slot N (1-based) is a per-role run counter */
+static atomic_uint g_dispatchCounters[NUM_DISPATCH_ROLES];
+
+void* GetSlotPointer(uint32_t slotId)
+{
+    if (slotId == 0 || slotId > NUM_DISPATCH_ROLES) {
+        return NULL;
+    }
+    return &g_dispatchCounters[slotId - 1];
+}
+
+static void ResetDispatchCounters(void)
+{
+    for (size_t i = 0; i < NUM_DISPATCH_ROLES; i++) {
+        atomic_store(&g_dispatchCounters[i], 0);
+    }
+}
+
+static void SleepMs(uint32_t ms)
+{
+    struct timespec ts = { .tv_sec = ms / 1000, .tv_nsec = (long)(ms % 1000) * 1000000L };
+    nanosleep(&ts, NULL);
+}
+
+static void CountParallel(void* role, void* context)
+{
+    (void)context;
+    atomic_fetch_add((atomic_uint*)role, 1);
+}
+
+/* Holds the join open long enough for continuous and periodic roles to run */
+static void SlowParallel(void* role, void* context)
+{
+    SleepMs(20);
+    CountParallel(role, context);
+}
+
+/* Outlasts SlowParallel, so it loses JOIN_ANY */
+static void SlowerParallel(void* role, void* context)
+{
+    SleepMs(40);
+    CountParallel(role, context);
+}
+
+static RoleParallelMetadata g_countMetadata = {
+    .roleName = "count", .function = CountParallel,
+    .scheduler = SCHEDULER_CPU_FIBER, .priority = PRIORITY_NORMAL
+};
+static RoleParallelMetadata g_slowMetadata = {
+    .roleName = "slow", .function = SlowParallel,
+    .scheduler = SCHEDULER_CPU_FIBER, .priority = PRIORITY_NORMAL
+};
+static RoleParallelMetadata g_slowerMetadata = {
+    .roleName = "slower", .function = SlowerParallel,
+    .scheduler = SCHEDULER_CPU_FIBER, .priority = PRIORITY_NORMAL
+};
+static RoleParallelMetadata g_continuousMetadata = {
+    .roleName = "loop", .function = CountParallel,
+    .scheduler = SCHEDULER_CPU_FIBER, .priority = PRIORITY_LOW, .continuous = true
+};
+static RoleParallelMetadata g_periodicMetadata = {
+    .roleName = "tick", .function = CountParallel,
+    .scheduler = SCHEDULER_CPU_FIBER, .priority = PRIORITY_NORMAL,
+    .intervalMs = 1, .continuous = true
+};
+
+/* Bind metadata[i] to instance slot i + 1 */
+static FiberMap* MakeDispatchMap(const char* partyType, RoleParallelMetadata** metadata,
+                                 size_t count)
+{
+    static const char* slotNames[NUM_DISPATCH_ROLES] = { "first", "second", "third", "fourth" };
+    RoleBinding bindings[NUM_DISPATCH_ROLES];
+
+    for (size_t i = 0; i < count; i++) {
+        bindings[i].slotName = slotNames[i];
+        bindings[i].instanceSlotId = (uint32_t)i + 1;
+        bindings[i].metadata = metadata[i];
+    }
+    return GenerateFiberMap(partyType, bindings, count);
+}
+
+static void TestDispatchJoinAll(void)
+{
+    RoleParallelMetadata* metadata[NUM_DISPATCH_ROLES] = {
+        &g_countMetadata, &g_countMetadata, &g_slowMetadata, &g_countMetadata
+    };
+    FiberMap* map = MakeDispatchMap("JoinAllParty", metadata, NUM_DISPATCH_ROLES);
+    TEST_ASSERT(map != NULL, "Dispatch map generation");
+    if (!map) {
+        return;
+    }
+
+    ResetDispatchCounters();
+    DispatchResult result = DispatchParallel(map, &g_context, JOIN_ALL, NULL);
+
+    bool everyRoleRanOnce = result.resultCount == NUM_DISPATCH_ROLES;
+    for (size_t i = 0; i < NUM_DISPATCH_ROLES && everyRoleRanOnce; i++) {
+        everyRoleRanOnce = result.results[i].success &&
+            atomic_load(&g_dispatchCounters[i]) == 1;
+    }
+    TEST_ASSERT(result.allSucceeded && everyRoleRanOnce,
+                "JOIN_ALL returns after every role ran once");
+
+    free(result.results);
+    FreeFiberMap(map);
+}
+
+static void TestDispatchLosers(void)
+{
+    RoleParallelMetadata* metadata[3] = {
+        &g_slowMetadata, &g_slowerMetadata, &g_continuousMetadata
+    };
+    FiberMap* map = MakeDispatchMap("LoserParty", metadata, 3);
+    DispatchArena* arena = DispatchArenaCreate(1024);
+    TEST_ASSERT(map != NULL && arena != NULL, "Loser dispatch setup");
+    if (!map || !arena) {
+        FreeFiberMap(map);
+        DispatchArenaDestroy(arena);
+        return;
+    }
+
+    ResetDispatchCounters();
+
+    /* The slow role decides each frame; the slower one and the loop lose */
+    DispatchResult result = {0};
+    bool framesSucceeded = true;
+    for (int frame = 0; frame < DISPATCH_FRAMES; frame++) {
+        framesSucceeded &= DispatchParallelInto(map, &g_context, JOIN_ANY, NULL, arena, &result);
+        framesSucceeded &= result.allSucceeded && result.results[2].success;
+    }
+    TEST_ASSERT(framesSucceeded, "JOIN_ANY frames succeed with continuous roles marked done");
+
+    /* Reset only returns once every loser released its dispatch state */
+    DispatchArenaReset(arena);
+    TEST_ASSERT(atomic_load(&g_dispatchCounters[1]) == DISPATCH_FRAMES,
+                "Arena reset waits for losing roles to finish");
+
+    unsigned int loops = atomic_load(&g_dispatchCounters[2]);
+    SleepMs(10);
+    TEST_ASSERT(loops > 0 && atomic_load(&g_dispatchCounters[2]) == loops,
+                "Continuous losers stop once the join closes");
+
+    DispatchArenaDestroy(arena);
+    FreeFiberMap(map);
+}
+
+static void TestDispatchPeriodic(void)
+{
+    RoleParallelMetadata* metadata[2] = { &g_slowMetadata, &g_periodicMetadata };
+    FiberMap* map = MakeDispatchMap("PeriodicParty", metadata, 2);
+    TEST_ASSERT(map != NULL, "Periodic dispatch map generation");
+    if (!map) {
+        return;
+    }
+
+    ResetDispatchCounters();
+
+    /* The timer fires the periodic role while the slow role holds the join open */
+    DispatchResult result = DispatchParallel(map, &g_context, JOIN_ALL, NULL);
+    unsigned int firings = atomic_load(&g_dispatchCounters[1]);
+    TEST_ASSERT(result.allSucceeded && result.results[1].success && firings > 0,
+                "Periodic role fires during the dispatch");
+
+    /* One firing may already have been in flight when the role was removed */
+    SleepMs(20);
+    TEST_ASSERT(atomic_load(&g_dispatchCounters[1]) <= firings + 1,
+                "Periodic role stops firing after the join");
+
+    free(result.results);
+    FreeFiberMap(map);
+}
+
+static void TestDispatchAsyncCancel(void)
+{
+    RoleParallelMetadata* metadata[2] = { &g_slowMetadata, &g_continuousMetadata };
+    FiberMap* map = MakeDispatchMap("CancelParty", metadata, 2);
+    TEST_ASSERT(map != NULL, "Async dispatch map generation");
+    if (!map) {
+        return;
+    }
+
+    ResetDispatchCounters();
+
+    DispatchHandle* handle = DispatchParallelAsync(map, &g_context, JOIN_ALL, NULL);
+    TEST_ASSERT(handle != NULL, "Async dispatch starts");
+    if (!handle) {
+        FreeFiberMap(map);
+        return;
+    }
+
+    CancelDispatch(handle);
+    DispatchResult result = WaitForDispatch(handle, 1000);
+    TEST_ASSERT(result.results != NULL && !result.allSucceeded,
+                "Cancelled dispatch completes as failed");
+    free(result.results);
+
+    /* The slow role runs to completion; the loop sees its stop flag */
+    SleepMs(40);
+    unsigned int loops = atomic_load(&g_dispatchCounters[1]);
+    SleepMs(10);
+    TEST_ASSERT(atomic_load(&g_dispatchCounters[0]) == 1 &&
+                atomic_load(&g_dispatchCounters[1]) == loops,
+                "Cancelled roles finish or stop on their own");
+
+    FreeFiberMap(map);
+}
+
+static void TestResidentDispatch(void)
+{
+    RoleParallelMetadata* metadata[NUM_DISPATCH_ROLES] = {
+        &g_countMetadata, &g_countMetadata, &g_countMetadata, &g_countMetadata
+    };
+    FiberMap* map = MakeDispatchMap("ResidentParty", metadata, NUM_DISPATCH_ROLES);
+    ResidentDispatch* dispatch = map ? ResidentDispatchCreate(map, &g_context, NULL) : NULL;
+    TEST_ASSERT(dispatch != NULL, "Resident dispatch creation");
+    if (!dispatch) {
+        FreeFiberMap(map);
+        return;
+    }
+
+    ResetDispatchCounters();
+
+    bool roundsSucceeded = true;
+    for (int round = 0; round < RESIDENT_ROUNDS; round++) {
+        DispatchResult result = ResidentDispatchRun(dispatch, JOIN_ALL);
+        roundsSucceeded &= result.allSucceeded;
+    }
+
+    bool everyRoleRanEachRound = true;
+    for (size_t i = 0; i < NUM_DISPATCH_ROLES; i++) {
+        everyRoleRanEachRound &= atomic_load(&g_dispatchCounters[i]) == RESIDENT_ROUNDS;
+    }
+    TEST_ASSERT(roundsSucceeded && everyRoleRanEachRound,
+                "Resident fibers run once per round");
+
+    ResidentDispatchDestroy(dispatch);
+    FreeFiberMap(map);
+}
+
+static void TestFiberMapCache(void)
+{
+    static RoleParallelMetadata metadata = {
+        .roleName = "tank",
+        .function = NoopParallel,
+        .scheduler = SCHEDULER_MAIN_THREAD,
+        .priority = PRIORITY_NORMAL
+    };
+    RoleBinding bindings[2] = {
+        { .slotName = "tank", .instanceSlotId = 1, .metadata = &metadata },
+        { .slotName = "healer", .instanceSlotId = 2, .metadata = &metadata }
+    };
+
+    InitializeFiberMapCache(4);
+
+    FiberMap* first = GenerateFiberMapCached("CacheParty", bindings, 2);
+    FiberMap* second = GenerateFiberMapCached("CacheParty", bindings, 2);
+    TEST_ASSERT(first != NULL && first == second, "Same bindings share a cached map");
+
+    /* Another party whose bindings hash to the same key must not get this map */
+    RoleBinding collided[1] = {
+        { .slotName = "dps", .instanceSlotId = 9, .metadata = &metadata }
+    };
+    FiberMap* collision = first ? GetCachedFiberMap(first->cacheKey, "OtherParty", collided, 1) : NULL;
+    TEST_ASSERT(first != NULL && collision == NULL, "Key collision is a miss");
+
+    bindings[1].instanceSlotId = 3;
+    FiberMap* other = GenerateFiberMapCached("CacheParty", bindings, 2);
+    TEST_ASSERT(other != first, "Different bindings get their own map");
+
+    FreeFiberMap(first);
+    FreeFiberMap(second);
+    FreeFiberMap(other);
+
+    /* Overfill the cache to force eviction */
+    for (uint32_t i = 0; i < 16; i++) {
+        bindings[1].instanceSlotId = 100 + i;
+        FreeFiberMap(GenerateFiberMapCached("CacheParty", bindings, 2));
+    }
+
+    FiberMapCacheStats stats;
+    GetFiberMapCacheStats(&stats);
+    printf("FiberMapCache: hits=%llu misses=%llu insertions=%llu evictions=%llu entries=%zu\n",
+           (unsigned long long)stats.hits, (unsigned long long)stats.misses,
+           (unsigned long long)stats.insertions, (unsigned long long)stats.evictions,
+           stats.entries);
+    TEST_ASSERT(stats.hits == 1, "Cache hit counted");
+    TEST_ASSERT(stats.entries <= 4 && stats.evictions > 0, "Cache stays bounded");
+
+    CleanupFiberMapCache();
+}
+
+static void TestDispatchArena(void)
+{
+    DispatchArena* arena = DispatchArenaCreate(256);
+    TEST_ASSERT(arena != NULL, "Arena creation");
+    if (!arena) {
+        return;
+    }
+
+    /* First frame outgrows the initial chunk */
+    void* first = NULL;
+    for (int i = 0; i < 64; i++) {
+        void* block = DispatchArenaAlloc(arena, 128);
+        if (i == 0) first = block;
+    }
+    const char* error = DispatchArenaPrintf(arena, "%s: %s", "tank", "Scheduler not found");
+    TEST_ASSERT(error && strcmp(error, "tank: Scheduler not found") == 0,
+                "Arena formats error strings");
+
+    /* Later frames fit in one coalesced chunk and stop hitting the heap */
+    DispatchAllocStats stats = {0};
+    uint32_t heapAllocations = 0;
+    for (int frame = 0; frame < 4; frame++) {
+        DispatchArenaReset(arena);
+        for (int i = 0; i < 64; i++) {
+            DispatchArenaAlloc(arena, 128);
+        }
+        DispatchArenaPrintf(arena, "%s: %s", "tank", "Scheduler not found");
+        DispatchArenaGetStats(arena, &stats);
+        if (frame > 0) {
+            heapAllocations += stats.heapAllocations;
+        }
+    }
+    printf("DispatchArena: %u arena allocations, %zu bytes per frame\n",
+           stats.arenaAllocations, stats.arenaBytes);
+    TEST_ASSERT(first != NULL && heapAllocations == 0, "Arena reuses memory across frames");
+
+    DispatchArenaDestroy(arena);
+}
+
+static void RunContention(Scheduler* scheduler, bool byId)
+{
+    atomic_store(&g_finishedFibers, 0);
+    atomic_store(&g_failedLookups, 0);
+    atomic_store(&g_stopWriter, false);
+
+    uint64_t publishes = 0;
+    pthread_t writer;
+    pthread_create(&writer, NULL, WriterThread, &publishes);
+
+    uint64_t start = GetTimeNanos();
+
+    for (uint32_t i = 0; i < NUM_ROLE_FIBERS; i++) {
+        g_fiberArgs[i].index = i;
+        g_fiberArgs[i].byId = byId;
+        SchedulerSpawn(scheduler, RoleFiber, &g_fiberArgs[i]);
+    }
+
+    while (atomic_load(&g_finishedFibers) < NUM_ROLE_FIBERS) {
+        sched_yield();
+    }
+
+    uint64_t elapsed = GetTimeNanos() - start;
+
+    atomic_store(&g_stopWriter, true);
+    pthread_join(writer, NULL);
+
+    /* Two lookups per iteration (role + shared field) */
+    double lookups = (double)NUM_ROLE_FIBERS * LOOKUPS_PER_FIBER * 2;
+    printf("%s: %d fibers, %.0f lookups in %.3f ms (%.2f ns/lookup aggregate, %.1f M lookups/sec)\n",
+           byId ? "ContextGetRoleById" : "ContextGetRole",
+           NUM_ROLE_FIBERS, lookups, elapsed / 1e6,
+           (double)elapsed / lookups,
+           lookups / (elapsed / 1e9) / 1e6);
+    printf("  writer published %llu table versions\n",
+           (unsigned long long)publishes);
+
+    TEST_ASSERT(atomic_load(&g_failedLookups) == 0,
+                byId ? "Lookups by ID stay consistent under republication"
+                     : "String lookups stay consistent under republication");
+}
+
+static void CountReady(DispatchLatch* latch, void* userData)
+{
+    (void)latch;
+    (*(int*)userData)++;
+}
+
+static void TestDispatchLatchReady(void)
+{
+    DispatchLatch latch;
+    TEST_ASSERT(DispatchLatchInit(&latch, 2), "Latch creation");
+
+    int fired = 0;
+    FiberResult done = { .roleId = "tank", .success = true };
+    DispatchLatchSetReady(&latch, CountReady, &fired);
+
+    /* The deciding signal fires the hook once; polling afterwards does not */
+    DispatchLatchArm(&latch, JOIN_ALL, NULL, NULL, 2);
+    DispatchLatchSignal(&latch, 0, &done);
+    DispatchLatchPoll(&latch);
+    TEST_ASSERT(fired == 0, "Hook waits for the join");
+    DispatchLatchSignal(&latch, 1, &done);
+    DispatchLatchPoll(&latch);
+    TEST_ASSERT(fired == 1 && DispatchLatchClose(&latch, NULL, NULL),
+                "Hook fires once on the deciding signal");
+
+    /* Cancellation decides first; the late exit is only bookkeeping */
+    DispatchLatchArm(&latch, JOIN_ALL, NULL, NULL, 2);
+    bool decided = DispatchLatchDecide(&latch, false);
+    bool again = DispatchLatchDecide(&latch, true);
+    TEST_ASSERT(decided && !again && fired == 2, "Decide settles the join once");
+    TEST_ASSERT(!DispatchLatchClose(&latch, NULL, NULL), "Cancelled join fails");
+    DispatchLatchSignal(&latch, 0, &done);
+    DispatchLatchSignal(&latch, 1, &done);
+    TEST_ASSERT(fired == 2, "Signals after the decision do not fire the hook");
+
+    DispatchLatchDestroy(&latch);
+}
+
+int main(void)
+{
+    printf("===== Pergyra Party Runtime Contention Benchmark =====\n");
+
+    SetupContext();
+    TEST_ASSERT(PartyContextPublish(&g_context), "Publish initial context table");
+    TEST_ASSERT(ContextGetRole(&g_context, "tank", "Tankable") == &g_roleInstances[0],
+                "Lookup by slot and ability");
+    TEST_ASSERT(ContextGetRole(&g_context, "healer", "Tankable") == NULL,
+                "Lookup rejects missing ability");
+
+    TestFiberMapCache();
+    TestDispatchArena();
+    TestDispatchLatchReady();
+
+    /* Default configuration: one worker per CPU, work stealing on */
+    Scheduler* scheduler = SchedulerCreate(NULL);
+    TEST_ASSERT(scheduler != NULL, "Scheduler creation");
+    if (!scheduler) {
+        return 1;
+    }
+    SchedulerStart(scheduler);
+
+    RunContention(scheduler, true);
+    RunContention(scheduler, false);
+
+    SchedulerStop(scheduler);
+    SchedulerDestroy(scheduler);
+
+    /* Sleeping roles hold a worker each; keep the loop runnable beside them */
+    SchedulerPoolConfig pools = {0};
+    pools.workerCounts[SCHEDULER_CPU_FIBER] = 4;
+    TEST_ASSERT(ConfigureSchedulerPools(&pools), "Configure dispatch pools");
+
+    TestDispatchJoinAll();
+    TestDispatchLosers();
+    TestDispatchPeriodic();
+    TestDispatchAsyncCancel();
+    TestResidentDispatch();
+    ShutdownSchedulerPools();
+
+    PartyContextRelease(&g_context);
+    EpochSynchronize();
+
+    EpochStats stats;
+    EpochGetStats(&stats);
+    printf("Epoch: current=%llu threads=%llu pending=%llu reclaimed=%llu\n",
+           (unsigned long long)stats.currentEpoch,
+           (unsigned long long)stats.registeredThreads,
+           (unsigned long long)stats.pendingObjects,
+           (unsigned long long)stats.reclaimedObjects);
+    TEST_ASSERT(stats.pendingObjects == 0, "All retired tables reclaimed");
+
+    printf("\n%d tests, %d failed\n", g_totalTests, g_failedTests);
+    return g_failedTests == 0 ? 0 : 1;
+}
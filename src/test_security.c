@@ -10,6 +10,8 @@
  * - Encryption/decryption
  * - Access control
  * - Security violation detection
+ * - Binary audit logging
+ * - Encrypted slot payloads
  */
 
 #include <stdio.h>
@@ -18,8 +20,10 @@
 #include <assert.h>
 #include <time.h>
 
-#include "../runtime/slot_manager.h"
-#include "../runtime/slot_security.h"
+#include <openssl/evp.h>
+
+#include "runtime/slot_manager.h"
+#include "runtime/slot_security.h"
 
 /* Global test manager */
 SlotManager *g_pergyraSlotManager = NULL;
@@ -87,6 +91,15 @@ void test_security_context_lifecycle()
     TEST_ASSERT(context->initialized, "Security context initialization");
     TEST_ASSERT(context->defaultLevel == SECURITY_LEVEL_BASIC, 
                 "Default security level setting");
+    TEST_ASSERT(context->hwMonitor == NULL, 
+                "Basic context starts no hardware monitor");
+    
+    /* The first hardware-bound token starts the monitor on demand */
+    TokenCapability token;
+    TokenGenerate(context, 1, SECURITY_LEVEL_HARDWARE, &token);
+    TEST_ASSERT(TokenValidate(context, 1, &token) == SECURITY_SUCCESS &&
+                context->hwMonitor != NULL,
+                "Hardware-bound validation starts the monitor");
     
     SecurityContextDestroy(context);
     printf("Security context destroyed successfully\n");
@@ -114,6 +127,19 @@ void test_hardware_fingerprint()
            (unsigned long long)fp1.cpuId,
            (unsigned long long)fp1.boardId, 
            (unsigned long long)fp1.macAddress);
+    
+    /* Cached binding: a forced re-check matches and tokens still validate */
+    SecurityContext *context = SecurityContextCreate(SECURITY_LEVEL_HARDWARE);
+    SecurityContextSetHardwareCheckInterval(context, 10);
+    TEST_ASSERT(SecurityContextUpdateHardware(context) == SECURITY_SUCCESS,
+                "Hardware re-verification matches bound fingerprint");
+    
+    TokenCapability token;
+    TokenGenerate(context, 1, SECURITY_LEVEL_HARDWARE, &token);
+    TEST_ASSERT(TokenValidate(context, 1, &token) == SECURITY_SUCCESS,
+                "Hardware-bound token validates against cached fingerprint");
+    
+    SecurityContextDestroy(context);
 }
 
 /*
@@ -142,6 +168,20 @@ void test_token_operations()
     TEST_SECURITY_VIOLATION(result != SECURITY_SUCCESS, 
                            "Token validation rejects wrong slot ID");
     
+    /* Test tampered expiry (the MAC covers it) */
+    TokenCapability extended = token;
+    extended.expiryTime += 1000000;
+    result = TokenValidate(context, 123, &extended);
+    TEST_SECURITY_VIOLATION(result != SECURITY_SUCCESS, 
+                           "Token validation rejects tampered expiry");
+    
+    /* Same machine, same fingerprint: the key still differs per context */
+    SecurityContext *other = SecurityContextCreate(SECURITY_LEVEL_HARDWARE);
+    result = other != NULL ? TokenValidate(other, 123, &token) : SECURITY_SUCCESS;
+    TEST_SECURITY_VIOLATION(result != SECURITY_SUCCESS, 
+                           "Token from another context rejected");
+    SecurityContextDestroy(other);
+    
     SecurityContextDestroy(context);
 }
 
@@ -180,6 +220,18 @@ void test_secure_slot_manager()
     TEST_ASSERT(result == SLOT_SUCCESS, "Secure slot reading");
     TEST_ASSERT(readValue == testValue, "Data integrity verification");
     
+    /* Repeat reads hit the validated-token cache; refresh must still revoke */
+    TokenCapability oldToken = token;
+    result = SlotRefreshToken(manager, &handle, &token);
+    TEST_ASSERT(result == SLOT_SUCCESS, "Token refresh");
+    result = SlotReadSecure(manager, &handle, &readValue, sizeof(readValue), 
+                          &bytesRead, &oldToken);
+    TEST_SECURITY_VIOLATION(result != SLOT_SUCCESS, 
+                           "Superseded token rejected after refresh");
+    result = SlotReadSecure(manager, &handle, &readValue, sizeof(readValue), 
+                          &bytesRead, &token);
+    TEST_ASSERT(result == SLOT_SUCCESS, "Refreshed token accepted");
+    
     /* Test secure release */
     result = SlotReleaseSecure(manager, &handle, &token);
     TEST_ASSERT(result == SLOT_SUCCESS, "Secure slot release");
@@ -235,6 +287,12 @@ void test_security_violations()
     TEST_SECURITY_VIOLATION(result != SLOT_SUCCESS, 
                            "Write without permission blocked");
     
+    /* Keep probing until the denials pass the anomaly threshold */
+    for (int i = 0; i < SECURITY_MAX_VALIDATION_FAILURES; i++) {
+        SlotWriteSecure(manager, &handle, &testValue, sizeof(testValue), 
+                       &invalidToken);
+    }
+    
     /* Check anomaly detection */
     bool anomalies = SlotManagerDetectAnomalies(manager);
     TEST_ASSERT(anomalies, "Anomaly detection identifies violations");
@@ -370,6 +428,25 @@ void test_performance()
     printf("Token generation: %d operations in %.3f seconds (%.1f ops/sec)\n",
            NUM_OPERATIONS, tokenGenTime, NUM_OPERATIONS / tokenGenTime);
     
+    /* Test token validation throughput (one MAC per validation) */
+    const int NUM_VALIDATIONS = 100000;
+    TokenCapability validationToken;
+    TokenGenerate(manager->securityContext, 7, SECURITY_LEVEL_BASIC, &validationToken);
+    
+    int validCount = 0;
+    start = clock();
+    for (int i = 0; i < NUM_VALIDATIONS; i++) {
+        if (TokenValidate(manager->securityContext, 7, &validationToken) == SECURITY_SUCCESS)
+            validCount++;
+    }
+    end = clock();
+    
+    double validateTime = ((double)(end - start)) / CLOCKS_PER_SEC;
+    printf("Token validation: %d operations in %.3f seconds (%.1f validations/sec)\n",
+           NUM_VALIDATIONS, validateTime,
+           validateTime > 0 ? NUM_VALIDATIONS / validateTime : 0.0);
+    TEST_ASSERT(validCount == NUM_VALIDATIONS, "Repeated validation of an issued token");
+    
     /* Test secure slot operations performance */
     SlotHandle handles[100];
     TokenCapability tokens[100];
@@ -409,10 +486,343 @@ void test_performance()
     g_pergyraSlotManager = NULL;
 }
 
+/*
+ * Test 9: Binary audit logging
+ */
+void test_audit_logging()
+{
+    printf("\n=== Test 9: Binary Audit Logging ===\n");
+    
+    const char *path = "test_security_audit.bin";
+    remove(path);
+    
+    SecurityAuditConfig config = { .ringCapacity = 64, .flushIntervalMs = 1 };
+    SecurityAuditLogger *logger = SecurityAuditLoggerOpen(path, &config);
+    TEST_ASSERT(logger != NULL, "Audit logger creation");
+    
+    SlotManager *manager = SlotManagerCreateSecure(100, 8*1024, true, 
+                                                  SECURITY_LEVEL_BASIC);
+    SlotManagerSetAuditLogger(manager, logger);
+    
+    SlotHandle handle;
+    TokenCapability token;
+    SlotClaimSecure(manager, TYPE_INT, SECURITY_LEVEL_BASIC, &handle, &token);
+    
+    /* Keep one in four writes */
+    SecurityAuditLoggerSetSampling(logger, SECURITY_AUDIT_SECURE_WRITE, 4);
+    int value = 7;
+    for (int i = 0; i < 8; i++)
+        SlotWriteSecure(manager, &handle, &value, sizeof(value), &token);
+    
+    /* Overload a 64-entry ring; the excess is counted, not blocked on */
+    for (int i = 0; i < 100000; i++)
+        SecurityAuditLoggerRecord(logger, SECURITY_AUDIT_SECURE_READ, handle.slotId);
+    
+    SlotManagerSetAuditLogger(manager, NULL);
+    uint64_t dropped = SecurityAuditLoggerDropped(logger);
+    SecurityAuditLoggerClose(logger);
+    
+    FILE *fp = fopen(path, "rb");
+    long size = 0;
+    if (fp != NULL) {
+        fseek(fp, 0, SEEK_END);
+        size = ftell(fp);
+        fclose(fp);
+    }
+    
+    long entries = (size - (long)sizeof(SecurityAuditHeader)) / 
+                   (long)sizeof(SecurityAuditEntry);
+    printf("Audit file: %ld entries, %llu dropped\n", entries, 
+           (unsigned long long)dropped);
+    
+    /* 1 claim + 2 sampled writes + reads, every record written or dropped */
+    TEST_ASSERT(size >= (long)(sizeof(SecurityAuditHeader) + 3 * sizeof(SecurityAuditEntry)),
+                "Audit entries written to file");
+    TEST_ASSERT((uint64_t)entries + dropped == 3 + 100000, 
+                "Sampled and dropped entries accounted for");
+    
+    remove(path);
+    SlotReleaseSecure(manager, &handle, &token);
+    SlotManagerDestroySecure(manager);
+}
+
+/*
+ * Test 10: Encrypted slot payloads
+ */
+static double print_payload_throughput(const char *label, long slots,
+                                       size_t slotSize, double seconds)
+{
+    if (seconds <= 0)
+        seconds = 1e-9;
+    
+    printf("%s: %ld slots in %.3f seconds (%.1f MB/s, %.0f ns/slot)\n",
+           label, slots, seconds, (double)slots * slotSize / seconds / 1e6,
+           seconds * 1e9 / slots);
+    return seconds;
+}
+
+/*
+ * Reference sealing: a fresh EVP context and key schedule per slot, as
+ * without the per-thread cipher cache. Returns the slots sealed.
+ */
+static long seal_uncached(SecurityCipher cipher, const uint8_t *record, size_t size,
+                          long slots)
+{
+    const EVP_CIPHER *evp = cipher == SECURITY_CIPHER_CHACHA20_POLY1305 ?
+                            EVP_chacha20_poly1305() : EVP_aes_256_gcm();
+    uint8_t key[32], nonce[SECURITY_PAYLOAD_NONCE_SIZE];
+    uint8_t tag[SECURITY_PAYLOAD_TAG_SIZE], ciphertext[256];
+    long sealed = 0;
+    int outSize;
+    
+    memset(key, 0x5A, sizeof(key));
+    memset(nonce, 0, sizeof(nonce));
+    
+    for (long i = 0; i < slots && size <= sizeof(ciphertext); i++) {
+        memcpy(nonce, &i, sizeof(i));
+        EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
+        if (ctx != NULL &&
+            EVP_EncryptInit_ex(ctx, evp, NULL, key, nonce) == 1 &&
+            EVP_EncryptUpdate(ctx, ciphertext, &outSize, record, (int)size) == 1 &&
+            EVP_EncryptFinal_ex(ctx, ciphertext + size, &outSize) == 1 &&
+            EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_GET_TAG, sizeof(tag), tag) == 1)
+            sealed++;
+        EVP_CIPHER_CTX_free(ctx);
+    }
+    
+    return sealed;
+}
+
+void test_encrypted_payloads()
+{
+    printf("\n=== Test 10: Encrypted Slot Payloads ===\n");
+    
+    SlotManager *manager = SlotManagerCreateSecure(2048, 1024*1024, true, 
+                                                  SECURITY_LEVEL_ENCRYPTED);
+    TEST_ASSERT(manager != NULL, "Encrypted slot manager creation");
+    printf("Payload cipher: %s\n", 
+           SecurityCipherName(manager->securityContext->cipher));
+    
+    /* Types past TYPE_CUSTOM occupy 64 bytes */
+    const TypeTag recordType = (TypeTag)(TYPE_CUSTOM + 1);
+    SlotHandle handle;
+    TokenCapability token;
+    SlotError result = SlotClaimSecure(manager, recordType, SECURITY_LEVEL_ENCRYPTED,
+                                     &handle, &token);
+    TEST_ASSERT(result == SLOT_SUCCESS, "Encrypted slot claiming");
+    
+    char secret[64] = "encrypted slot payload";
+    result = SlotWriteSecure(manager, &handle, secret, sizeof(secret), &token);
+    TEST_ASSERT(result == SLOT_SUCCESS, "Encrypted slot writing");
+    
+    SlotEntry *entry = NULL;
+    for (size_t i = 0; i < manager->tableSize; i++) {
+        if (manager->slotTable[i].occupied && 
+            manager->slotTable[i].slotId == handle.slotId)
+            entry = &manager->slotTable[i];
+    }
+    const uint8_t *block = entry != NULL ? entry->dataBlockRef : NULL;
+    TEST_ASSERT(block != NULL &&
+                memcmp(block + SECURITY_PAYLOAD_OVERHEAD, secret, sizeof(secret)) != 0,
+                "Slot memory holds ciphertext only");
+    
+    char readBack[64];
+    size_t bytesRead = 0;
+    result = SlotReadSecure(manager, &handle, readBack, sizeof(readBack), 
+                          &bytesRead, &token);
+    TEST_ASSERT(result == SLOT_SUCCESS && bytesRead == sizeof(readBack) &&
+                memcmp(readBack, secret, sizeof(secret)) == 0,
+                "Encrypted slot round trip");
+    
+    /* Short writes are zero-padded; short reads are truncated */
+    char prefix[8];
+    SlotWriteSecure(manager, &handle, "short", 6, &token);
+    result = SlotReadSecure(manager, &handle, prefix, sizeof(prefix), 
+                          &bytesRead, &token);
+    TEST_ASSERT(result == SLOT_SUCCESS && bytesRead == sizeof(prefix) &&
+                memcmp(prefix, "short\0\0\0", sizeof(prefix)) == 0,
+                "Short write and short read");
+    
+    /* One flipped ciphertext bit fails authentication */
+    if (block != NULL) {
+        ((uint8_t *)block)[SECURITY_PAYLOAD_OVERHEAD + 3] ^= 0x01;
+        result = SlotReadSecure(manager, &handle, readBack, sizeof(readBack), 
+                              &bytesRead, &token);
+        TEST_SECURITY_VIOLATION(result == SLOT_ERROR_PERMISSION_DENIED,
+                               "Tampered ciphertext rejected");
+        ((uint8_t *)block)[SECURITY_PAYLOAD_OVERHEAD + 3] ^= 0x01;
+    }
+    
+    /* The token copy kept with the slot decrypts to the issued token */
+    SecureToken storedToken;
+    SecurityError secResult = entry != NULL ?
+        TokenDecrypt(manager->securityContext, &entry->writeToken, &storedToken) :
+        SECURITY_ERROR_INVALID_TOKEN;
+    TEST_ASSERT(secResult == SECURITY_SUCCESS && 
+                TokenCompareSecure(&storedToken, &token.token),
+                "Stored token decryption");
+    
+    /* Throughput over many small slots, one call per slot and batched */
+    enum { BENCH_SLOTS = 1024, BENCH_ROUNDS = 100 };
+    SlotHandle *handles = malloc(BENCH_SLOTS * sizeof(SlotHandle));
+    TokenCapability *tokens = malloc(BENCH_SLOTS * sizeof(TokenCapability));
+    SlotWriteRequest *requests = malloc(BENCH_SLOTS * sizeof(SlotWriteRequest));
+    SlotError *results = malloc(BENCH_SLOTS * sizeof(SlotError));
+    uint8_t record[64];
+    memset(record, 0xA5, sizeof(record));
+    
+    int claimed = 0;
+    for (int i = 0; i < BENCH_SLOTS; i++) {
+        if (SlotClaimSecure(manager, recordType, SECURITY_LEVEL_ENCRYPTED,
+                           &handles[i], &tokens[i]) == SLOT_SUCCESS)
+            claimed++;
+        requests[i].handle = &handles[i];
+        requests[i].data = record;
+        requests[i].dataSize = sizeof(record);
+        requests[i].token = &tokens[i];
+    }
+    TEST_ASSERT(claimed == BENCH_SLOTS, "Encrypted benchmark slots claimed");
+    
+    /* Cipher cost alone, without token checks or slot lookup */
+    SecurePayloadItem *items = malloc(BENCH_SLOTS * sizeof(SecurePayloadItem));
+    uint8_t *sealed = malloc(BENCH_SLOTS * (sizeof(record) + SECURITY_PAYLOAD_OVERHEAD));
+    for (int i = 0; i < BENCH_SLOTS; i++) {
+        items[i].slotId = (uint32_t)i;
+        items[i].plaintext = record;
+        items[i].size = sizeof(record);
+        items[i].capacity = sizeof(record);
+        items[i].sealed = sealed + i * (sizeof(record) + SECURITY_PAYLOAD_OVERHEAD);
+    }
+    
+    long ops = (long)BENCH_SLOTS * BENCH_ROUNDS;
+    size_t sealedCount = 0;
+    clock_t start = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++)
+        sealedCount += SecurePayloadSealBatch(manager->securityContext, items, BENCH_SLOTS);
+    double cachedTime = print_payload_throughput("Payload sealing", ops, sizeof(record),
+                                                 (double)(clock() - start) / CLOCKS_PER_SEC);
+    TEST_ASSERT(sealedCount == (size_t)ops, "Batched payload sealing");
+    
+    start = clock();
+    long uncachedCount = seal_uncached(manager->securityContext->cipher, record,
+                                       sizeof(record), ops);
+    double uncachedTime = print_payload_throughput("Payload sealing, context per slot", ops,
+                                                   sizeof(record),
+                                                   (double)(clock() - start) / CLOCKS_PER_SEC);
+    printf("Cached cipher context speedup: %.1fx\n", uncachedTime / cachedTime);
+    TEST_ASSERT(uncachedCount == ops, "Reference sealing with a context per slot");
+    free(items);
+    free(sealed);
+    
+    start = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        for (int i = 0; i < BENCH_SLOTS; i++)
+            SlotWriteSecure(manager, &handles[i], record, sizeof(record), &tokens[i]);
+    }
+    print_payload_throughput("Encrypted writes", ops, sizeof(record),
+                             (double)(clock() - start) / CLOCKS_PER_SEC);
+    
+    size_t written = 0;
+    start = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++)
+        written += SlotWriteSecureBatch(manager, requests, BENCH_SLOTS, results);
+    print_payload_throughput("Encrypted batch writes", ops, sizeof(record),
+                             (double)(clock() - start) / CLOCKS_PER_SEC);
+    TEST_ASSERT(written == (size_t)ops, "Batched encrypted writes");
+    
+    int readOk = 0;
+    start = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        for (int i = 0; i < BENCH_SLOTS; i++) {
+            if (SlotReadSecure(manager, &handles[i], readBack, sizeof(readBack),
+                              &bytesRead, &tokens[i]) == SLOT_SUCCESS)
+                readOk++;
+        }
+    }
+    print_payload_throughput("Encrypted reads", ops, sizeof(record),
+                             (double)(clock() - start) / CLOCKS_PER_SEC);
+    TEST_ASSERT(readOk == ops && memcmp(readBack, record, sizeof(record)) == 0,
+                "Encrypted reads after batched writes");
+    
+    for (int i = 0; i < BENCH_SLOTS; i++)
+        SlotReleaseSecure(manager, &handles[i], &tokens[i]);
+    free(handles);
+    free(tokens);
+    free(requests);
+    free(results);
+    
+    /* Disabling security must not leave the payload readable */
+    SlotManagerDisableSecurity(manager);
+    TEST_ASSERT(block == NULL || memcmp(block, secret, 6) != 0,
+                "Encrypted payload wiped with its key");
+    
+    SlotRelease(manager, &handle);
+    SlotManagerDestroySecure(manager);
+}
+
+/*
+ * Test 11: Validated token cache
+ */
+void test_token_cache()
+{
+    printf("\n=== Test 11: Validated Token Cache ===\n");
+    
+    SlotManager *manager = SlotManagerCreateSecure(100, 8*1024, true, 
+                                                  SECURITY_LEVEL_BASIC);
+    SlotHandle handle;
+    TokenCapability token;
+    SlotError result = SlotClaimSecure(manager, TYPE_INT, SECURITY_LEVEL_BASIC,
+                                     &handle, &token);
+    TEST_ASSERT(result == SLOT_SUCCESS, "Slot claimed for cache tests");
+    
+    /* The first access fills the cache; the rest hit it and still count */
+    int value = 5;
+    int readValue = 0;
+    size_t bytesRead;
+    SlotWriteSecure(manager, &handle, &value, sizeof(value), &token);
+    uint64_t validated = manager->securityContext->tokensValidated;
+    int hits = 0;
+    for (int i = 0; i < 10; i++) {
+        if (SlotReadSecure(manager, &handle, &readValue, sizeof(readValue),
+                          &bytesRead, &token) == SLOT_SUCCESS)
+            hits++;
+    }
+    TEST_ASSERT(hits == 10 && readValue == value, "Cached token accepted");
+    TEST_ASSERT(manager->securityContext->tokensValidated == validated + 10,
+                "Cache hits counted as validations");
+    
+    /* Revocation reaches tokens already in the cache */
+    result = SlotRevokeToken(manager, &handle);
+    TEST_ASSERT(result == SLOT_SUCCESS, "Token revocation");
+    result = SlotReadSecure(manager, &handle, &readValue, sizeof(readValue), 
+                          &bytesRead, &token);
+    TEST_SECURITY_VIOLATION(result != SLOT_SUCCESS, 
+                           "Cached token rejected after revocation");
+    
+    SlotManagerDestroySecure(manager);
+    
+    /* A later context may reuse this one's address, slot ID and generation */
+    SlotHandle oldHandle;
+    TokenCapability oldToken;
+    manager = SlotManagerCreateSecure(100, 8*1024, true, SECURITY_LEVEL_BASIC);
+    SlotClaimSecure(manager, TYPE_INT, SECURITY_LEVEL_BASIC, &oldHandle, &oldToken);
+    SlotWriteSecure(manager, &oldHandle, &value, sizeof(value), &oldToken);
+    SlotManagerDestroySecure(manager);
+    
+    manager = SlotManagerCreateSecure(100, 8*1024, true, SECURITY_LEVEL_BASIC);
+    SlotClaimSecure(manager, TYPE_INT, SECURITY_LEVEL_BASIC, &handle, &token);
+    result = SlotWriteSecure(manager, &oldHandle, &value, sizeof(value), &oldToken);
+    TEST_SECURITY_VIOLATION(result != SLOT_SUCCESS, 
+                           "Token cached under a destroyed context rejected");
+    
+    SlotReleaseSecure(manager, &handle, &token);
+    SlotManagerDestroySecure(manager);
+}
+
 /*
  * Main test runner
  */
-int main(int argc, char *argv[])
+int main(void)
 {
     printf("===== Pergyra Security System Test Suite =====\n");
     printf("Testing secure slot-based memory management...\n");
@@ -429,6 +839,9 @@ int main(int argc, char *argv[])
     test_scope_based_slots();
     test_pergyra_api();
     test_performance();
+    test_audit_logging();
+    test_encrypted_payloads();
+    test_token_cache();
     
     /* Print final results */
     print_test_results();
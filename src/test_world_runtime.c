@@ -0,0 +1,528 @@
+/*
+ * Copyright (c) 2025 Pergyra Language Project
+ * All rights reserved.
+ *
+ * World Runtime Test Suite
+ *
+ * Checks the frame executor and its helpers:
+ * - Frame DAG ordering of parties under RAW, WAR and WAW declarations
+ * - Execution plan worker assignment (co-location and group caps)
+ * - Partitioned systemics: party timing and messages across a reshard
+ * - World snapshots: round trip and fallback past a torn header
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "runtime/world_systemic.h"
+#include "runtime/world_snapshot.h"
+
+#define NUM_ORDER_ROLES     8
+#define ORDER_FRAMES        20
+#define PLAN_WORKERS        4
+#define NUM_PLAN_PARTIES    8
+#define NUM_RESHARD_MESSAGES 32
+
+/* No slot manager: role instances come from GetSlotPointer below */
+SlotManager *g_pergyraSlotManager = NULL;
+
+/* Test statistics */
+static int g_totalTests = 0;
+static int g_failedTests = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        g_totalTests++; \
+        if (condition) { \
+            printf("[PASS] %s\n", message); \
+        } else { \
+            g_failedTests++; \
+            printf("[FAIL] %s\n", message); \
+        } \
+    } while(0)
+
+/* Ordering fixture: instance slot N (1-based) stamps role N - 1 */
+typedef struct {
+    atomic_uint startTicket;
+    atomic_uint finishTicket;
+} OrderRole;
+
+static OrderRole g_orderRoles[NUM_ORDER_ROLES];
+static atomic_uint g_ticket = 0;
+
+void* GetSlotPointer(uint32_t slotId)
+{
+    if (slotId == 0 || slotId > NUM_ORDER_ROLES) {
+        return NULL;
+    }
+    return &g_orderRoles[slotId - 1];
+}
+
+static void SleepMs(uint32_t ms)
+{
+    struct timespec ts = { .tv_sec = ms / 1000, .tv_nsec = (long)(ms % 1000) * 1000000L };
+    nanosleep(&ts, NULL);
+}
+
+/* Takes a ticket on entry and on exit; the sleep widens any overlap */
+static void OrderParallel(void* role, void* context)
+{
+    OrderRole* order = (OrderRole*)role;
+    (void)context;
+
+    atomic_store(&order->startTicket, atomic_fetch_add(&g_ticket, 1));
+    SleepMs(2);
+    atomic_store(&order->finishTicket, atomic_fetch_add(&g_ticket, 1));
+}
+
+static RoleParallelMetadata g_orderMetadata = {
+    .roleName = "order", .function = OrderParallel,
+    .scheduler = SCHEDULER_CPU_FIBER, .priority = PRIORITY_NORMAL
+};
+
+static PartyContext g_partyContexts[NUM_ORDER_ROLES];
+static PartyContext g_planContexts[NUM_PLAN_PARTIES];
+
+/* Party 'slotName' with its own context, running one role on 'instanceSlotId' */
+static bool AddPartyWithContext(SystemicContext* systemic, const char* slotName,
+                                uint32_t instanceSlotId, PartyContext* context)
+{
+    RoleBinding binding = {
+        .slotName = "order", .instanceSlotId = instanceSlotId, .metadata = &g_orderMetadata
+    };
+    context->partyName = "OrderParty";
+
+    FiberMap* map = GenerateFiberMap("OrderParty", &binding, 1);
+    bool added = map && SystemicAddParty(systemic, slotName, NULL, context) &&
+                 SystemicSetPartyFiberMap(systemic, slotName, map);
+    FreeFiberMap(map);
+    return added;
+}
+
+static bool AddOrderParty(SystemicContext* systemic, const char* slotName,
+                          uint32_t instanceSlotId)
+{
+    return AddPartyWithContext(systemic, slotName, instanceSlotId,
+                               &g_partyContexts[instanceSlotId - 1]);
+}
+
+/* Role 'before' had finished when role 'after' started */
+static bool RanBefore(size_t before, size_t after)
+{
+    return atomic_load(&g_orderRoles[before].finishTicket) <
+           atomic_load(&g_orderRoles[after].startTicket);
+}
+
+static bool Overlapped(size_t a, size_t b)
+{
+    return !RanBefore(a, b) && !RanBefore(b, a);
+}
+
+static void TestFrameOrdering(void)
+{
+    SystemicContext* systemic = CreateSystemic("OrderSystem", "order");
+    TEST_ASSERT(systemic != NULL, "Systemic creation");
+    if (!systemic) {
+        return;
+    }
+
+    /*
+     * writer -> reader (RAW), reader -> rewriter (WAR), writer -> rewriter
+     * (WAW). The two independent parties touch another field only.
+     */
+    bool built = AddOrderParty(systemic, "writer", 1) &&
+                 AddOrderParty(systemic, "reader", 2) &&
+                 AddOrderParty(systemic, "rewriter", 3) &&
+                 AddOrderParty(systemic, "firstWriter", 4) &&
+                 AddOrderParty(systemic, "secondWriter", 5) &&
+                 AddOrderParty(systemic, "loneReader", 6) &&
+                 AddOrderParty(systemic, "otherReader", 7);
+    built = built &&
+        SystemicDeclareAccess(systemic, "writer", "health", FIELD_ACCESS_WRITE) &&
+        SystemicDeclareAccess(systemic, "reader", "health", FIELD_ACCESS_READ) &&
+        SystemicDeclareAccess(systemic, "rewriter", "health", FIELD_ACCESS_WRITE) &&
+        SystemicDeclareAccess(systemic, "firstWriter", "mana", FIELD_ACCESS_WRITE) &&
+        SystemicDeclareAccess(systemic, "secondWriter", "mana", FIELD_ACCESS_WRITE) &&
+        SystemicDeclareAccess(systemic, "loneReader", "stamina", FIELD_ACCESS_READ) &&
+        SystemicDeclareAccess(systemic, "otherReader", "stamina", FIELD_ACCESS_READ);
+    TEST_ASSERT(built, "Ordering parties and accesses declared");
+    if (!built) {
+        FreeSystemicContext(systemic);
+        return;
+    }
+
+    bool framesSucceeded = true;
+    bool readAfterWrite = true;
+    bool writeAfterRead = true;
+    bool writeAfterWrite = true;
+    int readersOverlapped = 0;
+
+    for (int frame = 0; frame < ORDER_FRAMES; frame++) {
+        SystemicExecutionResult result = ExecuteSystemic(systemic, JOIN_ALL, NULL);
+        framesSucceeded &= result.allSucceeded && result.resultCount == 7;
+
+        readAfterWrite &= RanBefore(0, 1);
+        writeAfterRead &= RanBefore(1, 2);
+        writeAfterWrite &= RanBefore(0, 2) && RanBefore(3, 4);
+        readersOverlapped += Overlapped(5, 6);
+    }
+
+    TEST_ASSERT(framesSucceeded, "Ordered frames succeed");
+    TEST_ASSERT(readAfterWrite, "RAW: reader starts after the writer finished");
+    TEST_ASSERT(writeAfterRead, "WAR: writer starts after the earlier reader finished");
+    TEST_ASSERT(writeAfterWrite, "WAW: writers of one field never overlap");
+    TEST_ASSERT(readersOverlapped > 0, "Readers of one field run concurrently");
+
+    FreeSystemicContext(systemic);
+}
+
+/* Plan the systemic as the only one of a world on PLAN_WORKERS workers */
+static HierarchicalExecutionPlan* PlanSystemic(SystemicContext* systemic, WorldContext** world)
+{
+    *world = CreateWorld("PlanWorld");
+    if (!*world || !WorldAddSystemic(*world, "main", systemic)) {
+        return NULL;
+    }
+
+    HierarchicalExecutionPlan* plan = GenerateWorldExecutionPlan(*world);
+    ExecutionPlanConstraints constraints = { .availableCpuCores = PLAN_WORKERS };
+    if (plan) {
+        OptimizeExecutionPlan(plan, &constraints);
+    }
+    return plan;
+}
+
+static uint32_t PlannedWorker(const HierarchicalExecutionPlan* plan, const char* partyName)
+{
+    for (size_t p = 0; p < plan->systemics[0].partyCount; p++) {
+        if (strcmp(plan->systemics[0].parties[p].partyName, partyName) == 0) {
+            return plan->systemics[0].parties[p].worker;
+        }
+    }
+    return PLAN_WORKER_ANY;
+}
+
+static size_t DistinctWorkers(const HierarchicalExecutionPlan* plan, const char** names,
+                              size_t count)
+{
+    bool used[PLAN_WORKERS] = { false };
+    size_t distinct = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        uint32_t worker = PlannedWorker(plan, names[i]);
+        if (worker < PLAN_WORKERS && !used[worker]) {
+            used[worker] = true;
+            distinct++;
+        }
+    }
+    return distinct;
+}
+
+static void TestPlanColocation(void)
+{
+    static const char* lookers[] = { "lookerA", "lookerB", "lookerC", "lookerD" };
+    SystemicContext* systemic = CreateSystemic("PlanSystem", "plan");
+    WorldContext* world = NULL;
+
+    /* tank and healer share a context; writer and reader conflict on health */
+    bool built = systemic &&
+        AddPartyWithContext(systemic, "tank", 1, &g_planContexts[0]) &&
+        AddPartyWithContext(systemic, "healer", 2, &g_planContexts[0]) &&
+        AddPartyWithContext(systemic, "writer", 3, &g_planContexts[1]) &&
+        AddPartyWithContext(systemic, "reader", 4, &g_planContexts[2]) &&
+        SystemicDeclareAccess(systemic, "writer", "health", FIELD_ACCESS_WRITE) &&
+        SystemicDeclareAccess(systemic, "reader", "health", FIELD_ACCESS_READ);
+    for (size_t i = 0; built && i < 4; i++) {
+        built = AddPartyWithContext(systemic, lookers[i], (uint32_t)i + 5,
+                                    &g_planContexts[i + 3]) &&
+                SystemicDeclareAccess(systemic, lookers[i], "weather", FIELD_ACCESS_READ);
+    }
+
+    HierarchicalExecutionPlan* plan = built ? PlanSystemic(systemic, &world) : NULL;
+    TEST_ASSERT(plan != NULL && plan->workerCount == PLAN_WORKERS, "Co-location plan built");
+    if (plan) {
+        uint32_t tank = PlannedWorker(plan, "tank");
+        uint32_t writer = PlannedWorker(plan, "writer");
+        TEST_ASSERT(tank < PLAN_WORKERS && tank == PlannedWorker(plan, "healer"),
+                    "Parties sharing a context share a worker");
+        TEST_ASSERT(writer < PLAN_WORKERS && writer == PlannedWorker(plan, "reader"),
+                    "Writer and reader of a field share a worker");
+        TEST_ASSERT(DistinctWorkers(plan, lookers, 4) > 1,
+                    "Readers of a read-only field spread over workers");
+    }
+
+    FreeExecutionPlan(plan);
+    FreeWorldContext(world);
+    FreeSystemicContext(systemic);
+}
+
+static void TestPlanGroupCap(void)
+{
+    static const char* writers[NUM_PLAN_PARTIES] = {
+        "w0", "w1", "w2", "w3", "w4", "w5", "w6", "w7"
+    };
+    SystemicContext* systemic = CreateSystemic("PlanSystem", "hot");
+    WorldContext* world = NULL;
+
+    /* Every party writes the same field */
+    bool built = systemic != NULL;
+    for (size_t i = 0; built && i < NUM_PLAN_PARTIES; i++) {
+        built = AddPartyWithContext(systemic, writers[i], (uint32_t)i + 1,
+                                    &g_planContexts[i]) &&
+                SystemicDeclareAccess(systemic, writers[i], "health", FIELD_ACCESS_WRITE);
+    }
+
+    HierarchicalExecutionPlan* plan = built ? PlanSystemic(systemic, &world) : NULL;
+    TEST_ASSERT(plan != NULL, "Hot-field plan built");
+    if (plan) {
+        TEST_ASSERT(DistinctWorkers(plan, writers, NUM_PLAN_PARTIES) == PLAN_WORKERS,
+                    "One hot field does not pull every party onto one worker");
+        TEST_ASSERT(plan->imbalance <= 1.0 + 1e-9, "Capped groups balance evenly");
+    }
+
+    FreeExecutionPlan(plan);
+    FreeWorldContext(world);
+    FreeSystemicContext(systemic);
+}
+
+static atomic_uint g_deliveredMessages = 0;
+static atomic_uint g_misroutedMessages = 0;
+
+static void CountMessage(SystemicContext* systemic, uint32_t partition,
+                         const PartitionMessage* message, const void* payload, void* userData)
+{
+    (void)userData;
+
+    if (SystemicPartitionOf(systemic, message->targetKey) != partition ||
+        *(const uint64_t*)payload != message->targetKey) {
+        atomic_fetch_add(&g_misroutedMessages, 1);
+    }
+    atomic_fetch_add(&g_deliveredMessages, 1);
+}
+
+static void TestPartitionReshard(void)
+{
+    static const char* names[4] = { "p0", "p1", "p2", "p3" };
+    SystemicContext* systemic = CreateSystemic("ShardSystem", "shards");
+
+    bool built = systemic && SystemicEnablePartitioning(systemic, 2, NULL, NULL) &&
+                 SystemicSetMessageHandler(systemic, CountMessage, NULL);
+    for (size_t i = 0; built && i < 4; i++) {
+        built = AddPartyWithContext(systemic, names[i], (uint32_t)i + 1, &g_planContexts[i]);
+    }
+    TEST_ASSERT(built, "Partitioned systemic built");
+    if (!built) {
+        FreeSystemicContext(systemic);
+        return;
+    }
+
+    /* Partition tasks account per party like unpartitioned frames do */
+    SystemicExecutionResult result = ExecuteSystemic(systemic, JOIN_ALL, NULL);
+    bool partiesTimed = result.allSucceeded;
+    for (size_t i = 0; i < systemic->partyCount; i++) {
+        partiesTimed &= systemic->partySlots[i].sampledExecutions == 1 &&
+                        systemic->partySlots[i].costEwmaNs > 0;
+    }
+    TEST_ASSERT(partiesTimed, "Partitioned parties record sampled timing and cost");
+
+    /* Posted for next frame, then the systemic is resharded before it runs */
+    bool posted = true;
+    for (uint64_t key = 0; key < NUM_RESHARD_MESSAGES; key++) {
+        posted &= SystemicPostMessage(systemic, key, &key, sizeof(key));
+    }
+    TEST_ASSERT(posted && SystemicEnablePartitioning(systemic, 3, NULL, NULL),
+                "Reshard with messages in flight");
+
+    ExecuteSystemic(systemic, JOIN_ALL, NULL);
+    ExecuteSystemic(systemic, JOIN_ALL, NULL);
+    TEST_ASSERT(atomic_load(&g_deliveredMessages) == NUM_RESHARD_MESSAGES &&
+                atomic_load(&g_misroutedMessages) == 0,
+                "Messages survive a reshard and reach their new partitions");
+
+    FreeSystemicContext(systemic);
+}
+
+/* ============= Snapshots ============= */
+
+static PartyContext g_snapshotContext;
+
+static bool BindSnapshotParty(SystemicContext* systemic, const char* partySlot,
+                              const char* partyType, void** partyInstance,
+                              PartyContext** partyContext, void* userData)
+{
+    (void)systemic;
+    (void)partyType;
+    (void)userData;
+
+    *partyInstance = NULL;
+    *partyContext = &g_snapshotContext;
+    return strcmp(partySlot, "mover") == 0;
+}
+
+/* Value of the one slot in a snapshot, or -1 if it cannot be restored */
+static long SnapshotValue(const char* path, uint32_t slotId, uint64_t* generation)
+{
+    WorldSnapshot* snapshot = WorldSnapshotOpen(path);
+    if (!snapshot) return -1;
+
+    *generation = WorldSnapshotGeneration(snapshot);
+    SlotManager* restored = WorldSnapshotRestoreSlots(snapshot);
+    WorldSnapshotClose(snapshot);
+    if (!restored) return -1;
+
+    SlotHandle handle = { .slotId = slotId, .typeTag = TYPE_LONG, .generation = 1 };
+    long value = -1;
+    size_t bytesRead = 0;
+    if (SlotRead(restored, &handle, &value, sizeof(value), &bytesRead) != SLOT_SUCCESS ||
+        bytesRead != sizeof(value)) {
+        value = -1;
+    }
+
+    SlotManagerDestroy(restored);
+    return value;
+}
+
+/* Flip a byte of header slot 'slot', as a write torn mid-page would */
+static bool TearHeader(const char* path, uint32_t slot)
+{
+    FILE* file = fopen(path, "r+b");
+    if (!file) return false;
+
+    long offset = (long)slot * sysconf(_SC_PAGESIZE) + 16;
+    int byte = fseek(file, offset, SEEK_SET) == 0 ? fgetc(file) : EOF;
+    bool torn = byte != EOF && fseek(file, offset, SEEK_SET) == 0 &&
+                fputc(byte ^ 0xFF, file) != EOF;
+    return fclose(file) == 0 && torn;
+}
+
+static void TestSnapshotRoundTrip(void)
+{
+    char path[] = "/tmp/pergyra_snapshotXXXXXX";
+    int fd = mkstemp(path);
+    TEST_ASSERT(fd >= 0, "Snapshot file creation");
+    if (fd < 0) return;
+    close(fd);
+
+    SlotManager* slots = SlotManagerCreate(16, 64 * 1024);
+    SlotHandle handle;
+    long value = 42;
+    TEST_ASSERT(slots && SlotClaim(slots, TYPE_LONG, &handle) == SLOT_SUCCESS &&
+                SlotWrite(slots, &handle, &value, sizeof(value)) == SLOT_SUCCESS,
+                "Snapshot slot setup");
+
+    WorldContext* world = CreateWorld("snapshot");
+    SystemicContext* systemic = CreateSystemic("MoveSystem", "movement");
+    bool built = world && systemic && WorldAddSystemic(world, "movement", systemic) &&
+                 SystemicAddParty(systemic, "mover", NULL, &g_snapshotContext) &&
+                 SystemicDeclareAccess(systemic, "mover", "position", FIELD_ACCESS_WRITE);
+    TEST_ASSERT(built, "Snapshot world setup");
+    if (world) world->frameCount = 7;
+
+    WorldSnapshotWriter* writer = WorldSnapshotWriterOpen(path);
+    TEST_ASSERT(writer && WorldSnapshotCheckpoint(writer, world, slots),
+                "Checkpoint a world and its slots");
+    WorldSnapshotWriterClose(writer);
+
+    WorldSnapshot* snapshot = WorldSnapshotOpen(path);
+    TEST_ASSERT(snapshot && WorldSnapshotGeneration(snapshot) == 1,
+                "Snapshot opens at its first generation");
+
+    WorldSnapshotBindings bindings = { .bindParty = BindSnapshotParty };
+    WorldContext* restored = snapshot ? WorldSnapshotRestoreWorld(snapshot, &bindings) : NULL;
+    SystemicContext* restoredSystemic = restored && restored->systemicCount == 1 ?
+        restored->systemics[0].instance : NULL;
+    TEST_ASSERT(restored && strcmp(restored->name, "snapshot") == 0 &&
+                restored->frameCount == 7 && restoredSystemic &&
+                restoredSystemic->partyCount == 1 &&
+                strcmp(restoredSystemic->partySlots[0].slotName, "mover") == 0 &&
+                restoredSystemic->partySlots[0].accessCount == 1,
+                "Restored world keeps its systemics, parties and accesses");
+    WorldSnapshotClose(snapshot);
+
+    uint64_t generation = 0;
+    TEST_ASSERT(SnapshotValue(path, handle.slotId, &generation) == 42,
+                "Restored slots read back what was checkpointed");
+
+    if (restored) {
+        FreeSystemicContext(restoredSystemic);
+        FreeWorldContext(restored);
+    }
+    FreeSystemicContext(systemic);
+    FreeWorldContext(world);
+    SlotManagerDestroy(slots);
+    unlink(path);
+}
+
+static void TestSnapshotTornHeader(void)
+{
+    char path[] = "/tmp/pergyra_snapshotXXXXXX";
+    int fd = mkstemp(path);
+    TEST_ASSERT(fd >= 0, "Snapshot file creation");
+    if (fd < 0) return;
+    close(fd);
+
+    SlotManager* slots = SlotManagerCreate(16, 64 * 1024);
+    SlotHandle handle;
+    bool claimed = slots && SlotClaim(slots, TYPE_LONG, &handle) == SLOT_SUCCESS;
+
+    /* Generations 1, 2 and 3 hold 100, 200 and 300; 3 overwrote 1's pages */
+    WorldSnapshotWriter* writer = WorldSnapshotWriterOpen(path);
+    bool written = claimed && writer != NULL;
+    for (long value = 100; written && value <= 300; value += 100) {
+        written = SlotWrite(slots, &handle, &value, sizeof(value)) == SLOT_SUCCESS &&
+                  WorldSnapshotCheckpoint(writer, NULL, slots);
+    }
+    WorldSnapshotWriterClose(writer);
+    TEST_ASSERT(written, "Three checkpoints of a changing slot");
+
+    uint64_t generation = 0;
+    TEST_ASSERT(SnapshotValue(path, handle.slotId, &generation) == 300 && generation == 3,
+                "Snapshot opens at the newest generation");
+
+    /* Generation 3 went to header slot 0 */
+    TEST_ASSERT(TearHeader(path, 0) &&
+                SnapshotValue(path, handle.slotId, &generation) == 200 && generation == 2,
+                "Torn newest header falls back to the previous generation intact");
+
+    /* A writer reopened on the torn file resumes after generation 2 and spares it */
+    writer = WorldSnapshotWriterOpen(path);
+    long value = 400;
+    TEST_ASSERT(writer && SlotWrite(slots, &handle, &value, sizeof(value)) == SLOT_SUCCESS &&
+                WorldSnapshotCheckpoint(writer, NULL, slots) &&
+                SnapshotValue(path, handle.slotId, &generation) == 400 && generation == 3,
+                "Checkpoint after a torn header replaces the torn generation");
+    WorldSnapshotWriterClose(writer);
+
+    TEST_ASSERT(TearHeader(path, 0) && TearHeader(path, 1) &&
+                WorldSnapshotOpen(path) == NULL,
+                "Snapshot with both headers torn is rejected");
+
+    SlotManagerDestroy(slots);
+    unlink(path);
+}
+
+int main(void)
+{
+    printf("===== Pergyra World Runtime Tests =====\n");
+
+    /* Sleeping roles hold a worker each; leave room for concurrent readers */
+    SchedulerPoolConfig pools = {0};
+    pools.workerCounts[SCHEDULER_CPU_FIBER] = 4;
+    TEST_ASSERT(ConfigureSchedulerPools(&pools), "Configure frame pools");
+
+    TestFrameOrdering();
+    TestPlanColocation();
+    TestPlanGroupCap();
+    TestPartitionReshard();
+    TestSnapshotRoundTrip();
+    TestSnapshotTornHeader();
+
+    ShutdownSchedulerPools();
+
+    printf("\n%d tests, %d failed\n", g_totalTests, g_failedTests);
+    return g_failedTests == 0 ? 0 : 1;
+}